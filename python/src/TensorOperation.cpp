@@ -139,6 +139,12 @@ einsum_ir::basic::kernel_t einsum_ir::py::TensorOperation::convert_prim_to_kerne
       return einsum_ir::basic::kernel_t::COPY;
     case einsum_ir::py::TensorOperation::prim_t::relu:
       return einsum_ir::basic::kernel_t::RELU;
+    case einsum_ir::py::TensorOperation::prim_t::gelu:
+      return einsum_ir::basic::kernel_t::GELU;
+    case einsum_ir::py::TensorOperation::prim_t::sigmoid:
+      return einsum_ir::basic::kernel_t::SIGMOID;
+    case einsum_ir::py::TensorOperation::prim_t::tanh:
+      return einsum_ir::basic::kernel_t::TANH;
     case einsum_ir::py::TensorOperation::prim_t::gemm:
       return einsum_ir::basic::kernel_t::MADD;
     case einsum_ir::py::TensorOperation::prim_t::brgemm:
@@ -476,6 +482,25 @@ void einsum_ir::py::TensorOperation::execute( void const * tensor_in0,
   }
 }
 
+std::vector< einsum_ir::basic::thread_stats > einsum_ir::py::TensorOperation::get_stats() const {
+  std::vector< einsum_ir::basic::thread_stats > l_stats;
+  if (m_op_type == op_type_t::unary) {
+    l_stats.resize(1);
+    m_backend_unary.get_stats(l_stats[0].main);
+    l_stats[0].total = l_stats[0].main;
+  }
+  else if (m_op_type == op_type_t::binary) {
+    m_backend_binary.get_stats(l_stats);
+  }
+
+  return l_stats;
+}
+
+void einsum_ir::py::TensorOperation::reset_stats() {
+  m_backend_unary.reset_stats();
+  m_backend_binary.reset_stats();
+}
+
 einsum_ir::py::OptimizationConfig einsum_ir::py::TensorOperation::get_default_optimization_config() {
   OptimizationConfig config;
 
@@ -55,6 +55,9 @@ class einsum_ir::py::TensorOperation {
       relu      =  3,
       gemm      =  4,
       brgemm    =  5,
+      gelu      =  6,
+      sigmoid   =  7,
+      tanh      =  8,
       undefined = 99
     };
 
@@ -123,6 +126,20 @@ class einsum_ir::py::TensorOperation {
                   void const * tensor_in1,
                   void       * tensor_out );
 
+    /**
+     * Get the per-thread instrumentation counters of all executions since the setup or last reset.
+     * The counters are only updated if einsum_ir is built with instrumentation.
+     * Unary operations report a single thread whose main phase holds the evaluations.
+     *
+     * @return Counters of the threads.
+     **/
+    std::vector< einsum_ir::basic::thread_stats > get_stats() const;
+
+    /**
+     * Reset the instrumentation counters.
+     **/
+    void reset_stats();
+
     /**
      * Optimizes a tensor operation configuration.
      *
@@ -21,12 +21,15 @@ PYBIND11_MODULE(_etops_core, m) {
     .export_values();
 
   py::enum_<TensorOperation::prim_t>(m, "PrimType")
-    .value("none",   TensorOperation::prim_t::none)
-    .value("zero",   TensorOperation::prim_t::zero)
-    .value("relu",   TensorOperation::prim_t::relu)
-    .value("copy",   TensorOperation::prim_t::copy)
-    .value("gemm",   TensorOperation::prim_t::gemm)
-    .value("brgemm", TensorOperation::prim_t::brgemm)
+    .value("none",    TensorOperation::prim_t::none)
+    .value("zero",    TensorOperation::prim_t::zero)
+    .value("relu",    TensorOperation::prim_t::relu)
+    .value("copy",    TensorOperation::prim_t::copy)
+    .value("gemm",    TensorOperation::prim_t::gemm)
+    .value("brgemm",  TensorOperation::prim_t::brgemm)
+    .value("gelu",    TensorOperation::prim_t::gelu)
+    .value("sigmoid", TensorOperation::prim_t::sigmoid)
+    .value("tanh",    TensorOperation::prim_t::tanh)
     .export_values();
 
   py::enum_<TensorOperation::exec_t>(m, "ExecType")
@@ -43,6 +46,22 @@ PYBIND11_MODULE(_etops_core, m) {
     .value("k", TensorOperation::dim_t::k)
     .export_values();
 
+  py::class_<einsum_ir::basic::phase_stats>(m, "PhaseStats")
+    .def_readonly("cycles", &einsum_ir::basic::phase_stats::cycles)
+    .def_readonly("calls",  &einsum_ir::basic::phase_stats::calls);
+
+  py::class_<einsum_ir::basic::thread_stats>(m, "ThreadStats")
+    .def_readonly("total",                &einsum_ir::basic::thread_stats::total)
+    .def_readonly("packing_left",         &einsum_ir::basic::thread_stats::packing_left)
+    .def_readonly("packing_right",        &einsum_ir::basic::thread_stats::packing_right)
+    .def_readonly("first_touch",          &einsum_ir::basic::thread_stats::first_touch)
+    .def_readonly("main",                 &einsum_ir::basic::thread_stats::main)
+    .def_readonly("last_touch",           &einsum_ir::basic::thread_stats::last_touch)
+    .def_readonly("packing_hits_left",    &einsum_ir::basic::thread_stats::packing_hits_left)
+    .def_readonly("packing_misses_left",  &einsum_ir::basic::thread_stats::packing_misses_left)
+    .def_readonly("packing_hits_right",   &einsum_ir::basic::thread_stats::packing_hits_right)
+    .def_readonly("packing_misses_right", &einsum_ir::basic::thread_stats::packing_misses_right);
+
   py::class_<TensorOperation>(m, "TensorOperation")
     .def(py::init<>())
     .def(
@@ -86,7 +105,7 @@ PYBIND11_MODULE(_etops_core, m) {
           - prim_main: gemm or brgemm
           - dim_types: use m, n, k, c as appropriate for contraction semantics
           - prim_first: zero or none (first touch operation)
-          - prim_last: relu or none (last touch operation)
+          - prim_last: relu, gelu, sigmoid, tanh or none (last touch operation)
           - strides: [LEVEL][3][DIMENSION] tensor (each level has 3 tensors: in0, in1, out)
 
         Strides 3D tensor structure [LEVEL][TENSOR][DIMENSION]:
@@ -143,6 +162,37 @@ PYBIND11_MODULE(_etops_core, m) {
       py::arg("in1") = py::none(),
       py::arg("out")
     )
+    .def(
+      "get_stats",
+      &TensorOperation::get_stats,
+      R"doc(
+        Get the per-thread instrumentation counters of all executions since the setup or the last reset.
+
+        Counters are only updated if einsum_ir is built with instrumentation
+        (CMake option EINSUM_IR_ENABLE_INSTRUMENTATION), see has_instrumentation.
+        Phases (total, packing_left, packing_right, first_touch, main, last_touch) report cycles and calls.
+        Thread imbalance shows in the total cycles of the threads.
+        Unary operations report a single thread whose main phase holds the evaluations.
+
+        :return: List of ThreadStats, one entry per thread.
+      )doc"
+    )
+    .def(
+      "reset_stats",
+      &TensorOperation::reset_stats,
+      R"doc(
+        Reset the instrumentation counters.
+      )doc"
+    )
+    .def_static(
+      "has_instrumentation",
+      &einsum_ir::basic::ContractionBackend::has_instrumentation,
+      R"doc(
+        Check if einsum_ir was built with instrumentation counters.
+
+        :return: True if the counters are updated, False otherwise.
+      )doc"
+    )
     .def_static(
       "optimize",
       [](
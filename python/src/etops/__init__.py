@@ -36,17 +36,23 @@ float64: _DataType = _DataType.float64
 class prim:
     """Namespace for primitive types used in tensor operations."""
     #: Alias for PrimType.none
-    none   = PrimType.none
+    none    = PrimType.none
     #: Alias for PrimType.zero
-    zero   = PrimType.zero
+    zero    = PrimType.zero
     #: Alias for PrimType.relu
-    relu   = PrimType.relu
+    relu    = PrimType.relu
     #: Alias for PrimType.copy
-    copy   = PrimType.copy
+    copy    = PrimType.copy
     #: Alias for PrimType.gemm
-    gemm   = PrimType.gemm
+    gemm    = PrimType.gemm
     #: Alias for PrimType.brgemm
-    brgemm = PrimType.brgemm
+    brgemm  = PrimType.brgemm
+    #: Alias for PrimType.gelu
+    gelu    = PrimType.gelu
+    #: Alias for PrimType.sigmoid
+    sigmoid = PrimType.sigmoid
+    #: Alias for PrimType.tanh
+    tanh    = PrimType.tanh
 
     __all__ = [
         "none",
@@ -54,7 +60,10 @@ class prim:
         "relu",
         "copy",
         "gemm",
-        "brgemm"
+        "brgemm",
+        "gelu",
+        "sigmoid",
+        "tanh"
     ]
 
     @classmethod
@@ -143,7 +152,7 @@ class TensorOperationConfig:
       - prim_main: etops.prim.gemm or etops.prim.brgemm
       - dim_types: combination of etops.dim.m, .n, .k, .c
       - prim_first: etops.prim.zero or .none (optional first touch)
-      - prim_last: etops.prim.relu or .none (optional last touch)
+      - prim_last: etops.prim.relu, .gelu, .sigmoid, .tanh or .none (optional last touch)
       - strides: shape [1 or more][3][num_dims]
 
     Unary Operations:
@@ -252,10 +261,12 @@ class TensorOperationConfig:
                 )
 
             # Validate prim_last is compatible
-            if self.prim_last not in [PrimType.none, PrimType.relu]:
+            if self.prim_last not in [PrimType.none, PrimType.relu, PrimType.gelu,
+                                      PrimType.sigmoid, PrimType.tanh]:
                 raise ValueError(
-                    f"For binary contractions, prim_last must be etops.prim.none or "
-                    f"etops.prim.relu, got {self.prim_last}."
+                    f"For binary contractions, prim_last must be etops.prim.none, "
+                    f"etops.prim.relu, etops.prim.gelu, etops.prim.sigmoid or "
+                    f"etops.prim.tanh, got {self.prim_last}."
                 )
 
     def apply(self, op: _CppOp) -> None:
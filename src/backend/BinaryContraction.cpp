@@ -265,7 +265,9 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
                                                   kernel_t                             i_ktype_first_touch,
                                                   kernel_t                             i_ktype_main,
                                                   kernel_t                             i_ktype_last_touch,
-                                                  int64_t                              i_num_threads ) {
+                                                  int64_t                              i_num_threads,
+                                                  double                               i_alpha,
+                                                  double                               i_beta ) {
   init( i_num_dims_left,
         i_num_dims_right,
         i_num_dims_out,
@@ -288,7 +290,9 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
         i_ktype_first_touch,
         i_ktype_main,
         i_ktype_last_touch,
-        i_num_threads );
+        i_num_threads,
+        i_alpha,
+        i_beta );
 }
 
 void einsum_ir::backend::BinaryContraction::init( int64_t                              i_num_dims_left,
@@ -313,7 +317,9 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
                                                   kernel_t                             i_ktype_first_touch,
                                                   kernel_t                             i_ktype_main,
                                                   kernel_t                             i_ktype_last_touch,
-                                                  int64_t                              i_num_threads ) {
+                                                  int64_t                              i_num_threads,
+                                                  double                               i_alpha,
+                                                  double                               i_beta ) {
   m_num_dims_left  = i_num_dims_left;
   m_num_dims_right = i_num_dims_right;
   m_num_dims_out   = i_num_dims_out;
@@ -345,8 +351,60 @@ void einsum_ir::backend::BinaryContraction::init( int64_t
   m_memory = i_memory;
 
   m_num_threads = i_num_threads;
+
+  m_alpha = i_alpha;
+  m_beta  = i_beta;
   
-  m_l2_cache_size = 1024 * 1024; // default to 1MB L2 cache size
+  basic::MachineProfile const * l_machine = basic::MachineProfile::get_instance();
+  m_l2_cache_size  = l_machine->get_size_l2_cpu();
+  m_l3_cache_size  = l_machine->get_size_l3_cpu();
+  m_num_threads_l2 = l_machine->get_num_cpus_l2();
+}
+
+einsum_ir::err_t einsum_ir::backend::BinaryContraction::get_tuning_config( std::vector< basic::iter_property > const & i_loops,
+                                                                            std::string                         const & i_backend,
+                                                                            bool                                        i_packing_support,
+                                                                            basic::tuning_config                const & i_config_default,
+                                                                            std::function< basic::ContractionBackend * ( basic::tuning_config const &,
+                                                                                                                         basic::ContractionMemoryManager * ) > i_compile,
+                                                                            basic::tuning_config                      & o_config ) {
+  o_config = i_config_default;
+
+  basic::ContractionAutotuner * l_tuner = basic::ContractionAutotuner::get_instance();
+  uint64_t l_key = basic::ContractionAutotuner::key( i_loops,
+                                                     ce_kernelt_to_basic( m_ktype_first_touch ),
+                                                     ce_kernelt_to_basic( m_ktype_main ),
+                                                     ce_kernelt_to_basic( m_ktype_last_touch ),
+                                                     ce_dtype_to_basic( m_dtype_left ),
+                                                     ce_dtype_to_basic( m_dtype_right ),
+                                                     ce_dtype_to_basic( m_dtype_comp ),
+                                                     ce_dtype_to_basic( m_dtype_out ),
+                                                     m_num_threads,
+                                                     i_backend );
+
+  if( l_tuner->lookup( l_key, o_config ) ) {
+    return err_t::SUCCESS;
+  }
+  if( !m_autotune ) {
+    return err_t::SUCCESS;
+  }
+
+  basic::err_t l_err = l_tuner->tune( i_loops,
+                                      ce_dtype_to_basic( m_dtype_left ),
+                                      ce_dtype_to_basic( m_dtype_right ),
+                                      ce_dtype_to_basic( m_dtype_out ),
+                                      m_num_threads,
+                                      i_packing_support,
+                                      i_config_default,
+                                      i_compile,
+                                      o_config );
+  if( l_err != basic::err_t::SUCCESS ) {
+    return ce_basic_err_to_err( l_err );
+  }
+
+  l_tuner->insert( l_key, o_config );
+
+  return ce_basic_err_to_err( l_tuner->store() );
 }
 
 einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_base() {
@@ -462,4 +520,136 @@ int64_t einsum_ir::backend::BinaryContraction::num_ops() {
   }
 
   return l_num_ops;
-}
\ No newline at end of file
+}
+
+einsum_ir::err_t einsum_ir::backend::BinaryContraction::compile_backend( std::vector< basic::iter_property >                                                     const & i_loops,
+                                                                          std::string                                                                             const & i_backend,
+                                                                          bool                                                                                            i_packing_support,
+                                                                          basic::tuning_config                                                                    const & i_config_default,
+                                                                          std::function< void ( basic::tuning_config const &, basic::contraction_plan & ) >               i_optimize,
+                                                                          std::function< basic::ContractionBackend * () >                                                 i_new_backend,
+                                                                          basic::ContractionBackend                                                                     & io_backend ) {
+  err_t l_err = err_t::UNDEFINED_ERROR;
+
+  //initializes and compiles a backend for a plan
+  auto l_compile = [&]( basic::contraction_plan         const & i_plan,
+                        bool                                    i_preset_thread_infos,
+                        basic::ContractionMemoryManager       * i_contraction_memory,
+                        basic::ContractionBackend             & io_backend_plan ) {
+    io_backend_plan.init( i_plan.iters,
+                          ce_dtype_to_basic( m_dtype_left ),
+                          ce_dtype_to_basic( m_dtype_right ),
+                          ce_dtype_to_basic( m_dtype_comp ),
+                          ce_dtype_to_basic( m_dtype_out ),
+                          ce_kernelt_to_basic( m_ktype_first_touch ),
+                          i_plan.ktype_main,
+                          ce_kernelt_to_basic( m_ktype_last_touch ),
+                          i_plan.num_threads_shared,
+                          i_plan.num_threads_sfc_m,
+                          i_plan.num_threads_sfc_n,
+                          i_contraction_memory,
+                          ce_executor_to_basic( m_executor ),
+                          ce_schedule_to_basic( m_schedule ),
+                          m_fuse_first_touch,
+                          epilogue_to_basic( m_epilogue ),
+                          m_alpha,
+                          m_beta,
+                          m_cpx_3m );
+    if( i_preset_thread_infos ) {
+      io_backend_plan.set_thread_infos( i_plan.thread_infos,
+                                        i_plan.caching_size );
+    }
+    return io_backend_plan.compile();
+  };
+
+  //derive configuration of the contraction optimizer
+  basic::tuning_config l_config;
+  l_err = get_tuning_config( i_loops,
+                             i_backend,
+                             i_packing_support,
+                             i_config_default,
+                             [&]( basic::tuning_config            const & i_config,
+                                  basic::ContractionMemoryManager       * i_contraction_memory ) -> basic::ContractionBackend * {
+                               basic::contraction_plan l_plan;
+                               i_optimize( i_config,
+                                           l_plan );
+
+                               basic::ContractionBackend * l_backend = i_new_backend();
+                               if( l_compile( l_plan,
+                                              false,
+                                              i_contraction_memory,
+                                              *l_backend ) != basic::err_t::SUCCESS ) {
+                                 delete l_backend;
+                                 return nullptr;
+                               }
+                               return l_backend;
+                             },
+                             l_config );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  basic::ContractionMemoryManager * l_contraction_memory = nullptr;
+  if( m_memory != nullptr ) {
+    l_contraction_memory = m_memory->get_contraction_memory_manager();
+  }
+
+  //compile a cached plan
+  basic::ContractionPlanCache * l_plan_cache = basic::ContractionPlanCache::get_instance();
+  std::vector< int64_t > l_key = basic::ContractionPlanCache::key( i_loops,
+                                                                   ce_kernelt_to_basic( m_ktype_first_touch ),
+                                                                   ce_kernelt_to_basic( m_ktype_main ),
+                                                                   ce_kernelt_to_basic( m_ktype_last_touch ),
+                                                                   ce_dtype_to_basic( m_dtype_left ),
+                                                                   ce_dtype_to_basic( m_dtype_right ),
+                                                                   ce_dtype_to_basic( m_dtype_comp ),
+                                                                   ce_dtype_to_basic( m_dtype_out ),
+                                                                   m_num_threads,
+                                                                   m_l2_cache_size,
+                                                                   m_l3_cache_size,
+                                                                   m_num_threads_l2,
+                                                                   i_backend,
+                                                                   l_config,
+                                                                   ce_executor_to_basic( m_executor ),
+                                                                   ce_schedule_to_basic( m_schedule ),
+                                                                   m_fuse_first_touch,
+                                                                   epilogue_to_basic( m_epilogue ),
+                                                                   m_alpha,
+                                                                   m_beta,
+                                                                   m_cpx_3m );
+
+  std::shared_ptr< basic::contraction_plan const > l_plan = l_plan_cache->lookup( l_key );
+  if( l_plan != nullptr ) {
+    l_err = ce_basic_err_to_err( l_compile( *l_plan,
+                                            true,
+                                            l_contraction_memory,
+                                            io_backend ) );
+    if( l_err == err_t::SUCCESS ) {
+      m_plan_key = l_key;
+      m_plan = l_plan;
+    }
+    return l_err;
+  }
+
+  //optimize, compile and cache a new plan
+  std::shared_ptr< basic::contraction_plan > l_plan_new = std::make_shared< basic::contraction_plan >();
+  i_optimize( l_config,
+              *l_plan_new );
+
+  l_err = ce_basic_err_to_err( l_compile( *l_plan_new,
+                                          false,
+                                          l_contraction_memory,
+                                          io_backend ) );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  io_backend.get_thread_infos( l_plan_new->thread_infos,
+                               l_plan_new->caching_size );
+  l_plan_cache->insert( l_key,
+                        l_plan_new );
+  m_plan_key = l_key;
+  m_plan = l_plan_new;
+
+  return err_t::SUCCESS;
+}
@@ -2,9 +2,14 @@
 #define EINSUM_IR_BACKEND_BINARY_CONTRACTION
 
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <map>
+#include <string>
 #include "../constants.h"
+#include "../basic/binary/ContractionAutotuner.h"
+#include "../basic/binary/ContractionPlanCache.h"
+#include "../basic/MachineProfile.h"
 #include "MemoryManager.h"
 
 namespace einsum_ir {
@@ -117,6 +122,15 @@ class einsum_ir::backend::BinaryContraction {
     //! type of the last touch kernel
     kernel_t m_ktype_last_touch = UNDEFINED_KTYPE;
 
+    //! epilogue program of the last touch if its type is EPILOGUE, has to be set before compilation
+    std::vector< epilogue_op > m_epilogue;
+
+    //! scaling factor alpha of the contraction: out = alpha * left * right + beta * first_touch( out )
+    double m_alpha = 1.0;
+
+    //! scaling factor beta of the contraction's first touch
+    double m_beta = 1.0;
+
     //! true if the binary contraction was compiled
     bool m_compiled = false;
 
@@ -135,9 +149,36 @@ class einsum_ir::backend::BinaryContraction {
     //! number of threads for the contraction
     int64_t m_num_threads = 1;
 
-    //! size of the L2 cache in bytes
+    //! share of a thread of the L2 cache in bytes
     int64_t m_l2_cache_size = 1;
 
+    //! share of a thread of the L3 cache in bytes, 0 if unknown
+    int64_t m_l3_cache_size = 0;
+
+    //! number of threads sharing an L2 cache
+    int64_t m_num_threads_l2 = 1;
+
+    //! executor of the parallel execution, has to be set before compilation
+    executor_t m_executor = executor_t::OPENMP;
+
+    //! schedule of the shared loops, has to be set before compilation
+    schedule_t m_schedule = schedule_t::STATIC;
+
+    //! true if zero and copy first touches may be folded into the main kernel, has to be set before compilation
+    bool m_fuse_first_touch = true;
+
+    //! true if complex main kernels use three real multiplications (3M) instead of four, has to be set before compilation
+    bool m_cpx_3m = false;
+
+    //! true if the contraction is autotuned if the tuning database has no entry for it, has to be set before compilation
+    bool m_autotune = false;
+
+    //! key of the compiled plan in the plan cache, empty if the backend does not use plans
+    std::vector< int64_t > m_plan_key;
+
+    //! compiled plan, nullptr if the backend does not use plans
+    std::shared_ptr< basic::contraction_plan const > m_plan;
+
     /**
      * Derives the dimension types of tensor t2 w.r.t. tensors t0 and t1.
      *
@@ -275,6 +316,8 @@ class einsum_ir::backend::BinaryContraction {
      * @param i_ktype_main type of the main kernel.
      * @param i_ktype_last_touch type of the last touch kernel.
      * @param i_num_threads number of threads for the contraction.
+     * @param i_alpha scaling factor of the contraction's product.
+     * @param i_beta scaling factor of the output after the first touch.
      **/
     void init( int64_t                              i_num_dims_left,
                int64_t                              i_num_dims_right,
@@ -294,7 +337,9 @@ class einsum_ir::backend::BinaryContraction {
                kernel_t                             i_ktype_first_touch,
                kernel_t                             i_ktype_main,
                kernel_t                             i_ktype_last_touch,
-               int64_t                              i_num_threads );
+               int64_t                              i_num_threads,
+               double                               i_alpha = 1.0,
+               double                               i_beta  = 1.0 );
 
     /**
      * Initializes the binary contraction with fused permutations of the input tensors
@@ -322,6 +367,8 @@ class einsum_ir::backend::BinaryContraction {
      * @param i_ktype_main type of the main kernel.
      * @param i_ktype_last_touch type of the last touch kernel.
      * @param i_num_threads number of threads for the contraction.
+     * @param i_alpha scaling factor of the contraction's product.
+     * @param i_beta scaling factor of the output after the first touch.
      **/
     void init( int64_t                              i_num_dims_left,
                int64_t                              i_num_dims_right,
@@ -345,7 +392,9 @@ class einsum_ir::backend::BinaryContraction {
                kernel_t                             i_ktype_first_touch,
                kernel_t                             i_ktype_main,
                kernel_t                             i_ktype_last_touch,
-               int64_t                              i_num_threads  );
+               int64_t                              i_num_threads,
+               double                               i_alpha = 1.0,
+               double                               i_beta  = 1.0 );
 
     /**
      * Compiles the base data.
@@ -354,6 +403,49 @@ class einsum_ir::backend::BinaryContraction {
      **/
     err_t compile_base();
 
+    /**
+     * Derives the configuration of the contraction optimizer.
+     * An entry of the process-wide tuning database takes precedence over the default configuration.
+     * If m_autotune is set, contractions without an entry are tuned and added to the database.
+     *
+     * @param i_loops unoptimized loops of the contraction.
+     * @param i_backend name of the backend.
+     * @param i_packing_support true if the backend supports packing.
+     * @param i_config_default default configuration.
+     * @param i_compile function which initializes and compiles a backend for a configuration, nullptr on failure.
+     * @param o_config configuration of the contraction optimizer.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t get_tuning_config( std::vector< basic::iter_property > const & i_loops,
+                             std::string                         const & i_backend,
+                             bool                                        i_packing_support,
+                             basic::tuning_config                const & i_config_default,
+                             std::function< basic::ContractionBackend * ( basic::tuning_config const &,
+                                                                          basic::ContractionMemoryManager * ) > i_compile,
+                             basic::tuning_config                      & o_config );
+
+    /**
+     * Initializes and compiles a backend.
+     * The tuning database provides the configuration of the contraction optimizer,
+     * the plan cache provides the optimized loops and the iteration space of known contractions.
+     *
+     * @param i_loops unoptimized loops of the contraction.
+     * @param i_backend name of the backend.
+     * @param i_packing_support true if the backend supports packing.
+     * @param i_config_default default configuration of the contraction optimizer.
+     * @param i_optimize function which derives the optimized loops and threads of a plan for a configuration.
+     * @param i_new_backend function which allocates a backend, used by the autotuner.
+     * @param io_backend backend which is initialized and compiled.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t compile_backend( std::vector< basic::iter_property >                                                     const & i_loops,
+                           std::string                                                                             const & i_backend,
+                           bool                                                                                            i_packing_support,
+                           basic::tuning_config                                                                    const & i_config_default,
+                           std::function< void ( basic::tuning_config const &, basic::contraction_plan & ) >               i_optimize,
+                           std::function< basic::ContractionBackend * () >                                                 i_new_backend,
+                           basic::ContractionBackend                                                                     & io_backend );
+
     /**
      * Compiles the binary contraction. 
      *
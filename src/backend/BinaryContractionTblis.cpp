@@ -202,6 +202,12 @@ void einsum_ir::backend::BinaryContractionTblis::contract( void const * i_tensor
   if( m_ktype_first_touch == einsum_ir::kernel_t::ZERO ) {
     m_tblis_tensor_out.scalar = 0.0;
   }
+  else if( m_beta != 1.0 ) {
+    m_tblis_tensor_out.scalar = m_beta;
+  }
+  if( m_alpha != 1.0 ) {
+    m_tblis_tensor_left.scalar = m_alpha;
+  }
 
   tblis::tblis_tensor_mult( NULL,
                             NULL,
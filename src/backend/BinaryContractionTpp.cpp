@@ -66,59 +66,64 @@ einsum_ir::err_t einsum_ir::backend::BinaryContractionTpp::compile() {
   }
 
   //convert kernel to basic
-  basic::kernel_t l_ktype_first_touch = ce_kernelt_to_basic(m_ktype_first_touch);
-  basic::kernel_t l_ktype_main        = ce_kernelt_to_basic(m_ktype_main);
-  basic::kernel_t l_ktype_last_touch  = ce_kernelt_to_basic(m_ktype_last_touch);
-
-  //convert dtype
-  basic::data_t l_dtype_left  = ce_dtype_to_basic(m_dtype_left);
-  basic::data_t l_dtype_right = ce_dtype_to_basic(m_dtype_right);
-  basic::data_t l_dtype_comp  = ce_dtype_to_basic(m_dtype_comp);
-  basic::data_t l_dtype_out   = ce_dtype_to_basic(m_dtype_out);
-
-  //optimize loops
-  einsum_ir::basic::ContractionOptimizer l_optim;
-
-  int64_t l_num_threads_m = 1;
-  int64_t l_num_threads_n = 1;
-  int64_t l_num_threads_shared = m_num_threads;
-  l_optim.init(&l_loops,
-               &l_ktype_main,
-               m_target_prim_m,
-               m_target_prim_n,
-               m_target_prim_k,
-               true,
-               true,
-               true,
-               basic::packed_gemm_t::ALL_STRIDE_ONE,
-               ce_n_bytes(m_dtype_out),
-               m_l2_cache_size,
-               &l_num_threads_shared,
-               &l_num_threads_m,
-               &l_num_threads_n );
-  l_optim.optimize();
-
-  einsum_ir::basic::ContractionMemoryManager * l_contraction_memory = nullptr;
-  if( m_memory != nullptr ){
-    l_contraction_memory = m_memory->get_contraction_memory_manager();
-  }
+  basic::kernel_t l_ktype_main = ce_kernelt_to_basic(m_ktype_main);
+
+  //optimizes the loops for a configuration of the contraction optimizer
+  auto l_optimize = [&]( basic::tuning_config    const & i_config,
+                         basic::contraction_plan       & o_plan ) {
+    o_plan.iters      = l_loops;
+    o_plan.ktype_main = l_ktype_main;
+
+    einsum_ir::basic::ContractionOptimizer l_optim;
+
+    o_plan.num_threads_sfc_m  = 1;
+    o_plan.num_threads_sfc_n  = 1;
+    o_plan.num_threads_shared = m_num_threads;
+    l_optim.init(&o_plan.iters,
+                 &o_plan.ktype_main,
+                 i_config.target_m,
+                 i_config.target_n,
+                 i_config.target_k,
+                 i_config.generate_sfcs,
+                 true,
+                 i_config.packing,
+                 basic::packed_gemm_t::ALL_STRIDE_ONE,
+                 ce_n_bytes(m_dtype_out),
+                 m_l2_cache_size,
+                 &o_plan.num_threads_shared,
+                 &o_plan.num_threads_sfc_m,
+                 &o_plan.num_threads_sfc_n,
+                 i_config.target_extra_packing,
+                 m_l3_cache_size,
+                 m_num_threads_l2,
+                 ce_n_bytes(m_dtype_left),
+                 ce_n_bytes(m_dtype_right) );
+    l_optim.optimize();
+
+    if( i_config.num_threads_shared > 0 ) {
+      o_plan.num_threads_shared = i_config.num_threads_shared;
+      o_plan.num_threads_sfc_m  = i_config.num_threads_sfc_m;
+      o_plan.num_threads_sfc_n  = i_config.num_threads_sfc_n;
+    }
+  };
+
+  //default configuration of the contraction optimizer
+  basic::tuning_config l_config_default;
+  l_config_default.target_m = m_target_prim_m;
+  l_config_default.target_n = m_target_prim_n;
+  l_config_default.target_k = m_target_prim_k;
+  l_config_default.packing  = true;
 
   //compile backend
-  m_backend.init( l_loops,
-                  l_dtype_left,
-                  l_dtype_right,
-                  l_dtype_comp,
-                  l_dtype_out,
-                  l_ktype_first_touch,
-                  l_ktype_main,
-                  l_ktype_last_touch,
-                  l_num_threads_shared,
-                  l_num_threads_m,
-                  l_num_threads_n,
-                  l_contraction_memory );
-
-  
-  l_err = ce_basic_err_to_err(m_backend.compile());
+  l_err = compile_backend( l_loops,
+                           "tpp",
+                           true,
+                           l_config_default,
+                           l_optimize,
+                           []() -> basic::ContractionBackend * {
+                             return new basic::ContractionBackendTpp;
+                           },
+                           m_backend );
   if( l_err != err_t::SUCCESS ) {
     return l_err;
   }
@@ -25,7 +25,10 @@ void einsum_ir::backend::BinaryPrimitives::init( int64_t i_size_cb_min,
 einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::init( data_t    i_data_type,
                                                              backend_t i_backend_type ) {
   if( i_backend_type == backend_t::TPP ) {
-    if( i_data_type == data_t::FP32 ) {
+    // BF16 and FP16 use FP32 computations
+    if(    i_data_type == data_t::FP32
+        || i_data_type == data_t::BF16
+        || i_data_type == data_t::FP16 ) {
       init(  4,  16,
             32, 128,
             12,  64,
@@ -133,6 +136,40 @@ bool einsum_ir::backend::BinaryPrimitives::swap_inputs( int64_t
   return l_swap_inputs;
 }
 
+void einsum_ir::backend::BinaryPrimitives::align_outer( int64_t                              i_num_dims,
+                                                        dim_t                        const * i_dim_types,
+                                                        int64_t                      const * i_dim_ids_pref,
+                                                        int64_t                            * io_dim_ids ) {
+  // the blocked dimensions are part of the trailing runs of C, M, N or K dimensions
+  int64_t l_num_dims_outer = i_num_dims;
+  std::vector< dim_t > l_dim_types_runs;
+  while( l_num_dims_outer > 0 ) {
+    dim_t l_dim_type = i_dim_types[l_num_dims_outer-1];
+    if(    l_dim_type == I
+        || l_dim_type == J
+        || std::find( l_dim_types_runs.begin(),
+                      l_dim_types_runs.end(),
+                      l_dim_type ) != l_dim_types_runs.end() ) {
+      break;
+    }
+    while(    l_num_dims_outer > 0
+           && i_dim_types[l_num_dims_outer-1] == l_dim_type ) {
+      l_num_dims_outer--;
+    }
+    l_dim_types_runs.push_back( l_dim_type );
+  }
+
+  // positions in the preferred order
+  std::map< int64_t, int64_t > l_pos_pref;
+  for( int64_t l_di = 0; l_di < i_num_dims; l_di++ ) {
+    l_pos_pref[ i_dim_ids_pref[l_di] ] = l_di;
+  }
+
+  std::stable_sort( io_dim_ids,
+                    io_dim_ids + l_num_dims_outer,
+                    [&]( int64_t i_a, int64_t i_b ) { return l_pos_pref[i_a] < l_pos_pref[i_b]; } );
+}
+
 einsum_ir::err_t einsum_ir::backend::BinaryPrimitives::blocking_left_kb_x_mb_cb_right_nb_x_kb_cb_out_nb_x_mb_cb( int64_t                              i_size_mb_min,
                                                                                                                  int64_t                              i_size_mb_max,
                                                                                                                  int64_t                              i_size_nb_min,
@@ -309,6 +309,21 @@ class einsum_ir::backend::BinaryPrimitives {
                              int64_t                      const * i_dim_ids_right,
                              int64_t                      const * i_dim_ids_out );
 
+    /**
+     * Aligns the outer dimensions of a reordered input tensor with a preferred order, e.g., the tensor's external order.
+     * The blocked dimensions are part of the trailing runs of distinct C, M, N or K dimensions and keep their positions.
+     * The remaining dimensions are covered by loops and may be ordered arbitrarily.
+     *
+     * @param i_num_dims number of dimensions in the tensor.
+     * @param i_dim_types types of the reordered dimensions.
+     * @param i_dim_ids_pref array of dimension IDs in the preferred order.
+     * @param io_dim_ids array of reordered dimension IDs, the outer ones are aligned.
+     **/
+    void static align_outer( int64_t                              i_num_dims,
+                             dim_t                        const * i_dim_types,
+                             int64_t                      const * i_dim_ids_pref,
+                             int64_t                            * io_dim_ids );
+
     /**
      * Derives the primitive blocking for the given tensors.
      * If any of the strides is not provided, a contiguous generalized row-major layout is assumed.
@@ -1196,4 +1196,38 @@ TEST_CASE( "Reordering of a packed GEMM for the BLAS interface", "[binary_primit
   REQUIRE( l_dim_ids_out[ 0 ] == 'c' );
   REQUIRE( l_dim_ids_out[ 1 ] == 'b' );
   REQUIRE( l_dim_ids_out[ 2 ] == 'x' );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Alignment of the outer dimensions with the external order.", "[binary_primitives]" ) {
+  using namespace einsum_ir;
+
+  // reordered: bc bm bk bi kb mb
+  int64_t l_dim_ids_pref[ 7 ]     = { 'c', 'k', 'i', 'x', 'b', 'y', 'm' };
+  int64_t l_dim_ids[ 7 ]          = { 'c', 'x', 'k', 'i', 'b', 'y', 'm' };
+  dim_t   l_dim_types[ 7 ]        = {   C,   M,   K,   I,   K,   K,   M };
+  int64_t l_dim_ids_aligned[ 7 ]  = { 'c', 'k', 'i', 'x', 'b', 'y', 'm' };
+
+  backend::BinaryPrimitives::align_outer( 7,
+                                          l_dim_types,
+                                          l_dim_ids_pref,
+                                          l_dim_ids );
+
+  for( int64_t l_di = 0; l_di < 7; l_di++ ) {
+    REQUIRE( l_dim_ids[l_di] == l_dim_ids_aligned[l_di] );
+  }
+
+  // blocked dimensions keep their positions
+  int64_t l_dim_ids_pref_1[ 4 ]   = { 'm', 'k', 'n', 'c' };
+  int64_t l_dim_ids_1[ 4 ]        = { 'c', 'n', 'k', 'm' };
+  dim_t   l_dim_types_1[ 4 ]      = {   C,   N,   K,   M };
+  int64_t l_dim_ids_aligned_1[ 4 ] = { 'c', 'n', 'k', 'm' };
+
+  backend::BinaryPrimitives::align_outer( 4,
+                                          l_dim_types_1,
+                                          l_dim_ids_pref_1,
+                                          l_dim_ids_1 );
+
+  for( int64_t l_di = 0; l_di < 4; l_di++ ) {
+    REQUIRE( l_dim_ids_1[l_di] == l_dim_ids_aligned_1[l_di] );
+  }
+}
@@ -3,8 +3,11 @@
 #include "Tensor.h"
 #include "BinaryContractionFactory.h"
 #include "BinaryPrimitives.h"
+#include "../basic/ThreadPool.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <set>
 
 einsum_ir::backend::EinsumNode::~EinsumNode() {
   if( m_unary != nullptr ) {
@@ -16,6 +19,9 @@ einsum_ir::backend::EinsumNode::~EinsumNode() {
   if( m_data_ptr_int != nullptr ) {
     delete [] (char *) m_data_ptr_int;
   }
+  if( m_memory_inter_op != nullptr ) {
+    delete m_memory_inter_op;
+  }
 }
 
 void einsum_ir::backend::EinsumNode::init( int64_t                              i_num_dims,
@@ -76,34 +82,14 @@ void einsum_ir::backend::EinsumNode::init( int64_t
     m_btype_binary = backend_t::SCALAR;
   }
 
-  m_reorder_dims = true;
-  char * l_reorder_dims = std::getenv( "EINSUM_IR_REORDER_DIMS" );
-  if( l_reorder_dims != nullptr ) {
-    if( strcmp( l_reorder_dims, "1" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else if( strcmp( l_reorder_dims, "true" ) == 0 ) {
-      m_reorder_dims = true;
-    }
-    else {
-      m_reorder_dims = false;
-    }
-  }
-
-  m_pack_inputs = false;
-  char * l_pack_inputs = std::getenv( "EINSUM_IR_PACK_INPUTS" );
-  if( l_pack_inputs != nullptr ) {
-    if( strcmp( l_pack_inputs, "1" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else if( strcmp( l_pack_inputs, "true" ) == 0 ) {
-      m_pack_inputs = true;
-    }
-    else {
-      m_pack_inputs = false;
-    }
-  }
+  m_reorder_dims  = env_flag( "EINSUM_IR_REORDER_DIMS",  true );
+  m_align_layouts = env_flag( "EINSUM_IR_ALIGN_LAYOUTS", true );
+  m_pack_inputs   = env_flag( "EINSUM_IR_PACK_INPUTS",   false );
+  m_inter_op      = env_flag( "EINSUM_IR_INTER_OP",      false );
+  m_eval_parallel = false;
+  m_executor = executor_t::OPENMP;
 
+  m_compile_parallel = env_flag( "EINSUM_IR_COMPILE_PARALLEL", false );
 
   m_unary               = nullptr;
   m_cont                = nullptr;
@@ -125,6 +111,12 @@ void einsum_ir::backend::EinsumNode::init( int64_t
 
   m_compiled            = false;
   m_data_locked         = false;
+
+  m_incremental   = false;
+  m_resident      = false;
+  m_dirty         = true;
+  m_dirty_subtree = true;
+  m_valid         = false;
 }
 
 void einsum_ir::backend::EinsumNode::init( int64_t                              i_num_dims,
@@ -191,10 +183,16 @@ void einsum_ir::backend::EinsumNode::init( int64_t
 }
 einsum_ir::err_t einsum_ir::backend::EinsumNode::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
+  if( m_inter_op ) {
+    schedule_inter_op( m_num_threads );
+  }
   l_err = compile_recursive();
   if( l_err != einsum_ir::SUCCESS ){
     return l_err;
   }
+  if( m_memory->get_resident_budget() > 0 ) {
+    select_resident( m_memory->get_resident_budget() );
+  }
   compile_memory_usage();
   m_memory->alloc_all_memory();
 
@@ -268,6 +266,36 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
         return l_err;
       }
 
+      // intermediates are written in the reordered layout by their contraction,
+      // inputs with external data keep the external order of their outer dimensions to avoid permutations
+      if( m_align_layouts ) {
+        std::vector< dim_t > l_dim_types_left;
+        std::vector< dim_t > l_dim_types_right;
+        std::vector< dim_t > l_dim_types_out;
+        BinaryContraction::dim_types( m_children[0]->m_num_dims,
+                                      m_children[1]->m_num_dims,
+                                      m_num_dims,
+                                      m_children[0]->m_dim_ids_int.data(),
+                                      m_children[1]->m_dim_ids_int.data(),
+                                      m_dim_ids_int.data(),
+                                      &l_dim_types_left,
+                                      &l_dim_types_right,
+                                      &l_dim_types_out );
+
+        if( m_children[0]->requires_permutation() ) {
+          BinaryPrimitives::align_outer( m_children[0]->m_num_dims,
+                                         l_dim_types_left.data(),
+                                         m_children[0]->m_dim_ids_ext,
+                                         m_children[0]->m_dim_ids_int.data() );
+        }
+        if( m_children[1]->requires_permutation() ) {
+          BinaryPrimitives::align_outer( m_children[1]->m_num_dims,
+                                         l_dim_types_right.data(),
+                                         m_children[1]->m_dim_ids_ext,
+                                         m_children[1]->m_dim_ids_int.data() );
+        }
+      }
+
       //packing is only supported for TPP
       if( m_btype_binary == backend_t::TPP && m_pack_inputs ){
         if( m_children[0]->requires_permutation() ){
@@ -285,6 +313,13 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
       }
     }
 
+    // INT8 inputs are accumulated in INT32
+    data_t l_dtype_comp = ce_dtype_comp( m_dtype );
+    if(    m_children[0]->m_dtype == data_t::INT8
+        && m_children[1]->m_dtype == data_t::INT8 ) {
+      l_dtype_comp = data_t::INT32;
+    }
+
     m_cont = BinaryContractionFactory::create( m_btype_binary );
     m_cont->init( m_children[0]->m_num_dims,
                   m_children[1]->m_num_dims,
@@ -303,12 +338,16 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
                   m_memory,
                   m_children[0]->m_dtype,
                   m_children[1]->m_dtype,
-                  m_dtype,
+                  l_dtype_comp,
                   m_dtype,
                   m_ktype_first_touch,
                   m_ktype_main,
                   m_ktype_last_touch,
                   m_num_threads );
+    m_cont->m_executor = m_executor;
+    m_cont->m_epilogue = m_epilogue;
+    m_cont->m_cpx_3m = m_cpx_3m;
+    m_cont->m_autotune = m_autotune;
 
     l_err = m_cont->compile();
     if( l_err != einsum_ir::SUCCESS ) {
@@ -318,6 +357,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
 
   // compile unary copy operation
   m_unary = new UnaryTpp;
+  m_unary->m_executor = m_executor;
 
   int64_t l_num_threads_unary = 1;
   if( m_num_tasks_intra_op > 1 ) {
@@ -333,18 +373,19 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
                    m_dim_ids_ext,
                    m_dim_ids_int.data(),
                    m_dtype,
-                   m_dtype,
+                   ce_dtype_comp( m_dtype ),
                    m_dtype,
                    kernel_t::COPY,
                    l_num_threads_unary );
   }
   else {
+    // single children may be converted to the node's datatype
     m_unary->init( m_num_dims,
                    m_dim_sizes_outer,
                    m_children[0]->m_dim_ids_ext,
                    m_dim_ids_ext,
-                   m_dtype,
-                   m_dtype,
+                   m_children[0]->m_dtype,
+                   ce_dtype_comp( m_children[0]->m_dtype ),
                    m_dtype,
                    kernel_t::COPY,
                    l_num_threads_unary );
@@ -400,10 +441,34 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
 
   // compile children and determine best execution order
   if( m_children.size() > 1 ) {
-    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
-      l_err = m_children[l_ch]->compile_recursive();
-      if( l_err != einsum_ir::SUCCESS ) {
-        return l_err;
+    // subtrees with contractions are independent after the parent derived their layouts
+    // concurrent benchmarks of the autotuner would skew each other's timings
+    bool l_compile_parallel =    m_compile_parallel
+                              && m_children[0]->m_children.size() > 0
+                              && m_children[1]->m_children.size() > 0
+                              && !m_children[0]->autotunes_subtree()
+                              && !m_children[1]->autotunes_subtree();
+
+    if( l_compile_parallel ) {
+      err_t l_errs[2] = { err_t::UNDEFINED_ERROR, err_t::UNDEFINED_ERROR };
+      basic::ThreadPool::get_instance()->parallel_for( 2,
+                                                      [this, &l_errs]( int64_t i_ch ) {
+                                                        m_children[i_ch]->m_compile_parallel = true;
+                                                        l_errs[i_ch] = m_children[i_ch]->compile_recursive();
+                                                      } );
+      for( int64_t l_ch = 0; l_ch < 2; l_ch++ ) {
+        if( l_errs[l_ch] != einsum_ir::SUCCESS ) {
+          return l_errs[l_ch];
+        }
+      }
+    }
+    else {
+      for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+        m_children[l_ch]->m_compile_parallel |= m_compile_parallel;
+        l_err = m_children[l_ch]->compile_recursive();
+        if( l_err != einsum_ir::SUCCESS ) {
+          return l_err;
+        }
       }
     }
     int64_t l_mem_ch1 = m_children[0]-> m_mem_subtree;
@@ -424,6 +489,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
     m_mem_subtree = std::max(m_mem_subtree, m_req_mem + m_children[0]->m_req_mem + m_children[1]->m_req_mem);
   }
   else if( m_children.size() == 1 ) {
+    m_children[0]->m_compile_parallel |= m_compile_parallel;
     l_err = m_children[0]->compile_recursive();
     if( l_err != einsum_ir::SUCCESS ) {
       return l_err;
@@ -455,6 +521,86 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::compile_recursive() {
 
 
 
+int64_t einsum_ir::backend::EinsumNode::num_ops_estimate() const {
+  int64_t l_num_ops = 0;
+
+  if( m_children.size() == 2 ) {
+    std::set< int64_t > l_dim_ids;
+    for( std::size_t l_ch = 0; l_ch < 2; l_ch++ ) {
+      l_dim_ids.insert( m_children[l_ch]->m_dim_ids_ext,
+                        m_children[l_ch]->m_dim_ids_ext + m_children[l_ch]->m_num_dims );
+    }
+
+    l_num_ops = 2;
+    for( std::set< int64_t >::iterator l_di = l_dim_ids.begin(); l_di != l_dim_ids.end(); l_di++ ) {
+      l_num_ops *= m_dim_sizes_inner->at( *l_di );
+    }
+  }
+
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    l_num_ops += m_children[l_ch]->num_ops_estimate();
+  }
+
+  return l_num_ops;
+}
+
+void einsum_ir::backend::EinsumNode::set_memory( MemoryManager * i_memory ) {
+  m_memory = i_memory;
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->set_memory( i_memory );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::set_executor( executor_t i_executor ) {
+  m_executor = i_executor;
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->set_executor( i_executor );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::schedule_inter_op( int64_t i_num_threads ) {
+  m_num_threads = i_num_threads;
+  m_eval_parallel = false;
+
+  int64_t l_num_threads_left  = i_num_threads;
+  int64_t l_num_threads_right = i_num_threads;
+
+  if( m_children.size() == 2 && i_num_threads > 1 ) {
+    int64_t l_num_ops_left  = m_children[0]->num_ops_estimate();
+    int64_t l_num_ops_right = m_children[1]->num_ops_estimate();
+
+    if( l_num_ops_left > 0 && l_num_ops_right > 0 ) {
+      m_eval_parallel = true;
+
+      // split the threads by the operations of the subtrees
+      double l_ratio = (double) l_num_ops_left / ( (double) l_num_ops_left + (double) l_num_ops_right );
+      l_num_threads_left  = std::llround( l_ratio * i_num_threads );
+      l_num_threads_left  = std::max( l_num_threads_left, int64_t(1) );
+      l_num_threads_left  = std::min( l_num_threads_left, i_num_threads-1 );
+      l_num_threads_right = i_num_threads - l_num_threads_left;
+
+      // the right subtree uses separate memory
+      if( m_memory_inter_op == nullptr ) {
+        m_memory_inter_op = new MemoryManager;
+      }
+      m_children[1]->set_memory( m_memory_inter_op );
+    }
+  }
+
+  if( m_children.size() > 0 ) {
+    m_children[0]->schedule_inter_op( l_num_threads_left );
+  }
+  if( m_children.size() > 1 ) {
+    m_children[1]->schedule_inter_op( l_num_threads_right );
+  }
+
+  // the subtrees are evaluated by pinned workers of the pool
+  if( m_eval_parallel ) {
+    m_children[0]->set_executor( executor_t::THREAD_POOL );
+    m_children[1]->set_executor( executor_t::THREAD_POOL );
+  }
+}
+
 einsum_ir::err_t einsum_ir::backend::EinsumNode::store_and_lock_data() {
   if( m_compiled == false ) {
     return err_t::CALLED_BEFORE_COMPILATION;
@@ -474,6 +620,7 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::store_and_lock_data() {
                  m_data_ptr_int );
 
   m_data_locked = true;
+  m_dirty = true;
 
   return err_t::SUCCESS;
 }
@@ -489,13 +636,138 @@ einsum_ir::err_t einsum_ir::backend::EinsumNode::unlock_data() {
   }
 
   m_data_locked = false;
+  m_dirty = true;
 
   return err_t::SUCCESS;
 }
 
-void einsum_ir::backend::EinsumNode::eval() {
+einsum_ir::err_t einsum_ir::backend::EinsumNode::set_data_ptr( void * i_data_ptr ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+  else if( m_data_ptr_ext != nullptr && i_data_ptr == nullptr ) {
+    return err_t::NO_DATA_PTR_PROVIDED;
+  }
+  else if( m_data_ptr_ext == nullptr && i_data_ptr != nullptr ) {
+    return err_t::UNEXPECTED_DATA_PTR;
+  }
+
+  // locked and resident nodes keep their data, rebinding the same pointer changes nothing
+  if(    i_data_ptr != m_data_ptr_ext
+      && !m_data_locked
+      && !m_resident ) {
+    m_dirty = true;
+  }
+  m_data_ptr_ext = i_data_ptr;
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::backend::EinsumNode::select_resident( int64_t i_budget ) {
+  // candidates: all nodes with internal data except this one
+  std::vector< EinsumNode * > l_nodes;
+  std::vector< EinsumNode * > l_candidates;
+  l_nodes.push_back( this );
+  for( std::size_t l_no = 0; l_no < l_nodes.size(); l_no++ ) {
+    EinsumNode * l_node = l_nodes[l_no];
+    for( std::size_t l_ch = 0; l_ch < l_node->m_children.size(); l_ch++ ) {
+      l_nodes.push_back( l_node->m_children[l_ch] );
+    }
+
+    l_node->m_incremental = true;
+    l_node->m_resident = false;
+    if( l_node != this && l_node->m_req_mem > 0 ) {
+      l_candidates.push_back( l_node );
+    }
+  }
+
+  // saved operations per byte, permuted inputs save the moved bytes
+  auto l_benefit = []( EinsumNode const * i_node ) {
+    double l_saved = (double) i_node->m_num_ops_node + (double) i_node->m_num_ops_children + (double) i_node->m_req_mem;
+    return l_saved / (double) i_node->m_req_mem;
+  };
+  std::stable_sort( l_candidates.begin(),
+                    l_candidates.end(),
+                    [&]( EinsumNode const * i_a, EinsumNode const * i_b ) { return l_benefit( i_a ) > l_benefit( i_b ); } );
+
+  int64_t l_mem = 0;
+  for( std::size_t l_ca = 0; l_ca < l_candidates.size(); l_ca++ ) {
+    if( l_mem + l_candidates[l_ca]->m_req_mem <= i_budget ) {
+      l_candidates[l_ca]->m_resident = true;
+      l_mem += l_candidates[l_ca]->m_req_mem;
+    }
+  }
+}
+
+void einsum_ir::backend::EinsumNode::mark_dirty() {
+  m_dirty = true;
+}
+
+bool einsum_ir::backend::EinsumNode::update_dirty() {
+  m_dirty_subtree = m_dirty;
   for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
-    m_children[m_exec_order[l_ch]]->eval();
+    if( m_children[l_ch]->update_dirty() ) {
+      m_dirty_subtree = true;
+    }
+  }
+
+  return m_dirty_subtree;
+}
+
+void einsum_ir::backend::EinsumNode::eval() {
+  if( m_incremental ) {
+    // the result of a clean tree is still in place
+    if( update_dirty() || m_valid == false ) {
+      eval_incremental();
+    }
+    return;
+  }
+
+  if( m_eval_parallel ) {
+    basic::ThreadPool::get_instance()->parallel_for( 2,
+                                                    [this]( int64_t i_ch ) {
+                                                      m_children[i_ch]->eval();
+                                                    } );
+  }
+  else {
+    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+      m_children[m_exec_order[l_ch]]->eval();
+    }
+  }
+
+  eval_node();
+}
+
+void einsum_ir::backend::EinsumNode::eval_incremental() {
+  // reuse the resident data of a clean subtree
+  if( m_resident && m_valid && !m_dirty_subtree ) {
+    return;
+  }
+
+  if( m_eval_parallel ) {
+    basic::ThreadPool::get_instance()->parallel_for( 2,
+                                                    [this]( int64_t i_ch ) {
+                                                      m_children[i_ch]->eval_incremental();
+                                                    } );
+  }
+  else {
+    for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+      m_children[m_exec_order[l_ch]]->eval_incremental();
+    }
+  }
+
+  eval_node();
+
+  m_valid = true;
+  m_dirty = false;
+  m_dirty_subtree = false;
+}
+
+void einsum_ir::backend::EinsumNode::eval_node() {
+  int64_t l_time_node  = 0;
+  int64_t l_time_phase = 0;
+  if( m_tracer != nullptr ) {
+    l_time_node = m_tracer->now();
   }
 
   if( m_data_locked ) {
@@ -513,13 +785,31 @@ void einsum_ir::backend::EinsumNode::eval() {
     if(    m_data_locked     == false
         && m_data_ptr_ext    != nullptr
         && m_req_mem         != 0 ) {
+      if( m_tracer != nullptr ) {
+        l_time_phase = m_tracer->now();
+      }
       m_unary->eval( m_data_ptr_ext,
                      m_data_ptr_active );
+      if( m_tracer != nullptr ) {
+        m_tracer->record( m_trace_id,
+                          trace_t::TRACE_PERMUTE,
+                          l_time_phase,
+                          0 );
+      }
     }
   }
   else {
+    if( m_tracer != nullptr ) {
+      l_time_phase = m_tracer->now();
+    }
     m_unary->eval( m_children[0]->m_data_ptr_active,
                    m_data_ptr_active );
+    if( m_tracer != nullptr ) {
+      m_tracer->record( m_trace_id,
+                        trace_t::TRACE_COPY,
+                        l_time_phase,
+                        0 );
+    }
   }
 
   if( m_children.size() == 2 ) {
@@ -532,10 +822,53 @@ void einsum_ir::backend::EinsumNode::eval() {
     void * l_data = m_data_ptr_active;
     l_data = (char *) l_data + m_offset_bytes;
 
+    if( m_tracer != nullptr ) {
+      l_time_phase = m_tracer->now();
+    }
     m_cont->contract( l_left,
                       l_right,
                       l_data_aux,
                       l_data );
+    if( m_tracer != nullptr ) {
+      m_tracer->record( m_trace_id,
+                        trace_t::TRACE_CONTRACT,
+                        l_time_phase,
+                        m_num_ops_node );
+    }
+  }
+
+  if( m_tracer != nullptr ) {
+    m_tracer->record( m_trace_id,
+                      trace_t::TRACE_NODE,
+                      l_time_node,
+                      m_num_ops_node );
+  }
+}
+
+void einsum_ir::backend::EinsumNode::set_tracer( Tracer * i_tracer ) {
+  // breadth-first traversal, matching the rendered einsum tree
+  std::vector< EinsumNode * > l_nodes;
+  l_nodes.push_back( this );
+  for( std::size_t l_no = 0; l_no < l_nodes.size(); l_no++ ) {
+    EinsumNode * l_node = l_nodes[l_no];
+    for( std::size_t l_ch = 0; l_ch < l_node->m_children.size(); l_ch++ ) {
+      l_nodes.push_back( l_node->m_children[l_ch] );
+    }
+
+    l_node->m_tracer   = i_tracer;
+    l_node->m_trace_id = l_no;
+
+    if( i_tracer != nullptr ) {
+      std::string l_label = "";
+      for( int64_t l_di = 0; l_di < l_node->m_num_dims; l_di++ ) {
+        l_label += std::to_string( l_node->m_dim_ids_int[l_di] );
+        if( l_di < l_node->m_num_dims-1 ) {
+          l_label += " ";
+        }
+      }
+      i_tracer->add_node( l_no,
+                          l_label );
+    }
   }
 }
 
@@ -549,6 +882,19 @@ int64_t einsum_ir::backend::EinsumNode::num_ops( bool i_children ) {
   return l_num_ops;
 }
 
+void einsum_ir::backend::EinsumNode::get_plans( std::vector< std::vector< int64_t > >                          & io_keys,
+                                                std::vector< std::shared_ptr< basic::contraction_plan const > > & io_plans ) const {
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    m_children[l_ch]->get_plans( io_keys,
+                                 io_plans );
+  }
+
+  if( m_cont != nullptr && m_cont->m_plan != nullptr ) {
+    io_keys.push_back( m_cont->m_plan_key );
+    io_plans.push_back( m_cont->m_plan );
+  }
+}
+
 void  einsum_ir::backend::EinsumNode::cancel_memory_reservation() {
   m_active_mem_users--;
   if( m_active_mem_users <= 0 && m_mem_id ){
@@ -559,15 +905,16 @@ void  einsum_ir::backend::EinsumNode::cancel_memory_reservation() {
 
 void einsum_ir::backend::EinsumNode::compile_memory_usage(){
   // compile children
-  m_memory->m_layer_id++;
   for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
     m_children[m_exec_order[l_ch]]->compile_memory_usage();
   }
-  m_memory->m_layer_id--;
 
   //reserve own mem
   if( m_req_mem ) {
-    m_mem_id = m_memory->reserve_memory(m_req_mem);
+    m_mem_id = m_memory->reserve_memory( m_req_mem,
+                                         m_resident );
+    // the memory manager rejects resident reservations beyond its budget
+    m_resident = m_memory->is_resident( m_mem_id );
   }
 
   //cancel reservation of child memory
@@ -575,6 +922,35 @@ void einsum_ir::backend::EinsumNode::compile_memory_usage(){
     m_children[l_ch]->cancel_memory_reservation();
   }
 
+  //the right subtree's memory is complete
+  if( m_memory_inter_op != nullptr ) {
+    m_memory_inter_op->alloc_all_memory();
+  }
+
+}
+
+bool einsum_ir::backend::EinsumNode::autotunes_subtree() const {
+  if( m_autotune && m_children.size() > 0 ) {
+    return true;
+  }
+  for( std::size_t l_ch = 0; l_ch < m_children.size(); l_ch++ ) {
+    if( m_children[l_ch]->autotunes_subtree() ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool einsum_ir::backend::EinsumNode::env_flag( char const * i_name,
+                                               bool         i_default ) {
+  char const * l_env = std::getenv( i_name );
+  if( l_env == nullptr ) {
+    return i_default;
+  }
+
+  return    strcmp( l_env, "1" ) == 0
+         || strcmp( l_env, "true" ) == 0;
 }
 
 bool einsum_ir::backend::EinsumNode::requires_permutation(){
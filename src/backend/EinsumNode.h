@@ -5,6 +5,7 @@
 #include "Unary.h"
 #include "BinaryContraction.h"
 #include "MemoryManager.h"
+#include "Tracer.h"
 #include "../constants.h"
 
 namespace einsum_ir {
@@ -24,6 +25,12 @@ class einsum_ir::backend::EinsumNode {
     kernel_t m_ktype_main = kernel_t::UNDEFINED_KTYPE;
     //! type of the last-touch kernel
     kernel_t m_ktype_last_touch = kernel_t::UNDEFINED_KTYPE;
+    //! epilogue program of the last-touch kernel if its type is EPILOGUE, has to be set before compilation
+    std::vector< epilogue_op > m_epilogue;
+    //! true if complex contractions use three real multiplications (3M) instead of four, has to be set before compilation
+    bool m_cpx_3m = false;
+    //! true if the contraction is autotuned if the tuning database has no entry for it, has to be set before compilation
+    bool m_autotune = false;
 
     //! size of the node's tensor in bytes
     int64_t m_size = 0;
@@ -72,9 +79,26 @@ class einsum_ir::backend::EinsumNode {
     //! true if dimension reordering is enabled
     bool m_reorder_dims = false;
 
+    //! true if the outer dimensions of inputs with external data are aligned with the external layout
+    bool m_align_layouts = false;
+
     //! true if packing is enabled
     bool m_pack_inputs = false;
 
+    //! true if independent subtrees are evaluated concurrently, has to be set before compilation
+    bool m_inter_op = false;
+
+    //! true if the two children are evaluated concurrently
+    bool m_eval_parallel = false;
+
+    //! executor of the node's contraction and unary operation
+    //! the thread pool is used below concurrently evaluated children since its workers are pinned to cores
+    executor_t m_executor = executor_t::OPENMP;
+
+    //! true if independent subtrees are compiled concurrently, has to be set before compilation
+    //! the setting is passed on to the children
+    bool m_compile_parallel = false;
+
     //! backend types
     backend_t m_btype_unary  = backend_t::UNDEFINED_BACKEND;
     backend_t m_btype_binary = backend_t::UNDEFINED_BACKEND;
@@ -88,6 +112,9 @@ class einsum_ir::backend::EinsumNode {
     //! Memory manager for intermendiate results
     MemoryManager * m_memory = nullptr;
 
+    //! memory manager of the right subtree if the children are evaluated concurrently
+    MemoryManager * m_memory_inter_op = nullptr;
+
     //! id of allocated memoy
     int64_t m_mem_id = 0;
 
@@ -119,9 +146,30 @@ class einsum_ir::backend::EinsumNode {
     //! true if the external data was copied and locked
     bool m_data_locked = false;
 
+    //! true if only nodes depending on dirty nodes are recomputed in an evaluation
+    bool m_incremental = false;
+
+    //! true if the node's data is kept resident between evaluations
+    bool m_resident = false;
+
+    //! true if the node's external data changed since the last evaluation
+    bool m_dirty = true;
+
+    //! true if the node or one of its descendants is dirty
+    bool m_dirty_subtree = true;
+
+    //! true if the node's data is the result of the last evaluation
+    bool m_valid = false;
+
     //! number of threads for the evaluation
     int64_t m_num_threads = 1;
 
+    //! tracer recording the evaluation, nullptr if disabled
+    Tracer * m_tracer = nullptr;
+
+    //! id of the node in the tracer
+    int64_t m_trace_id = -1;
+
     /**
      * Destructor.
      **/
@@ -221,6 +269,47 @@ class einsum_ir::backend::EinsumNode {
      **/    
     err_t compile_recursive();
 
+    /**
+     * Checks if a contraction of the node's subtree is autotuned.
+     *
+     * @return true if the node or one of its descendants is autotuned, false otherwise.
+     **/
+    bool autotunes_subtree() const;
+
+    /**
+     * Estimates the number of operations of the node and all its children before compilation.
+     *
+     * @return estimated number of operations.
+     **/
+    int64_t num_ops_estimate() const;
+
+    /**
+     * Assigns a memory manager to the node and all its children.
+     *
+     * @param i_memory memory manager.
+     **/
+    void set_memory( MemoryManager * i_memory );
+
+    /**
+     * Assigns an executor to the node and all its children.
+     *
+     * @param i_executor executor.
+     **/
+    void set_executor( executor_t i_executor );
+
+    /**
+     * Splits the threads between concurrently evaluated subtrees.
+     * The two children of a binary node are evaluated concurrently if both contain contractions.
+     * The threads are split by the estimated number of operations of the subtrees and
+     * the right subtree gets its own memory manager, i.e., concurrent nodes never share memory.
+     * Concurrently evaluated subtrees run on the thread pool, whose workers are pinned to cores:
+     * an OpenMP team started by a pinned worker would inherit the worker's core.
+     * Has to be called before compilation.
+     *
+     * @param i_num_threads number of threads of the subtree.
+     **/
+    void schedule_inter_op( int64_t i_num_threads );
+
     /**
      * Stores the provided data internally and locks it, i.e.,
      * the provided data pointer is ignored in future evaluations.
@@ -238,11 +327,63 @@ class einsum_ir::backend::EinsumNode {
      **/
     err_t unlock_data();
 
+    /**
+     * Sets the external data pointer of a compiled node.
+     * Kernels and the memory plan are kept, locked data remains valid.
+     * Since the memory plan depends on the presence of external data,
+     * the pointer has to be nullptr if and only if the node was compiled without external data.
+     * The node becomes dirty only if the pointer changes and the node is neither locked nor resident.
+     *
+     * @param i_data_ptr new data pointer.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t set_data_ptr( void * i_data_ptr );
+
+    /**
+     * Selects the nodes whose data is kept resident between evaluations and enables the incremental evaluation of the tree.
+     * The nodes are selected by the operations of their subtrees per byte until the budget is exhausted.
+     * Has to be called after the recursive compilation and before the memory usage is compiled.
+     *
+     * @param i_budget memory budget of the resident data in bytes.
+     **/
+    void select_resident( int64_t i_budget );
+
+    /**
+     * Marks the node's external data as changed, i.e., the node and its ancestors are recomputed in the next evaluation.
+     **/
+    void mark_dirty();
+
+    /**
+     * Derives recursively if the subtrees contain dirty nodes.
+     *
+     * @return true if the node or one of its descendants is dirty.
+     **/
+    bool update_dirty();
+
     /**
      * Evaluates the einsum tree described by the node all its children. 
      **/
     void eval();
 
+    /**
+     * Evaluates the node and those children whose data is not resident and up to date.
+     **/
+    void eval_incremental();
+
+    /**
+     * Evaluates the node assuming that the data of the children is available.
+     **/
+    void eval_node();
+
+    /**
+     * Sets the tracer of the node and all its children.
+     * The nodes are numbered in breadth-first order starting at this node, matching the rendered einsum tree.
+     * Has to be called after compilation, nullptr disables tracing.
+     *
+     * @param i_tracer tracer which records the evaluation.
+     **/
+    void set_tracer( Tracer * i_tracer );
+
     /**
      * Gets the number of operations required to evaluate the node.
      *
@@ -250,16 +391,38 @@ class einsum_ir::backend::EinsumNode {
      **/
     int64_t num_ops( bool i_children = true );
 
+    /**
+     * Gets the compiled contraction plans of the node and recursively those of all children.
+     * Has to be called after compilation.
+     *
+     * @param io_keys keys of the plans, new keys are appended.
+     * @param io_plans plans, new plans are appended.
+     **/
+    void get_plans( std::vector< std::vector< int64_t > >                          & io_keys,
+                    std::vector< std::shared_ptr< basic::contraction_plan const > > & io_plans ) const;
+
     /** 
      * Cancels a memory resrevation if this method is called m_req_mem_frees times
      **/
     void cancel_memory_reservation();
 
     /**
-     * compiles the effective memory usage depending on the execution order 
+     * compiles the effective memory usage depending on the execution order.
+     * The reservations are made in execution order, i.e., they give the live intervals of the intermediates.
      **/
     void compile_memory_usage();
 
+    /**
+     * Reads a boolean environment variable.
+     * The variable is read on every call, i.e., changes take effect in the next initialization.
+     *
+     * @param i_name name of the environment variable.
+     * @param i_default value which is returned if the variable is not set.
+     * @return true if the variable is set to 1 or true, false if set to any other value.
+     **/
+    static bool env_flag( char const * i_name,
+                          bool         i_default );
+
     /**
      * Determine if a permutation of Data is required for evalutation
      * 
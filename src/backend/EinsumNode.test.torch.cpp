@@ -2,6 +2,7 @@
 #include "catch.hpp"
 #include "EinsumNode.h"
 #include "MemoryManager.h"
+#include <cstdlib>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -1268,4 +1269,71 @@ TEST_CASE( "Einsum expression without batch dimensions.", "[einsum_node]" ) {
 
 
   REQUIRE( at::allclose( l_data_iefgh_ref, l_data_iefgh ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "Environment variables are read whenever a node is initialized.", "[einsum_node]" ) {
+  std::map< int64_t, int64_t > l_dim_sizes;
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 0, 2 ) );
+  l_dim_sizes.insert( std::pair< int64_t, int64_t >( 1, 3 ) );
+  int64_t l_dim_ids[2] = { 0, 1 };
+
+  at::Tensor l_data = at::rand( {3, 2} );
+
+  einsum_ir::backend::MemoryManager l_memory;
+  einsum_ir::backend::EinsumNode l_node;
+
+  char const * l_names[5] = { "EINSUM_IR_REORDER_DIMS",
+                              "EINSUM_IR_ALIGN_LAYOUTS",
+                              "EINSUM_IR_PACK_INPUTS",
+                              "EINSUM_IR_INTER_OP",
+                              "EINSUM_IR_COMPILE_PARALLEL" };
+
+  // defaults
+  for( int64_t l_va = 0; l_va < 5; l_va++ ) {
+    unsetenv( l_names[l_va] );
+  }
+  l_node.init( 2,
+               l_dim_ids,
+               &l_dim_sizes,
+               nullptr,
+               einsum_ir::FP32,
+               l_data.data_ptr(),
+               &l_memory );
+  REQUIRE(  l_node.m_reorder_dims );
+  REQUIRE(  l_node.m_align_layouts );
+  REQUIRE( !l_node.m_pack_inputs );
+  REQUIRE( !l_node.m_inter_op );
+  REQUIRE( !l_node.m_compile_parallel );
+
+  // toggle all flags
+  setenv( "EINSUM_IR_REORDER_DIMS",     "0",     1 );
+  setenv( "EINSUM_IR_ALIGN_LAYOUTS",    "false", 1 );
+  setenv( "EINSUM_IR_PACK_INPUTS",      "1",     1 );
+  setenv( "EINSUM_IR_INTER_OP",         "true",  1 );
+  setenv( "EINSUM_IR_COMPILE_PARALLEL", "1",     1 );
+  l_node.init( 2,
+               l_dim_ids,
+               &l_dim_sizes,
+               nullptr,
+               einsum_ir::FP32,
+               l_data.data_ptr(),
+               &l_memory );
+  REQUIRE( !l_node.m_reorder_dims );
+  REQUIRE( !l_node.m_align_layouts );
+  REQUIRE(  l_node.m_pack_inputs );
+  REQUIRE(  l_node.m_inter_op );
+  REQUIRE(  l_node.m_compile_parallel );
+
+  // back to the defaults
+  for( int64_t l_va = 0; l_va < 5; l_va++ ) {
+    unsetenv( l_names[l_va] );
+  }
+  l_node.init( 2,
+               l_dim_ids,
+               &l_dim_sizes,
+               nullptr,
+               einsum_ir::FP32,
+               l_data.data_ptr(),
+               &l_memory );
+  REQUIRE(  l_node.m_align_layouts );
+  REQUIRE( !l_node.m_inter_op );
+}
@@ -1,4 +1,8 @@
 #include "MemoryManager.h"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
 
 einsum_ir::backend::MemoryManager::~MemoryManager() {
   if(  m_memory_ptr != nullptr ) {
@@ -6,84 +10,167 @@ einsum_ir::backend::MemoryManager::~MemoryManager() {
   }
 }
 
-int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size ){
-  m_last_id++;
+int64_t einsum_ir::backend::MemoryManager::plan_best_fit( std::vector< int64_t > const & i_sizes,
+                                                          std::vector< int64_t > const & i_times_start,
+                                                          std::vector< int64_t > const & i_times_end,
+                                                          std::vector< int64_t > const & i_order,
+                                                          std::vector< int64_t >       & o_offsets ) {
+  o_offsets.assign( i_sizes.size(), 0 );
+  int64_t l_req_mem = 0;
 
+  std::vector< int64_t > l_placed;
+  std::vector< std::pair< int64_t, int64_t > > l_conflicts;
+  for( std::size_t l_or = 0; l_or < i_order.size(); l_or++ ) {
+    int64_t l_id = i_order[l_or];
+
+    // placed intervals which are live at the same time
+    l_conflicts.clear();
+    for( std::size_t l_pl = 0; l_pl < l_placed.size(); l_pl++ ) {
+      int64_t l_other = l_placed[l_pl];
+      if(    i_times_start[l_id]    < i_times_end[l_other]
+          && i_times_start[l_other] < i_times_end[l_id] ) {
+        l_conflicts.push_back( { o_offsets[l_other],
+                                 o_offsets[l_other] + i_sizes[l_other] } );
+      }
+    }
+    std::sort( l_conflicts.begin(),
+               l_conflicts.end() );
+
+    // smallest gap which fits, the top of the conflicts otherwise
+    int64_t l_pos = 0;
+    int64_t l_best_offset = -1;
+    int64_t l_best_gap = std::numeric_limits< int64_t >::max();
+    for( std::size_t l_co = 0; l_co < l_conflicts.size(); l_co++ ) {
+      int64_t l_gap = l_conflicts[l_co].first - l_pos;
+      if( l_gap >= i_sizes[l_id] && l_gap < l_best_gap ) {
+        l_best_gap = l_gap;
+        l_best_offset = l_pos;
+      }
+      l_pos = std::max( l_pos, l_conflicts[l_co].second );
+    }
+    if( l_best_offset < 0 ) {
+      l_best_offset = l_pos;
+    }
+
+    o_offsets[l_id] = l_best_offset;
+    l_placed.push_back( l_id );
+    l_req_mem = std::max( l_req_mem, l_best_offset + i_sizes[l_id] );
+  }
+
+  return l_req_mem;
+}
+
+int64_t einsum_ir::backend::MemoryManager::reserve_memory( int64_t i_size,
+                                                           bool    i_resident ){
   //increase size to multiple of alignment
   if( i_size % m_alignment_line != 0 ){
     i_size += m_alignment_line - ( i_size % m_alignment_line );
   }
-  
-  //calculate new memory offset and append to allocation
-  int64_t l_mem_id;
-  int64_t l_offset = 0;
-  if( m_layer_id % 2 == 0 ){
-    if( !m_allocated_id_left.empty() ){
-      l_offset = m_allocated_offset_left.front();
-    }
-    m_tensor_offset.push_back(l_offset);
-    l_offset += i_size;
-    l_mem_id = m_last_id;
-    m_allocated_id_left.push_front(l_mem_id);
-    m_allocated_offset_left.push_front(l_offset);
-  }
-  else{
-    if( !m_allocated_id_right.empty() ){
-      l_offset = m_allocated_offset_right.front();
-    }
-    l_offset -= i_size;
-    l_mem_id = -m_last_id;
-    m_tensor_offset.push_back(l_offset);
-    m_allocated_id_right.push_front(l_mem_id);
-    m_allocated_offset_right.push_front(l_offset);
+
+  // resident reservations are limited by the budget
+  if(    i_resident
+      && m_resident_mem + i_size > m_resident_budget ) {
+    i_resident = false;
   }
 
-  //check if more memory required
-  int64_t l_offset_left  = (m_allocated_offset_left.empty())  ? 0 : m_allocated_offset_left.front();
-  int64_t l_offset_right = (m_allocated_offset_right.empty()) ? 0 : m_allocated_offset_right.front();
-  int64_t l_current_mem = l_offset_left - l_offset_right;
-  if(l_current_mem > m_req_mem){
-    m_req_mem = l_current_mem;
+  m_sizes.push_back( i_size );
+  m_times_start.push_back( m_time );
+  m_times_end.push_back( std::numeric_limits< int64_t >::max() );
+  m_resident.push_back( i_resident );
+  m_time++;
+
+  if( i_resident ) {
+    m_resident_mem += i_size;
   }
 
-  return l_mem_id;
+  // ids start at 1, 0 is used for no memory
+  return m_sizes.size();
 }
 
 void einsum_ir::backend::MemoryManager::remove_reservation( int64_t i_id ){
+  if( m_resident[i_id - 1] ) {
+    return;
+  }
+
+  m_times_end[i_id - 1] = m_time;
+  m_time++;
+}
 
-  //find offset and id in list of allocated and delete them
-  std::list<int64_t>::iterator l_alloc_id_it;
-  std::list<int64_t>::iterator l_alloc_offset_it;
-  if( i_id >= 0 ){
-    l_alloc_offset_it = m_allocated_offset_left.begin();
-    for(l_alloc_id_it = m_allocated_id_left.begin(); l_alloc_id_it != m_allocated_id_left.end(); ++l_alloc_id_it ) {
-      if( i_id == *l_alloc_id_it ) {
-        break;
+void einsum_ir::backend::MemoryManager::set_resident_budget( int64_t i_budget ){
+  m_resident_budget = i_budget;
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_resident_budget() const {
+  return m_resident_budget;
+}
+
+bool einsum_ir::backend::MemoryManager::is_resident( int64_t i_id ) const {
+  return m_resident[i_id - 1];
+}
+
+int64_t einsum_ir::backend::MemoryManager::get_resident_memory() const {
+  return m_resident_mem;
+}
+
+void einsum_ir::backend::MemoryManager::plan_memory(){
+  int64_t l_num_res = m_sizes.size();
+
+  // lower bound: maximum live memory at the start of a reservation
+  m_lower_bound = 0;
+  for( int64_t l_re = 0; l_re < l_num_res; l_re++ ) {
+    int64_t l_live = 0;
+    for( int64_t l_ot = 0; l_ot < l_num_res; l_ot++ ) {
+      if(    m_times_start[l_ot] <= m_times_start[l_re]
+          && m_times_start[l_re] <  m_times_end[l_ot] ) {
+        l_live += m_sizes[l_ot];
       }
-      l_alloc_offset_it++;
     }
-    m_allocated_id_left.erase(l_alloc_id_it);
-    m_allocated_offset_left.erase(l_alloc_offset_it);
+    m_lower_bound = std::max( m_lower_bound, l_live );
   }
-  else {
-    l_alloc_offset_it = m_allocated_offset_right.begin();
-    for(l_alloc_id_it = m_allocated_id_right.begin(); l_alloc_id_it != m_allocated_id_right.end(); ++l_alloc_id_it ) {
-      if( i_id == *l_alloc_id_it ) {
-        break;
-      }
-      l_alloc_offset_it++;
+
+  // placement orders: decreasing size, execution order, decreasing size times lifetime
+  std::vector< std::vector< int64_t > > l_orders( 3 );
+  for( std::size_t l_or = 0; l_or < l_orders.size(); l_or++ ) {
+    l_orders[l_or].resize( l_num_res );
+    std::iota( l_orders[l_or].begin(),
+               l_orders[l_or].end(),
+               0 );
+  }
+  std::stable_sort( l_orders[0].begin(),
+                    l_orders[0].end(),
+                    [&]( int64_t i_a, int64_t i_b ) { return m_sizes[i_a] > m_sizes[i_b]; } );
+  std::vector< double > l_weights( l_num_res );
+  for( int64_t l_re = 0; l_re < l_num_res; l_re++ ) {
+    int64_t l_time_end = std::min( m_times_end[l_re], m_time );
+    l_weights[l_re] = (double) m_sizes[l_re] * (double) ( l_time_end - m_times_start[l_re] + 1 );
+  }
+  std::stable_sort( l_orders[2].begin(),
+                    l_orders[2].end(),
+                    [&]( int64_t i_a, int64_t i_b ) { return l_weights[i_a] > l_weights[i_b]; } );
+
+  m_req_mem = -1;
+  std::vector< int64_t > l_offsets;
+  for( std::size_t l_or = 0; l_or < l_orders.size(); l_or++ ) {
+    int64_t l_req_mem = plan_best_fit( m_sizes,
+                                       m_times_start,
+                                       m_times_end,
+                                       l_orders[l_or],
+                                       l_offsets );
+    if( m_req_mem < 0 || l_req_mem < m_req_mem ) {
+      m_req_mem = l_req_mem;
+      m_offsets = l_offsets;
     }
-    m_allocated_id_right.erase(l_alloc_id_it);
-    m_allocated_offset_right.erase(l_alloc_offset_it);
   }
 }
 
 void einsum_ir::backend::MemoryManager::alloc_all_memory(){
+  plan_memory();
+
   if( m_req_mem ){
-    //allocate memory 
+    //allocate memory
     m_memory_ptr = new char[m_req_mem + m_alignment_page];
 
-    //allign data in memory 
+    //allign data in memory
     int64_t l_align_offset = (unsigned long)m_memory_ptr % m_alignment_page;
     l_align_offset = l_align_offset ? m_alignment_page - l_align_offset : 0;
     m_aligned_memory_ptr = m_memory_ptr + l_align_offset;
@@ -93,17 +180,16 @@ void einsum_ir::backend::MemoryManager::alloc_all_memory(){
 }
 
 void * einsum_ir::backend::MemoryManager::get_mem_ptr( int64_t i_id ){
+  return (void *) (m_aligned_memory_ptr + m_offsets[i_id - 1]);
+}
 
-  void * l_return_ptr;
-  if(i_id >= 0){
-    l_return_ptr = (void *) (m_aligned_memory_ptr +  m_tensor_offset[i_id - 1]);
-  }
-  else{
-    l_return_ptr = (void *) (m_aligned_memory_ptr + m_req_mem + m_tensor_offset[-i_id - 1]);
-  }
-  return l_return_ptr;
+int64_t einsum_ir::backend::MemoryManager::get_peak_memory() const {
+  return m_req_mem;
 }
 
+int64_t einsum_ir::backend::MemoryManager::get_lower_bound() const {
+  return m_lower_bound;
+}
 
 einsum_ir::basic::ContractionMemoryManager * einsum_ir::backend::MemoryManager::get_contraction_memory_manager(){
   return &m_contraction_memory_manager;
@@ -2,7 +2,6 @@
 #define EINSUM_IR_BACKEND_MEMORY_MANAGER
 
 #include <vector>
-#include <list>
 #include "../constants.h"
 #include "../basic/binary/ContractionMemoryManager.h"
 
@@ -12,11 +11,22 @@ namespace einsum_ir {
   }
 }
 
+/**
+ * Memory of the intermediate tensors of an einsum tree.
+ * The reservations are recorded in execution order: every reservation and removal advances a logical clock,
+ * i.e., each intermediate has a size and a live interval.
+ * Before allocation, the offsets are planned such that intermediates with overlapping live intervals never overlap in memory.
+ * The placement is best-fit: an intermediate goes into the smallest gap between the conflicting, already placed ones.
+ * Since the result depends on the order of the placement, multiple orders are planned and the one with the lowest peak is kept.
+ * Resident reservations are never removed, i.e., their data is kept between evaluations.
+ * The resident budget limits the memory which may be used by resident reservations.
+ * Resident reservations which exceed the budget fall back to regular ones.
+ **/
 class einsum_ir::backend::MemoryManager{
   private:
-    //! alignment of memory to cache lines in bytes 
+    //! alignment of memory to cache lines in bytes
     int64_t m_alignment_line = 128;
-    //! alignment of memory to pages in bytes 
+    //! alignment of memory to pages in bytes
     int64_t m_alignment_page = 4096;
 
     //! pointer to the start of all allocated memory
@@ -25,25 +35,48 @@ class einsum_ir::backend::MemoryManager{
     char * m_aligned_memory_ptr = nullptr;
     //! the required memory for all data
     int64_t m_req_mem = 0;
-
-    //! last id given to any tensor
-    int64_t m_last_id = 0;
-
-    //! offset of the tensor for pointer calculation
-    std::vector<int64_t> m_tensor_offset;
-
-    //! propertys of allocated memory
-    std::list<int64_t> m_allocated_id_left;
-    std::list<int64_t> m_allocated_id_right;
-    std::list<int64_t> m_allocated_offset_left;
-    std::list<int64_t> m_allocated_offset_right;
+    //! maximum memory which is live at the same time
+    int64_t m_lower_bound = 0;
+
+    //! current time of the logical clock
+    int64_t m_time = 0;
+
+    //! sizes of the reservations
+    std::vector< int64_t > m_sizes;
+    //! times at which the reservations were made
+    std::vector< int64_t > m_times_start;
+    //! times at which the reservations were removed
+    std::vector< int64_t > m_times_end;
+    //! planned offsets of the reservations
+    std::vector< int64_t > m_offsets;
+    //! true if a reservation is resident
+    std::vector< bool > m_resident;
+
+    //! memory budget of the resident reservations in bytes
+    int64_t m_resident_budget = 0;
+    //! memory of the resident reservations in bytes
+    int64_t m_resident_mem = 0;
 
     //! memory manager for contractions
     einsum_ir::basic::ContractionMemoryManager m_contraction_memory_manager;
 
   public:
-    //! id of the current layer
-    int64_t m_layer_id = 0;
+    /**
+     * Plans the offsets of intervals by placing them in the given order.
+     * Every interval is placed in the smallest gap between the already placed intervals which are live at the same time.
+     *
+     * @param i_sizes sizes of the intervals.
+     * @param i_times_start start times of the intervals.
+     * @param i_times_end end times (exclusive) of the intervals.
+     * @param i_order order in which the intervals are placed.
+     * @param o_offsets will be set to the offsets of the intervals.
+     * @return required memory, i.e., the maximum end of an interval in memory.
+     **/
+    static int64_t plan_best_fit( std::vector< int64_t > const & i_sizes,
+                                  std::vector< int64_t > const & i_times_start,
+                                  std::vector< int64_t > const & i_times_end,
+                                  std::vector< int64_t > const & i_order,
+                                  std::vector< int64_t >       & o_offsets );
 
     /**
      * Destructor.
@@ -51,23 +84,62 @@ class einsum_ir::backend::MemoryManager{
     ~MemoryManager();
 
     /**
-     * reserves memory for a calculation. Only used in theoretical compilation of the memory manager. 
+     * reserves memory for a calculation. Only used in theoretical compilation of the memory manager.
      *
      * @param i_size size of reserved memory.
-     * 
+     * @param i_resident true if the reservation is resident, i.e., it is never removed.
+     *                   the reservation is regular if it would exceed the resident budget.
+     *
      * @return id of the memory reservation.
      **/
-    int64_t reserve_memory( int64_t i_size );
+    int64_t reserve_memory( int64_t i_size,
+                            bool    i_resident = false );
 
     /**
      * removes a memory reservation.
+     * Resident reservations are kept.
+     *
+     * @param i_id id of the memory reservation.
+     **/
+    void remove_reservation( int64_t i_id );
+
+    /**
+     * Sets the memory budget of the resident reservations.
+     *
+     * @param i_budget budget in bytes, 0 disables resident reservations.
+     **/
+    void set_resident_budget( int64_t i_budget );
+
+    /**
+     * Gets the memory budget of the resident reservations.
+     *
+     * @return budget in bytes.
+     **/
+    int64_t get_resident_budget() const;
+
+    /**
+     * Checks if a reservation is resident.
      *
      * @param i_id id of the memory reservation.
+     * @return true if the reservation is resident, false otherwise.
+     **/
+    bool is_resident( int64_t i_id ) const;
+
+    /**
+     * Gets the memory of the resident reservations.
+     *
+     * @return memory in bytes.
+     **/
+    int64_t get_resident_memory() const;
+
+    /**
+     * Plans the offsets of all reservations.
+     * Reservations which were not removed are live until the end.
      **/
-    void remove_reservation( int64_t i_size );
+    void plan_memory();
 
     /**
-     * Allocates the required memory.
+     * Plans the offsets and allocates the required memory.
      **/
     void alloc_all_memory();
 
@@ -75,11 +147,27 @@ class einsum_ir::backend::MemoryManager{
      * returns a pointer to requested memory
      *
      * @param i_id id of the memory request.
-     * 
+     *
      * @return pointer to requested memory
      **/
     void * get_mem_ptr( int64_t i_id );
 
+    /**
+     * Gets the planned memory of the intermediates.
+     * Has to be called after planning.
+     *
+     * @return required memory in bytes.
+     **/
+    int64_t get_peak_memory() const;
+
+    /**
+     * Gets the lower bound of the memory, i.e., the maximum memory which is live at the same time.
+     * Has to be called after planning.
+     *
+     * @return lower bound in bytes.
+     **/
+    int64_t get_lower_bound() const;
+
     /**
      * retruns a poiner to the ContractionMemoryManager
      *
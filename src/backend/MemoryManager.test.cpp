@@ -11,47 +11,127 @@ TEST_CASE( "A complex memory allocation test", "[memory_manager]" ) {
 
   //Memory Manager
   einsum_ir::backend::MemoryManager l_memory;
-  l_memory.increase_layer();
-
-  //  | 12 | 20 | ... | 15 |
-  l_memory.increase_layer();
-  int64_t l_mem_id_1 = l_memory.request_memory(12 * 4);
-  int64_t l_mem_id_2 = l_memory.request_memory(20 * 4);
-  l_memory.decrease_layer();
-  int64_t l_mem_id_3 = l_memory.request_memory(15 * 4);
-  l_memory.remove_memory(l_mem_id_1);
-  l_memory.remove_memory(l_mem_id_2);
-
-  // | 30 | ... | 30 | 15 |
-  l_memory.increase_layer();
-  int64_t l_mem_id_4 = l_memory.request_memory(30 * 4);
-  l_memory.decrease_layer();
-  int64_t l_mem_id_5 = l_memory.request_memory(30 * 4);
-  l_memory.remove_memory(l_mem_id_4);
-
-  l_memory.decrease_layer();
-
-  // | 18 | ... | 30 | 15 |
-  int64_t l_mem_id_6 = l_memory.request_memory(18 * 4);
-  l_memory.remove_memory(l_mem_id_3);
-  l_memory.remove_memory(l_mem_id_5);
-
-
-  //check that pointers are written to the correct memory side
-  REQUIRE( l_mem_id_1 >= 0 );
-  REQUIRE( l_mem_id_2 >= 0 );
-  REQUIRE( l_mem_id_3 < 0 );
-  REQUIRE( l_mem_id_4 >= 0 );
-  REQUIRE( l_mem_id_5 < 0 );
-  REQUIRE( l_mem_id_6 >= 0 );
-
-  //check that right amount of memory gets allocated
-  REQUIRE( l_memory.m_req_mem >= ( 30 + 30 + 15 ) * 4 );
-
-  //allocate memory and check some pointer
+
+  // sizes are multiples of the alignment
+  int64_t l_mem_id_1 = l_memory.reserve_memory(12 * 4);
+  int64_t l_mem_id_2 = l_memory.reserve_memory(20 * 4);
+  int64_t l_mem_id_3 = l_memory.reserve_memory(15 * 4);
+  l_memory.remove_reservation(l_mem_id_1);
+  l_memory.remove_reservation(l_mem_id_2);
+
+  int64_t l_mem_id_4 = l_memory.reserve_memory(30 * 4);
+  int64_t l_mem_id_5 = l_memory.reserve_memory(30 * 4);
+  l_memory.remove_reservation(l_mem_id_4);
+
+  int64_t l_mem_id_6 = l_memory.reserve_memory(18 * 4);
+  l_memory.remove_reservation(l_mem_id_3);
+  l_memory.remove_reservation(l_mem_id_5);
+
+  // ids are positive, 0 is used for no memory
+  REQUIRE( l_mem_id_1 > 0 );
+  REQUIRE( l_mem_id_6 > 0 );
+
+  //allocate memory and check the pointers of live intermediates
+  l_memory.alloc_all_memory();
+
+  // live at the same time: 1, 2, 3 | 3, 4, 5 | 3, 5, 6
+  REQUIRE( l_memory.get_lower_bound() == 3 * 128 );
+  REQUIRE( l_memory.get_peak_memory() == 3 * 128 );
+
+  std::vector< std::vector< int64_t > > l_live = { { l_mem_id_1, l_mem_id_2, l_mem_id_3 },
+                                                   { l_mem_id_3, l_mem_id_4, l_mem_id_5 },
+                                                   { l_mem_id_3, l_mem_id_5, l_mem_id_6 } };
+  for( std::size_t l_se = 0; l_se < l_live.size(); l_se++ ) {
+    std::vector< char * > l_ptrs;
+    for( std::size_t l_id = 0; l_id < l_live[l_se].size(); l_id++ ) {
+      l_ptrs.push_back( (char *) l_memory.get_mem_ptr( l_live[l_se][l_id] ) );
+    }
+    std::sort( l_ptrs.begin(), l_ptrs.end() );
+    REQUIRE( l_ptrs[0] != nullptr );
+    REQUIRE( l_ptrs[1] - l_ptrs[0] >= 128 );
+    REQUIRE( l_ptrs[2] - l_ptrs[1] >= 128 );
+  }
+}
+
+TEST_CASE( "Best-fit planning reuses the gaps of dead intermediates.", "[memory_manager]" ) {
+  // time:  0 1 2 3 4 5
+  // 0:     xxxx            size 2
+  // 1:     xxxxxxxxxxxx    size 1
+  // 2:         xxxxxxxx    size 2
+  // 3:           xxxx      size 1
+  std::vector< int64_t > l_sizes       = { 2, 1, 2, 1 };
+  std::vector< int64_t > l_times_start = { 0, 0, 2, 3 };
+  std::vector< int64_t > l_times_end   = { 2, 6, 6, 5 };
+  std::vector< int64_t > l_offsets;
+
+  int64_t l_req_mem = einsum_ir::backend::MemoryManager::plan_best_fit( l_sizes,
+                                                                        l_times_start,
+                                                                        l_times_end,
+                                                                        { 0, 1, 2, 3 },
+                                                                        l_offsets );
+  REQUIRE( l_req_mem == 4 );
+  REQUIRE( l_offsets[0] == 0 );
+  REQUIRE( l_offsets[1] == 2 );
+  REQUIRE( l_offsets[2] == 0 );
+  REQUIRE( l_offsets[3] == 3 );
+
+  // a stack would keep the dead space of interval 0 below interval 1
+  einsum_ir::backend::MemoryManager l_memory;
+  int64_t l_id_0 = l_memory.reserve_memory( 256 );
+  int64_t l_id_1 = l_memory.reserve_memory( 128 );
+  l_memory.remove_reservation( l_id_0 );
+  int64_t l_id_2 = l_memory.reserve_memory( 256 );
+  l_memory.remove_reservation( l_id_1 );
+  l_memory.remove_reservation( l_id_2 );
+  l_memory.plan_memory();
+
+  REQUIRE( l_memory.get_lower_bound() == 384 );
+  REQUIRE( l_memory.get_peak_memory() == 384 );
+}
+
+TEST_CASE( "Resident memory reservations.", "[memory_manager]" ) {
+  einsum_ir::backend::MemoryManager l_memory;
+  l_memory.set_resident_budget( 1024 );
+  REQUIRE( l_memory.get_resident_budget() == 1024 );
+
+  // the resident reservation is not reused by the later reservation
+  int64_t l_id_0 = l_memory.reserve_memory( 256, true );
+  int64_t l_id_1 = l_memory.reserve_memory( 128 );
+  l_memory.remove_reservation( l_id_0 );
+  l_memory.remove_reservation( l_id_1 );
+  int64_t l_id_2 = l_memory.reserve_memory( 384 );
+  l_memory.remove_reservation( l_id_2 );
+  l_memory.alloc_all_memory();
+
+  REQUIRE( l_memory.get_resident_memory() == 256 );
+  REQUIRE( l_memory.get_peak_memory() == 640 );
+
+  char * l_ptr_0 = (char *) l_memory.get_mem_ptr( l_id_0 );
+  char * l_ptr_2 = (char *) l_memory.get_mem_ptr( l_id_2 );
+  REQUIRE( ( l_ptr_2 + 384 <= l_ptr_0 || l_ptr_0 + 256 <= l_ptr_2 ) );
+}
+
+TEST_CASE( "Resident memory reservations beyond the budget.", "[memory_manager]" ) {
+  einsum_ir::backend::MemoryManager l_memory;
+  l_memory.set_resident_budget( 512 );
+
+  // the second resident reservation exceeds the budget and is regular
+  int64_t l_id_0 = l_memory.reserve_memory( 384, true );
+  int64_t l_id_1 = l_memory.reserve_memory( 256, true );
+  l_memory.remove_reservation( l_id_0 );
+  l_memory.remove_reservation( l_id_1 );
+  int64_t l_id_2 = l_memory.reserve_memory( 256 );
+  l_memory.remove_reservation( l_id_2 );
   l_memory.alloc_all_memory();
-  float * l_mem_1_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_2);
-  float * l_mem_2_ptr = (float*) l_memory.get_mem_ptr(l_mem_id_3);
-  REQUIRE( l_mem_1_ptr != nullptr );
-  REQUIRE( l_mem_2_ptr != nullptr);
-}
\ No newline at end of file
+
+  REQUIRE( l_memory.is_resident( l_id_0 ) );
+  REQUIRE( !l_memory.is_resident( l_id_1 ) );
+  REQUIRE( l_memory.get_resident_memory() == 384 );
+  REQUIRE( l_memory.get_peak_memory() == 640 );
+
+  // without a budget, no reservation is resident
+  einsum_ir::backend::MemoryManager l_memory_no_budget;
+  int64_t l_id_3 = l_memory_no_budget.reserve_memory( 128, true );
+  REQUIRE( !l_memory_no_budget.is_resident( l_id_3 ) );
+  REQUIRE( l_memory_no_budget.get_resident_memory() == 0 );
+}
@@ -0,0 +1,116 @@
+#include "Tracer.h"
+#include <fstream>
+#include <iomanip>
+
+std::string einsum_ir::backend::Tracer::phase_name( trace_t i_phase ) {
+  if(      i_phase == trace_t::TRACE_NODE     ) return "node";
+  else if( i_phase == trace_t::TRACE_PERMUTE  ) return "permute";
+  else if( i_phase == trace_t::TRACE_CONTRACT ) return "contract";
+  else if( i_phase == trace_t::TRACE_COPY     ) return "copy";
+  else return "undefined";
+}
+
+void einsum_ir::backend::Tracer::add_node( int64_t             i_node_id,
+                                           std::string const & i_label ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_labels[i_node_id] = i_label;
+}
+
+int64_t einsum_ir::backend::Tracer::now() const {
+  return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now() - m_time_start ).count();
+}
+
+void einsum_ir::backend::Tracer::record( int64_t i_node_id,
+                                         trace_t i_phase,
+                                         int64_t i_time_start,
+                                         int64_t i_num_ops ) {
+  trace_event l_event;
+  l_event.node_id    = i_node_id;
+  l_event.phase      = i_phase;
+  l_event.time_start = i_time_start;
+  l_event.time_end   = now();
+  l_event.num_ops    = i_num_ops;
+
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  std::thread::id l_thread = std::this_thread::get_id();
+  std::map< std::thread::id, int64_t >::iterator l_it = m_thread_ids.find( l_thread );
+  if( l_it == m_thread_ids.end() ) {
+    l_it = m_thread_ids.insert( { l_thread, (int64_t) m_thread_ids.size() } ).first;
+  }
+  l_event.thread_id = l_it->second;
+
+  m_events.push_back( l_event );
+}
+
+void einsum_ir::backend::Tracer::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_events.clear();
+  m_time_start = std::chrono::steady_clock::now();
+}
+
+std::vector< einsum_ir::trace_event > einsum_ir::backend::Tracer::get_events() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_events;
+}
+
+void einsum_ir::backend::Tracer::write( std::ostream & io_stream ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
+  io_stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+  // names of the threads
+  for( int64_t l_th = 0; l_th < (int64_t) m_thread_ids.size(); l_th++ ) {
+    if( l_th > 0 ) {
+      io_stream << ",";
+    }
+    io_stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << l_th
+              << ",\"args\":{\"name\":\"thread " << l_th << "\"}}";
+  }
+
+  // complete events, timestamps are given in microseconds
+  io_stream << std::fixed << std::setprecision( 3 );
+  for( std::size_t l_ev = 0; l_ev < m_events.size(); l_ev++ ) {
+    trace_event const & l_event = m_events[l_ev];
+
+    std::string l_label = "";
+    if( m_labels.find( l_event.node_id ) != m_labels.end() ) {
+      l_label = m_labels.at( l_event.node_id );
+    }
+
+    std::string l_name = phase_name( l_event.phase );
+    if( l_event.phase == trace_t::TRACE_NODE ) {
+      l_name = "node " + std::to_string( l_event.node_id ) + ": " + l_label;
+    }
+
+    if( l_ev > 0 || m_thread_ids.size() > 0 ) {
+      io_stream << ",";
+    }
+    io_stream << "\n{\"name\":\"" << l_name << "\""
+              << ",\"cat\":\"" << phase_name( l_event.phase ) << "\""
+              << ",\"ph\":\"X\""
+              << ",\"pid\":0"
+              << ",\"tid\":" << l_event.thread_id
+              << ",\"ts\":" << l_event.time_start * 1.0E-3
+              << ",\"dur\":" << ( l_event.time_end - l_event.time_start ) * 1.0E-3
+              << ",\"args\":{\"node\":" << l_event.node_id
+              << ",\"dims\":\"" << l_label << "\""
+              << ",\"flops\":" << l_event.num_ops
+              << "}}";
+  }
+  io_stream << "\n]}" << std::endl;
+}
+
+einsum_ir::err_t einsum_ir::backend::Tracer::store( std::string const & i_path ) {
+  std::ofstream l_file( i_path );
+  if( !l_file.is_open() ) {
+    return err_t::IO_FAILED;
+  }
+
+  write( l_file );
+  l_file.close();
+  if( l_file.fail() ) {
+    return err_t::IO_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
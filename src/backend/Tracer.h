@@ -0,0 +1,109 @@
+#ifndef EINSUM_IR_BACKEND_TRACER
+#define EINSUM_IR_BACKEND_TRACER
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace backend {
+    class Tracer;
+  }
+}
+
+/**
+ * Records the evaluation of einsum nodes as timeline.
+ * Nodes are registered with the id and the label of the rendered einsum tree.
+ * Events may be recorded concurrently and are exported in the Chrome Trace Event format,
+ * e.g., for chrome://tracing or Perfetto.
+ **/
+class einsum_ir::backend::Tracer {
+  private:
+    //! start of the trace
+    std::chrono::steady_clock::time_point m_time_start = std::chrono::steady_clock::now();
+
+    //! recorded events
+    std::vector< trace_event > m_events;
+
+    //! labels of the registered nodes
+    std::map< int64_t, std::string > m_labels;
+
+    //! dense ids of the recording threads
+    std::map< std::thread::id, int64_t > m_thread_ids;
+
+    //! mutex protecting the events and thread ids
+    std::mutex m_mutex;
+
+  public:
+    /**
+     * Gets the name of a phase.
+     *
+     * @param i_phase phase.
+     * @return name of the phase.
+     **/
+    static std::string phase_name( trace_t i_phase );
+
+    /**
+     * Registers a node.
+     *
+     * @param i_node_id id of the node.
+     * @param i_label label of the node.
+     **/
+    void add_node( int64_t             i_node_id,
+                   std::string const & i_label );
+
+    /**
+     * Gets the current time of the trace.
+     *
+     * @return nanoseconds since the start of the trace.
+     **/
+    int64_t now() const;
+
+    /**
+     * Records an event which ends now.
+     *
+     * @param i_node_id id of the node.
+     * @param i_phase phase of the event.
+     * @param i_time_start start of the event, obtained through now().
+     * @param i_num_ops number of operations of the event.
+     **/
+    void record( int64_t i_node_id,
+                 trace_t i_phase,
+                 int64_t i_time_start,
+                 int64_t i_num_ops );
+
+    /**
+     * Removes all events and restarts the trace.
+     * Registered nodes are kept.
+     **/
+    void clear();
+
+    /**
+     * Gets the recorded events.
+     *
+     * @return recorded events.
+     **/
+    std::vector< trace_event > get_events();
+
+    /**
+     * Writes the events in the Chrome Trace Event format.
+     *
+     * @param io_stream output stream.
+     **/
+    void write( std::ostream & io_stream );
+
+    /**
+     * Writes the events in the Chrome Trace Event format to a file.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the events were written, otherwise an appropiate error code.
+     **/
+    err_t store( std::string const & i_path );
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "catch.hpp"
+#include "Tracer.h"
+#include <sstream>
+#include <thread>
+
+TEST_CASE( "Records events of multiple threads and writes them as Chrome trace.", "[tracer]" ) {
+  einsum_ir::backend::Tracer l_tracer;
+  l_tracer.add_node( 0, "0 1 2" );
+  l_tracer.add_node( 1, "0 3" );
+
+  int64_t l_time_start = l_tracer.now();
+  l_tracer.record( 1,
+                   einsum_ir::TRACE_PERMUTE,
+                   l_time_start,
+                   0 );
+
+  std::thread l_thread( [&l_tracer](){
+    int64_t l_time_thread = l_tracer.now();
+    l_tracer.record( 0,
+                     einsum_ir::TRACE_CONTRACT,
+                     l_time_thread,
+                     1024 );
+  } );
+  l_thread.join();
+
+  l_tracer.record( 0,
+                   einsum_ir::TRACE_NODE,
+                   l_time_start,
+                   1024 );
+
+  std::vector< einsum_ir::trace_event > l_events = l_tracer.get_events();
+  REQUIRE( l_events.size() == 3 );
+  REQUIRE( l_events[0].node_id   == 1 );
+  REQUIRE( l_events[0].thread_id == 0 );
+  REQUIRE( l_events[1].thread_id == 1 );
+  REQUIRE( l_events[1].num_ops   == 1024 );
+  REQUIRE( l_events[2].thread_id == 0 );
+  REQUIRE( l_events[2].time_start <= l_events[1].time_start );
+  REQUIRE( l_events[2].time_end   >= l_events[1].time_end );
+
+  std::stringstream l_stream;
+  l_tracer.write( l_stream );
+  std::string l_json = l_stream.str();
+
+  REQUIRE( l_json.find( "\"traceEvents\":[" )                  != std::string::npos );
+  REQUIRE( l_json.find( "\"name\":\"node 0: 0 1 2\"" )         != std::string::npos );
+  REQUIRE( l_json.find( "\"cat\":\"contract\",\"ph\":\"X\"" )  != std::string::npos );
+  REQUIRE( l_json.find( "\"tid\":1" )                          != std::string::npos );
+  REQUIRE( l_json.find( "\"dims\":\"0 3\",\"flops\":0" )       != std::string::npos );
+  REQUIRE( l_json.find( "\"flops\":1024" )                     != std::string::npos );
+
+  l_tracer.clear();
+  REQUIRE( l_tracer.get_events().size() == 0 );
+}
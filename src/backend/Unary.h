@@ -49,6 +49,9 @@ class einsum_ir::backend::Unary {
     //! number of threads
     int64_t m_num_threads = 1;
 
+    //! executor of the parallel execution, has to be set before compilation
+    executor_t m_executor = executor_t::OPENMP;
+
     /**
      * Derives the strides based on the sizes of the dimensions in the respective tensors.
      *
@@ -39,7 +39,8 @@ einsum_ir::err_t einsum_ir::backend::UnaryScalar::compile() {
                   l_dtype_comp,
                   l_dtype_out,
                   l_ktype_main,
-                  m_num_threads );
+                  m_num_threads,
+                  ce_executor_to_basic(m_executor) );
 
   l_err = ce_basic_err_to_err(m_backend.compile());
   if( l_err != err_t::SUCCESS ) {
@@ -1,5 +1,7 @@
 #include "UnaryTpp.h"
 #include "../basic/unary/UnaryOptimizer.h"
+#include "../basic/MachineProfile.h"
+#include <algorithm>
 
 einsum_ir::err_t einsum_ir::backend::UnaryTpp::compile() {
   err_t l_err = Unary::compile_base();
@@ -30,7 +32,9 @@ einsum_ir::err_t einsum_ir::backend::UnaryTpp::compile() {
 
   l_optim.init( &l_loops ,
                 m_num_threads,
-                false );
+                false,
+                std::max( ce_n_bytes(m_dtype_in), ce_n_bytes(m_dtype_out) ),
+                basic::MachineProfile::get_instance()->get_size_l1d_cpu() );
   l_optim.optimize();
 
   //setup backend
@@ -39,7 +43,8 @@ einsum_ir::err_t einsum_ir::backend::UnaryTpp::compile() {
                   l_dtype_comp,
                   l_dtype_out,
                   l_ktype_main,
-                  m_num_threads );
+                  m_num_threads,
+                  ce_executor_to_basic(m_executor) );
 
   l_err = ce_basic_err_to_err(m_backend.compile());
   if( l_err != err_t::SUCCESS ) {
@@ -0,0 +1,278 @@
+#include "MachineProfile.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <utility>
+
+bool einsum_ir::basic::MachineProfile::read_line( std::string const & i_path,
+                                                  std::string       & o_line ) {
+  std::ifstream l_file( i_path );
+  if( !l_file.is_open() ) {
+    return false;
+  }
+  if( !std::getline( l_file, o_line ) ) {
+    return false;
+  }
+  return true;
+}
+
+einsum_ir::basic::MachineProfile const * einsum_ir::basic::MachineProfile::get_instance() {
+  // never destroyed: the profile is used until the process exits
+  static MachineProfile * l_profile = [](){
+    MachineProfile * l_new_profile = new MachineProfile;
+    l_new_profile->detect();
+
+    char const * l_path = std::getenv( "EINSUM_IR_MACHINE_PROFILE" );
+    if( l_path != nullptr ) {
+      l_new_profile->load_override( l_path );
+    }
+    return l_new_profile;
+  }();
+
+  return l_profile;
+}
+
+int64_t einsum_ir::basic::MachineProfile::parse_size( std::string const & i_size ) {
+  std::istringstream l_stream( i_size );
+  int64_t l_size = 0;
+  l_stream >> l_size;
+  if( l_stream.fail() || l_size < 0 ) {
+    return -1;
+  }
+
+  std::string l_suffix;
+  l_stream >> l_suffix;
+  if(      l_suffix == ""  || l_suffix == "B" ) return l_size;
+  else if( l_suffix == "K" || l_suffix == "KB" ) return l_size * 1024;
+  else if( l_suffix == "M" || l_suffix == "MB" ) return l_size * 1024 * 1024;
+  else if( l_suffix == "G" || l_suffix == "GB" ) return l_size * 1024 * 1024 * 1024;
+  else                                           return -1;
+}
+
+bool einsum_ir::basic::MachineProfile::parse_cpu_list( std::string            const & i_list,
+                                                       std::vector< int64_t >       & o_cpus ) {
+  o_cpus.clear();
+
+  std::istringstream l_stream( i_list );
+  std::string l_range;
+  while( std::getline( l_stream, l_range, ',' ) ) {
+    if( l_range.empty() ) {
+      continue;
+    }
+    std::size_t l_pos_dash = l_range.find( '-' );
+    char * l_end = nullptr;
+    int64_t l_first = std::strtoll( l_range.c_str(), &l_end, 10 );
+    if( l_end == l_range.c_str() ) {
+      return false;
+    }
+    int64_t l_last = l_first;
+    if( l_pos_dash != std::string::npos ) {
+      char const * l_begin_last = l_range.c_str() + l_pos_dash + 1;
+      l_last = std::strtoll( l_begin_last, &l_end, 10 );
+      if( l_end == l_begin_last ) {
+        return false;
+      }
+    }
+    if( l_first < 0 || l_last < l_first ) {
+      return false;
+    }
+    for( int64_t l_cpu = l_first; l_cpu <= l_last; l_cpu++ ) {
+      o_cpus.push_back( l_cpu );
+    }
+  }
+
+  return !o_cpus.empty();
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::MachineProfile::detect( std::string const & i_path_sys ) {
+  std::string l_line;
+  std::vector< int64_t > l_cpus;
+
+  // online cpus
+  if(    !read_line( i_path_sys + "/online", l_line )
+      || !parse_cpu_list( l_line, l_cpus ) ) {
+    l_cpus = { 0 };
+  }
+
+  // topology: cores are identified by their package and core ids
+  std::set< std::pair< int64_t, int64_t > > l_cores;
+  std::set< int64_t > l_sockets;
+  for( std::size_t l_cp = 0; l_cp < l_cpus.size(); l_cp++ ) {
+    std::string l_path_topo = i_path_sys + "/cpu" + std::to_string( l_cpus[l_cp] ) + "/topology/";
+    std::string l_package;
+    std::string l_core;
+    if(    read_line( l_path_topo + "physical_package_id", l_package )
+        && read_line( l_path_topo + "core_id",             l_core ) ) {
+      int64_t l_package_id = std::strtoll( l_package.c_str(), nullptr, 10 );
+      int64_t l_core_id    = std::strtoll( l_core.c_str(),    nullptr, 10 );
+      l_cores.insert( std::make_pair( l_package_id, l_core_id ) );
+      l_sockets.insert( l_package_id );
+    }
+  }
+  m_num_cpus = l_cpus.size();
+  if( !l_cores.empty() ) {
+    m_num_cores   = l_cores.size();
+    m_num_sockets = l_sockets.size();
+  }
+  else {
+    m_num_cores   = m_num_cpus;
+    m_num_sockets = 1;
+  }
+
+  // caches of the first online cpu
+  bool l_found_cache = false;
+  std::string l_path_cache = i_path_sys + "/cpu" + std::to_string( l_cpus[0] ) + "/cache/index";
+  for( int64_t l_id = 0; l_id < 16; l_id++ ) {
+    std::string l_path_index = l_path_cache + std::to_string( l_id ) + "/";
+
+    std::string l_level;
+    std::string l_type;
+    std::string l_size;
+    if(    !read_line( l_path_index + "level", l_level )
+        || !read_line( l_path_index + "type",  l_type  )
+        || !read_line( l_path_index + "size",  l_size  ) ) {
+      break;
+    }
+    if( l_type == "Instruction" ) {
+      continue;
+    }
+
+    int64_t l_size_bytes = parse_size( l_size );
+    if( l_size_bytes <= 0 ) {
+      continue;
+    }
+
+    int64_t l_num_cpus_shared = 1;
+    std::string l_shared;
+    std::vector< int64_t > l_cpus_shared;
+    if(    read_line( l_path_index + "shared_cpu_list", l_shared )
+        && parse_cpu_list( l_shared, l_cpus_shared ) ) {
+      l_num_cpus_shared = l_cpus_shared.size();
+    }
+
+    std::string l_line_size;
+    if( read_line( l_path_index + "coherency_line_size", l_line_size ) ) {
+      int64_t l_size_line = std::strtoll( l_line_size.c_str(), nullptr, 10 );
+      if( l_size_line > 0 ) {
+        m_size_line = l_size_line;
+      }
+    }
+
+    int64_t l_level_id = std::strtoll( l_level.c_str(), nullptr, 10 );
+    if( l_level_id == 1 ) {
+      m_size_l1d     = l_size_bytes;
+      m_num_cpus_l1d = l_num_cpus_shared;
+    }
+    else if( l_level_id == 2 ) {
+      m_size_l2     = l_size_bytes;
+      m_num_cpus_l2 = l_num_cpus_shared;
+    }
+    else if( l_level_id == 3 ) {
+      m_size_l3     = l_size_bytes;
+      m_num_cpus_l3 = l_num_cpus_shared;
+    }
+    l_found_cache = true;
+  }
+
+  if( !l_found_cache ) {
+    return err_t::IO_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::MachineProfile::load_override( std::string const & i_path ) {
+  std::ifstream l_file( i_path );
+  if( !l_file.is_open() ) {
+    return err_t::IO_FAILED;
+  }
+
+  std::string l_line;
+  while( std::getline( l_file, l_line ) ) {
+    std::istringstream l_entry( l_line );
+    std::string l_key;
+    std::string l_value;
+    l_entry >> l_key;
+    if( l_key.empty() || l_key[0] == '#' ) {
+      continue;
+    }
+    std::getline( l_entry >> std::ws, l_value );
+
+    int64_t l_num = parse_size( l_value );
+    if( l_num < 0 ) {
+      return err_t::IO_FAILED;
+    }
+
+    if(      l_key == "l1d_size"     ) m_size_l1d     = l_num;
+    else if( l_key == "l2_size"      ) m_size_l2      = l_num;
+    else if( l_key == "l3_size"      ) m_size_l3      = l_num;
+    else if( l_key == "l1d_num_cpus" ) m_num_cpus_l1d = std::max( l_num, int64_t(1) );
+    else if( l_key == "l2_num_cpus"  ) m_num_cpus_l2  = std::max( l_num, int64_t(1) );
+    else if( l_key == "l3_num_cpus"  ) m_num_cpus_l3  = std::max( l_num, int64_t(1) );
+    else if( l_key == "line_size"    ) m_size_line    = l_num;
+    else if( l_key == "num_cpus"     ) m_num_cpus     = std::max( l_num, int64_t(1) );
+    else if( l_key == "num_cores"    ) m_num_cores    = std::max( l_num, int64_t(1) );
+    else if( l_key == "num_sockets"  ) m_num_sockets  = std::max( l_num, int64_t(1) );
+    else return err_t::IO_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l1d() const {
+  return m_size_l1d;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l2() const {
+  return m_size_l2;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l3() const {
+  return m_size_l3;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l1d_cpu() const {
+  return m_size_l1d / m_num_cpus_l1d;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l2_cpu() const {
+  return m_size_l2 / m_num_cpus_l2;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_l3_cpu() const {
+  return m_size_l3 / m_num_cpus_l3;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_cpus_l1d() const {
+  return m_num_cpus_l1d;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_cpus_l2() const {
+  return m_num_cpus_l2;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_cpus_l3() const {
+  return m_num_cpus_l3;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_size_line() const {
+  return m_size_line;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_cpus() const {
+  return m_num_cpus;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_cores() const {
+  return m_num_cores;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_sockets() const {
+  return m_num_sockets;
+}
+
+int64_t einsum_ir::basic::MachineProfile::get_num_smt() const {
+  return std::max( m_num_cpus / m_num_cores, int64_t(1) );
+}
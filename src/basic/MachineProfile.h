@@ -0,0 +1,210 @@
+#ifndef EINSUM_IR_BASIC_MACHINE_PROFILE
+#define EINSUM_IR_BASIC_MACHINE_PROFILE
+
+#include <string>
+#include <vector>
+
+#include "constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class MachineProfile;
+  }
+}
+
+/**
+ * Cache hierarchy and CPU topology of the machine.
+ * The profile is detected from sysfs (/sys/devices/system/cpu) and may be overwritten by an override file.
+ *
+ * The override file has one entry per line, lines starting with # are ignored:
+ *   key value
+ * Supported keys are l1d_size, l2_size, l3_size, l1d_num_cpus, l2_num_cpus, l3_num_cpus, line_size,
+ * num_cpus, num_cores and num_sockets. Sizes accept the suffixes K, M and G.
+ **/
+class einsum_ir::basic::MachineProfile {
+  private:
+    //! size of the L1 data cache in bytes
+    int64_t m_size_l1d = 32 * 1024;
+
+    //! size of the L2 cache in bytes
+    int64_t m_size_l2 = 1024 * 1024;
+
+    //! size of the L3 cache in bytes, 0 if unknown or not present
+    int64_t m_size_l3 = 0;
+
+    //! number of logical cpus sharing an L1 data cache
+    int64_t m_num_cpus_l1d = 1;
+
+    //! number of logical cpus sharing an L2 cache
+    int64_t m_num_cpus_l2 = 1;
+
+    //! number of logical cpus sharing an L3 cache
+    int64_t m_num_cpus_l3 = 1;
+
+    //! size of a cache line in bytes
+    int64_t m_size_line = 64;
+
+    //! number of logical cpus
+    int64_t m_num_cpus = 1;
+
+    //! number of physical cores
+    int64_t m_num_cores = 1;
+
+    //! number of sockets
+    int64_t m_num_sockets = 1;
+
+    /**
+     * Reads the first line of a file.
+     *
+     * @param i_path path of the file.
+     * @param o_line first line of the file.
+     * @return true if the line was read, false otherwise.
+     **/
+    static bool read_line( std::string const & i_path,
+                           std::string       & o_line );
+
+  public:
+    /**
+     * Gets the process-wide machine profile.
+     * The profile is detected on first use.
+     * If the environment variable EINSUM_IR_MACHINE_PROFILE is set, the given override file is applied afterwards.
+     *
+     * @return process-wide machine profile.
+     **/
+    static MachineProfile const * get_instance();
+
+    /**
+     * Parses a size with an optional suffix K, M or G, e.g., 48K.
+     *
+     * @param i_size size as string.
+     * @return size in bytes, -1 if the string is invalid.
+     **/
+    static int64_t parse_size( std::string const & i_size );
+
+    /**
+     * Parses a cpu list, e.g., 0-3,8-11.
+     *
+     * @param i_list cpu list as string.
+     * @param o_cpus ids of the cpus.
+     * @return true if the list is valid, false otherwise.
+     **/
+    static bool parse_cpu_list( std::string            const & i_list,
+                                std::vector< int64_t >       & o_cpus );
+
+    /**
+     * Detects the cache hierarchy and the topology from sysfs.
+     * Values which cannot be detected keep their defaults.
+     *
+     * @param i_path_sys path of the cpu directory in sysfs.
+     * @return SUCCESS if the caches of the first cpu were found, otherwise an appropiate error code.
+     **/
+    err_t detect( std::string const & i_path_sys = "/sys/devices/system/cpu" );
+
+    /**
+     * Applies an override file.
+     *
+     * @param i_path path of the override file.
+     * @return SUCCESS if the file was applied, otherwise an appropiate error code.
+     **/
+    err_t load_override( std::string const & i_path );
+
+    /**
+     * Gets the size of the L1 data cache.
+     *
+     * @return size in bytes.
+     **/
+    int64_t get_size_l1d() const;
+
+    /**
+     * Gets the size of the L2 cache.
+     *
+     * @return size in bytes.
+     **/
+    int64_t get_size_l2() const;
+
+    /**
+     * Gets the size of the L3 cache.
+     *
+     * @return size in bytes, 0 if unknown.
+     **/
+    int64_t get_size_l3() const;
+
+    /**
+     * Gets the share of a logical cpu of the L1 data cache.
+     *
+     * @return size in bytes.
+     **/
+    int64_t get_size_l1d_cpu() const;
+
+    /**
+     * Gets the share of a logical cpu of the L2 cache.
+     *
+     * @return size in bytes.
+     **/
+    int64_t get_size_l2_cpu() const;
+
+    /**
+     * Gets the share of a logical cpu of the L3 cache.
+     *
+     * @return size in bytes, 0 if unknown.
+     **/
+    int64_t get_size_l3_cpu() const;
+
+    /**
+     * Gets the number of logical cpus sharing an L1 data cache.
+     *
+     * @return number of logical cpus.
+     **/
+    int64_t get_num_cpus_l1d() const;
+
+    /**
+     * Gets the number of logical cpus sharing an L2 cache.
+     *
+     * @return number of logical cpus.
+     **/
+    int64_t get_num_cpus_l2() const;
+
+    /**
+     * Gets the number of logical cpus sharing an L3 cache.
+     *
+     * @return number of logical cpus.
+     **/
+    int64_t get_num_cpus_l3() const;
+
+    /**
+     * Gets the size of a cache line.
+     *
+     * @return size in bytes.
+     **/
+    int64_t get_size_line() const;
+
+    /**
+     * Gets the number of logical cpus.
+     *
+     * @return number of logical cpus.
+     **/
+    int64_t get_num_cpus() const;
+
+    /**
+     * Gets the number of physical cores.
+     *
+     * @return number of cores.
+     **/
+    int64_t get_num_cores() const;
+
+    /**
+     * Gets the number of sockets.
+     *
+     * @return number of sockets.
+     **/
+    int64_t get_num_sockets() const;
+
+    /**
+     * Gets the number of hardware threads per core.
+     *
+     * @return number of hardware threads.
+     **/
+    int64_t get_num_smt() const;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "catch.hpp"
+#include "MachineProfile.h"
+#include <cstdio>
+#include <fstream>
+#include <sys/stat.h>
+
+/**
+ * Writes a file of the test's sysfs tree, missing directories are created.
+ *
+ * @param i_root root of the tree.
+ * @param i_path path relative to the root.
+ * @param i_content content of the file.
+ * @param io_created created files and directories.
+ **/
+static void write_sys_file( std::string                const & i_root,
+                            std::string                const & i_path,
+                            std::string                const & i_content,
+                            std::vector< std::string >       & io_created ) {
+  std::string l_dir = i_root;
+  if( mkdir( l_dir.c_str(), 0755 ) == 0 ) {
+    io_created.push_back( l_dir );
+  }
+  std::size_t l_pos = 0;
+  while( ( l_pos = i_path.find( '/', l_pos ) ) != std::string::npos ) {
+    l_dir = i_root + "/" + i_path.substr( 0, l_pos );
+    if( mkdir( l_dir.c_str(), 0755 ) == 0 ) {
+      io_created.push_back( l_dir );
+    }
+    l_pos++;
+  }
+
+  std::ofstream l_file( i_root + "/" + i_path );
+  l_file << i_content << std::endl;
+  io_created.push_back( i_root + "/" + i_path );
+}
+
+TEST_CASE( "Parses sizes and cpu lists of sysfs.", "[machine_profile]" ) {
+  using namespace einsum_ir::basic;
+
+  REQUIRE( MachineProfile::parse_size( "48K"   ) == 48 * 1024 );
+  REQUIRE( MachineProfile::parse_size( "2048K" ) == 2048 * 1024 );
+  REQUIRE( MachineProfile::parse_size( "32M"   ) == 32 * 1024 * 1024 );
+  REQUIRE( MachineProfile::parse_size( "64"    ) == 64 );
+  REQUIRE( MachineProfile::parse_size( "abc"   ) == -1 );
+  REQUIRE( MachineProfile::parse_size( "12X"   ) == -1 );
+
+  std::vector< int64_t > l_cpus;
+  REQUIRE( MachineProfile::parse_cpu_list( "0-3,8-9,12", l_cpus ) );
+  REQUIRE( l_cpus == std::vector< int64_t >{ 0, 1, 2, 3, 8, 9, 12 } );
+
+  REQUIRE( MachineProfile::parse_cpu_list( "5", l_cpus ) );
+  REQUIRE( l_cpus == std::vector< int64_t >{ 5 } );
+
+  REQUIRE( !MachineProfile::parse_cpu_list( "", l_cpus ) );
+  REQUIRE( !MachineProfile::parse_cpu_list( "3-1", l_cpus ) );
+}
+
+TEST_CASE( "Detects the cache hierarchy and topology of a sysfs tree.", "[machine_profile]" ) {
+  using namespace einsum_ir::basic;
+
+  // two sockets, two cores per socket, two hardware threads per core
+  std::string l_root = "einsum_ir_sys.test";
+  std::vector< std::string > l_created;
+  write_sys_file( l_root, "online", "0-7", l_created );
+  for( int64_t l_cpu = 0; l_cpu < 8; l_cpu++ ) {
+    std::string l_topo = "cpu" + std::to_string( l_cpu ) + "/topology/";
+    write_sys_file( l_root, l_topo + "physical_package_id", std::to_string( l_cpu / 4 ), l_created );
+    write_sys_file( l_root, l_topo + "core_id",             std::to_string( l_cpu % 2 ), l_created );
+  }
+
+  std::string l_cache = "cpu0/cache/index";
+  write_sys_file( l_root, l_cache + "0/level",               "1", l_created );
+  write_sys_file( l_root, l_cache + "0/type",                "Data", l_created );
+  write_sys_file( l_root, l_cache + "0/size",                "48K", l_created );
+  write_sys_file( l_root, l_cache + "0/shared_cpu_list",     "0,2", l_created );
+  write_sys_file( l_root, l_cache + "0/coherency_line_size", "64", l_created );
+  write_sys_file( l_root, l_cache + "1/level",               "1", l_created );
+  write_sys_file( l_root, l_cache + "1/type",                "Instruction", l_created );
+  write_sys_file( l_root, l_cache + "1/size",                "32K", l_created );
+  write_sys_file( l_root, l_cache + "1/shared_cpu_list",     "0,2", l_created );
+  write_sys_file( l_root, l_cache + "2/level",               "2", l_created );
+  write_sys_file( l_root, l_cache + "2/type",                "Unified", l_created );
+  write_sys_file( l_root, l_cache + "2/size",                "2048K", l_created );
+  write_sys_file( l_root, l_cache + "2/shared_cpu_list",     "0,2", l_created );
+  write_sys_file( l_root, l_cache + "3/level",               "3", l_created );
+  write_sys_file( l_root, l_cache + "3/type",                "Unified", l_created );
+  write_sys_file( l_root, l_cache + "3/size",                "32M", l_created );
+  write_sys_file( l_root, l_cache + "3/shared_cpu_list",     "0-3", l_created );
+
+  MachineProfile l_profile;
+  REQUIRE( l_profile.detect( l_root ) == err_t::SUCCESS );
+
+  REQUIRE( l_profile.get_num_cpus()    == 8 );
+  REQUIRE( l_profile.get_num_cores()   == 4 );
+  REQUIRE( l_profile.get_num_sockets() == 2 );
+  REQUIRE( l_profile.get_num_smt()     == 2 );
+
+  REQUIRE( l_profile.get_size_l1d() == 48 * 1024 );
+  REQUIRE( l_profile.get_size_l2()  == 2048 * 1024 );
+  REQUIRE( l_profile.get_size_l3()  == 32 * 1024 * 1024 );
+  REQUIRE( l_profile.get_num_cpus_l1d() == 2 );
+  REQUIRE( l_profile.get_num_cpus_l2()  == 2 );
+  REQUIRE( l_profile.get_num_cpus_l3()  == 4 );
+  REQUIRE( l_profile.get_size_l2_cpu()  == 1024 * 1024 );
+  REQUIRE( l_profile.get_size_l3_cpu()  == 8 * 1024 * 1024 );
+  REQUIRE( l_profile.get_size_line()    == 64 );
+
+  // override file
+  std::string l_path_override = "einsum_ir_machine_profile.test.txt";
+  std::ofstream l_file( l_path_override );
+  l_file << "# EPYC-like L3" << std::endl;
+  l_file << "l3_size 16M" << std::endl;
+  l_file << "l3_num_cpus 8" << std::endl;
+  l_file.close();
+
+  REQUIRE( l_profile.load_override( l_path_override ) == err_t::SUCCESS );
+  REQUIRE( l_profile.get_size_l3()     == 16 * 1024 * 1024 );
+  REQUIRE( l_profile.get_size_l3_cpu() == 2 * 1024 * 1024 );
+  REQUIRE( l_profile.get_size_l2()     == 2048 * 1024 );
+
+  l_file.open( l_path_override );
+  l_file << "l4_size 1G" << std::endl;
+  l_file.close();
+  REQUIRE( l_profile.load_override( l_path_override ) == err_t::IO_FAILED );
+
+  std::remove( l_path_override.c_str() );
+  for( std::size_t l_pa = l_created.size(); l_pa > 0; l_pa-- ) {
+    std::remove( l_created[l_pa-1].c_str() );
+  }
+}
+
+TEST_CASE( "Falls back to defaults without sysfs.", "[machine_profile]" ) {
+  using namespace einsum_ir::basic;
+
+  MachineProfile l_profile;
+  REQUIRE( l_profile.detect( "einsum_ir_sys_missing.test" ) == err_t::IO_FAILED );
+  REQUIRE( l_profile.get_num_cpus()    == 1 );
+  REQUIRE( l_profile.get_size_l1d()    >  0 );
+  REQUIRE( l_profile.get_size_l2_cpu() >  0 );
+  REQUIRE( l_profile.get_size_l3()     == 0 );
+
+  MachineProfile const * l_instance = MachineProfile::get_instance();
+  REQUIRE( l_instance->get_size_l1d_cpu() > 0 );
+  REQUIRE( l_instance->get_size_l2_cpu()  > 0 );
+  REQUIRE( l_instance->get_num_cpus()     > 0 );
+}
@@ -0,0 +1,234 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EINSUM_IR_BASIC_THREAD_POOL_RELAX() _mm_pause()
+#elif defined(__aarch64__)
+#define EINSUM_IR_BASIC_THREAD_POOL_RELAX() __asm__ __volatile__("yield")
+#else
+#define EINSUM_IR_BASIC_THREAD_POOL_RELAX() std::this_thread::yield()
+#endif
+
+//! id of the deque owned by the calling thread, -1 for threads outside of the pool
+static thread_local int64_t g_queue_id = -1;
+
+einsum_ir::basic::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex_sleep );
+    m_shutdown.store( true );
+  }
+  m_cv_sleep.notify_all();
+
+  for( std::size_t l_wo = 0; l_wo < m_workers.size(); l_wo++ ) {
+    m_workers[l_wo].join();
+  }
+}
+
+void einsum_ir::basic::ThreadPool::init( int64_t i_num_workers,
+                                         bool    i_pin ) {
+  // deques of the workers and the shared deque of external threads
+  m_queues.resize( i_num_workers + 1 );
+  for( std::size_t l_qu = 0; l_qu < m_queues.size(); l_qu++ ) {
+    m_queues[l_qu] = std::make_unique< queue_t >();
+  }
+
+  m_workers.reserve( i_num_workers );
+  for( int64_t l_wo = 0; l_wo < i_num_workers; l_wo++ ) {
+    m_workers.emplace_back( &ThreadPool::work,
+                            this,
+                            l_wo,
+                            i_pin );
+  }
+}
+
+einsum_ir::basic::ThreadPool * einsum_ir::basic::ThreadPool::get_instance() {
+  // never destroyed: workers stay alive until the process exits
+  static ThreadPool * l_pool = [](){
+#ifdef _OPENMP
+    int64_t l_num_threads = omp_get_max_threads();
+#else
+    int64_t l_num_threads = std::thread::hardware_concurrency();
+#endif
+    ThreadPool * l_new_pool = new ThreadPool;
+    l_new_pool->init( std::max( l_num_threads - 1, int64_t(0) ),
+                      true );
+    return l_new_pool;
+  }();
+
+  return l_pool;
+}
+
+int64_t einsum_ir::basic::ThreadPool::get_num_workers() const {
+  return m_workers.size();
+}
+
+void einsum_ir::basic::ThreadPool::pin_thread( int64_t i_core_id ) {
+#ifdef __linux__
+  cpu_set_t l_mask_process;
+  CPU_ZERO( &l_mask_process );
+  if( sched_getaffinity( 0, sizeof(cpu_set_t), &l_mask_process ) != 0 ) {
+    return;
+  }
+
+  // select the i_core_id-th core of the process' affinity mask
+  int64_t l_num_cores = CPU_COUNT( &l_mask_process );
+  if( l_num_cores == 0 ) {
+    return;
+  }
+  int64_t l_target = i_core_id % l_num_cores;
+  for( int64_t l_co = 0; l_co < CPU_SETSIZE; l_co++ ) {
+    if( CPU_ISSET( l_co, &l_mask_process ) ) {
+      if( l_target == 0 ) {
+        cpu_set_t l_mask_thread;
+        CPU_ZERO( &l_mask_thread );
+        CPU_SET( l_co, &l_mask_thread );
+        pthread_setaffinity_np( pthread_self(),
+                                sizeof(cpu_set_t),
+                                &l_mask_thread );
+        return;
+      }
+      l_target--;
+    }
+  }
+#else
+  (void) i_core_id;
+#endif
+}
+
+void einsum_ir::basic::ThreadPool::work( int64_t i_worker_id,
+                                         bool    i_pin ) {
+  g_queue_id = i_worker_id;
+
+  // the submitting thread is expected to run on the first core
+  if( i_pin ) {
+    pin_thread( i_worker_id + 1 );
+  }
+
+  int64_t l_idle = 0;
+  task_t l_task;
+  while( !m_shutdown.load( std::memory_order_relaxed ) ) {
+    if( try_get( i_worker_id, l_task ) ) {
+      run( l_task );
+      l_idle = 0;
+    }
+    else if( l_idle < m_num_spins ) {
+      EINSUM_IR_BASIC_THREAD_POOL_RELAX();
+      l_idle++;
+    }
+    else {
+      std::unique_lock< std::mutex > l_lock( m_mutex_sleep );
+      m_num_sleeping++;
+      m_cv_sleep.wait( l_lock, [this](){ return m_shutdown.load() || m_num_queued.load() > 0; } );
+      m_num_sleeping--;
+      l_idle = 0;
+    }
+  }
+}
+
+bool einsum_ir::basic::ThreadPool::try_get( int64_t   i_queue_id,
+                                            task_t  & o_task ) {
+  if( m_num_queued.load( std::memory_order_acquire ) == 0 ) {
+    return false;
+  }
+
+  int64_t l_num_queues = m_queues.size();
+
+  // own deque: LIFO
+  {
+    queue_t & l_queue = *m_queues[i_queue_id];
+    std::lock_guard< std::mutex > l_lock( l_queue.mutex );
+    if( !l_queue.tasks.empty() ) {
+      o_task = l_queue.tasks.back();
+      l_queue.tasks.pop_back();
+      m_num_queued--;
+      return true;
+    }
+  }
+
+  // steal from the other deques: FIFO
+  for( int64_t l_qu = 1; l_qu < l_num_queues; l_qu++ ) {
+    queue_t & l_queue = *m_queues[ (i_queue_id + l_qu) % l_num_queues ];
+    std::unique_lock< std::mutex > l_lock( l_queue.mutex, std::try_to_lock );
+    if( l_lock.owns_lock() && !l_queue.tasks.empty() ) {
+      o_task = l_queue.tasks.front();
+      l_queue.tasks.pop_front();
+      m_num_queued--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void einsum_ir::basic::ThreadPool::run( task_t const & i_task ) {
+  i_task.invoke( i_task.func,
+                 i_task.id );
+  i_task.remaining->fetch_sub( 1,
+                               std::memory_order_release );
+}
+
+void einsum_ir::basic::ThreadPool::submit( int64_t         i_num_tasks,
+                                           void    const * i_func,
+                                           void         (* i_invoke)( void const *, int64_t ) ) {
+  // execute sequentially if there is nothing to share
+  if( i_num_tasks <= 1 || m_workers.size() == 0 ) {
+    for( int64_t l_ta = 0; l_ta < i_num_tasks; l_ta++ ) {
+      i_invoke( i_func, l_ta );
+    }
+    return;
+  }
+
+  // external threads use the shared deque
+  int64_t l_queue_id = g_queue_id;
+  if( l_queue_id < 0 ) {
+    l_queue_id = m_queues.size() - 1;
+  }
+
+  std::atomic< int64_t > l_remaining( i_num_tasks - 1 );
+
+  // distribute tasks 1, ..., i_num_tasks-1 round-robin over the deques
+  int64_t l_num_queues = m_queues.size();
+  int64_t l_first_queue = m_next_queue.fetch_add( 1, std::memory_order_relaxed );
+  m_num_queued += i_num_tasks - 1;
+  for( int64_t l_ta = 1; l_ta < i_num_tasks; l_ta++ ) {
+    task_t l_task;
+    l_task.func      = i_func;
+    l_task.invoke    = i_invoke;
+    l_task.id        = l_ta;
+    l_task.remaining = &l_remaining;
+
+    queue_t & l_queue = *m_queues[ (l_first_queue + l_ta) % l_num_queues ];
+    std::lock_guard< std::mutex > l_lock( l_queue.mutex );
+    l_queue.tasks.push_back( l_task );
+  }
+
+  // wake up sleeping workers
+  if( m_num_sleeping.load() > 0 ) {
+    std::lock_guard< std::mutex > l_lock( m_mutex_sleep );
+    m_cv_sleep.notify_all();
+  }
+
+  // first task is executed by the submitting thread
+  i_invoke( i_func, 0 );
+
+  // help until all tasks of this submission are done
+  task_t l_task;
+  while( l_remaining.load( std::memory_order_acquire ) > 0 ) {
+    if( try_get( l_queue_id, l_task ) ) {
+      run( l_task );
+    }
+    else {
+      EINSUM_IR_BASIC_THREAD_POOL_RELAX();
+    }
+  }
+}
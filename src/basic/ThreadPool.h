@@ -0,0 +1,176 @@
+#ifndef EINSUM_IR_BASIC_THREAD_POOL
+#define EINSUM_IR_BASIC_THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ThreadPool;
+  }
+}
+
+/**
+ * Persistent team of worker threads which is used as executor of the backends.
+ * Every worker owns a deque of tasks:
+ * the owner takes tasks from the back, idle workers steal from the front of other deques.
+ * The submitting thread participates in the execution of its tasks.
+ **/
+class einsum_ir::basic::ThreadPool {
+  private:
+    //! task submitted to the pool
+    struct task_t {
+      //! type-erased callable
+      void const * func = nullptr;
+      //! trampoline which invokes the callable with the task id
+      void (* invoke)( void const *, int64_t ) = nullptr;
+      //! id of the task
+      int64_t id = 0;
+      //! counter of unfinished tasks of the submission
+      std::atomic< int64_t > * remaining = nullptr;
+    };
+
+    //! deque of a worker, aligned to avoid false sharing
+    struct alignas(128) queue_t {
+      std::mutex mutex;
+      std::deque< task_t > tasks;
+    };
+
+    //! worker threads
+    std::vector< std::thread > m_workers;
+
+    //! one deque per worker and one shared deque for external threads (last entry)
+    std::vector< std::unique_ptr< queue_t > > m_queues;
+
+    //! number of queued tasks in all deques
+    std::atomic< int64_t > m_num_queued{ 0 };
+
+    //! number of workers sleeping on the condition variable
+    std::atomic< int64_t > m_num_sleeping{ 0 };
+
+    //! true if the workers should exit
+    std::atomic< bool > m_shutdown{ false };
+
+    //! mutex for sleeping workers
+    std::mutex m_mutex_sleep;
+
+    //! condition variable for sleeping workers
+    std::condition_variable m_cv_sleep;
+
+    //! number of polling iterations before an idle worker goes to sleep
+    int64_t m_num_spins = 1 << 16;
+
+    //! round-robin counter of external submissions
+    std::atomic< int64_t > m_next_queue{ 0 };
+
+    /**
+     * Invokes a callable of type T.
+     *
+     * @param i_func pointer to the callable.
+     * @param i_id id of the task.
+     **/
+    template< typename T >
+    static void invoke( void const * i_func,
+                        int64_t      i_id ) {
+      (*static_cast< T const * >( i_func ))( i_id );
+    }
+
+    /**
+     * Pins the calling thread to the given logical core.
+     *
+     * @param i_core_id id of the core in the affinity mask of the process.
+     **/
+    static void pin_thread( int64_t i_core_id );
+
+    /**
+     * Main loop of a worker.
+     *
+     * @param i_worker_id id of the worker.
+     * @param i_pin true if the worker pins itself to a core.
+     **/
+    void work( int64_t i_worker_id,
+               bool    i_pin );
+
+    /**
+     * Tries to obtain a task, first from the own deque, then by stealing.
+     *
+     * @param i_queue_id id of the own deque.
+     * @param o_task will be set to the task if successful.
+     * @return true if a task was obtained, false otherwise.
+     **/
+    bool try_get( int64_t   i_queue_id,
+                  task_t  & o_task );
+
+    /**
+     * Executes a task and signals its completion.
+     *
+     * @param i_task task which is executed.
+     **/
+    static void run( task_t const & i_task );
+
+    /**
+     * Submits tasks [0, i_num_tasks) and executes task 0 on the calling thread.
+     * Returns once all tasks finished.
+     *
+     * @param i_num_tasks number of tasks.
+     * @param i_func type-erased callable.
+     * @param i_invoke trampoline which invokes the callable.
+     **/
+    void submit( int64_t         i_num_tasks,
+                 void    const * i_func,
+                 void         (* i_invoke)( void const *, int64_t ) );
+
+  public:
+    /**
+     * Destructor which joins all workers.
+     **/
+    ~ThreadPool();
+
+    /**
+     * Starts the workers of the pool.
+     * The calling thread acts as an additional worker during submissions.
+     *
+     * @param i_num_workers number of worker threads.
+     * @param i_pin true if the workers should be pinned to cores.
+     **/
+    void init( int64_t i_num_workers,
+               bool    i_pin );
+
+    /**
+     * Gets the process-wide pool.
+     * The pool is started at the first call with one worker less than the maximum number of threads.
+     *
+     * @return pool.
+     **/
+    static ThreadPool * get_instance();
+
+    /**
+     * Gets the number of worker threads.
+     *
+     * @return number of workers.
+     **/
+    int64_t get_num_workers() const;
+
+    /**
+     * Executes i_func( l_id ) for all l_id in [0, i_num_tasks) and waits for completion.
+     *
+     * @param i_num_tasks number of tasks.
+     * @param i_func callable with signature void( int64_t ).
+     **/
+    template< typename T >
+    void parallel_for( int64_t         i_num_tasks,
+                       T       const & i_func ) {
+      submit( i_num_tasks,
+              &i_func,
+              &invoke< T > );
+    }
+};
+
+#endif
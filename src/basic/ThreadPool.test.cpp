@@ -0,0 +1,66 @@
+#include "catch.hpp"
+#include "ThreadPool.h"
+
+TEST_CASE( "Executes all tasks of a submission exactly once.", "[thread_pool]" ) {
+  using namespace einsum_ir::basic;
+
+  ThreadPool l_pool;
+  l_pool.init( 3,
+               false );
+  REQUIRE( l_pool.get_num_workers() == 3 );
+
+  for( int64_t l_num_tasks = 0; l_num_tasks < 40; l_num_tasks++ ) {
+    std::vector< std::atomic< int64_t > > l_counts( l_num_tasks );
+    for( int64_t l_ta = 0; l_ta < l_num_tasks; l_ta++ ) {
+      l_counts[l_ta] = 0;
+    }
+
+    for( int64_t l_rep = 0; l_rep < 10; l_rep++ ) {
+      l_pool.parallel_for( l_num_tasks,
+                           [&]( int64_t l_id ) {
+                             l_counts[l_id]++;
+                           } );
+    }
+
+    for( int64_t l_ta = 0; l_ta < l_num_tasks; l_ta++ ) {
+      REQUIRE( l_counts[l_ta] == 10 );
+    }
+  }
+}
+
+TEST_CASE( "Nested submissions to the thread pool.", "[thread_pool]" ) {
+  using namespace einsum_ir::basic;
+
+  ThreadPool l_pool;
+  l_pool.init( 2,
+               false );
+
+  std::atomic< int64_t > l_sum( 0 );
+  l_pool.parallel_for( 5,
+                       [&]( int64_t l_id_outer ) {
+                         l_pool.parallel_for( 7,
+                                              [&]( int64_t l_id_inner ) {
+                                                l_sum += l_id_outer * 7 + l_id_inner;
+                                              } );
+                       } );
+
+  // sum of 0, ..., 34
+  REQUIRE( l_sum == 595 );
+}
+
+TEST_CASE( "Process-wide thread pool.", "[thread_pool]" ) {
+  using namespace einsum_ir::basic;
+
+  ThreadPool * l_pool = ThreadPool::get_instance();
+  REQUIRE( l_pool == ThreadPool::get_instance() );
+
+  std::vector< int64_t > l_data( 1000, 0 );
+  l_pool->parallel_for( l_data.size(),
+                        [&]( int64_t l_id ) {
+                          l_data[l_id] = 2 * l_id;
+                        } );
+
+  for( std::size_t l_en = 0; l_en < l_data.size(); l_en++ ) {
+    REQUIRE( l_data[l_en] == 2 * (int64_t) l_en );
+  }
+}
@@ -0,0 +1,408 @@
+#include "ContractionAutotuner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+void einsum_ir::basic::ContractionAutotuner::hash_add( int64_t    i_value,
+                                                       uint64_t & io_hash ) {
+  uint64_t l_value = i_value;
+  for( int64_t l_by = 0; l_by < 8; l_by++ ) {
+    io_hash ^= (l_value >> (8*l_by)) & 0xff;
+    io_hash *= 1099511628211ull;
+  }
+}
+
+einsum_ir::basic::ContractionAutotuner * einsum_ir::basic::ContractionAutotuner::get_instance() {
+  // never destroyed: entries may be added until the process exits
+  static ContractionAutotuner * l_tuner = [](){
+    ContractionAutotuner * l_new_tuner = new ContractionAutotuner;
+    char const * l_path = std::getenv( "EINSUM_IR_TUNING_DB" );
+    if( l_path != nullptr ) {
+      l_new_tuner->load( l_path );
+    }
+    return l_new_tuner;
+  }();
+
+  return l_tuner;
+}
+
+uint64_t einsum_ir::basic::ContractionAutotuner::key( std::vector< iter_property > const & i_iter_space,
+                                                      kernel_t                             i_ktype_first_touch,
+                                                      kernel_t                             i_ktype_main,
+                                                      kernel_t                             i_ktype_last_touch,
+                                                      data_t                               i_dtype_left,
+                                                      data_t                               i_dtype_right,
+                                                      data_t                               i_dtype_comp,
+                                                      data_t                               i_dtype_out,
+                                                      int64_t                              i_num_threads,
+                                                      std::string                  const & i_backend ) {
+  // canonical iteration space: size-1 iterations are removed, the remaining ones are sorted
+  std::vector< std::tuple< int64_t, int64_t, int64_t, int64_t, int64_t, int64_t > > l_iters;
+  for( std::size_t l_it = 0; l_it < i_iter_space.size(); l_it++ ) {
+    iter_property const & l_iter = i_iter_space[l_it];
+    if( l_iter.size == 1 ) {
+      continue;
+    }
+    l_iters.push_back( std::make_tuple( (int64_t) l_iter.dim_type,
+                                        l_iter.size,
+                                        l_iter.stride_left,
+                                        l_iter.stride_right,
+                                        l_iter.stride_out_aux,
+                                        l_iter.stride_out ) );
+  }
+  std::sort( l_iters.begin(),
+             l_iters.end() );
+
+  uint64_t l_hash = 14695981039346656037ull;
+  hash_add( m_db_version, l_hash );
+  hash_add( l_iters.size(), l_hash );
+  for( std::size_t l_it = 0; l_it < l_iters.size(); l_it++ ) {
+    hash_add( std::get<0>( l_iters[l_it] ), l_hash );
+    hash_add( std::get<1>( l_iters[l_it] ), l_hash );
+    hash_add( std::get<2>( l_iters[l_it] ), l_hash );
+    hash_add( std::get<3>( l_iters[l_it] ), l_hash );
+    hash_add( std::get<4>( l_iters[l_it] ), l_hash );
+    hash_add( std::get<5>( l_iters[l_it] ), l_hash );
+  }
+
+  hash_add( i_ktype_first_touch, l_hash );
+  hash_add( i_ktype_main,        l_hash );
+  hash_add( i_ktype_last_touch,  l_hash );
+  hash_add( i_dtype_left,        l_hash );
+  hash_add( i_dtype_right,       l_hash );
+  hash_add( i_dtype_comp,        l_hash );
+  hash_add( i_dtype_out,         l_hash );
+  hash_add( i_num_threads,       l_hash );
+  for( std::size_t l_ch = 0; l_ch < i_backend.size(); l_ch++ ) {
+    hash_add( i_backend[l_ch], l_hash );
+  }
+
+  return l_hash;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionAutotuner::load( std::string const & i_path ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex_db );
+  m_path_db = i_path;
+
+  std::ifstream l_file( i_path );
+  if( !l_file.is_open() ) {
+    return err_t::SUCCESS;
+  }
+
+  std::string l_line;
+  // header
+  if( !std::getline( l_file, l_line ) ) {
+    return err_t::SUCCESS;
+  }
+  std::istringstream l_header( l_line );
+  std::string l_magic;
+  int64_t l_version = 0;
+  l_header >> l_magic >> l_version;
+  if( l_magic != "einsum_ir_tuning_db" || l_version != m_db_version ) {
+    return err_t::IO_FAILED;
+  }
+
+  // entries
+  std::map< uint64_t, tuning_config > l_db;
+  while( std::getline( l_file, l_line ) ) {
+    if( l_line.empty() ) {
+      continue;
+    }
+    std::istringstream l_entry( l_line );
+    uint64_t l_key = 0;
+    tuning_config l_config;
+    l_entry >> std::hex >> l_key >> std::dec
+            >> l_config.target_m
+            >> l_config.target_n
+            >> l_config.target_k
+            >> l_config.target_extra_packing
+            >> l_config.generate_sfcs
+            >> l_config.packing
+            >> l_config.num_threads_shared
+            >> l_config.num_threads_sfc_m
+            >> l_config.num_threads_sfc_n
+            >> l_config.time;
+    if( l_entry.fail() ) {
+      return err_t::IO_FAILED;
+    }
+    l_db[l_key] = l_config;
+  }
+
+  // entries of the file take precedence over in-memory entries
+  for( std::map< uint64_t, tuning_config >::iterator l_en = l_db.begin(); l_en != l_db.end(); l_en++ ) {
+    m_db[l_en->first] = l_en->second;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionAutotuner::store() {
+  std::lock_guard< std::mutex > l_lock( m_mutex_db );
+  if( m_path_db.empty() ) {
+    return err_t::SUCCESS;
+  }
+
+  // write to a temporary file which replaces the database
+  std::string l_path_tmp = m_path_db + ".tmp";
+  std::ofstream l_file( l_path_tmp );
+  if( !l_file.is_open() ) {
+    return err_t::IO_FAILED;
+  }
+
+  l_file << "einsum_ir_tuning_db " << m_db_version << "\n";
+  l_file.precision( 17 );
+  for( std::map< uint64_t, tuning_config >::iterator l_en = m_db.begin(); l_en != m_db.end(); l_en++ ) {
+    tuning_config const & l_config = l_en->second;
+    l_file << std::hex << l_en->first << std::dec
+           << " " << l_config.target_m
+           << " " << l_config.target_n
+           << " " << l_config.target_k
+           << " " << l_config.target_extra_packing
+           << " " << l_config.generate_sfcs
+           << " " << l_config.packing
+           << " " << l_config.num_threads_shared
+           << " " << l_config.num_threads_sfc_m
+           << " " << l_config.num_threads_sfc_n
+           << " " << l_config.time << "\n";
+  }
+  l_file.close();
+  if( l_file.fail() ) {
+    return err_t::IO_FAILED;
+  }
+
+  if( std::rename( l_path_tmp.c_str(), m_path_db.c_str() ) != 0 ) {
+    return err_t::IO_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+bool einsum_ir::basic::ContractionAutotuner::lookup( uint64_t        i_key,
+                                                     tuning_config & o_config ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex_db );
+  std::map< uint64_t, tuning_config >::iterator l_en = m_db.find( i_key );
+  if( l_en == m_db.end() ) {
+    return false;
+  }
+  o_config = l_en->second;
+  return true;
+}
+
+void einsum_ir::basic::ContractionAutotuner::insert( uint64_t              i_key,
+                                                     tuning_config const & i_config ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex_db );
+  m_db[i_key] = i_config;
+}
+
+void einsum_ir::basic::ContractionAutotuner::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex_db );
+  m_db.clear();
+}
+
+void einsum_ir::basic::ContractionAutotuner::set_min_time_bench( double i_min_time ) {
+  m_min_time_bench = i_min_time;
+}
+
+bool einsum_ir::basic::ContractionAutotuner::equal( tuning_config const & i_config_0,
+                                                    tuning_config const & i_config_1 ) {
+  return    i_config_0.target_m             == i_config_1.target_m
+         && i_config_0.target_n             == i_config_1.target_n
+         && i_config_0.target_k             == i_config_1.target_k
+         && i_config_0.target_extra_packing == i_config_1.target_extra_packing
+         && i_config_0.generate_sfcs        == i_config_1.generate_sfcs
+         && i_config_0.packing              == i_config_1.packing
+         && i_config_0.num_threads_shared   == i_config_1.num_threads_shared
+         && i_config_0.num_threads_sfc_m    == i_config_1.num_threads_sfc_m
+         && i_config_0.num_threads_sfc_n    == i_config_1.num_threads_sfc_n;
+}
+
+double einsum_ir::basic::ContractionAutotuner::bench( ContractionBackend       & i_backend,
+                                                      void               const * i_left,
+                                                      void               const * i_right,
+                                                      void               const * i_out_aux,
+                                                      void                     * io_out ) {
+  // warm up
+  i_backend.contract( i_left,
+                      i_right,
+                      i_out_aux,
+                      io_out );
+
+  std::chrono::steady_clock::time_point l_tp0 = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point l_tp1 = l_tp0;
+  double l_dur = 0;
+  int64_t l_num_reps = 0;
+  do {
+    i_backend.contract( i_left,
+                        i_right,
+                        i_out_aux,
+                        io_out );
+    l_num_reps++;
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double > >( l_tp1 - l_tp0 ).count();
+  } while( l_dur < m_min_time_bench && l_num_reps < m_max_reps_bench );
+
+  return l_dur / l_num_reps;
+}
+
+void einsum_ir::basic::ContractionAutotuner::bench_candidate( std::function< ContractionBackend * ( tuning_config const &,
+                                                                                                   ContractionMemoryManager * ) > const & i_compile,
+                                                              void          const * i_left,
+                                                              void          const * i_right,
+                                                              void          const * i_out_aux,
+                                                              void                * io_out,
+                                                              tuning_config       & io_config ) {
+  io_config.time = 0;
+
+  ContractionMemoryManager l_contraction_mem;
+  ContractionBackend * l_backend = i_compile( io_config,
+                                              &l_contraction_mem );
+  if( l_backend == nullptr ) {
+    return;
+  }
+  l_contraction_mem.alloc_all_memory();
+
+  io_config.time = bench( *l_backend,
+                          i_left,
+                          i_right,
+                          i_out_aux,
+                          io_out );
+
+  delete l_backend;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionAutotuner::tune( std::vector< iter_property > const & i_iter_space,
+                                                                      data_t                               i_dtype_left,
+                                                                      data_t                               i_dtype_right,
+                                                                      data_t                               i_dtype_out,
+                                                                      int64_t                              i_num_threads,
+                                                                      bool                                 i_packing_support,
+                                                                      tuning_config                const & i_config_default,
+                                                                      std::function< ContractionBackend * ( tuning_config const &,
+                                                                                                            ContractionMemoryManager * ) > i_compile,
+                                                                      tuning_config                      & o_config ) {
+  std::lock_guard< std::mutex > l_lock( m_mutex_tune );
+
+  // allocate tensors covering the iteration space
+  int64_t l_size_left    = 1;
+  int64_t l_size_right   = 1;
+  int64_t l_size_out_aux = 1;
+  int64_t l_size_out     = 1;
+  for( std::size_t l_it = 0; l_it < i_iter_space.size(); l_it++ ) {
+    l_size_left    += (i_iter_space[l_it].size - 1) * i_iter_space[l_it].stride_left;
+    l_size_right   += (i_iter_space[l_it].size - 1) * i_iter_space[l_it].stride_right;
+    l_size_out_aux += (i_iter_space[l_it].size - 1) * i_iter_space[l_it].stride_out_aux;
+    l_size_out     += (i_iter_space[l_it].size - 1) * i_iter_space[l_it].stride_out;
+  }
+  std::vector< char > l_left(    l_size_left    * ce_n_bytes( i_dtype_left  ), 0 );
+  std::vector< char > l_right(   l_size_right   * ce_n_bytes( i_dtype_right ), 0 );
+  std::vector< char > l_out_aux( l_size_out_aux * ce_n_bytes( i_dtype_out   ), 0 );
+  std::vector< char > l_out(     l_size_out     * ce_n_bytes( i_dtype_out   ), 0 );
+
+  tuning_config l_best;
+  bool l_has_best = false;
+  std::vector< tuning_config > l_tested;
+
+  // benchmarks the candidate and keeps it if faster than the best one
+  auto l_try = [&]( tuning_config i_config ) {
+    i_config.target_m = std::max( i_config.target_m, (int64_t) 1 );
+    i_config.target_n = std::max( i_config.target_n, (int64_t) 1 );
+    i_config.target_k = std::max( i_config.target_k, (int64_t) 1 );
+    i_config.target_extra_packing = std::max( i_config.target_extra_packing, (int64_t) 1 );
+    for( std::size_t l_te = 0; l_te < l_tested.size(); l_te++ ) {
+      if( equal( l_tested[l_te], i_config ) ) {
+        return;
+      }
+    }
+    l_tested.push_back( i_config );
+
+    bench_candidate( i_compile,
+                     l_left.data(),
+                     l_right.data(),
+                     l_out_aux.data(),
+                     l_out.data(),
+                     i_config );
+
+    if(    i_config.time > 0
+        && ( !l_has_best || i_config.time < l_best.time ) ) {
+      l_best = i_config;
+      l_has_best = true;
+    }
+  };
+
+  // default configuration
+  tuning_config l_default = i_config_default;
+  l_default.packing = l_default.packing && i_packing_support;
+  l_try( l_default );
+
+  // stage 1: kernel targets m and n
+  tuning_config l_base = l_has_best ? l_best : l_default;
+  // scaling of the targets: 1/2, 1, 2
+  int64_t const l_scale_num[3] = { 1, 1, 2 };
+  int64_t const l_scale_den[3] = { 2, 1, 1 };
+  for( int64_t l_fm = 0; l_fm < 3; l_fm++ ) {
+    for( int64_t l_fn = 0; l_fn < 3; l_fn++ ) {
+      tuning_config l_config = l_base;
+      l_config.target_m = l_base.target_m * l_scale_num[l_fm] / l_scale_den[l_fm];
+      l_config.target_n = l_base.target_n * l_scale_num[l_fn] / l_scale_den[l_fn];
+      l_try( l_config );
+    }
+  }
+
+  // stage 2: kernel target k and extra packing
+  l_base = l_has_best ? l_best : l_default;
+  for( int64_t l_fk = 0; l_fk < 3; l_fk++ ) {
+    for( int64_t l_fp = 0; l_fp < 3; l_fp++ ) {
+      tuning_config l_config = l_base;
+      l_config.target_k             = l_base.target_k             * l_scale_num[l_fk] / l_scale_den[l_fk];
+      l_config.target_extra_packing = l_base.target_extra_packing * l_scale_num[l_fp] / l_scale_den[l_fp];
+      l_try( l_config );
+    }
+  }
+
+  // stage 3: sfcs and packing
+  l_base = l_has_best ? l_best : l_default;
+  for( int64_t l_sf = 0; l_sf < 2; l_sf++ ) {
+    for( int64_t l_pa = 0; l_pa < (i_packing_support ? 2 : 1); l_pa++ ) {
+      tuning_config l_config = l_base;
+      l_config.generate_sfcs = (l_sf == 0) ? l_base.generate_sfcs : !l_base.generate_sfcs;
+      l_config.packing       = (l_pa == 0) ? l_base.packing       : !l_base.packing;
+      l_try( l_config );
+    }
+  }
+
+  // stage 4: thread distribution
+  l_base = l_has_best ? l_best : l_default;
+  if( i_num_threads > 1 ) {
+    for( int64_t l_sh = 1; l_sh <= i_num_threads; l_sh++ ) {
+      if( i_num_threads % l_sh != 0 ) {
+        continue;
+      }
+      int64_t l_num_threads_sfc = i_num_threads / l_sh;
+      for( int64_t l_sm = 1; l_sm <= l_num_threads_sfc; l_sm++ ) {
+        if( l_num_threads_sfc % l_sm != 0 ) {
+          continue;
+        }
+        // sfc threads require sfc dimensions
+        if( !l_base.generate_sfcs && l_sh != i_num_threads ) {
+          continue;
+        }
+        tuning_config l_config = l_base;
+        l_config.num_threads_shared = l_sh;
+        l_config.num_threads_sfc_m  = l_sm;
+        l_config.num_threads_sfc_n  = l_num_threads_sfc / l_sm;
+        l_try( l_config );
+      }
+    }
+  }
+
+  if( !l_has_best ) {
+    return err_t::COMPILATION_FAILED;
+  }
+  o_config = l_best;
+
+  return err_t::SUCCESS;
+}
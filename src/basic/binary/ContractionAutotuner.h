@@ -0,0 +1,223 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_AUTOTUNER
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_AUTOTUNER
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+#include "ContractionBackend.h"
+#include "ContractionMemoryManager.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionAutotuner;
+  }
+}
+
+/**
+ * Autotuner of the contraction optimizer's configuration.
+ * Candidate configurations (kernel targets, extra packing, packing, sfcs, thread distribution) are benchmarked
+ * and the fastest one is stored in a tuning database.
+ * Entries are keyed by a canonical hash of the unoptimized iteration space, the kernel types, the data types,
+ * the number of threads and the backend.
+ *
+ * The database is stored as text file, one entry per line:
+ *   key target_m target_n target_k target_extra_packing generate_sfcs packing num_threads_shared num_threads_sfc_m num_threads_sfc_n time
+ **/
+class einsum_ir::basic::ContractionAutotuner {
+  private:
+    //! version of the database's file format
+    static constexpr int64_t m_db_version = 1;
+
+    //! path of the database's file, empty if the database is kept in memory only
+    std::string m_path_db;
+
+    //! tuned configurations
+    std::map< uint64_t, tuning_config > m_db;
+
+    //! mutex protecting the database
+    std::mutex m_mutex_db;
+
+    //! mutex serializing the benchmarks
+    std::mutex m_mutex_tune;
+
+    //! minimum duration of the timed repetitions of a candidate in seconds
+    double m_min_time_bench = 0.02;
+
+    //! maximum number of timed repetitions of a candidate
+    int64_t m_max_reps_bench = 100;
+
+    /**
+     * Adds a value to an FNV-1a hash.
+     *
+     * @param i_value value which is added.
+     * @param io_hash hash which is updated.
+     **/
+    static void hash_add( int64_t    i_value,
+                          uint64_t & io_hash );
+
+    /**
+     * Benchmarks a compiled contraction.
+     *
+     * @param i_backend compiled contraction backend.
+     * @param i_left left input tensor.
+     * @param i_right right input tensor.
+     * @param i_out_aux auxiliary output tensor.
+     * @param io_out output tensor.
+     * @return time of a single contraction in seconds.
+     **/
+    double bench( ContractionBackend       & i_backend,
+                  void               const * i_left,
+                  void               const * i_right,
+                  void               const * i_out_aux,
+                  void                     * io_out );
+
+    /**
+     * Compiles and benchmarks a candidate configuration.
+     *
+     * @param i_compile function which initializes and compiles a backend for the given configuration.
+     * @param i_left left input tensor.
+     * @param i_right right input tensor.
+     * @param i_out_aux auxiliary output tensor.
+     * @param io_out output tensor.
+     * @param io_config candidate configuration, the measured time is set on output; 0 if compilation failed.
+     **/
+    void bench_candidate( std::function< ContractionBackend * ( tuning_config const &,
+                                                                ContractionMemoryManager * ) > const & i_compile,
+                          void          const * i_left,
+                          void          const * i_right,
+                          void          const * i_out_aux,
+                          void                * io_out,
+                          tuning_config       & io_config );
+
+    /**
+     * Checks if two configurations are equal, ignoring the measured times.
+     *
+     * @param i_config_0 first configuration.
+     * @param i_config_1 second configuration.
+     * @return true if the configurations are equal, false otherwise.
+     **/
+    static bool equal( tuning_config const & i_config_0,
+                       tuning_config const & i_config_1 );
+
+  public:
+    /**
+     * Gets the process-wide autotuner.
+     * If the environment variable EINSUM_IR_TUNING_DB is set, the database is loaded from the given path on first use.
+     *
+     * @return process-wide autotuner.
+     **/
+    static ContractionAutotuner * get_instance();
+
+    /**
+     * Derives the canonical key of a contraction.
+     * The key is independent of the order of the iterations and of size-1 iterations.
+     *
+     * @param i_iter_space unoptimized iteration space.
+     * @param i_ktype_first_touch type of the first touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     * @param i_ktype_last_touch type of the last touch kernel.
+     * @param i_dtype_left datatype of left input tensor.
+     * @param i_dtype_right datatype of right input tensor.
+     * @param i_dtype_comp datatype of computation.
+     * @param i_dtype_out datatype of output tensor.
+     * @param i_num_threads number of threads.
+     * @param i_backend name of the backend.
+     * @return key of the contraction.
+     **/
+    static uint64_t key( std::vector< iter_property > const & i_iter_space,
+                         kernel_t                             i_ktype_first_touch,
+                         kernel_t                             i_ktype_main,
+                         kernel_t                             i_ktype_last_touch,
+                         data_t                               i_dtype_left,
+                         data_t                               i_dtype_right,
+                         data_t                               i_dtype_comp,
+                         data_t                               i_dtype_out,
+                         int64_t                              i_num_threads,
+                         std::string                  const & i_backend );
+
+    /**
+     * Loads the database from the given file and uses the file for future stores.
+     * A non-existing file results in an empty database.
+     *
+     * @param i_path path of the database's file.
+     * @return SUCCESS if the database was loaded, otherwise an appropiate error code.
+     **/
+    err_t load( std::string const & i_path );
+
+    /**
+     * Stores the database in the file of the last load.
+     * Nothing is stored if no file was loaded.
+     *
+     * @return SUCCESS if the database was stored, otherwise an appropiate error code.
+     **/
+    err_t store();
+
+    /**
+     * Looks up a configuration in the database.
+     *
+     * @param i_key key of the contraction.
+     * @param o_config configuration of the contraction if found.
+     * @return true if the database has an entry for the key, false otherwise.
+     **/
+    bool lookup( uint64_t        i_key,
+                 tuning_config & o_config );
+
+    /**
+     * Inserts a configuration into the database.
+     * Existing entries are replaced.
+     *
+     * @param i_key key of the contraction.
+     * @param i_config configuration of the contraction.
+     **/
+    void insert( uint64_t              i_key,
+                 tuning_config const & i_config );
+
+    /**
+     * Removes all entries from the database.
+     **/
+    void clear();
+
+    /**
+     * Sets the minimum duration of the timed repetitions of a candidate.
+     *
+     * @param i_min_time minimum duration in seconds.
+     **/
+    void set_min_time_bench( double i_min_time );
+
+    /**
+     * Tunes a contraction through a staged search starting at the default configuration:
+     *   1) kernel targets m and n,
+     *   2) kernel target k and extra packing,
+     *   3) sfcs and packing,
+     *   4) thread distribution among sfc m, sfc n and shared dimensions.
+     * Every stage keeps the fastest configuration of the previous stages.
+     * The tensors of the benchmarks are allocated by the autotuner.
+     *
+     * @param i_iter_space unoptimized iteration space.
+     * @param i_dtype_left datatype of left input tensor.
+     * @param i_dtype_right datatype of right input tensor.
+     * @param i_dtype_out datatype of output tensor.
+     * @param i_num_threads number of threads.
+     * @param i_packing_support true if the backend supports packing.
+     * @param i_config_default default configuration.
+     * @param i_compile function which initializes and compiles a backend for a configuration, nullptr on failure.
+     * @param o_config fastest configuration.
+     * @return SUCCESS if at least one configuration compiled, otherwise an appropiate error code.
+     **/
+    err_t tune( std::vector< iter_property > const & i_iter_space,
+                data_t                               i_dtype_left,
+                data_t                               i_dtype_right,
+                data_t                               i_dtype_out,
+                int64_t                              i_num_threads,
+                bool                                 i_packing_support,
+                tuning_config                const & i_config_default,
+                std::function< ContractionBackend * ( tuning_config const &,
+                                                      ContractionMemoryManager * ) > i_compile,
+                tuning_config                      & o_config );
+};
+
+#endif
@@ -0,0 +1,171 @@
+#include "catch.hpp"
+#include "ContractionAutotuner.h"
+#include "ContractionBackendScalar.h"
+#include "ContractionOptimizer.h"
+#include <cstdio>
+
+TEST_CASE( "Canonical keys of the contraction autotuner.", "[contraction_autotuner]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters_0 = { {dim_t::M, exec_t::SEQ, 32,  1, 0, 0,  1},
+                                             {dim_t::N, exec_t::SEQ, 16,  0, 8, 0, 32},
+                                             {dim_t::K, exec_t::SEQ,  8, 32, 1, 0,  0} };
+
+  // reordered and additional size-1 iteration
+  std::vector< iter_property > l_iters_1 = { {dim_t::K, exec_t::SEQ,  8, 32, 1, 0,  0},
+                                             {dim_t::C, exec_t::SEQ,  1,  0, 0, 0,  0},
+                                             {dim_t::M, exec_t::SEQ, 32,  1, 0, 0,  1},
+                                             {dim_t::N, exec_t::SEQ, 16,  0, 8, 0, 32} };
+
+  // different size
+  std::vector< iter_property > l_iters_2 = { {dim_t::M, exec_t::SEQ, 32,  1, 0, 0,  1},
+                                             {dim_t::N, exec_t::SEQ, 16,  0, 4, 0, 32},
+                                             {dim_t::K, exec_t::SEQ,  4, 32, 1, 0,  0} };
+
+  uint64_t l_key_0 = ContractionAutotuner::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP32, FP32, FP32, FP32, 1, "scalar" );
+  uint64_t l_key_1 = ContractionAutotuner::key( l_iters_1, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP32, FP32, FP32, FP32, 1, "scalar" );
+  uint64_t l_key_2 = ContractionAutotuner::key( l_iters_2, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP32, FP32, FP32, FP32, 1, "scalar" );
+  uint64_t l_key_3 = ContractionAutotuner::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP64, FP64, FP64, FP64, 1, "scalar" );
+  uint64_t l_key_4 = ContractionAutotuner::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP32, FP32, FP32, FP32, 4, "scalar" );
+  uint64_t l_key_5 = ContractionAutotuner::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                FP32, FP32, FP32, FP32, 1, "tpp" );
+
+  REQUIRE( l_key_0 == l_key_1 );
+  REQUIRE( l_key_0 != l_key_2 );
+  REQUIRE( l_key_0 != l_key_3 );
+  REQUIRE( l_key_0 != l_key_4 );
+  REQUIRE( l_key_0 != l_key_5 );
+}
+
+TEST_CASE( "Store and load of the tuning database.", "[contraction_autotuner]" ) {
+  using namespace einsum_ir::basic;
+
+  std::string l_path = "einsum_ir_tuning_db.test.txt";
+  std::remove( l_path.c_str() );
+
+  tuning_config l_config;
+  l_config.target_m             = 32;
+  l_config.target_n             = 48;
+  l_config.target_k             = 128;
+  l_config.target_extra_packing = 4;
+  l_config.generate_sfcs        = false;
+  l_config.packing              = false;
+  l_config.num_threads_shared   = 2;
+  l_config.num_threads_sfc_m    = 3;
+  l_config.num_threads_sfc_n    = 1;
+  l_config.time                 = 1.5e-3;
+
+  ContractionAutotuner l_tuner_store;
+  REQUIRE( l_tuner_store.load( l_path ) == err_t::SUCCESS );
+  l_tuner_store.insert( 0xfedcba9876543210, l_config );
+  REQUIRE( l_tuner_store.store() == err_t::SUCCESS );
+
+  ContractionAutotuner l_tuner_load;
+  REQUIRE( l_tuner_load.load( l_path ) == err_t::SUCCESS );
+
+  tuning_config l_config_load;
+  REQUIRE( !l_tuner_load.lookup( 0x0123456789abcdef, l_config_load ) );
+  REQUIRE(  l_tuner_load.lookup( 0xfedcba9876543210, l_config_load ) );
+
+  REQUIRE( l_config_load.target_m             == l_config.target_m );
+  REQUIRE( l_config_load.target_n             == l_config.target_n );
+  REQUIRE( l_config_load.target_k             == l_config.target_k );
+  REQUIRE( l_config_load.target_extra_packing == l_config.target_extra_packing );
+  REQUIRE( l_config_load.generate_sfcs        == l_config.generate_sfcs );
+  REQUIRE( l_config_load.packing              == l_config.packing );
+  REQUIRE( l_config_load.num_threads_shared   == l_config.num_threads_shared );
+  REQUIRE( l_config_load.num_threads_sfc_m    == l_config.num_threads_sfc_m );
+  REQUIRE( l_config_load.num_threads_sfc_n    == l_config.num_threads_sfc_n );
+  REQUIRE( l_config_load.time                 == Approx( l_config.time ) );
+
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Autotuning of a matrix-matrix multiplication with the scalar backend.", "[contraction_autotuner]" ) {
+  using namespace einsum_ir::basic;
+
+  // C[n][m] = A[k][m] * B[n][k]
+  std::vector< iter_property > l_iters = { {dim_t::M, exec_t::SEQ, 24,  1, 0, 0,  1},
+                                           {dim_t::N, exec_t::SEQ, 20,  0, 16, 0, 24},
+                                           {dim_t::K, exec_t::SEQ, 16, 24, 1, 0,  0} };
+
+  tuning_config l_config_default;
+  l_config_default.target_m = 1;
+  l_config_default.target_n = 1;
+  l_config_default.target_k = 1;
+  l_config_default.packing  = false;
+
+  int64_t l_num_compiled = 0;
+  auto l_compile = [&]( tuning_config            const & i_config,
+                        ContractionMemoryManager       * i_contraction_mem ) -> ContractionBackend * {
+    std::vector< iter_property > l_iters_opt = l_iters;
+    kernel_t l_ktype_main = kernel_t::MADD;
+    int64_t l_num_threads_shared = 1;
+    int64_t l_num_threads_m = 1;
+    int64_t l_num_threads_n = 1;
+
+    ContractionOptimizer l_opt;
+    l_opt.init( &l_iters_opt,
+                &l_ktype_main,
+                i_config.target_m,
+                i_config.target_n,
+                i_config.target_k,
+                i_config.generate_sfcs,
+                false,
+                false,
+                packed_gemm_t::ALL_STRIDE_ONE,
+                4,
+                1024*1024,
+                &l_num_threads_shared,
+                &l_num_threads_m,
+                &l_num_threads_n,
+                i_config.target_extra_packing );
+    l_opt.optimize();
+
+    ContractionBackendScalar * l_backend = new ContractionBackendScalar;
+    l_backend->init( l_iters_opt,
+                     FP32,
+                     FP32,
+                     FP32,
+                     FP32,
+                     kernel_t::ZERO,
+                     l_ktype_main,
+                     kernel_t::UNDEFINED_KTYPE,
+                     l_num_threads_shared,
+                     l_num_threads_m,
+                     l_num_threads_n,
+                     i_contraction_mem );
+    if( l_backend->compile() != err_t::SUCCESS ) {
+      delete l_backend;
+      return nullptr;
+    }
+    l_num_compiled++;
+    return l_backend;
+  };
+
+  ContractionAutotuner l_tuner;
+  l_tuner.set_min_time_bench( 0 );
+
+  tuning_config l_config;
+  err_t l_err = l_tuner.tune( l_iters,
+                              FP32,
+                              FP32,
+                              FP32,
+                              1,
+                              false,
+                              l_config_default,
+                              l_compile,
+                              l_config );
+  REQUIRE( l_err == err_t::SUCCESS );
+  REQUIRE( l_num_compiled > 1 );
+  REQUIRE( l_config.time > 0 );
+  REQUIRE( l_config.target_m >= 1 );
+  REQUIRE( l_config.target_n >= 1 );
+  REQUIRE( l_config.target_k >= 1 );
+  REQUIRE( l_config.packing == false );
+}
@@ -1,11 +1,23 @@
 #include "ContractionBackend.h"
 #include "../unary/UnaryOptimizer.h"
 #include <algorithm>
+#include <cstring>
+#include <map>
 
 #ifdef _OPENMP
 #include <omp.h>
 #endif
 
+#ifdef PP_EINSUM_IR_INSTRUMENT
+#define EINSUM_IR_STATS_START( l_name ) int64_t l_name = read_cycles();
+#define EINSUM_IR_STATS_STOP( l_name, io_phase ) io_phase.cycles += read_cycles() - l_name; io_phase.calls++;
+#define EINSUM_IR_STATS_ADD( io_counter ) io_counter++;
+#else
+#define EINSUM_IR_STATS_START( l_name )
+#define EINSUM_IR_STATS_STOP( l_name, io_phase )
+#define EINSUM_IR_STATS_ADD( io_counter )
+#endif
+
 void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const & i_dim_type,
                                                  std::vector< exec_t >  const & i_exec_type,
                                                  std::vector< int64_t > const & i_dim_sizes,
@@ -25,7 +37,14 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const &
                                                  int64_t                        i_num_threads_shared,
                                                  int64_t                        i_num_threads_sfc_m,
                                                  int64_t                        i_num_threads_sfc_n,
-                                                 ContractionMemoryManager     * i_contraction_mem ){
+                                                 ContractionMemoryManager     * i_contraction_mem,
+                                                 executor_t                     i_executor,
+                                                 schedule_t                     i_schedule,
+                                                 bool                           i_fuse_first_touch,
+                                                 std::vector< epilogue_op > const & i_epilogue,
+                                                 double                         i_alpha,
+                                                 double                         i_beta,
+                                                 bool                           i_cpx_3m ){
 
   //copy to local variables
   m_dim_type        = i_dim_type;
@@ -64,6 +83,18 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< dim_t >   const &
 
   m_memory = i_contraction_mem;
 
+  m_executor = i_executor;
+  m_schedule = i_schedule;
+  m_fuse_first_touch = i_fuse_first_touch;
+
+  init_epilogue( i_epilogue );
+
+  m_alpha = i_alpha;
+  m_beta  = i_beta;
+  m_scale_first_touch = 1.0;
+  m_skip_main = false;
+  m_cpx_3m = i_cpx_3m;
+
   m_is_compiled = false;
 }
 
@@ -78,7 +109,14 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< iter_property > co
                                                  int64_t                              i_num_threads_shared,
                                                  int64_t                              i_num_threads_sfc_m,
                                                  int64_t                              i_num_threads_sfc_n,
-                                                 ContractionMemoryManager           * i_contraction_mem ){
+                                                 ContractionMemoryManager           * i_contraction_mem,
+                                                 executor_t                           i_executor,
+                                                 schedule_t                           i_schedule,
+                                                 bool                                 i_fuse_first_touch,
+                                                 std::vector< epilogue_op >   const & i_epilogue,
+                                                 double                               i_alpha,
+                                                 double                               i_beta,
+                                                 bool                                 i_cpx_3m ){
 
 
   size_t l_num_iters = i_iterations.size();
@@ -119,9 +157,199 @@ void einsum_ir::basic::ContractionBackend::init( std::vector< iter_property > co
 
   m_memory = i_contraction_mem;
 
+  m_executor = i_executor;
+  m_schedule = i_schedule;
+  m_fuse_first_touch = i_fuse_first_touch;
+
+  init_epilogue( i_epilogue );
+
+  m_alpha = i_alpha;
+  m_beta  = i_beta;
+  m_scale_first_touch = 1.0;
+  m_skip_main = false;
+  m_cpx_3m = i_cpx_3m;
+
   m_is_compiled = false;
 }
 
+void einsum_ir::basic::ContractionBackend::init_epilogue( std::vector< epilogue_op > const & i_epilogue ){
+  m_epilogue.clear();
+
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ){
+    m_epilogue = i_epilogue;
+  }
+  // single eltwise ops beyond RELU and ADD are epilogue programs with one op
+  else if(    m_ktype_last_touch == kernel_t::GELU
+           || m_ktype_last_touch == kernel_t::SIGMOID
+           || m_ktype_last_touch == kernel_t::TANH
+           || m_ktype_last_touch == kernel_t::MUL
+           || m_ktype_last_touch == kernel_t::MIN
+           || m_ktype_last_touch == kernel_t::MAX
+           || m_ktype_last_touch == kernel_t::DEQUANT
+           || m_ktype_last_touch == kernel_t::QUANT ){
+    m_epilogue.resize( 1 );
+    m_epilogue[0].ktype = m_ktype_last_touch;
+    m_ktype_last_touch = kernel_t::EPILOGUE;
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::fold_alpha_beta(){
+  if( m_alpha == 1.0 && m_beta == 1.0 ){
+    return err_t::SUCCESS;
+  }
+  // alpha=0 only scales the output with beta
+  if( m_alpha == 0.0 ){
+    m_scale_first_touch = m_beta;
+    m_beta = 1.0;
+    m_skip_main = true;
+
+    return err_t::SUCCESS;
+  }
+
+  // beta scales the output directly after the first touch, zeroed outputs need no scaling
+  bool l_first_touch_zero =    m_ktype_first_touch == kernel_t::ZERO
+                            || m_ktype_first_touch == kernel_t::CPX_ZERO;
+  m_scale_first_touch = l_first_touch_zero ? 1.0 : m_beta;
+  m_beta = 1.0;
+
+  // alpha scales the products in the main kernel if the output has initial values,
+  // otherwise the output holds the plain sum of products which is scaled in the last touch
+  if(    m_alpha != 1.0
+      && l_first_touch_zero ){
+    epilogue_op l_scale;
+    l_scale.ktype   = kernel_t::MUL;
+    l_scale.use_aux = false;
+    l_scale.scalar  = m_alpha;
+
+    if(    m_ktype_last_touch == kernel_t::RELU
+        || m_ktype_last_touch == kernel_t::ADD ){
+      m_epilogue.resize( 1 );
+      m_epilogue[0].ktype = m_ktype_last_touch;
+    }
+    else if( m_ktype_last_touch == kernel_t::UNDEFINED_KTYPE ){
+      m_epilogue.clear();
+    }
+    else if( m_ktype_last_touch != kernel_t::EPILOGUE ){
+      return err_t::COMPILATION_FAILED;
+    }
+    // dequantization has to see the raw INT32 accumulators
+    std::vector< epilogue_op >::iterator l_pos = m_epilogue.begin();
+    if(    m_epilogue.size() > 0
+        && m_epilogue[0].ktype == kernel_t::DEQUANT ){
+      l_pos++;
+    }
+    m_epilogue.insert( l_pos,
+                       l_scale );
+    m_ktype_last_touch = kernel_t::EPILOGUE;
+    m_alpha = 1.0;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::check_quantization() const {
+  bool l_dequant = false;
+  for( std::size_t l_op = 0; l_op < m_epilogue.size(); l_op++ ){
+    if( m_epilogue[l_op].ktype == kernel_t::DEQUANT ){
+      // dequantization converts the accumulators and has to be the first op
+      if( l_op != 0 ){
+        return err_t::COMPILATION_FAILED;
+      }
+      l_dequant = true;
+    }
+  }
+  if( m_ktype_last_touch != kernel_t::EPILOGUE ){
+    l_dequant = false;
+  }
+
+  if(    m_dtype_left  != data_t::INT8
+      && m_dtype_right != data_t::INT8
+      && m_dtype_comp  != data_t::INT32
+      && m_dtype_out   != data_t::INT32 ){
+    return l_dequant ? err_t::COMPILATION_FAILED : err_t::SUCCESS;
+  }
+
+  if(    m_dtype_left  != data_t::INT8
+      || m_dtype_right != data_t::INT8
+      || m_dtype_comp  != data_t::INT32 ){
+    return err_t::COMPILATION_FAILED;
+  }
+  if(    m_ktype_main != kernel_t::MADD
+      && m_ktype_main != kernel_t::BR_MADD ){
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // INT32 outputs hold the raw accumulators
+  if( m_dtype_out == data_t::INT32 ){
+    if(    m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE
+        || m_alpha != 1.0 ){
+      return err_t::COMPILATION_FAILED;
+    }
+    if(    m_ktype_first_touch != kernel_t::ZERO
+        && m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE ){
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+  // FP32 outputs hold the accumulators until the last touch dequantizes them in place
+  else if( m_dtype_out == data_t::FP32 ){
+    if(    !l_dequant
+        || m_ktype_first_touch != kernel_t::ZERO ){
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+  else {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // the accumulators cannot be scaled by beta
+  if( m_beta != 1.0 ){
+    return err_t::COMPILATION_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::basic::ContractionBackend::set_thread_infos( std::vector< thread_info > const & i_thread_infos,
+                                                             int64_t                            i_caching_size ){
+  m_thread_infos = i_thread_infos;
+  m_caching_size_preset = i_caching_size;
+  m_thread_infos_preset = true;
+}
+
+void einsum_ir::basic::ContractionBackend::get_thread_infos( std::vector< thread_info > & o_thread_infos,
+                                                             int64_t                    & o_caching_size ) const {
+  o_thread_infos = m_thread_infos;
+  o_caching_size = m_num_cached_ptrs_left;
+
+  // runtime state of the contractions is not part of the iteration space
+  for( std::size_t l_th = 0; l_th < o_thread_infos.size(); l_th++ ){
+    o_thread_infos[l_th].memory_left  = nullptr;
+    o_thread_infos[l_th].memory_right = nullptr;
+    o_thread_infos[l_th].cached_ptrs_left.clear();
+    o_thread_infos[l_th].cached_ptrs_right.clear();
+  }
+}
+
+einsum_ir::basic::thread_stats & einsum_ir::basic::ContractionBackend::stats( thread_info const * i_thread_info ){
+  return m_stats[ i_thread_info - m_thread_infos.data() ];
+}
+
+bool einsum_ir::basic::ContractionBackend::has_instrumentation(){
+#ifdef PP_EINSUM_IR_INSTRUMENT
+  return true;
+#else
+  return false;
+#endif
+}
+
+void einsum_ir::basic::ContractionBackend::get_stats( std::vector< thread_stats > & o_stats ) const {
+  o_stats = m_stats;
+}
+
+void einsum_ir::basic::ContractionBackend::reset_stats(){
+  m_stats.assign( m_stats.size(), thread_stats() );
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   err_t l_err = err_t::UNDEFINED_ERROR;
   if( m_is_compiled ){
@@ -134,6 +362,24 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
     return l_err;
   }
 
+  // beta=0 overwrites the output
+  if( m_beta == 0.0 ){
+    if(    m_ktype_main == kernel_t::CPX_MADD
+        || m_ktype_main == kernel_t::CPX_PACKED_MADD ){
+      m_ktype_first_touch = kernel_t::CPX_ZERO;
+    }
+    else{
+      m_ktype_first_touch = kernel_t::ZERO;
+    }
+    m_beta = 1.0;
+  }
+
+  // INT8 inputs are accumulated in INT32
+  l_err = check_quantization();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
   // compile kernel
   l_err = compile_kernels();
   if( l_err != err_t::SUCCESS ) {
@@ -167,8 +413,39 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
   m_num_threads_shared = std::min(m_num_threads_shared, l_size_shared);
   m_num_threads = m_num_threads_sfc_m * m_num_threads_sfc_n * m_num_threads_shared;
 
+  //shared K loops are parallelized through partial outputs
+  m_split_k = false;
+  for(int64_t l_id = 0; l_id < l_num_iters; l_id++){
+    if(    m_exec_type.at(l_id) == exec_t::OMP
+        && m_dim_type.at(l_id)  == dim_t::K ){
+      m_split_k = true;
+    }
+  }
+  //partial outputs are not reduced in 16-bit storage types
+  if(    m_split_k
+      && ce_n_bytes( m_dtype_out ) == 2 ){
+    return err_t::COMPILATION_FAILED;
+  }
+
+  //dynamic and guided schedules require that the shared loops are entered once per contraction
+  m_num_tasks_shared = l_size_shared;
+  if(    m_num_shared_loops == 0
+      || m_exec_type.at(0) != exec_t::OMP ){
+    m_schedule = schedule_t::STATIC;
+  }
+  if( m_schedule == schedule_t::DYNAMIC ){
+    //about four chunks per thread to balance the tail while keeping consecutive tasks together
+    m_chunk_size_shared = std::max( m_num_tasks_shared / (4 * m_num_threads_shared), (int64_t)1 );
+  }
+  else{
+    m_chunk_size_shared = 1;
+  }
+  m_num_shared_counters = m_num_threads_sfc_m * m_num_threads_sfc_n;
+
   //check if first and last touch exists
-  m_has_first_touch = m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE;
+  m_has_first_touch =    m_ktype_first_touch != kernel_t::UNDEFINED_KTYPE
+                      || m_beta != 1.0
+                      || m_scale_first_touch != 1.0;
   m_has_last_touch = m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE;
 
   //create packing
@@ -176,14 +453,16 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
                   m_size_packing_left,
                   m_unary_left,
                   m_strides_left,
-                  m_packing_strides_left);
+                  m_packing_strides_left,
+                  m_dtype_left );
   m_size_packing_left *= ce_n_bytes(m_dtype_left);
   
   create_packing( m_packing_right_id,
                   m_size_packing_right,
                   m_unary_right,
                   m_strides_right,
-                  m_packing_strides_right);
+                  m_packing_strides_right,
+                  m_dtype_right );
   m_size_packing_right *= ce_n_bytes(m_dtype_right);
 
   //multiply strides by size of datatype 
@@ -193,6 +472,12 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
     m_strides_out[l_id]     *= ce_n_bytes(m_dtype_out  );
     m_strides_out_aux[l_id] *= ce_n_bytes(m_dtype_out  );
   }
+
+  //keep the byte strides of the output tensors for split-K, the strides of the sfc loops are converted below
+  if( m_split_k ){
+    m_strides_out_split_k     = m_strides_out;
+    m_strides_out_aux_split_k = m_strides_out_aux;
+  }
   
   // init iteration spaces
   m_iter.init( &m_dim_type,
@@ -202,22 +487,63 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::compile(){
                m_num_threads_sfc_n,
                m_num_threads_shared );
 
-  // compile iteration spaces
-  l_err = m_iter.setup( m_strides_left,
-                        m_strides_right,
-                        m_strides_out_aux,
-                        m_strides_out,
-                        m_thread_infos );
+  if( m_thread_infos_preset ){
+    // preset thread infos of an identical iteration space
+    if( (int64_t) m_thread_infos.size() != m_num_threads ){
+      return err_t::COMPILATION_FAILED;
+    }
 
-  if( l_err != err_t::SUCCESS ) {
-    return l_err;
+    // the preset thread infos move along the converted sfc strides
+    l_err = m_iter.setup_strides( m_strides_left,
+                                  m_strides_right,
+                                  m_strides_out_aux,
+                                  m_strides_out );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    m_num_cached_ptrs_left  = m_caching_size_preset;
+    m_num_cached_ptrs_right = m_caching_size_preset;
+  }
+  else{
+    // compile iteration spaces
+    l_err = m_iter.setup( m_strides_left,
+                          m_strides_right,
+                          m_strides_out_aux,
+                          m_strides_out,
+                          m_thread_infos );
+
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    m_num_cached_ptrs_left = m_iter.get_caching_size();
+    m_num_cached_ptrs_right = m_iter.get_caching_size();
   }
 
-  m_num_cached_ptrs_left = m_iter.get_caching_size();
-  m_num_cached_ptrs_right = m_iter.get_caching_size();
+  if( m_split_k ){
+    l_err = setup_split_k();
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  m_stats.assign( m_num_threads, thread_stats() );
 
   //reserve memory for packing
   int64_t l_reserved_size = m_size_packing_left * m_num_cached_ptrs_left + m_size_packing_right * m_num_cached_ptrs_right;
+
+  //reserve memory for the partial output of split-K
+  if( m_split_k ){
+    m_offset_split_k = ( (l_reserved_size + 127) / 128 ) * 128;
+    l_reserved_size  = m_offset_split_k + m_size_out_split_k;
+  }
+
+  //reserve scratch memory of the kernels
+  if( m_size_scratch > 0 ){
+    m_offset_scratch = ( (l_reserved_size + 127) / 128 ) * 128;
+    l_reserved_size  = m_offset_scratch + m_size_scratch;
+  }
   if( m_memory == nullptr ){
     m_memory = &m_personal_memory;
     m_memory->reserve_thread_memory( l_reserved_size, m_num_threads );
@@ -255,58 +581,111 @@ void einsum_ir::basic::ContractionBackend::contract( void const * i_tensor_left,
                                                      void const * i_tensor_right,
                                                      void const * i_tensor_out_aux,
                                                      void       * io_tensor_out ) {
-#ifdef _OPENMP
-#pragma omp parallel for num_threads(m_num_threads)
-#endif
-  for( int64_t l_thread_id = 0; l_thread_id < m_num_threads; l_thread_id++ ) {
-    thread_info * l_thread_inf = &m_thread_infos[l_thread_id];
-    //get packing memory
-    if( m_size_packing_left || m_size_packing_right ){
-      l_thread_inf->memory_left  = m_memory->get_thread_memory( l_thread_id );
-      l_thread_inf->memory_right = l_thread_inf->memory_left + m_size_packing_left * m_num_cached_ptrs_left;
-      l_thread_inf->cached_ptrs_left.resize(  m_num_cached_ptrs_left,  nullptr );
-      l_thread_inf->cached_ptrs_right.resize( m_num_cached_ptrs_right, nullptr );
-    }
+  //counters of the shared tasks and touched flags of this call, the counters start at zero
+  call_state_t l_call_state;
+  std::unique_ptr< shared_counter_t[] > l_shared_counters;
+  std::vector< uint8_t > l_touched_split_k;
+  if( m_schedule != schedule_t::STATIC ) {
+    l_shared_counters = std::make_unique< shared_counter_t[] >( m_num_shared_counters );
+    l_call_state.shared_counters = l_shared_counters.get();
+  }
+  if( m_split_k ) {
+    l_touched_split_k.assign( m_num_threads * m_stride_touched_split_k, 0 );
+    l_call_state.touched_split_k = l_touched_split_k.data();
+  }
 
-    //add thread offset
-    char * l_tensor_left    = (char *) i_tensor_left    + l_thread_inf->offset_left;
-    char * l_tensor_right   = (char *) i_tensor_right   + l_thread_inf->offset_right;
-    char * l_tensor_out_aux = (char *) i_tensor_out_aux + l_thread_inf->offset_out_aux;
-    char * l_tensor_out     = (char *) io_tensor_out    + l_thread_inf->offset_out;
+  execute( [&]( int64_t l_thread_id ) {
+             contract_thread( l_thread_id,
+                              l_call_state,
+                              i_tensor_left,
+                              i_tensor_right,
+                              i_tensor_out_aux,
+                              io_tensor_out );
+           } );
+
+  //combine the partial outputs once all threads finished
+  if( m_split_k ) {
+    execute( [&]( int64_t l_thread_id ) {
+               reduce_split_k( l_thread_id,
+                               l_call_state.touched_split_k,
+                               i_tensor_out_aux,
+                               io_tensor_out );
+             } );
+  }
+}
 
+void einsum_ir::basic::ContractionBackend::contract_thread( int64_t              i_thread_id,
+                                                            call_state_t const & i_call_state,
+                                                            void         const * i_tensor_left,
+                                                            void         const * i_tensor_right,
+                                                            void         const * i_tensor_out_aux,
+                                                            void               * io_tensor_out ) {
+  EINSUM_IR_STATS_START( l_cycles_total )
+  thread_info * l_thread_inf = &m_thread_infos[i_thread_id];
+  //get packing memory
+  if( m_size_packing_left || m_size_packing_right || m_split_k || m_size_scratch ){
+    l_thread_inf->memory_left    = m_memory->get_thread_memory( i_thread_id );
+    l_thread_inf->memory_right   = l_thread_inf->memory_left + m_size_packing_left * m_num_cached_ptrs_left;
+    l_thread_inf->memory_scratch = l_thread_inf->memory_left + m_offset_scratch;
+    l_thread_inf->cached_ptrs_left.resize(  m_num_cached_ptrs_left,  nullptr );
+    l_thread_inf->cached_ptrs_right.resize( m_num_cached_ptrs_right, nullptr );
+  }
 
-    //pack left tensor
-    if( m_packing_left_id == 0)  {
-      m_unary_left.eval(l_tensor_left, l_thread_inf->memory_left);
-      l_tensor_left = l_thread_inf->memory_left;
-    }
+  //add thread offset
+  char * l_tensor_left    = (char *) i_tensor_left    + l_thread_inf->offset_left;
+  char * l_tensor_right   = (char *) i_tensor_right   + l_thread_inf->offset_right;
+  char * l_tensor_out_aux = (char *) i_tensor_out_aux + l_thread_inf->offset_out_aux;
+  char * l_tensor_out     = (char *) io_tensor_out    + l_thread_inf->offset_out;
+
+  //split-K: accumulate in the partial output, the tiles are zeroed when first touched
+  //the first and last touch of the output are applied in the reduction
+  bool l_first_access = m_has_first_touch;
+  bool l_last_access  = m_has_last_touch;
+  if( m_split_k ){
+    char * l_partial = m_memory->get_thread_memory( i_thread_id ) + m_offset_split_k;
+    l_tensor_out = l_partial + ( l_thread_inf->offset_out - m_offsets_split_k[i_thread_id] );
+    l_first_access = true;
+    l_last_access  = false;
+  }
 
-    //pack right tensor
-    if( m_packing_right_id == 0 )  {
-      m_unary_right.eval(l_tensor_right, l_thread_inf->memory_right);
-      l_tensor_right = l_thread_inf->memory_right;
-    }
+  //pack left tensor
+  if( m_packing_left_id == 0)  {
+    EINSUM_IR_STATS_START( l_cycles_packing )
+    m_unary_left.eval(l_tensor_left, l_thread_inf->memory_left);
+    EINSUM_IR_STATS_STOP( l_cycles_packing, m_stats[i_thread_id].packing_left )
+    l_tensor_left = l_thread_inf->memory_left;
+  }
 
-    //contract
-    (this->*(m_loop_functs[0]))( l_thread_inf,
-                                 0,
-                                 l_tensor_left,
-                                 l_tensor_right,
-                                 l_tensor_out_aux,
-                                 l_tensor_out,
-                                 m_has_first_touch,
-                                 m_has_last_touch );
+  //pack right tensor
+  if( m_packing_right_id == 0 )  {
+    EINSUM_IR_STATS_START( l_cycles_packing )
+    m_unary_right.eval(l_tensor_right, l_thread_inf->memory_right);
+    EINSUM_IR_STATS_STOP( l_cycles_packing, m_stats[i_thread_id].packing_right )
+    l_tensor_right = l_thread_inf->memory_right;
   }
+
+  //contract
+  (this->*(m_loop_functs[0]))( l_thread_inf,
+                               i_call_state,
+                               0,
+                               l_tensor_left,
+                               l_tensor_right,
+                               l_tensor_out_aux,
+                               l_tensor_out,
+                               l_first_access,
+                               l_last_access );
+  EINSUM_IR_STATS_STOP( l_cycles_total, m_stats[i_thread_id].total )
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thread_info,
-                                                          int64_t         i_id_loop,
-                                                          char    const * i_ptr_left,
-                                                          char    const * i_ptr_right,
-                                                          char    const * i_ptr_out_aux,
-                                                          char          * i_ptr_out,
-                                                          bool            i_first_access,
-                                                          bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter( thread_info          * i_thread_info,
+                                                          call_state_t   const & i_call_state,
+                                                          int64_t                i_id_loop,
+                                                          char           const * i_ptr_left,
+                                                          char           const * i_ptr_right,
+                                                          char           const * i_ptr_out_aux,
+                                                          char                 * i_ptr_out,
+                                                          bool                   i_first_access,
+                                                          bool                   i_last_access ) {
   bool l_first_access = i_first_access;
   bool l_last_access  = i_last_access;
 
@@ -325,18 +704,23 @@ void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thre
     const char * l_ptr_left_active = i_ptr_left;
     if( m_packing_left_id == l_id_next_loop )  {
       l_ptr_left_active = i_thread_info->memory_left;
+      EINSUM_IR_STATS_START( l_cycles_packing )
       m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
+      EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_left )
     }
 
     //pack right tensor
     const char * l_ptr_right_active = i_ptr_right;
     if( m_packing_right_id == l_id_next_loop )  {
       l_ptr_right_active = i_thread_info->memory_right;
+      EINSUM_IR_STATS_START( l_cycles_packing )
       m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
+      EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_right )
     }
   
     //recursive function call
     (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                              i_call_state,
                                               l_id_next_loop,
                                               l_ptr_left_active,
                                               l_ptr_right_active,
@@ -353,78 +737,411 @@ void einsum_ir::basic::ContractionBackend::contract_iter( thread_info   * i_thre
   }
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info   * i_thread_info,
-                                                                 int64_t         i_id_loop,
-                                                                 char    const * i_ptr_left,
-                                                                 char    const * i_ptr_right,
-                                                                 char    const * i_ptr_out_aux,
-                                                                 char          * i_ptr_out,
-                                                                 bool            i_first_access,
-                                                                 bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter_shared( thread_info          * i_thread_info,
+                                                                 call_state_t   const & i_call_state,
+                                                                 int64_t                i_id_loop,
+                                                                 char           const * i_ptr_left,
+                                                                 char           const * i_ptr_right,
+                                                                 char           const * i_ptr_out_aux,
+                                                                 char                 * i_ptr_out,
+                                                                 bool                   i_first_access,
+                                                                 bool                   i_last_access ) {
 
-  // issue loop iterations
   int64_t l_id_next_loop = i_id_loop + m_num_shared_loops;
+
+  //static schedules use the thread's range, dynamic and guided ones take chunks until all tasks are done
   int64_t l_start = i_thread_info->id_shared_loop_start;
   int64_t l_end   = i_thread_info->id_shared_loop_end;
-  for( int64_t l_it = l_start; l_it < l_end; l_it++ ) {
+  if( m_schedule != schedule_t::STATIC ) {
+    next_shared_chunk( i_thread_info->id_shared_group,
+                       i_call_state.shared_counters,
+                       l_start,
+                       l_end );
+  }
+
+  while( l_start < l_end ) {
+    // issue loop iterations
+    for( int64_t l_it = l_start; l_it < l_end; l_it++ ) {
+
+      char const * l_ptr_left    = i_ptr_left;
+      char const * l_ptr_right   = i_ptr_right;
+      char const * l_ptr_out_aux = i_ptr_out_aux;
+      char       * l_ptr_out     = i_ptr_out;
+
+      int64_t l_it_all_loops   = l_it;
+      int64_t l_it_single_loop = 0;
+      int64_t l_id_slot        = 0;
+      for( int64_t l_loop = i_id_loop + m_num_shared_loops - 1; l_loop >= i_id_loop; l_loop-- ) {
+        l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
+        l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
+        if( m_split_k ) {
+          l_id_slot += l_it_single_loop * m_strides_slot_split_k[l_loop];
+        }
+
+        //update pointer
+        l_ptr_left    = l_ptr_left    + l_it_single_loop * m_strides_left[    l_loop ];
+        l_ptr_right   = l_ptr_right   + l_it_single_loop * m_strides_right[   l_loop ];
+        l_ptr_out_aux = l_ptr_out_aux + l_it_single_loop * m_strides_out_aux[ l_loop ];
+        l_ptr_out     = l_ptr_out     + l_it_single_loop * m_strides_out[     l_loop ];
+      }
 
-    char const * l_ptr_left    = i_ptr_left;
-    char const * l_ptr_right   = i_ptr_right;
-    char const * l_ptr_out_aux = i_ptr_out_aux;
-    char       * l_ptr_out     = i_ptr_out;
+      //pack left tensor
+      if( m_packing_left_id == l_id_next_loop )  {
+        if( l_ptr_left != i_thread_info->cached_ptrs_left[0] ){
+          EINSUM_IR_STATS_START( l_cycles_packing )
+          m_unary_left.eval(l_ptr_left, i_thread_info->memory_left);
+          EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_left )
+          EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_misses_left )
+          i_thread_info->cached_ptrs_left[0] = l_ptr_left;
+        }
+        else{
+          EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_hits_left )
+        }
+        l_ptr_left = i_thread_info->memory_left;
+      }
+
+      //pack right tensor
+      if( m_packing_right_id == l_id_next_loop )  {
+        if( l_ptr_right != i_thread_info->cached_ptrs_right[0]){
+          EINSUM_IR_STATS_START( l_cycles_packing )
+          m_unary_right.eval(l_ptr_right, i_thread_info->memory_right);
+          EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_right )
+          EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_misses_right )
+          i_thread_info->cached_ptrs_right[0] = l_ptr_right;
+        }
+        else{
+          EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_hits_right )
+        }
+        l_ptr_right = i_thread_info->memory_right;
+      }
 
-    int64_t l_it_all_loops   = l_it;
-    int64_t l_it_single_loop = 0;
-    for( int64_t l_loop = i_id_loop + m_num_shared_loops - 1; l_loop >= i_id_loop; l_loop-- ) {
-      l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
-      l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
 
-      //update pointer
-      l_ptr_left    = l_ptr_left    + l_it_single_loop * m_strides_left[    l_loop ];
-      l_ptr_right   = l_ptr_right   + l_it_single_loop * m_strides_right[   l_loop ];
-      l_ptr_out_aux = l_ptr_out_aux + l_it_single_loop * m_strides_out_aux[ l_loop ];
-      l_ptr_out     = l_ptr_out     + l_it_single_loop * m_strides_out[     l_loop ];
+      //split-K: the partial output of a slot is first touched by the thread's first task of the slot
+      bool l_first_access = i_first_access;
+      if( m_split_k ) {
+        int64_t l_id_thread = i_thread_info - m_thread_infos.data();
+        uint8_t & l_touched = i_call_state.touched_split_k[ l_id_thread * m_stride_touched_split_k + l_id_slot ];
+        l_first_access = i_first_access && ( l_touched == 0 );
+        l_touched = 1;
+      }
+
+      //recursive function call
+      (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                                i_call_state,
+                                                l_id_next_loop,
+                                                l_ptr_left,
+                                                l_ptr_right,
+                                                l_ptr_out_aux,
+                                                l_ptr_out,
+                                                l_first_access,
+                                                i_last_access );
     }
 
-    //pack left tensor
-    if( m_packing_left_id == l_id_next_loop )  {
-      if( l_ptr_left != i_thread_info->cached_ptrs_left[0] ){
-        m_unary_left.eval(l_ptr_left, i_thread_info->memory_left);
-        i_thread_info->cached_ptrs_left[0] = l_ptr_left;
+    if( m_schedule != schedule_t::STATIC ) {
+      next_shared_chunk( i_thread_info->id_shared_group,
+                         i_call_state.shared_counters,
+                         l_start,
+                         l_end );
+    }
+    else {
+      l_start = l_end;
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::next_shared_chunk( int64_t            i_id_group,
+                                                              shared_counter_t * io_counters,
+                                                              int64_t          & o_start,
+                                                              int64_t          & o_end ) {
+  std::atomic< int64_t > & l_next = io_counters[i_id_group].next;
+  int64_t l_chunk_size = m_chunk_size_shared;
+
+  if( m_schedule == schedule_t::GUIDED ) {
+    //chunk size is proportional to the number of remaining tasks
+    int64_t l_start = l_next.load( std::memory_order_relaxed );
+    do {
+      int64_t l_remaining = m_num_tasks_shared - l_start;
+      l_chunk_size = (l_remaining + 2 * m_num_threads_shared - 1) / (2 * m_num_threads_shared);
+      l_chunk_size = std::max( l_chunk_size, m_chunk_size_shared );
+    } while(    l_start < m_num_tasks_shared
+             && !l_next.compare_exchange_weak( l_start,
+                                               l_start + l_chunk_size,
+                                               std::memory_order_relaxed ) );
+    o_start = l_start;
+  }
+  else {
+    o_start = l_next.fetch_add( l_chunk_size,
+                                std::memory_order_relaxed );
+  }
+
+  o_start = std::min( o_start,                m_num_tasks_shared );
+  o_end   = std::min( o_start + l_chunk_size, m_num_tasks_shared );
+}
+
+template< typename T >
+void einsum_ir::basic::ContractionBackend::add_elements( int64_t         i_size,
+                                                         int64_t         i_stride,
+                                                         char    const * i_in,
+                                                         char          * io_out ) {
+  if( i_stride == sizeof(T) ) {
+    T const * l_in  = (T const *) i_in;
+    T       * l_out = (T       *) io_out;
+    for( int64_t l_el = 0; l_el < i_size; l_el++ ) {
+      l_out[l_el] += l_in[l_el];
+    }
+  }
+  else {
+    for( int64_t l_el = 0; l_el < i_size; l_el++ ) {
+      *(T *) (io_out + l_el * i_stride) += *(T const *) (i_in + l_el * i_stride);
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::add_partial( int64_t         i_size,
+                                                        int64_t         i_stride,
+                                                        char    const * i_in,
+                                                        char          * io_out ) const {
+  // partial outputs of quantized contractions hold INT32 accumulators
+  if( m_dtype_comp == data_t::INT32 ){
+    add_elements< int32_t >( i_size, i_stride, i_in, io_out );
+  }
+  else if( m_dtype_out == data_t::FP32 ){
+    add_elements< float   >( i_size, i_stride, i_in, io_out );
+  }
+  else{
+    add_elements< double  >( i_size, i_stride, i_in, io_out );
+  }
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::setup_split_k() {
+  int64_t l_num_iters = m_dim_sizes.size();
+  int64_t l_size_elem = ce_n_bytes( m_dtype_out );
+
+  //a thread enters its slots once per contraction if the shared loops are the outermost loops
+  if( m_exec_type[0] != exec_t::OMP ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  //slots of the non-K shared loops
+  m_strides_slot_split_k.assign( l_num_iters, 0 );
+  m_num_slots_split_k = 1;
+  for( int64_t l_id = m_num_shared_loops - 1; l_id >= 0; l_id-- ) {
+    if( m_dim_type[l_id] != dim_t::K ) {
+      m_strides_slot_split_k[l_id] = m_num_slots_split_k;
+      m_num_slots_split_k *= m_dim_sizes[l_id];
+    }
+  }
+  m_stride_touched_split_k = ( (m_num_slots_split_k + 63) / 64 ) * 64;
+
+  //rows of the output tiles, the innermost primitive loop is reduced at once
+  m_loops_elem_split_k.clear();
+  for( int64_t l_id = 0; l_id < l_num_iters; l_id++ ) {
+    if(    m_dim_type[l_id]  != dim_t::K
+        && m_exec_type[l_id] == exec_t::PRIM ) {
+      m_loops_elem_split_k.push_back( l_id );
+    }
+  }
+  std::stable_sort( m_loops_elem_split_k.begin(),
+                    m_loops_elem_split_k.end(),
+                    [&]( int64_t l_a, int64_t l_b ) -> bool {
+                      return m_strides_out_split_k[l_a] > m_strides_out_split_k[l_b];
+                    } );
+
+  int64_t l_num_loops_elem = m_loops_elem_split_k.size();
+  m_num_rows_split_k   = 1;
+  m_size_row_split_k   = 1;
+  m_stride_row_split_k = 0;
+  if( l_num_loops_elem > 0 ) {
+    m_size_row_split_k   = m_dim_sizes[           m_loops_elem_split_k.back() ];
+    m_stride_row_split_k = m_strides_out_split_k[ m_loops_elem_split_k.back() ];
+  }
+  for( int64_t l_lo = 0; l_lo < l_num_loops_elem - 1; l_lo++ ) {
+    m_num_rows_split_k *= m_dim_sizes[ m_loops_elem_split_k[l_lo] ];
+  }
+
+  //bytes of the output block of a sfc position, the non-K shared loops are covered entirely since their tasks might be taken dynamically
+  int64_t l_min_block = 0;
+  int64_t l_max_block = 0;
+  for( int64_t l_id = 0; l_id < l_num_iters; l_id++ ) {
+    if(    m_dim_type[l_id]  != dim_t::K
+        && m_exec_type[l_id] != exec_t::SFC ) {
+      int64_t l_extent = (m_dim_sizes[l_id] - 1) * m_strides_out_split_k[l_id];
+      l_min_block += std::min( l_extent, (int64_t) 0 );
+      l_max_block += std::max( l_extent, (int64_t) 0 );
+    }
+  }
+
+  //follow the sfc of every thread: the partial output covers the output blocks of all sfc positions
+  int64_t l_num_groups = m_num_threads_sfc_m * m_num_threads_sfc_n;
+  m_threads_group_split_k.assign( l_num_groups, std::vector< int64_t >() );
+  m_offsets_split_k.assign( m_num_threads, 0 );
+  m_size_out_split_k = 0;
+  std::map< int64_t, int64_t > l_groups_sfc;
+
+  for( int64_t l_th = 0; l_th < m_num_threads; l_th++ ) {
+    thread_info const & l_thread_inf = m_thread_infos[l_th];
+    int64_t l_id_group = l_thread_inf.id_shared_group;
+    if( l_id_group < 0 || l_id_group >= l_num_groups ) {
+      return err_t::COMPILATION_FAILED;
+    }
+    m_threads_group_split_k[l_id_group].push_back( l_th );
+
+    int64_t l_offset     = l_thread_inf.offset_out;
+    int64_t l_offset_min = l_offset;
+    int64_t l_offset_max = l_offset;
+    l_groups_sfc[l_offset] = l_id_group;
+
+    //the movement after the last position is not used
+    int64_t l_num_moves = (int64_t) l_thread_inf.movement_ids.size() - 1;
+    for( int64_t l_mo = 0; l_mo < l_num_moves; l_mo++ ) {
+      sfc_t   l_move      = l_thread_inf.movement_ids[l_mo];
+      int64_t l_direction = 1 - ( (int64_t) (l_move & 1) << 1 );
+      l_offset += l_direction * m_strides_out[ l_move >> 1 ];
+
+      l_offset_min = std::min( l_offset_min, l_offset );
+      l_offset_max = std::max( l_offset_max, l_offset );
+      l_groups_sfc[l_offset] = l_id_group;
+    }
+
+    m_offsets_split_k[l_th] = l_offset_min + l_min_block;
+    m_size_out_split_k = std::max( m_size_out_split_k,
+                                   l_offset_max + l_max_block + l_size_elem - m_offsets_split_k[l_th] );
+  }
+
+  //output tiles of the non-primitive loops
+  std::vector< int64_t > l_loops_tile;
+  int64_t l_num_tiles = 1;
+  for( int64_t l_id = 0; l_id < l_num_iters; l_id++ ) {
+    if(    m_dim_type[l_id]  != dim_t::K
+        && m_exec_type[l_id] != exec_t::PRIM ) {
+      l_loops_tile.push_back( l_id );
+      l_num_tiles *= m_dim_sizes[l_id];
+    }
+  }
+
+  m_tiles_split_k.resize( l_num_tiles );
+  for( int64_t l_ti = 0; l_ti < l_num_tiles; l_ti++ ) {
+    tile_split_k_t & l_tile = m_tiles_split_k[l_ti];
+    l_tile = tile_split_k_t();
+
+    int64_t l_offset_sfc   = 0;
+    int64_t l_it_all_loops = l_ti;
+    for( int64_t l_lo = l_loops_tile.size() - 1; l_lo >= 0; l_lo-- ) {
+      int64_t l_id_loop = l_loops_tile[l_lo];
+      int64_t l_it_single_loop = l_it_all_loops % m_dim_sizes[l_id_loop];
+      l_it_all_loops = l_it_all_loops / m_dim_sizes[l_id_loop];
+
+      l_tile.offset_out     += l_it_single_loop * m_strides_out_split_k[    l_id_loop ];
+      l_tile.offset_out_aux += l_it_single_loop * m_strides_out_aux_split_k[l_id_loop ];
+      l_tile.id_slot        += l_it_single_loop * m_strides_slot_split_k[   l_id_loop ];
+      if( m_exec_type[l_id_loop] == exec_t::SFC ) {
+        l_offset_sfc += l_it_single_loop * m_strides_out_split_k[l_id_loop];
       }
-      l_ptr_left = i_thread_info->memory_left;
     }
 
-    //pack right tensor
-    if( m_packing_right_id == l_id_next_loop )  {
-      if( l_ptr_right != i_thread_info->cached_ptrs_right[0]){
-        m_unary_right.eval(l_ptr_right, i_thread_info->memory_right);
-        i_thread_info->cached_ptrs_right[0] = l_ptr_right;
+    std::map< int64_t, int64_t >::const_iterator l_group = l_groups_sfc.find( l_offset_sfc );
+    if( l_group == l_groups_sfc.end() ) {
+      return err_t::COMPILATION_FAILED;
+    }
+    l_tile.id_group = l_group->second;
+  }
+
+  return err_t::SUCCESS;
+}
+
+int64_t einsum_ir::basic::ContractionBackend::offset_row_split_k( int64_t i_id_row ) const {
+  int64_t l_offset_row   = 0;
+  int64_t l_it_all_loops = i_id_row;
+  for( int64_t l_lo = (int64_t) m_loops_elem_split_k.size() - 2; l_lo >= 0; l_lo-- ) {
+    int64_t l_id_loop = m_loops_elem_split_k[l_lo];
+    int64_t l_it_single_loop = l_it_all_loops % m_dim_sizes[l_id_loop];
+    l_it_all_loops = l_it_all_loops / m_dim_sizes[l_id_loop];
+
+    l_offset_row += l_it_single_loop * m_strides_out_split_k[l_id_loop];
+  }
+
+  return l_offset_row;
+}
+
+void einsum_ir::basic::ContractionBackend::zero_partial( char * io_out ) const {
+  int64_t l_size_elem = ce_n_bytes( m_dtype_out );
+
+  for( int64_t l_ro = 0; l_ro < m_num_rows_split_k; l_ro++ ) {
+    char * l_ptr_row = io_out + offset_row_split_k( l_ro );
+
+    if( m_stride_row_split_k == l_size_elem ) {
+      std::memset( l_ptr_row,
+                   0,
+                   m_size_row_split_k * l_size_elem );
+    }
+    else {
+      for( int64_t l_el = 0; l_el < m_size_row_split_k; l_el++ ) {
+        std::memset( l_ptr_row + l_el * m_stride_row_split_k,
+                     0,
+                     l_size_elem );
       }
-      l_ptr_right = i_thread_info->memory_right;
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackend::reduce_split_k( int64_t         i_thread_id,
+                                                           uint8_t const * i_touched_split_k,
+                                                           void    const * i_tensor_out_aux,
+                                                           void          * io_tensor_out ) {
+  //static distribution of the output tiles
+  int64_t l_num_tiles = m_tiles_split_k.size();
+  int64_t l_tiles_per_thread = (l_num_tiles + m_num_threads - 1) / m_num_threads;
+  int64_t l_start = std::min( i_thread_id * l_tiles_per_thread, l_num_tiles );
+  int64_t l_end   = std::min( l_start     + l_tiles_per_thread, l_num_tiles );
+
+  for( int64_t l_ti = l_start; l_ti < l_end; l_ti++ ){
+    tile_split_k_t const & l_tile = m_tiles_split_k[l_ti];
+    char const * l_ptr_out_aux = (char const *) i_tensor_out_aux + l_tile.offset_out_aux;
+    char       * l_ptr_out     = (char       *) io_tensor_out    + l_tile.offset_out;
+
+    if( m_has_first_touch ){
+      kernel_first_touch( l_ptr_out_aux,
+                          l_ptr_out );
     }
 
+    //add the partial outputs of the group's threads which touched the tile
+    std::vector< int64_t > const & l_threads = m_threads_group_split_k[l_tile.id_group];
+    for( std::size_t l_th = 0; l_th < l_threads.size(); l_th++ ){
+      int64_t l_id_thread = l_threads[l_th];
+      if( i_touched_split_k[ l_id_thread * m_stride_touched_split_k + l_tile.id_slot ] == 0 ){
+        continue;
+      }
 
-    //recursive function call
-    (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
-                                              l_id_next_loop,
-                                              l_ptr_left,
-                                              l_ptr_right,
-                                              l_ptr_out_aux,
-                                              l_ptr_out,
-                                              i_first_access,
-                                              i_last_access );
+      char const * l_ptr_partial =   m_memory->get_thread_memory( l_id_thread )
+                                   + m_offset_split_k
+                                   + l_tile.offset_out
+                                   - m_offsets_split_k[l_id_thread];
+
+      for( int64_t l_ro = 0; l_ro < m_num_rows_split_k; l_ro++ ){
+        int64_t l_offset_row = offset_row_split_k( l_ro );
+        add_partial( m_size_row_split_k,
+                     m_stride_row_split_k,
+                     l_ptr_partial + l_offset_row,
+                     l_ptr_out     + l_offset_row );
+      }
+    }
+
+    if( m_has_last_touch ){
+      kernel_last_touch( l_ptr_out_aux,
+                         l_ptr_out );
+    }
   }
 }
 
-void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_thread_info,
-                                                              int64_t         i_id_loop,
-                                                              char    const * i_ptr_left,
-                                                              char    const * i_ptr_right,
-                                                              char    const * i_ptr_out_aux,
-                                                              char          * i_ptr_out,
-                                                              bool            i_first_access,
-                                                              bool            i_last_access ) {
+void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info          * i_thread_info,
+                                                              call_state_t   const & i_call_state,
+                                                              int64_t                i_id_loop,
+                                                              char           const * i_ptr_left,
+                                                              char           const * i_ptr_right,
+                                                              char           const * i_ptr_out_aux,
+                                                              char                 * i_ptr_out,
+                                                              bool                   i_first_access,
+                                                              bool                   i_last_access ) {
   bool l_first_access = i_first_access;
   bool l_last_access  = i_last_access;
 
@@ -437,6 +1154,7 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
   // issue loop iterations
   uint64_t l_id_m = 0;
   uint64_t l_id_n = 0;
+  uint64_t l_id_k = 0;
   for( int64_t l_it = 0; l_it < l_size; l_it++ ) {
 
     //determine if this is the first or last access in the k dimension
@@ -456,27 +1174,40 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
     //pack left tensor
     const char * l_ptr_left_active = i_ptr_left;
     if( m_packing_left_id == l_id_next_loop )  {
-      int64_t l_id = l_id_m % m_num_cached_ptrs_left;
+      int64_t l_id = (l_id_m + l_id_k * i_thread_info->sfc_size_m) % m_num_cached_ptrs_left;
       l_ptr_left_active = i_thread_info->memory_left + l_id * m_size_packing_left;
       if( i_ptr_left != i_thread_info->cached_ptrs_left[l_id] ){
+        EINSUM_IR_STATS_START( l_cycles_packing )
         m_unary_left.eval(i_ptr_left, (void *)l_ptr_left_active);
+        EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_left )
+        EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_misses_left )
         i_thread_info->cached_ptrs_left[l_id] = i_ptr_left;
       }
+      else{
+        EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_hits_left )
+      }
     }
 
     //pack right tensor
     const char * l_ptr_right_active = i_ptr_right;
     if( m_packing_right_id == l_id_next_loop )  {
-      int64_t l_id = l_id_n % m_num_cached_ptrs_right;
+      int64_t l_id = (l_id_n + l_id_k * i_thread_info->sfc_size_n) % m_num_cached_ptrs_right;
       l_ptr_right_active = i_thread_info->memory_right + l_id * m_size_packing_right;
       if( i_ptr_right != i_thread_info->cached_ptrs_right[l_id]){
+        EINSUM_IR_STATS_START( l_cycles_packing )
         m_unary_right.eval(i_ptr_right, (void *)l_ptr_right_active);
+        EINSUM_IR_STATS_STOP( l_cycles_packing, stats( i_thread_info ).packing_right )
+        EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_misses_right )
         i_thread_info->cached_ptrs_right[l_id] = i_ptr_right;
       }
+      else{
+        EINSUM_IR_STATS_ADD( stats( i_thread_info ).packing_hits_right )
+      }
     }
     
     //recursive function call
     (this->*(m_loop_functs[l_id_next_loop]))( i_thread_info,
+                                              i_call_state,
                                               l_id_next_loop,
                                               l_ptr_left_active,
                                               l_ptr_right_active,
@@ -488,6 +1219,7 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
     //update m and n ids
     l_id_m += l_direction * (m_dim_type[l_current_id] == dim_t::M);
     l_id_n += l_direction * (m_dim_type[l_current_id] == dim_t::N);
+    l_id_k += l_direction * (m_dim_type[l_current_id] == dim_t::K);
 
     //update pointer
     i_ptr_left    += l_direction * m_strides_left[    l_current_id ];
@@ -498,29 +1230,80 @@ void einsum_ir::basic::ContractionBackend::contract_iter_sfc( thread_info   * i_
 }
 
 
-void einsum_ir::basic::ContractionBackend::contract_iter_kernel( thread_info   * i_thread_info,
-                                                                 int64_t         i_id_loop,
-                                                                 char    const * i_ptr_left,
-                                                                 char    const * i_ptr_right,
-                                                                 char    const * i_ptr_out_aux,
-                                                                 char          * i_ptr_out,
-                                                                 bool            i_first_access,
-                                                                 bool            i_last_access ) {
-  if( i_first_access ) {
-    kernel_first_touch( i_ptr_out_aux,
-                        i_ptr_out );
-  }
-  kernel_main( i_ptr_left,
-               i_ptr_right,
-               i_ptr_out );
+void einsum_ir::basic::ContractionBackend::contract_iter_kernel( thread_info          * i_thread_info,
+                                                                 call_state_t   const & i_call_state,
+                                                                 int64_t                i_id_loop,
+                                                                 char           const * i_ptr_left,
+                                                                 char           const * i_ptr_right,
+                                                                 char           const * i_ptr_out_aux,
+                                                                 char                 * i_ptr_out,
+                                                                 bool                   i_first_access,
+                                                                 bool                   i_last_access ) {
+  //split-K: the first touch zeroes the tile of the partial output
+  if( m_split_k ) {
+    if( i_first_access ) {
+      EINSUM_IR_STATS_START( l_cycles_first_touch )
+      zero_partial( i_ptr_out );
+      EINSUM_IR_STATS_STOP( l_cycles_first_touch, stats( i_thread_info ).first_touch )
+    }
+    if( !m_skip_main ) {
+      EINSUM_IR_STATS_START( l_cycles_main )
+      kernel_main( i_ptr_left,
+                   i_ptr_right,
+                   i_ptr_out,
+                   i_thread_info->memory_scratch );
+      EINSUM_IR_STATS_STOP( l_cycles_main, stats( i_thread_info ).main )
+    }
+  }
+  else if( m_skip_main ) {
+    if( i_first_access ) {
+      EINSUM_IR_STATS_START( l_cycles_first_touch )
+      kernel_first_touch( i_ptr_out_aux,
+                          i_ptr_out );
+      EINSUM_IR_STATS_STOP( l_cycles_first_touch, stats( i_thread_info ).first_touch )
+    }
+  }
+  else if( i_first_access ) {
+    EINSUM_IR_STATS_START( l_cycles_first_touch )
+    kernel_main_first_touch( i_ptr_left,
+                             i_ptr_right,
+                             i_ptr_out_aux,
+                             i_ptr_out,
+                             i_thread_info->memory_scratch );
+    EINSUM_IR_STATS_STOP( l_cycles_first_touch, stats( i_thread_info ).first_touch )
+  }
+  else {
+    EINSUM_IR_STATS_START( l_cycles_main )
+    kernel_main( i_ptr_left,
+                 i_ptr_right,
+                 i_ptr_out,
+                 i_thread_info->memory_scratch );
+    EINSUM_IR_STATS_STOP( l_cycles_main, stats( i_thread_info ).main )
+  }
   
   if( i_last_access ) {
+    EINSUM_IR_STATS_START( l_cycles_last_touch )
     kernel_last_touch( i_ptr_out_aux,
                        i_ptr_out );
+    EINSUM_IR_STATS_STOP( l_cycles_last_touch, stats( i_thread_info ).last_touch )
   }                                                             
 }
 
 
+void einsum_ir::basic::ContractionBackend::kernel_main_first_touch( void const * i_left,
+                                                                    void const * i_right,
+                                                                    void const * i_out_aux,
+                                                                    void       * io_out,
+                                                                    char       * io_scratch ) {
+  kernel_first_touch( i_out_aux,
+                      io_out );
+  kernel_main( i_left,
+               i_right,
+               io_out,
+               io_scratch );
+}
+
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::set_kernel_shape( ){
   //check that there are enough primitive dimensions
   int64_t l_size = m_dim_sizes.size();
@@ -687,7 +1470,8 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( in
                                                                               int64_t              & o_size_packing,
                                                                               UnaryBackendTpp      & o_unary,
                                                                               std::vector<int64_t> & i_strides,
-                                                                              std::vector<int64_t> & i_packing_strides ){
+                                                                              std::vector<int64_t> & i_packing_strides,
+                                                                              data_t                 i_dtype ){
   //determine size of and iteration id of packing
   o_packing_id = -1;
   for( std::size_t l_id = 0; l_id < i_packing_strides.size(); l_id++ ) {
@@ -733,7 +1517,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackend::create_packing( in
     }
 
     //init and compile kernel
-    o_unary.init(l_packing_iters, m_dtype_left, m_dtype_comp, m_dtype_out, kernel_t::COPY, 1);
+    o_unary.init(l_packing_iters, i_dtype, m_dtype_comp, i_dtype, kernel_t::COPY, 1);
     l_err = o_unary.compile();
     if( l_err != err_t::SUCCESS ) {
       return l_err;
@@ -1,9 +1,12 @@
 #ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND
 #define EINSUM_IR_BASIC_BINARY_CONTRACTION_BACKEND
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "../constants.h"
+#include "../ThreadPool.h"
 #include "IterationSpace.h"
 #include "ContractionMemoryManager.h"
 #include "../unary/UnaryBackendTpp.h"
@@ -51,6 +54,15 @@ class einsum_ir::basic::ContractionBackend {
     //! vector with thread personal information
     std::vector<thread_info> m_thread_infos;
 
+    //! instrumentation counters of the threads, only updated if built with PP_EINSUM_IR_INSTRUMENT
+    std::vector< thread_stats > m_stats;
+
+    //! true if the thread infos were set before compilation and replace the setup of the iteration space
+    bool m_thread_infos_preset = false;
+
+    //! number of cached packed blocks per input of preset thread infos
+    int64_t m_caching_size_preset = 0;
+
     //! indicates if the backend is compiled
     bool m_is_compiled = false;
 
@@ -81,7 +93,229 @@ class einsum_ir::basic::ContractionBackend {
     //! number of cached pointers for right input tensor
     int64_t m_num_cached_ptrs_right = 1;
 
+    //! executor which runs the per-thread tasks
+    executor_t m_executor = executor_t::OPENMP;
+
+    //! schedule of the shared loops
+    schedule_t m_schedule = schedule_t::STATIC;
+
+    //! number of tasks in the shared loops
+    int64_t m_num_tasks_shared = 1;
+
+    //! (minimum) number of shared tasks which a thread takes from the counter of its group
+    int64_t m_chunk_size_shared = 1;
+
+    //! counter of the next shared task, aligned to avoid false sharing
+    struct alignas(128) shared_counter_t {
+      std::atomic< int64_t > next{ 0 };
+    };
+
+    //! number of shared counters, i.e., one counter per group of threads with the same sfc ids
+    int64_t m_num_shared_counters = 0;
+
+    //! runtime state of a single call of contract, concurrent contractions do not share the state
+    struct call_state_t {
+      //! counters of the shared tasks, nullptr for static schedules
+      shared_counter_t * shared_counters = nullptr;
+      //! flags of the slots which were touched by the threads, padded per thread, nullptr without split-K
+      uint8_t * touched_split_k = nullptr;
+    };
+
+    /**
+     * Takes the next chunk of shared tasks from the counter of a thread group.
+     * Used for dynamic and guided schedules.
+     *
+     * @param i_id_group id of the thread group.
+     * @param io_counters counters of the shared tasks of the contraction.
+     * @param o_start will be set to the first task of the chunk.
+     * @param o_end will be set to the end of the chunk; equals o_start if all tasks are taken.
+     **/
+    void next_shared_chunk( int64_t            i_id_group,
+                            shared_counter_t * io_counters,
+                            int64_t          & o_start,
+                            int64_t          & o_end );
+
+    //! true if at least one shared loop has dimension type K (split-K)
+    bool m_split_k = false;
+
+    //! byte strides of the output tensor before they are converted for the sfc loops
+    std::vector< int64_t > m_strides_out_split_k;
+
+    //! byte strides of the auxiliary output tensor before they are converted for the sfc loops
+    std::vector< int64_t > m_strides_out_aux_split_k;
+
+    //! output tile of a split-K contraction
+    struct tile_split_k_t {
+      //! byte offset of the tile in the output tensor
+      int64_t offset_out = 0;
+      //! byte offset of the tile in the auxiliary output tensor
+      int64_t offset_out_aux = 0;
+      //! id of the thread group which computes the tile
+      int64_t id_group = 0;
+      //! id of the tile's slot, i.e., the combined id of the non-K shared loops
+      int64_t id_slot = 0;
+    };
+
+    //! output tiles, i.e., the tiles of the kernels' outputs
+    std::vector< tile_split_k_t > m_tiles_split_k;
+
+    //! ids of the threads of every thread group
+    std::vector< std::vector< int64_t > > m_threads_group_split_k;
+
+    //! strides of the slot ids, zero for all loops except the non-K shared loops
+    std::vector< int64_t > m_strides_slot_split_k;
+
+    //! number of slots
+    int64_t m_num_slots_split_k = 0;
+
+    //! ids of the primitive output loops, the loop with the smallest stride is last
+    std::vector< int64_t > m_loops_elem_split_k;
+
+    //! number of rows of an output tile
+    int64_t m_num_rows_split_k = 0;
+
+    //! number of elements in a row of an output tile
+    int64_t m_size_row_split_k = 0;
+
+    //! byte stride of the elements in a row of an output tile
+    int64_t m_stride_row_split_k = 0;
+
+    //! byte offset in the output tensor of the first byte of every thread's partial output
+    std::vector< int64_t > m_offsets_split_k;
+
+    //! distance of two threads in the touched flags of a contraction
+    int64_t m_stride_touched_split_k = 0;
+
+    //! number of bytes of the largest partial output, a partial output covers the output block of the thread's group
+    int64_t m_size_out_split_k = 0;
+
+    //! offset of the partial output in the thread memory
+    int64_t m_offset_split_k = 0;
+
+    //! offset of the kernels' scratch memory in the thread memory
+    int64_t m_offset_scratch = 0;
+
+    /**
+     * Runs i_func( l_thread_id ) for all threads of the contraction on the selected executor.
+     *
+     * @param i_func callable with signature void( int64_t ).
+     **/
+    template< typename T >
+    void execute( T const & i_func ) {
+      if( m_executor == executor_t::THREAD_POOL ) {
+        ThreadPool::get_instance()->parallel_for( m_num_threads,
+                                                  i_func );
+      }
+      else {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(m_num_threads)
+#endif
+        for( int64_t l_thread_id = 0; l_thread_id < m_num_threads; l_thread_id++ ) {
+          i_func( l_thread_id );
+        }
+      }
+    }
+
+    /**
+     * Adds a strided vector to another one: io_out[i*i_stride] += i_in[i*i_stride].
+     *
+     * @param i_size number of elements.
+     * @param i_stride stride of the elements in bytes.
+     * @param i_in input data.
+     * @param io_out data which is updated.
+     **/
+    template< typename T >
+    static void add_elements( int64_t         i_size,
+                              int64_t         i_stride,
+                              char    const * i_in,
+                              char          * io_out );
+
+    /**
+     * Adds a strided partial output of a split-K contraction to another one in the accumulator datatype.
+     *
+     * @param i_size number of elements.
+     * @param i_stride stride of the elements in bytes.
+     * @param i_in input data.
+     * @param io_out data which is updated.
+     **/
+    void add_partial( int64_t         i_size,
+                      int64_t         i_stride,
+                      char    const * i_in,
+                      char          * io_out ) const;
+
+    /**
+     * Derives the output tiles, thread groups and partial outputs of a split-K contraction.
+     * Requires the thread infos and the byte strides of the output tensor.
+     *
+     * @return SUCCESS if the split-K contraction is supported, otherwise an appropiate error code.
+     **/
+    err_t setup_split_k();
+
+    /**
+     * Gets the byte offset of a row in an output tile.
+     *
+     * @param i_id_row id of the row.
+     * @return offset of the row w.r.t. the tile.
+     **/
+    int64_t offset_row_split_k( int64_t i_id_row ) const;
+
+    /**
+     * Zeroes an output tile in a partial output.
+     *
+     * @param io_out output tile.
+     **/
+    void zero_partial( char * io_out ) const;
+
+    /**
+     * Combines the partial outputs of a split-K contraction for the output tiles assigned to one thread.
+     * Applies the first touch kernel, adds the partial outputs of the threads which touched the tile and applies the last touch kernel.
+     *
+     * @param i_thread_id id of the thread's task.
+     * @param i_touched_split_k touched flags of the contraction.
+     * @param i_tensor_out_aux auxiliary data w.r.t. output tensor.
+     * @param io_tensor_out output tensor.
+     **/
+    void reduce_split_k( int64_t         i_thread_id,
+                         uint8_t const * i_touched_split_k,
+                         void    const * i_tensor_out_aux,
+                         void          * io_tensor_out );
+
+    /**
+     * Sets the epilogue program of the last touch.
+     * Single unary or binary last touch kernels beyond RELU and ADD are converted to programs with one op.
+     *
+     * @param i_epilogue epilogue program which is used if the last touch kernel is EPILOGUE.
+     **/
+    void init_epilogue( std::vector< epilogue_op > const & i_epilogue );
+
+    /**
+     * Checks the configuration of quantized contractions which have INT8 inputs and INT32 accumulators.
+     * INT32 outputs hold the accumulators, FP32 outputs are dequantized in place by an epilogue program starting with DEQUANT.
+     *
+     * @return SUCCESS if the contraction is not quantized or the configuration is supported, otherwise an appropiate error code.
+     **/
+    err_t check_quantization() const;
+
+    /**
+     * Gets the instrumentation counters of a thread.
+     *
+     * @param i_thread_info thread info of the thread.
+     * @return counters of the thread.
+     **/
+    thread_stats & stats( thread_info const * i_thread_info );
+
   protected:
+    /**
+     * Folds alpha and beta into the kernels for backends without native support of the scaling factors.
+     * The first touch is followed by a scaling with beta, i.e., m_scale_first_touch.
+     * If the first touch zeroes the output, the last touch is an epilogue program which starts with a multiplication by alpha.
+     * Otherwise m_alpha is kept and the main kernels have to scale the products by alpha.
+     * If alpha is zero, the first touch scales with beta and the main kernel is skipped.
+     *
+     * @return SUCCESS if the scaling factors could be folded, otherwise an appropiate error code.
+     **/
+    err_t fold_alpha_beta();
+
     //! datatype of the left input
     data_t m_dtype_left = UNDEFINED_DTYPE;
 
@@ -124,10 +358,26 @@ class einsum_ir::basic::ContractionBackend {
 
     //! type of the first touch kernel
     kernel_t m_ktype_first_touch = UNDEFINED_KTYPE;
+    //! true if zero and copy first touches may be folded into the main kernel
+    bool m_fuse_first_touch = true;
     //! type of the main kernel
     kernel_t  m_ktype_main = UNDEFINED_KTYPE;
     //! type of the last touch kernel
     kernel_t m_ktype_last_touch = UNDEFINED_KTYPE;
+    //! epilogue program which is applied to the output as last touch if m_ktype_last_touch is EPILOGUE
+    std::vector< epilogue_op > m_epilogue;
+    //! scaling factor of the contraction's result
+    double m_alpha = 1.0;
+    //! scaling factor of the output after the first touch
+    double m_beta = 1.0;
+    //! true if complex main kernels use three real multiplications (3M) instead of four
+    bool m_cpx_3m = false;
+    //! scaling with beta applied after the first touch kernel by backends without native support of beta
+    double m_scale_first_touch = 1.0;
+    //! true if the main kernel is skipped since alpha is zero, i.e., only the touch kernels are applied
+    bool m_skip_main = false;
+    //! number of bytes of scratch memory per thread which is required by the main kernels, set in compile_kernels
+    int64_t m_size_scratch = 0;
 
     //! kernel br size
     uint64_t m_br = 0;
@@ -179,6 +429,7 @@ class einsum_ir::basic::ContractionBackend {
 
     //! vector of function pointers to the loop implementations, set once during compielation and used in contraction
     std::vector<void (ContractionBackend::*)( thread_info *,
+                                              call_state_t const &,
                                               int64_t,
                                               char const  *,
                                               char const  *,
@@ -188,6 +439,11 @@ class einsum_ir::basic::ContractionBackend {
                                               bool) > m_loop_functs;
     
   public:
+    /**
+     * Destructor.
+     **/
+    virtual ~ContractionBackend() = default;
+
     /**
      * Initializes the class.
      *
@@ -211,6 +467,13 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_num_threads_sfc_m number of threads used for sfc m parallelization.
      * @param i_num_threads_sfc_n number of threads used for sfc n parallelization.
      * @param i_contraction_mem pointer to the contraction memory manager.
+     * @param i_executor executor which runs the per-thread tasks.
+     * @param i_schedule schedule of the shared loops.
+     * @param i_fuse_first_touch true if zero and copy first touches may be folded into the main kernel.
+     * @param i_epilogue epilogue program which is used if the last touch kernel is EPILOGUE.
+     * @param i_alpha scaling factor of the contraction's result.
+     * @param i_beta scaling factor of the output tensor after the first touch.
+     * @param i_cpx_3m true if complex main kernels should use three real multiplications (3M) instead of four.
      **/
     void init( std::vector< dim_t >   const & i_dim_type,
                std::vector< exec_t >  const & i_exec_type,
@@ -231,7 +494,14 @@ class einsum_ir::basic::ContractionBackend {
                int64_t                        i_num_threads_shared,
                int64_t                        i_num_threads_sfc_m,
                int64_t                        i_num_threads_sfc_n,
-               ContractionMemoryManager     * i_contraction_mem );
+               ContractionMemoryManager     * i_contraction_mem,
+               executor_t                     i_executor = executor_t::OPENMP,
+               schedule_t                     i_schedule = schedule_t::STATIC,
+               bool                           i_fuse_first_touch = true,
+               std::vector< epilogue_op > const & i_epilogue = std::vector< epilogue_op >(),
+               double                         i_alpha = 1.0,
+               double                         i_beta = 1.0,
+               bool                           i_cpx_3m = false );
 
 
     /**
@@ -249,6 +519,13 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_num_threads_sfc_m number of threads used for sfc m parallelization.
      * @param i_num_threads_sfc_n number of threads used for sfc n parallelization.
      * @param i_contraction_mem pointer to the contraction memory manager.
+     * @param i_executor executor which runs the per-thread tasks.
+     * @param i_schedule schedule of the shared loops.
+     * @param i_fuse_first_touch true if zero and copy first touches may be folded into the main kernel.
+     * @param i_epilogue epilogue program which is used if the last touch kernel is EPILOGUE.
+     * @param i_alpha scaling factor of the contraction's result.
+     * @param i_beta scaling factor of the output tensor after the first touch.
+     * @param i_cpx_3m true if complex main kernels should use three real multiplications (3M) instead of four.
      **/
     void init( std::vector< iter_property > const & i_iterations,
                data_t                               i_dtype_left,
@@ -261,7 +538,54 @@ class einsum_ir::basic::ContractionBackend {
                int64_t                              i_num_threads_shared,
                int64_t                              i_num_threads_sfc_m,
                int64_t                              i_num_threads_sfc_n,
-               ContractionMemoryManager           * i_contraction_mem );
+               ContractionMemoryManager           * i_contraction_mem,
+               executor_t                           i_executor = executor_t::OPENMP,
+               schedule_t                           i_schedule = schedule_t::STATIC,
+               bool                                 i_fuse_first_touch = true,
+               std::vector< epilogue_op >   const & i_epilogue = std::vector< epilogue_op >(),
+               double                               i_alpha = 1.0,
+               double                               i_beta = 1.0,
+               bool                                 i_cpx_3m = false );
+
+    /**
+     * Sets precomputed thread infos which replace the setup of the iteration space in the compilation.
+     * The thread infos have to stem from a compiled backend with identical iterations, data types and threads.
+     * Has to be called after the initialization and before the compilation.
+     *
+     * @param i_thread_infos thread infos of the iteration space.
+     * @param i_caching_size number of cached packed blocks per input.
+     **/
+    void set_thread_infos( std::vector< thread_info > const & i_thread_infos,
+                           int64_t                            i_caching_size );
+
+    /**
+     * Gets the thread infos of the compiled iteration space.
+     *
+     * @param o_thread_infos thread infos of the iteration space.
+     * @param o_caching_size number of cached packed blocks per input.
+     **/
+    void get_thread_infos( std::vector< thread_info > & o_thread_infos,
+                           int64_t                    & o_caching_size ) const;
+
+    /**
+     * Checks if the backends were built with instrumentation counters (PP_EINSUM_IR_INSTRUMENT).
+     *
+     * @return true if the counters are updated, false otherwise.
+     **/
+    static bool has_instrumentation();
+
+    /**
+     * Gets the per-thread instrumentation counters of all contractions since the compilation or the last reset.
+     * The phases are measured in cycles of the core's counter (see read_cycles), imbalance shows in the total cycles.
+     *
+     * @param o_stats will be set to the counters of the threads.
+     **/
+    void get_stats( std::vector< thread_stats > & o_stats ) const;
+
+    /**
+     * Resets the instrumentation counters.
+     **/
+    void reset_stats();
 
     /**
      * Compiles the contraction loop interface.
@@ -282,12 +606,30 @@ class einsum_ir::basic::ContractionBackend {
                    void const * i_tensor_right,
                    void const * i_tensor_out_aux,
                    void       * io_tensor_out );
+
+    /**
+     * Executes the part of the contraction which is assigned to one thread.
+     *
+     * @param i_thread_id id of the thread's task.
+     * @param i_call_state runtime state of the contraction.
+     * @param i_tensor_left left tensor.
+     * @param i_tensor_right right tensor.
+     * @param i_tensor_out_aux auxiliary data w.r.t. output tensor.
+     * @param io_tensor_out output tensor.
+     **/
+    void contract_thread( int64_t              i_thread_id,
+                          call_state_t const & i_call_state,
+                          void         const * i_tensor_left,
+                          void         const * i_tensor_right,
+                          void         const * i_tensor_out_aux,
+                          void               * io_tensor_out );
     
     /**
      * General purpose loop implementation featuring first and last touch operations.
      * No threading is applied.
      *
      * @param i_thread_info information for the executing thread.
+     * @param i_call_state runtime state of the contraction.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -296,20 +638,22 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter( thread_info   * i_thread_info,
-                        int64_t         i_id_loop,
-                        char    const * i_ptr_left,
-                        char    const * i_ptr_right,
-                        char    const * i_ptr_out_aux,
-                        char          * i_ptr_out,
-                        bool            i_first_access,
-                        bool            i_last_access );
+    void contract_iter( thread_info          * i_thread_info,
+                        call_state_t   const & i_call_state,
+                        int64_t                i_id_loop,
+                        char           const * i_ptr_left,
+                        char           const * i_ptr_right,
+                        char           const * i_ptr_out_aux,
+                        char                 * i_ptr_out,
+                        bool                   i_first_access,
+                        bool                   i_last_access );
 
     /**
      * General purpose loop implementation featuring first and last touch operations.
      * Threading is applied.
      *
      * @param i_thread_info information for the executing thread.
+     * @param i_call_state runtime state of the contraction.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -318,19 +662,21 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data.
      * @param i_last_access true if last time accessing this data.
      **/
-    void contract_iter_shared( thread_info   * i_thread_info,
-                               int64_t         i_id_loop,
-                               char    const * i_ptr_left,
-                               char    const * i_ptr_right,
-                               char    const * i_ptr_out_aux,
-                               char          * i_ptr_out,
-                               bool            i_first_access,
-                               bool            i_last_access );
+    void contract_iter_shared( thread_info          * i_thread_info,
+                               call_state_t   const & i_call_state,
+                               int64_t                i_id_loop,
+                               char           const * i_ptr_left,
+                               char           const * i_ptr_right,
+                               char           const * i_ptr_out_aux,
+                               char                 * i_ptr_out,
+                               bool                   i_first_access,
+                               bool                   i_last_access );
  
     /**
      * SFC based loop implementation featuring first and last touch operations.
      *
      * @param i_thread_info information for the executing thread.
+     * @param i_call_state runtime state of the contraction.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -339,19 +685,21 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter_sfc( thread_info   * i_thread_info,
-                            int64_t         i_id_loop,
-                            char    const * i_ptr_left,
-                            char    const * i_ptr_right,
-                            char    const * i_ptr_out_aux,
-                            char          * i_ptr_out,
-                            bool            i_first_access,
-                            bool            i_last_access );
+    void contract_iter_sfc( thread_info          * i_thread_info,
+                            call_state_t   const & i_call_state,
+                            int64_t                i_id_loop,
+                            char           const * i_ptr_left,
+                            char           const * i_ptr_right,
+                            char           const * i_ptr_out_aux,
+                            char                 * i_ptr_out,
+                            bool                   i_first_access,
+                            bool                   i_last_access );
 
     /**
      * Inner most loop implementation based on kernel call featuring first and last touch operations.
      *
      * @param i_thread_info information for the executing thread.
+     * @param i_call_state runtime state of the contraction.
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_left pointer to the left tensor's data.
      * @param i_ptr_right pointer to the right tensor's data.
@@ -360,14 +708,15 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_first_access true if first time accessing this data
      * @param i_last_access true if last time accessing this data
      **/
-    void contract_iter_kernel( thread_info   * i_thread_info,
-                               int64_t         i_id_loop,
-                               char    const * i_ptr_left,
-                               char    const * i_ptr_right,
-                               char    const * i_ptr_out_aux,
-                               char          * i_ptr_out,
-                               bool            i_first_access,
-                               bool            i_last_access );
+    void contract_iter_kernel( thread_info          * i_thread_info,
+                               call_state_t   const & i_call_state,
+                               int64_t                i_id_loop,
+                               char           const * i_ptr_left,
+                               char           const * i_ptr_right,
+                               char           const * i_ptr_out_aux,
+                               char                 * i_ptr_out,
+                               bool                   i_first_access,
+                               bool                   i_last_access );
 
     /**
      * calculates the shape of the kernel i.e. m, n, k, lda, ldb, ldc, ...
@@ -384,6 +733,7 @@ class einsum_ir::basic::ContractionBackend {
      * @param o_unary compiled unary backend used for packing.
      * @param i_strides strides of the input tensor.
      * @param i_packing_strides strides of the packing tensor.
+     * @param i_dtype datatype of the input tensor.
      *
      * @return SUCCESS if packing was created successfully, otherwise an appropiate error code.
      **/
@@ -391,7 +741,8 @@ class einsum_ir::basic::ContractionBackend {
                           int64_t              & o_size_packing,
                           UnaryBackendTpp      & o_unary,
                           std::vector<int64_t> & i_strides,
-                          std::vector<int64_t> & i_packing_strides );
+                          std::vector<int64_t> & i_packing_strides,
+                          data_t                 i_dtype );
 
     /**
      * Kernel applied to the output tensor before the main primitive touches the memory.
@@ -417,10 +768,29 @@ class einsum_ir::basic::ContractionBackend {
      * @param i_left pointer to a data section of the left tensor.
      * @param i_right pointer to a data section of the right tensor.
      * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
      **/
     virtual void kernel_main( void const * i_left,
                               void const * i_right,
-                              void       * io_out ) = 0;
+                              void       * io_out,
+                              char       * io_scratch ) = 0;
+
+    /**
+     * Kernel called in the innermost loop on the first access of the output tensor.
+     * The default implementation applies the first touch kernel before the main kernel.
+     * Backends may override this to fold the first touch into the main kernel.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    virtual void kernel_main_first_touch( void const * i_left,
+                                          void const * i_right,
+                                          void const * i_out_aux,
+                                          void       * io_out,
+                                          char       * io_scratch );
 
     /**
      * Compiles all kernels
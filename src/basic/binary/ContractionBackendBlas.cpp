@@ -37,6 +37,40 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_zero_64( int64_t   i_m,
   }
 }
 
+void einsum_ir::basic::ContractionBackendBlas::kernel_scale_32( int64_t   i_m,
+                                                                int64_t   i_n,
+                                                                int64_t   i_ld,
+                                                                float     i_scale,
+                                                                void    * io_out ) {
+  float * l_out = (float *) io_out;
+
+  for( int64_t l_n = 0; l_n < i_n; l_n++ ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for( int64_t l_m = 0; l_m < i_m; l_m++ ) {
+      l_out[ l_n * i_ld + l_m ] *= i_scale;
+    }
+  }
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_scale_64( int64_t   i_m,
+                                                                int64_t   i_n,
+                                                                int64_t   i_ld,
+                                                                double    i_scale,
+                                                                void    * io_out ) {
+  double * l_out = (double *) io_out;
+
+  for( int64_t l_n = 0; l_n < i_n; l_n++ ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for( int64_t l_m = 0; l_m < i_m; l_m++ ) {
+      l_out[ l_n * i_ld + l_m ] *= i_scale;
+    }
+  }
+}
+
 void einsum_ir::basic::ContractionBackendBlas::kernel_trans_32( int64_t   i_m,
                                                                 int64_t   i_n,
                                                                 int64_t   i_ld_a,
@@ -114,6 +148,7 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_trans_64( int64_t   i_m,
 }
 
 void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp32( float         i_alpha,
+                                                                 float         i_beta,
                                                                  void  const * i_a,
                                                                  void  const * i_b,
                                                                  void        * io_c ) {
@@ -128,12 +163,13 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp32( float         i
                m_lda,
                (const float *) i_b,
                m_ldb,
-               1.0f,
+               i_beta,
                (float *) io_c,
                m_ldc );
 }
 
 void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp64( double         i_alpha,
+                                                                 double         i_beta,
                                                                  void   const * i_a,
                                                                  void   const * i_b,
                                                                  void         * io_c ) {
@@ -148,11 +184,177 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_fp64( double
                m_lda,
                (const double *) i_b,
                m_ldb,
-               1.0,
+               i_beta,
                (double *) io_c,
                m_ldc );
 }
 
+void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_ld( bool          i_trans_a,
+                                                               bool          i_trans_b,
+                                                               float         i_alpha,
+                                                               float         i_beta,
+                                                               float const * i_a,
+                                                               int64_t       i_lda,
+                                                               float const * i_b,
+                                                               int64_t       i_ldb,
+                                                               float       * io_c,
+                                                               int64_t       i_ldc ) {
+  cblas_sgemm( CblasColMajor,
+               i_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
+               i_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
+               m_m,
+               m_n,
+               m_k,
+               i_alpha,
+               i_a,
+               i_lda,
+               i_b,
+               i_ldb,
+               i_beta,
+               io_c,
+               i_ldc );
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_gemm_ld( bool           i_trans_a,
+                                                               bool           i_trans_b,
+                                                               double         i_alpha,
+                                                               double         i_beta,
+                                                               double const * i_a,
+                                                               int64_t        i_lda,
+                                                               double const * i_b,
+                                                               int64_t        i_ldb,
+                                                               double       * io_c,
+                                                               int64_t        i_ldc ) {
+  cblas_dgemm( CblasColMajor,
+               i_trans_a ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
+               i_trans_b ? CBLAS_TRANSPOSE::CblasTrans : CBLAS_TRANSPOSE::CblasNoTrans,
+               m_m,
+               m_n,
+               m_k,
+               i_alpha,
+               i_a,
+               i_lda,
+               i_b,
+               i_ldb,
+               i_beta,
+               io_c,
+               i_ldc );
+}
+
+template< typename T >
+void einsum_ir::basic::ContractionBackendBlas::kernel_cpx_3m( void const * i_left,
+                                                              void const * i_right,
+                                                              void       * io_out,
+                                                              double       i_beta,
+                                                              char       * io_scratch ) {
+  int64_t l_m = m_m;
+  int64_t l_n = m_n;
+  int64_t l_k = m_k;
+
+  // shapes of the stored input matrices
+  int64_t l_rows_a = m_trans_a ? l_k : l_m;
+  int64_t l_cols_a = m_trans_a ? l_m : l_k;
+  int64_t l_rows_b = m_trans_b ? l_n : l_k;
+  int64_t l_cols_b = m_trans_b ? l_k : l_n;
+
+  // scratch: sums of the real and imaginary parts of A and B, products X and Y
+  T * l_sum_a = (T *) io_scratch;
+  T * l_sum_b = l_sum_a + l_rows_a * l_cols_a;
+  T * l_x     = l_sum_b + l_rows_b * l_cols_b;
+  T * l_y     = l_x     + l_m * l_n;
+
+  T const * l_a_re = (T const *)   i_left;
+  T const * l_a_im = (T const *) ( (char const *) i_left  + m_cpx_stride_in_left_bytes  );
+  T const * l_b_re = (T const *)   i_right;
+  T const * l_b_im = (T const *) ( (char const *) i_right + m_cpx_stride_in_right_bytes );
+  T       * l_c_re = (T       *)   io_out;
+  T       * l_c_im = (T       *) ( (char       *) io_out  + m_cpx_stride_out_bytes      );
+
+  int64_t l_lda = m_lda;
+  int64_t l_ldb = m_ldb;
+  int64_t l_ldc = m_ldc;
+
+  for( int64_t l_co = 0; l_co < l_cols_a; l_co++ ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for( int64_t l_ro = 0; l_ro < l_rows_a; l_ro++ ) {
+      l_sum_a[ l_co * l_rows_a + l_ro ] = l_a_re[ l_co * l_lda + l_ro ] + l_a_im[ l_co * l_lda + l_ro ];
+    }
+  }
+  for( int64_t l_co = 0; l_co < l_cols_b; l_co++ ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+    for( int64_t l_ro = 0; l_ro < l_rows_b; l_ro++ ) {
+      l_sum_b[ l_co * l_rows_b + l_ro ] = l_b_re[ l_co * l_ldb + l_ro ] + l_b_im[ l_co * l_ldb + l_ro ];
+    }
+  }
+
+  // X = real * real
+  kernel_gemm_ld( m_trans_a,
+                  m_trans_b,
+                  T(1),
+                  T(0),
+                  l_a_re,
+                  l_lda,
+                  l_b_re,
+                  l_ldb,
+                  l_x,
+                  l_m );
+  // Y = imag * imag
+  kernel_gemm_ld( m_trans_a,
+                  m_trans_b,
+                  T(1),
+                  T(0),
+                  l_a_im,
+                  l_lda,
+                  l_b_im,
+                  l_ldb,
+                  l_y,
+                  l_m );
+  // imag = beta * imag + alpha * (real + imag) * (real + imag)
+  kernel_gemm_ld( m_trans_a,
+                  m_trans_b,
+                  T(m_alpha),
+                  T(i_beta),
+                  l_sum_a,
+                  l_rows_a,
+                  l_sum_b,
+                  l_rows_b,
+                  l_c_im,
+                  l_ldc );
+
+  // real = beta * real + alpha * (X - Y), imag -= alpha * (X + Y)
+  T l_alpha = m_alpha;
+  T l_beta  = i_beta;
+  for( int64_t l_co = 0; l_co < l_n; l_co++ ) {
+    T const * l_x_col    = l_x    + l_co * l_m;
+    T const * l_y_col    = l_y    + l_co * l_m;
+    T       * l_c_re_col = l_c_re + l_co * l_ldc;
+    T       * l_c_im_col = l_c_im + l_co * l_ldc;
+
+    if( i_beta == 0.0 ) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_ro = 0; l_ro < l_m; l_ro++ ) {
+        l_c_re_col[l_ro]  = l_alpha * ( l_x_col[l_ro] - l_y_col[l_ro] );
+        l_c_im_col[l_ro] -= l_alpha * ( l_x_col[l_ro] + l_y_col[l_ro] );
+      }
+    }
+    else {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+      for( int64_t l_ro = 0; l_ro < l_m; l_ro++ ) {
+        l_c_re_col[l_ro]  = l_beta * l_c_re_col[l_ro] + l_alpha * ( l_x_col[l_ro] - l_y_col[l_ro] );
+        l_c_im_col[l_ro] -= l_alpha * ( l_x_col[l_ro] + l_y_col[l_ro] );
+      }
+    }
+  }
+}
+
 void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch_part( void * io_out ) {
   if(    m_ktype_first_touch == kernel_t::ZERO
       || m_ktype_first_touch == kernel_t::CPX_ZERO ) {
@@ -197,6 +399,30 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_first_touch( void const *,
   if( m_cpx_outer_c ) {
     kernel_first_touch_part( (char *) io_out + m_cpx_stride_out_bytes );
   }
+
+  // beta scales the first-touched output
+  if(    m_beta != 1.0
+      && m_ktype_first_touch != kernel_t::ZERO
+      && m_ktype_first_touch != kernel_t::CPX_ZERO ) {
+    int64_t l_num_parts = m_cpx_outer_c ? 2 : 1;
+    for( int64_t l_pa = 0; l_pa < l_num_parts; l_pa++ ) {
+      void * l_out = (char *) io_out + l_pa * m_cpx_stride_out_bytes;
+      if( m_dtype_comp == data_t::FP32 ) {
+        kernel_scale_32( m_m * m_r,
+                         m_n,
+                         m_ldc,
+                         m_beta,
+                         l_out );
+      }
+      else {
+        kernel_scale_64( m_m * m_r,
+                         m_n,
+                         m_ldc,
+                         m_beta,
+                         l_out );
+      }
+    }
+  }
 }
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendBlas::compile_kernels(){
   m_num_bytes_scalar = ce_n_bytes( m_dtype_comp );
@@ -210,6 +436,24 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendBlas::compile_kernel
     m_ktype_last_touch = kernel_t::CPX_COPY;
   }
 
+  // epilogue programs are not supported
+  if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // zero first touches are folded into the first GEMMs of the output
+  m_fused_first_touch_zero =    m_fuse_first_touch
+                             && (    m_ktype_first_touch == kernel_t::ZERO
+                                  || m_ktype_first_touch == kernel_t::CPX_ZERO );
+
+  // scratch of the 3M kernel: sums of the real and imaginary parts of A and B, products X and Y
+  if( m_cpx_outer_c && m_cpx_3m ) {
+    m_size_scratch =   m_m * m_k
+                     + m_k * m_n
+                     + 2 * m_m * m_n;
+    m_size_scratch *= m_num_bytes_scalar;
+  }
+
   // disable threading in OpenBLAS
 #ifdef OPENBLAS_VERSION
   openblas_set_num_threads( 1 );
@@ -219,52 +463,85 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendBlas::compile_kernel
 }
 
 
-void einsum_ir::basic::ContractionBackendBlas::kernel_main( void const * i_left,
-                                                            void const * i_right,
-                                                            void       * io_out ) {
+void einsum_ir::basic::ContractionBackendBlas::kernel_main_beta( void const * i_left,
+                                                                 void const * i_right,
+                                                                 void       * io_out,
+                                                                 double       i_beta,
+                                                                 char       * io_scratch ) {
+  // complex (packed) GEMM primitive with three real GEMMs
+  if( m_cpx_outer_c && m_cpx_3m ) {
+    for( uint64_t l_c = 0; l_c < m_r; l_c++ ) {
+      void const * l_left  = (char *) i_left  + l_c * m_packed_stride_a * m_num_bytes_scalar;
+      void const * l_right = (char *) i_right + l_c * m_packed_stride_b * m_num_bytes_scalar;
+      void       * l_out   = (char *) io_out  + l_c * m_m * m_num_bytes_scalar;
+
+      if( m_dtype_comp == data_t::FP32 ) {
+        kernel_cpx_3m< float >( l_left,
+                                l_right,
+                                l_out,
+                                i_beta,
+                                io_scratch );
+      }
+      else {
+        kernel_cpx_3m< double >( l_left,
+                                 l_right,
+                                 l_out,
+                                 i_beta,
+                                 io_scratch );
+      }
+    }
+  }
   // GEMM primitive
-  if( m_r == 1 ) {
+  else if( m_r == 1 ) {
     if( m_dtype_comp == data_t::FP32 ) {
-      kernel_gemm_fp32( 1.0f,
+      kernel_gemm_fp32( (float) m_alpha,
+                        i_beta,
                         i_left,
                         i_right,
                         io_out );
       if( m_cpx_outer_c ) {
         // imag += real * imag
-        kernel_gemm_fp32( 1.0f,
+        kernel_gemm_fp32( (float) m_alpha,
+                          i_beta,
                           i_left,
                           (char *) i_right + m_cpx_stride_in_right_bytes,
                           (char *) io_out  + m_cpx_stride_out_bytes );
         // imag += imag * real
-        kernel_gemm_fp32( 1.0f,
+        kernel_gemm_fp32( (float) m_alpha,
+                          1.0f,
                           (char *) i_left  + m_cpx_stride_in_left_bytes,
                           i_right,
                           (char *) io_out  + m_cpx_stride_out_bytes );
         // real += imag * imag
-        kernel_gemm_fp32( -1.0f,
+        kernel_gemm_fp32( (float) -m_alpha,
+                          1.0f,
                           (char *) i_left  + m_cpx_stride_in_left_bytes,
                           (char *) i_right + m_cpx_stride_in_right_bytes,
                           (char *) io_out  );
       }
     }
     else {
-      kernel_gemm_fp64( 1.0,
+      kernel_gemm_fp64( m_alpha,
+                        i_beta,
                         i_left,
                         i_right,
                         io_out );
       if( m_cpx_outer_c ) {
         // imag += real * imag
-        kernel_gemm_fp64( 1.0,
+        kernel_gemm_fp64( m_alpha,
+                          i_beta,
                           i_left,
                           (char *) i_right + m_cpx_stride_in_right_bytes,
                           (char *) io_out  + m_cpx_stride_out_bytes );
         // imag += imag * real
-        kernel_gemm_fp64( 1.0,
+        kernel_gemm_fp64( m_alpha,
+                          1.0,
                           (char *) i_left  + m_cpx_stride_in_left_bytes,
                           i_right,
                           (char *) io_out  + m_cpx_stride_out_bytes );
         // real += imag * imag
-        kernel_gemm_fp64( -1.0,
+        kernel_gemm_fp64( -m_alpha,
+                          1.0,
                           (char *) i_left  + m_cpx_stride_in_left_bytes,
                           (char *) i_right + m_cpx_stride_in_right_bytes,
                           (char *) io_out  );
@@ -280,46 +557,54 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_main( void const * i_left,
       void       * l_out   = (char *) io_out  + l_c * m_m * m_num_bytes_scalar;
       // execute GEMM
       if( m_dtype_comp == data_t::FP32 ) {
-        kernel_gemm_fp32( 1.0f,
+        kernel_gemm_fp32( (float) m_alpha,
+                          i_beta,
                           l_left,
                           l_right,
                           l_out );
         if( m_cpx_outer_c ) {
           // imag += real * imag
-          kernel_gemm_fp32( 1.0f,
+          kernel_gemm_fp32( (float) m_alpha,
+                            i_beta,
                             l_left,
                             (char *) l_right + m_cpx_stride_in_right_bytes,
                             (char *) l_out   + m_cpx_stride_out_bytes );
           // imag += imag * real
-          kernel_gemm_fp32( 1.0f,
+          kernel_gemm_fp32( (float) m_alpha,
+                            1.0f,
                             (char *) l_left  + m_cpx_stride_in_left_bytes,
                             l_right,
                             (char *) l_out   + m_cpx_stride_out_bytes );
           // real += imag * imag
-          kernel_gemm_fp32( -1.0f,
+          kernel_gemm_fp32( (float) -m_alpha,
+                            1.0f,
                             (char *) l_left  + m_cpx_stride_in_left_bytes,
                             (char *) l_right + m_cpx_stride_in_right_bytes,
                             (char *) l_out  );
         }
       }
       else if( m_dtype_comp == data_t::FP64  ) {
-        kernel_gemm_fp64( 1.0f,
+        kernel_gemm_fp64( m_alpha,
+                          i_beta,
                           l_left,
                           l_right,
                           l_out );
         if( m_cpx_outer_c ) {
           // imag += real * imag
-          kernel_gemm_fp64( 1.0,
+          kernel_gemm_fp64( m_alpha,
+                            i_beta,
                             l_left,
                             (char *) l_right + m_cpx_stride_in_right_bytes,
                             (char *) l_out   + m_cpx_stride_out_bytes );
           // imag += imag * real
-          kernel_gemm_fp64( 1.0,
+          kernel_gemm_fp64( m_alpha,
+                            1.0,
                             (char *) l_left  + m_cpx_stride_in_left_bytes,
                             l_right,
                             (char *) l_out   + m_cpx_stride_out_bytes );
           // real += imag * imag
-          kernel_gemm_fp64( -1.0,
+          kernel_gemm_fp64( -m_alpha,
+                            1.0,
                             (char *) l_left  + m_cpx_stride_in_left_bytes,
                             (char *) l_right + m_cpx_stride_in_right_bytes,
                             (char *) l_out  );
@@ -329,6 +614,53 @@ void einsum_ir::basic::ContractionBackendBlas::kernel_main( void const * i_left,
   }
 }
 
+void einsum_ir::basic::ContractionBackendBlas::kernel_main( void const * i_left,
+                                                            void const * i_right,
+                                                            void       * io_out,
+                                                            char       * io_scratch ) {
+  kernel_main_beta( i_left,
+                    i_right,
+                    io_out,
+                    1.0,
+                    io_scratch );
+}
+
+void einsum_ir::basic::ContractionBackendBlas::kernel_main_first_touch( void const * i_left,
+                                                                        void const * i_right,
+                                                                        void const * i_out_aux,
+                                                                        void       * io_out,
+                                                                        char       * io_scratch ) {
+  // zeroing and the layout conversion of zeros are replaced by beta=0
+  if( m_fused_first_touch_zero ) {
+    kernel_main_beta( i_left,
+                      i_right,
+                      io_out,
+                      0.0,
+                      io_scratch );
+  }
+  // beta of the first touch is passed to the first GEMMs of the output
+  else if(    m_beta != 1.0
+           && m_ktype_first_touch != kernel_t::ZERO
+           && m_ktype_first_touch != kernel_t::CPX_ZERO ) {
+    kernel_first_touch_part( io_out );
+    if( m_cpx_outer_c ) {
+      kernel_first_touch_part( (char *) io_out + m_cpx_stride_out_bytes );
+    }
+    kernel_main_beta( i_left,
+                      i_right,
+                      io_out,
+                      m_beta,
+                      io_scratch );
+  }
+  else {
+    ContractionBackend::kernel_main_first_touch( i_left,
+                                                 i_right,
+                                                 i_out_aux,
+                                                 io_out,
+                                                 io_scratch );
+  }
+}
+
 void einsum_ir::basic::ContractionBackendBlas::kernel_last_touch_part( void * io_out ) {
 
   if( m_r != 1 ) {
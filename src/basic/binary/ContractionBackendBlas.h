@@ -17,6 +17,9 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
     //! true if the outermost C dimension represents the complex dimension
     bool m_cpx_outer_c = false;
 
+    //! true if the zero first touch is folded into the main kernel
+    bool m_fused_first_touch_zero = false;
+
     /**
      * 32-bit kernel zeroing a column-major matrix.
      *
@@ -43,6 +46,36 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
                                 int64_t   i_ld,
                                 void    * io_out );
 
+    /**
+     * 32-bit kernel scaling a column-major matrix.
+     *
+     * @param i_m number of rows.
+     * @param i_n number of columns.
+     * @param i_ld leading dimension.
+     * @param i_scale scaling factor.
+     * @param io_out pointer to the matrix.
+     */
+    static void kernel_scale_32( int64_t   i_m,
+                                 int64_t   i_n,
+                                 int64_t   i_ld,
+                                 float     i_scale,
+                                 void    * io_out );
+
+    /**
+     * 64-bit kernel scaling a column-major matrix.
+     *
+     * @param i_m number of rows.
+     * @param i_n number of columns.
+     * @param i_ld leading dimension.
+     * @param i_scale scaling factor.
+     * @param io_out pointer to the matrix.
+     */
+    static void kernel_scale_64( int64_t   i_m,
+                                 int64_t   i_n,
+                                 int64_t   i_ld,
+                                 double    i_scale,
+                                 void    * io_out );
+
     /**
      * 32-bit kernel transposing a column-major matrix.
      * The matrix is transposed in-place.
@@ -78,11 +111,13 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      * FP32 GEMM kernel.
      *
      * @param i_alpha parameter alpha.
+     * @param i_beta parameter beta.
      * @param i_a pointer to matrix A.
      * @param i_b pointer to matrix B.
      * @param io_c pointer to matrix C.
      **/
     void kernel_gemm_fp32( float         i_alpha,
+                           float         i_beta,
                            void  const * i_a,
                            void  const * i_b,
                            void        * io_c );
@@ -91,15 +126,111 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      * FP64 GEMM kernel.
      *
      * @param i_alpha parameter alpha.
+     * @param i_beta parameter beta.
      * @param i_a pointer to matrix A.
      * @param i_b pointer to matrix B.
      * @param io_c pointer to matrix C.
      **/
     void kernel_gemm_fp64( double         i_alpha,
+                           double         i_beta,
                            void   const * i_a,
                            void   const * i_b,
                            void         * io_c );
 
+    /**
+     * FP32 GEMM with explicit leading dimensions.
+     * The sizes of the GEMM are those of the kernel.
+     *
+     * @param i_trans_a true if A is transposed.
+     * @param i_trans_b true if B is transposed.
+     * @param i_alpha parameter alpha.
+     * @param i_beta parameter beta.
+     * @param i_a pointer to matrix A.
+     * @param i_lda leading dimension of A.
+     * @param i_b pointer to matrix B.
+     * @param i_ldb leading dimension of B.
+     * @param io_c pointer to matrix C.
+     * @param i_ldc leading dimension of C.
+     **/
+    void kernel_gemm_ld( bool          i_trans_a,
+                         bool          i_trans_b,
+                         float         i_alpha,
+                         float         i_beta,
+                         float const * i_a,
+                         int64_t       i_lda,
+                         float const * i_b,
+                         int64_t       i_ldb,
+                         float       * io_c,
+                         int64_t       i_ldc );
+
+    /**
+     * FP64 GEMM with explicit leading dimensions.
+     * The sizes of the GEMM are those of the kernel.
+     *
+     * @param i_trans_a true if A is transposed.
+     * @param i_trans_b true if B is transposed.
+     * @param i_alpha parameter alpha.
+     * @param i_beta parameter beta.
+     * @param i_a pointer to matrix A.
+     * @param i_lda leading dimension of A.
+     * @param i_b pointer to matrix B.
+     * @param i_ldb leading dimension of B.
+     * @param io_c pointer to matrix C.
+     * @param i_ldc leading dimension of C.
+     **/
+    void kernel_gemm_ld( bool           i_trans_a,
+                         bool           i_trans_b,
+                         double         i_alpha,
+                         double         i_beta,
+                         double const * i_a,
+                         int64_t        i_lda,
+                         double const * i_b,
+                         int64_t        i_ldb,
+                         double       * io_c,
+                         int64_t        i_ldc );
+
+    /**
+     * Executes a complex GEMM through three real GEMMs (3M):
+     *   X = Re(A)*Re(B), Y = Im(A)*Im(B),
+     *   Re(C) = beta*Re(C) + alpha*(X-Y),
+     *   Im(C) = beta*Im(C) + alpha*((Re(A)+Im(A))*(Re(B)+Im(B)) - X - Y).
+     *
+     * Accuracy: the imaginary part is obtained by cancellation.
+     * Its absolute error is bounded by a multiple of (|Re(A)|+|Im(A)|)*(|Re(B)|+|Im(B)|) rather than |Re(A)|*|Im(B)|+|Im(A)|*|Re(B)|.
+     * Results with a small imaginary part relative to the magnitude of the inputs lose relative accuracy compared to the four-multiplication kernel.
+     * The real part is computed as in the four-multiplication kernel.
+     *
+     * @param i_left pointer to the real part of a data section of the left tensor.
+     * @param i_right pointer to the real part of a data section of the right tensor.
+     * @param io_out pointer to the real part of a data section of the output tensor.
+     * @param i_beta parameter beta.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    template< typename T >
+    void kernel_cpx_3m( void const * i_left,
+                        void const * i_right,
+                        void       * io_out,
+                        double       i_beta,
+                        char       * io_scratch );
+
+    /**
+     * Executes the GEMMs of the main kernel.
+     * The first GEMM of the real and imaginary part of the output uses the given beta, all others use beta=1.
+     * All GEMMs scale the product by the contraction's alpha.
+     * Complex kernels use three instead of four GEMMs per output if 3M is enabled.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     * @param i_beta parameter beta of the first GEMMs.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    void kernel_main_beta( void const * i_left,
+                           void const * i_right,
+                           void       * io_out,
+                           double       i_beta,
+                           char       * io_scratch );
+
     /**
      * Partially executes the first touch kernel on the given real or imaginary data section of the tensor.
      *
@@ -130,10 +261,28 @@ class einsum_ir::basic::ContractionBackendBlas: public ContractionBackend {
      * @param i_left pointer to a data section of the left tensor.
      * @param i_right pointer to a data section of the right tensor.
      * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out,
+                      char       * io_scratch );
+
+    /**
+     * Executes the main kernel on the first access of the output tensor.
+     * Zero first touches are folded into the main kernel by using beta=0.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    void kernel_main_first_touch( void const * i_left,
+                                  void const * i_right,
+                                  void const * i_out_aux,
+                                  void       * io_out,
+                                  char       * io_scratch );
 
     /**
      * Executes the last touch kernel on the given data section of the tensor.
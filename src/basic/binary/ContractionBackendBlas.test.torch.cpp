@@ -477,4 +477,80 @@ TEST_CASE( "FP32 packed tensor contraction using the BLAS contraction backend im
                           { l_left, l_right } );
 
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "FP64 matmul with alpha and beta using the BLAS contraction backend implementation.", "[contraction_backend_blas]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0      5
+  //    n    1      7
+  //    k    2      8
+
+  using namespace einsum_ir::basic;
+
+  at::Tensor l_left    = at::randn( { 8, 5 },
+                                    at::ScalarType::Double );
+  at::Tensor l_right   = at::randn( { 7, 8 },
+                                    at::ScalarType::Double );
+  at::Tensor l_out     = at::randn( { 7, 5 },
+                                    at::ScalarType::Double );
+  at::Tensor l_out_ref = 0.5 * l_out + 1.5 * at::matmul( l_right, l_left );
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  m, n, k
+  std::vector< int64_t > l_loop_sizes            = {  5, 7, 8 };
+  std::vector< int64_t > l_loop_strides_left     = {  1, 0, 5 };
+  std::vector< int64_t > l_loop_strides_right    = {  0, 8, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {  0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = {  1, 5, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  ContractionBackendBlas l_cont_blas;
+
+  l_cont_blas.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::FP64,
+                    data_t::FP64,
+                    data_t::FP64,
+                    data_t::FP64,
+                    kernel_t::UNDEFINED_KTYPE,
+                    kernel_t::MADD,
+                    kernel_t::UNDEFINED_KTYPE,
+                    1,
+                    1,
+                    1,
+                    nullptr,
+                    executor_t::OPENMP,
+                    schedule_t::STATIC,
+                    true,
+                    std::vector< epilogue_op >(),
+                    1.5,
+                    0.5 );
+  err_t l_err = l_cont_blas.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_blas.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        nullptr,
+                        l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, l_out_ref ) );
+}
@@ -1,5 +1,7 @@
 
 #include "ContractionBackendScalar.h"
+#include <cmath>
+#include <cstring>
 
 template < typename T >
 void einsum_ir::basic::ContractionBackendScalar::kernel_zero( void const *,
@@ -24,6 +26,46 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_copy( void const * i_dat
   *l_data_dst = *l_data_src;
 }
 
+template < typename T >
+void einsum_ir::basic::ContractionBackendScalar::kernel_epilogue( void const * i_out_aux,
+                                                                  void       * io_data ) const {
+  T * l_data = (T *) io_data;
+
+  for( std::size_t l_op = 0; l_op < m_epilogue.size(); l_op++ ) {
+    kernel_t l_ktype = m_epilogue[l_op].ktype;
+    T l_x = *l_data;
+
+    // the output holds an INT32 accumulator before the dequantization
+    if( l_ktype == kernel_t::DEQUANT ) {
+      int32_t l_acc = 0;
+      std::memcpy( &l_acc,
+                   io_data,
+                   sizeof(int32_t) );
+      l_x = T( l_acc );
+    }
+
+    // unary ops
+    if(      l_ktype == kernel_t::RELU    ) *l_data = std::max( l_x, T(0) );
+    else if( l_ktype == kernel_t::GELU    ) *l_data = T(0.5) * l_x * ( T(1) + std::erf( l_x / std::sqrt( T(2) ) ) );
+    else if( l_ktype == kernel_t::SIGMOID ) *l_data = T(1) / ( T(1) + std::exp( -l_x ) );
+    else if( l_ktype == kernel_t::TANH    ) *l_data = std::tanh( l_x );
+    // binary ops
+    else {
+      T l_y = (T) m_epilogue[l_op].scalar;
+      if( m_epilogue[l_op].use_aux ) {
+        l_y = *(T const *) i_out_aux;
+      }
+
+      if(      l_ktype == kernel_t::ADD     ) *l_data = l_x + l_y;
+      else if( l_ktype == kernel_t::MUL     ) *l_data = l_x * l_y;
+      else if( l_ktype == kernel_t::MIN     ) *l_data = std::min( l_x, l_y );
+      else if( l_ktype == kernel_t::MAX     ) *l_data = std::max( l_x, l_y );
+      else if( l_ktype == kernel_t::DEQUANT ) *l_data = l_x * l_y;
+      else if( l_ktype == kernel_t::QUANT   ) *l_data = std::min( std::max( std::nearbyint( l_x * l_y ), T(-128) ), T(127) );
+    }
+  }
+}
+
 template < typename T_LEFT,
            typename T_RIGHT,
            typename T_OUT >
@@ -37,6 +79,35 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_madd( void const * i_lef
   *l_out += (*l_left) * (*l_right);
 }
 
+template < typename T_LEFT,
+           typename T_RIGHT,
+           typename T_OUT >
+void einsum_ir::basic::ContractionBackendScalar::kernel_mul_zero( void const * i_left,
+                                                                  void const * i_right,
+                                                                  void const *,
+                                                                  void       * o_out ) {
+  T_LEFT  const * l_left  = (T_LEFT  const *) i_left;
+  T_RIGHT const * l_right = (T_RIGHT const *) i_right;
+  T_OUT         * l_out   = (T_OUT         *) o_out;
+
+  *l_out = (*l_left) * (*l_right);
+}
+
+template < typename T_LEFT,
+           typename T_RIGHT,
+           typename T_OUT >
+void einsum_ir::basic::ContractionBackendScalar::kernel_madd_copy( void const * i_left,
+                                                                   void const * i_right,
+                                                                   void const * i_out_aux,
+                                                                   void       * o_out ) {
+  T_LEFT  const * l_left    = (T_LEFT  const *) i_left;
+  T_RIGHT const * l_right   = (T_RIGHT const *) i_right;
+  T_OUT   const * l_out_aux = (T_OUT   const *) i_out_aux;
+  T_OUT         * l_out     = (T_OUT         *) o_out;
+
+  *l_out = *l_out_aux + (*l_left) * (*l_right);
+}
+
 einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kernels() {
 
   //kernel should be of size 1 for scalar interface
@@ -47,11 +118,17 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     return err_t::COMPILATION_FAILED;
   }
 
-  // determine if all dtypes are FP32 or FP64
+  // determine if all dtypes are FP32 or FP64, or if the contraction is quantized
   bool l_dtype_all_fp32 = false;
   bool l_dtype_all_fp64 = false;
+  bool l_dtype_int8     = false;
 
-  if(    m_dtype_left  == FP32
+  if(    m_dtype_left  == INT8
+      && m_dtype_right == INT8
+      && m_dtype_comp  == INT32 ) {
+    l_dtype_int8 = true;
+  }
+  else if(    m_dtype_left  == FP32
       && m_dtype_right == FP32
       && m_dtype_comp  == FP32
       && m_dtype_out   == FP32 ) {
@@ -67,9 +144,18 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     return err_t::COMPILATION_FAILED;
   }
 
+  // alpha and beta are applied in the first and last touches
+  err_t l_err = fold_alpha_beta();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
   // first-touch kernel
   if( m_ktype_first_touch == kernel_t::ZERO ) {
-    if( l_dtype_all_fp32 ) {
+    if( l_dtype_int8 ) {
+      m_kernel_first_touch = &kernel_zero< int32_t >;
+    }
+    else if( l_dtype_all_fp32 ) {
       m_kernel_first_touch = &kernel_zero< float >;
     }
     else if( l_dtype_all_fp64 ) {
@@ -90,7 +176,10 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
 
   // main kernel
   if( m_ktype_main == kernel_t::MADD ) {
-    if( l_dtype_all_fp32 ) {
+    if( l_dtype_int8 ) {
+      m_kernel_main = &kernel_madd< int8_t, int8_t, int32_t >;
+    }
+    else if( l_dtype_all_fp32 ) {
       m_kernel_main = &kernel_madd< float, float, float >;
     }
     else if( l_dtype_all_fp64 ) {
@@ -101,6 +190,31 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
     return err_t::COMPILATION_FAILED;
   }
 
+  // main kernel with folded first touch
+  if( m_fuse_first_touch ) {
+    if( m_ktype_first_touch == kernel_t::ZERO ) {
+      if( l_dtype_int8 ) {
+        m_kernel_main_first_touch = &kernel_mul_zero< int8_t, int8_t, int32_t >;
+      }
+      else if( l_dtype_all_fp32 ) {
+        m_kernel_main_first_touch = &kernel_mul_zero< float, float, float >;
+      }
+      else if( l_dtype_all_fp64 ) {
+        m_kernel_main_first_touch = &kernel_mul_zero< double, double, double >;
+      }
+    }
+    else if(    m_ktype_first_touch == kernel_t::COPY
+             && m_scale_first_touch == 1.0
+             && m_alpha == 1.0 ) {
+      if( l_dtype_all_fp32 ) {
+        m_kernel_main_first_touch = &kernel_madd_copy< float, float, float >;
+      }
+      else if( l_dtype_all_fp64 ) {
+        m_kernel_main_first_touch = &kernel_madd_copy< double, double, double >;
+      }
+    }
+  }
+
   // last-touch kernel
   if( m_ktype_last_touch == kernel_t::RELU ) {
     if( l_dtype_all_fp32 ) {
@@ -110,6 +224,23 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendScalar::compile_kern
       m_kernel_last_touch = &kernel_relu< double >;
     }
   }
+  else if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    for( std::size_t l_op = 0; l_op < m_epilogue.size(); l_op++ ) {
+      kernel_t l_ktype = m_epilogue[l_op].ktype;
+      if(    l_ktype != kernel_t::RELU
+          && l_ktype != kernel_t::GELU
+          && l_ktype != kernel_t::SIGMOID
+          && l_ktype != kernel_t::TANH
+          && l_ktype != kernel_t::ADD
+          && l_ktype != kernel_t::MUL
+          && l_ktype != kernel_t::MIN
+          && l_ktype != kernel_t::MAX
+          && l_ktype != kernel_t::DEQUANT
+          && l_ktype != kernel_t::QUANT ) {
+        return err_t::COMPILATION_FAILED;
+      }
+    }
+  }
   else if( m_ktype_last_touch != UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
   }
@@ -124,14 +255,61 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_first_touch( void const
     m_kernel_first_touch( i_out_aux,
                           io_out );
   }
+
+  if( m_scale_first_touch != 1.0 ) {
+    if( m_dtype_out == data_t::FP32 ) {
+      *(float *) io_out *= (float) m_scale_first_touch;
+    }
+    else {
+      *(double *) io_out *= m_scale_first_touch;
+    }
+  }
 }
 
 void einsum_ir::basic::ContractionBackendScalar::kernel_main( void const * i_left,
                                                               void const * i_right,
-                                                              void       * io_out ) {
-  m_kernel_main( i_left,
-                 i_right,
-                 io_out );
+                                                              void       * io_out,
+                                                              char       * io_scratch ) {
+  if( m_alpha == 1.0 ) {
+    m_kernel_main( i_left,
+                   i_right,
+                   io_out );
+  }
+  // the product is scaled by alpha before it is added to the output
+  else if( m_dtype_out == data_t::FP32 ) {
+    float l_product = 0;
+    m_kernel_main( i_left,
+                   i_right,
+                   &l_product );
+    *(float *) io_out += (float) m_alpha * l_product;
+  }
+  else {
+    double l_product = 0;
+    m_kernel_main( i_left,
+                   i_right,
+                   &l_product );
+    *(double *) io_out += m_alpha * l_product;
+  }
+}
+
+void einsum_ir::basic::ContractionBackendScalar::kernel_main_first_touch( void const * i_left,
+                                                                          void const * i_right,
+                                                                          void const * i_out_aux,
+                                                                          void       * io_out,
+                                                                          char       * io_scratch ) {
+  if( m_kernel_main_first_touch != nullptr ) {
+    m_kernel_main_first_touch( i_left,
+                               i_right,
+                               i_out_aux,
+                               io_out );
+  }
+  else {
+    ContractionBackend::kernel_main_first_touch( i_left,
+                                                 i_right,
+                                                 i_out_aux,
+                                                 io_out,
+                                                 io_scratch );
+  }
 }
 
 void einsum_ir::basic::ContractionBackendScalar::kernel_last_touch( void const * i_out_aux,
@@ -140,4 +318,14 @@ void einsum_ir::basic::ContractionBackendScalar::kernel_last_touch( void const *
     m_kernel_last_touch( i_out_aux,
                          io_out );
   }
+  else if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    if( m_dtype_out == data_t::FP32 ) {
+      kernel_epilogue< float >( i_out_aux,
+                                io_out );
+    }
+    else {
+      kernel_epilogue< double >( i_out_aux,
+                                 io_out );
+    }
+  }
 }
\ No newline at end of file
@@ -56,6 +56,47 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
                              void const * i_in_right,
                              void       * io_out );
 
+    /**
+     * Compiler-based multiply kernel which overwrites the output.
+     *
+     * @param_t T_LEFT data type of the left input.
+     * @param_t T_RIGHT data type of the right input.
+     * @param_t T_OUT data type of the output.
+     **/
+    template < typename T_LEFT,
+               typename T_RIGHT,
+               typename T_OUT >
+    static void kernel_mul_zero( void const * i_in_left,
+                                 void const * i_in_right,
+                                 void const *,
+                                 void       * o_out );
+
+    /**
+     * Compiler-based multiply add kernel which adds to the auxiliary output tensor.
+     *
+     * @param_t T_LEFT data type of the left input.
+     * @param_t T_RIGHT data type of the right input.
+     * @param_t T_OUT data type of the output.
+     **/
+    template < typename T_LEFT,
+               typename T_RIGHT,
+               typename T_OUT >
+    static void kernel_madd_copy( void const * i_in_left,
+                                  void const * i_in_right,
+                                  void const * i_out_aux,
+                                  void       * o_out );
+
+    /**
+     * Compiler-based reference implementation of the epilogue program.
+     *
+     * @param_t datatype.
+     * @param i_out_aux auxiliary data which is the second operand of binary ops using it.
+     * @param io_data data to which the epilogue program is applied.
+     **/
+    template < typename T >
+    void kernel_epilogue( void const * i_out_aux,
+                          void       * io_data ) const;
+
     //! first-touch kernel
     void (* m_kernel_first_touch)( void const *,
                                    void       * ) = nullptr;
@@ -65,6 +106,12 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
                             void const *,
                             void       * ) = nullptr;
 
+    //! main kernel with folded first touch
+    void (* m_kernel_main_first_touch)( void const *,
+                                        void const *,
+                                        void const *,
+                                        void       * ) = nullptr;
+
     //! last-touch kernel
     void (* m_kernel_last_touch)( void const *,
                                   void       * ) = nullptr;
@@ -85,10 +132,27 @@ class einsum_ir::basic::ContractionBackendScalar: public ContractionBackend {
      * @param i_left pointer to a data section of the left tensor.
      * @param i_right pointer to a data section of the right tensor.
      * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out,
+                      char       * io_scratch );
+
+    /**
+     * Executes the main kernel with folded first touch if available.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    void kernel_main_first_touch( void const * i_left,
+                                  void const * i_right,
+                                  void const * i_out_aux,
+                                  void       * io_out,
+                                  char       * io_scratch );
 
     /**
      * Executes the last touch kernel on the given data section of the tensor.
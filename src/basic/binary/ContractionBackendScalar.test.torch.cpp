@@ -626,3 +626,370 @@ TEST_CASE( "Binary contraction involving C, M, N and K dimensions using FP64, ze
 
   REQUIRE( at::allclose( l_out, l_out_ref )  );
 }
+
+TEST_CASE( "Matrix-matrix multiplication with a bias, scaling and tanh epilogue program using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0      2
+  //    n    1      3
+  //    k    2      4
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 2, 3, 4, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 1, 0, 2, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, 4, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 1, 0, 0, 1, 1, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, 2, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  std::vector< epilogue_op > l_epilogue( 3 );
+  l_epilogue[0].ktype   = kernel_t::ADD;
+  l_epilogue[1].ktype   = kernel_t::MUL;
+  l_epilogue[1].use_aux = false;
+  l_epilogue[1].scalar  = 0.25;
+  l_epilogue[2].ktype   = kernel_t::TANH;
+
+  ContractionBackendScalar l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   data_t::FP32,
+                   kernel_t::ZERO,
+                   kernel_t::MADD,
+                   kernel_t::EPILOGUE,
+                   1,
+                   1,
+                   1,
+                   nullptr,
+                   executor_t::OPENMP,
+                   schedule_t::STATIC,
+                   true,
+                   l_epilogue );
+
+  // data
+  at::Tensor l_in_left  = at::rand( {4, 2} );
+  at::Tensor l_in_right = at::rand( {3, 4} );
+  at::Tensor l_bias     = at::rand( {1, 2} );
+  at::Tensor l_out      = at::rand( {3, 2} );
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( "km,nk->nm",
+                                     {l_in_left, l_in_right} );
+  l_out_ref = at::tanh( 0.25 * ( l_out_ref + l_bias ) );
+
+  err_t l_err = l_bin_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_bin_cont.contract( l_in_left.data_ptr(),
+                       l_in_right.data_ptr(),
+                       l_bias.data_ptr(),
+                       l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, l_out_ref ) );
+}
+
+TEST_CASE( "Matrix-matrix multiplication with alpha and beta using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0      2
+  //    n    1      3
+  //    k    2      4
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 2, 3, 4, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 1, 0, 2, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, 4, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 1, 2, 0, 1, 1, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, 2, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // data
+  at::Tensor l_in_left  = at::rand( {4, 2} );
+  at::Tensor l_in_right = at::rand( {3, 4} );
+  at::Tensor l_out_aux  = at::rand( {3, 2} );
+  at::Tensor l_out      = at::rand( {3, 2} );
+  at::Tensor l_product  = at::einsum( "km,nk->nm",
+                                      {l_in_left, l_in_right} );
+
+  kernel_t l_ktypes_first_touch[3] = { kernel_t::UNDEFINED_KTYPE,
+                                       kernel_t::COPY,
+                                       kernel_t::UNDEFINED_KTYPE };
+  double l_alphas[3] = { -2.0, 1E-39, 0.0 };
+  double l_betas[3]  = {  0.5, 2.0,   0.5 };
+
+  for( int64_t l_te = 0; l_te < 3; l_te++ ) {
+    ContractionBackendScalar l_bin_cont;
+    l_bin_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     l_ktypes_first_touch[l_te],
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr,
+                     executor_t::OPENMP,
+                     schedule_t::STATIC,
+                     true,
+                     std::vector< epilogue_op >(),
+                     l_alphas[l_te],
+                     l_betas[l_te] );
+
+    // reference
+    at::Tensor l_out_ref = ( l_ktypes_first_touch[l_te] == kernel_t::COPY ) ? l_out_aux.clone() : l_out.clone();
+    l_out_ref = l_betas[l_te] * l_out_ref + l_alphas[l_te] * l_product;
+
+    err_t l_err = l_bin_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_bin_cont.contract( l_in_left.data_ptr(),
+                         l_in_right.data_ptr(),
+                         l_out_aux.data_ptr(),
+                         l_out.data_ptr() );
+
+    REQUIRE( at::isfinite( l_out ).all().item< bool >() );
+    REQUIRE( at::allclose( l_out, l_out_ref ) );
+  }
+}
+
+TEST_CASE( "INT8 matrix-matrix multiplication with INT32 accumulation and dequantization using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // Test Case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0      2
+  //    n    1      3
+  //    k    2      4
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 m, n, k mp,np,kp
+  std::vector< int64_t > l_loop_sizes            = { 2, 3, 4, 1, 1, 1 };
+  std::vector< int64_t > l_loop_strides_left     = { 1, 0, 2, 1, 0, 1 };
+  std::vector< int64_t > l_loop_strides_right    = { 0, 4, 1, 0, 1, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = { 0, 1, 0, 0, 1, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 1, 2, 0, 1, 1, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // per-channel scales of the N dimension
+  std::vector< epilogue_op > l_epilogue( 1 );
+  l_epilogue[0].ktype = kernel_t::DEQUANT;
+
+  ContractionBackendScalar l_bin_cont;
+  l_bin_cont.init( l_loop_dim_type,
+                   l_loop_exec_type,
+                   l_loop_sizes,
+                   l_loop_strides_left,
+                   l_loop_strides_right,
+                   l_loop_strides_out_aux,
+                   l_loop_strides_out,
+                   l_packing_strides_left,
+                   l_packing_strides_right,
+                   data_t::INT8,
+                   data_t::INT8,
+                   data_t::INT32,
+                   data_t::FP32,
+                   kernel_t::ZERO,
+                   kernel_t::MADD,
+                   kernel_t::EPILOGUE,
+                   1,
+                   1,
+                   1,
+                   nullptr,
+                   executor_t::OPENMP,
+                   schedule_t::STATIC,
+                   true,
+                   l_epilogue );
+
+  // data
+  at::Tensor l_in_left  = at::randint( -128, 128, {4, 2}, at::ScalarType::Char );
+  at::Tensor l_in_right = at::randint( -128, 128, {3, 4}, at::ScalarType::Char );
+  at::Tensor l_scales   = at::rand( {3, 1} );
+  at::Tensor l_out      = at::rand( {3, 2} );
+
+  // reference
+  at::Tensor l_out_ref = at::einsum( "km,nk->nm",
+                                     {l_in_left.to( at::ScalarType::Float ), l_in_right.to( at::ScalarType::Float )} );
+  l_out_ref = l_out_ref * l_scales;
+
+  err_t l_err = l_bin_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_bin_cont.contract( l_in_left.data_ptr(),
+                       l_in_right.data_ptr(),
+                       l_scales.data_ptr(),
+                       l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, l_out_ref ) );
+}
+
+TEST_CASE( "Split K dimension with sfc thread groups and a shared N dimension using the Scalar contraction backend implementation.", "[contraction_backend_scalar]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     5x4
+  //    n    1     2x3x2
+  //    k    2     4x8
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::N,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::OMP,
+                                             exec_t::SFC,
+                                             exec_t::SFC,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                 k0,  n0, m1,  n1, m2, n2, k2, mp, np, kp
+  std::vector< int64_t > l_loop_sizes            = {  4,   2,  5,   3,  4,  2,  8,  1,  1,  1 };
+  std::vector< int64_t > l_loop_strides_left     = {160,   0,  4,   0,  1,  0, 20,  1,  0,  1 };
+  std::vector< int64_t > l_loop_strides_right    = {  8, 192,  0,  64,  0, 32,  1,  0,  1,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {  0, 120,  4,  40,  1, 20,  0,  1,  1,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {  0, 120,  4,  40,  1, 20,  0,  1,  1,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left     = at::randn( { 32, 20 }, at::ScalarType::Double );
+  at::Tensor l_right    = at::randn( { 12, 32 }, at::ScalarType::Double );
+  at::Tensor l_out_aux  = at::randn( { 12, 20 }, at::ScalarType::Double );
+  at::Tensor l_out_init = at::randn( { 12, 20 }, at::ScalarType::Double );
+
+  at::Tensor l_out_ref = at::relu( l_out_aux + at::matmul( l_right, l_left ) );
+
+  std::vector< schedule_t > l_schedules = { schedule_t::STATIC,
+                                            schedule_t::DYNAMIC };
+
+  for( std::size_t l_sc = 0; l_sc < l_schedules.size(); l_sc++ ) {
+    ContractionBackendScalar l_bin_cont;
+    l_bin_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP64,
+                     data_t::FP64,
+                     data_t::FP64,
+                     data_t::FP64,
+                     kernel_t::COPY,
+                     kernel_t::MADD,
+                     kernel_t::RELU,
+                     2,
+                     2,
+                     2,
+                     nullptr,
+                     executor_t::OPENMP,
+                     l_schedules[l_sc] );
+
+    err_t l_err = l_bin_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    // partial outputs are zeroed when first touched in every contraction
+    for( int64_t l_re = 0; l_re < 2; l_re++ ) {
+      at::Tensor l_out = l_out_init.clone();
+
+      l_bin_cont.contract( l_left.data_ptr(),
+                           l_right.data_ptr(),
+                           l_out_aux.data_ptr(),
+                           l_out.data_ptr() );
+
+      REQUIRE( at::allclose( l_out, l_out_ref ) );
+    }
+  }
+}
@@ -7,10 +7,59 @@ libxsmm_datatype einsum_ir::basic::ContractionBackendTpp::dtype_to_libxsmm( data
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
+  else if( i_dtype == INT8 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I8;
+  }
+  else if( i_dtype == INT32 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I32;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
 
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::store_scalar( double             i_scalar,
+                                                                               libxsmm_datatype   i_xmm_dtype,
+                                                                               void             * o_scalar ) {
+  if( i_xmm_dtype == libxsmm_datatype::LIBXSMM_DATATYPE_F64 ) {
+    *(double *) o_scalar = i_scalar;
+    return err_t::SUCCESS;
+  }
+
+  float l_scalar_fp32 = (float) i_scalar;
+  if( i_xmm_dtype == libxsmm_datatype::LIBXSMM_DATATYPE_F32 ) {
+    *(float *) o_scalar = l_scalar_fp32;
+    return err_t::SUCCESS;
+  }
+
+  // 16-bit types: libxsmm performs the rounding
+  libxsmm_meltw_unary_shape l_shape = libxsmm_create_meltw_unary_shape( 1,
+                                                                        1,
+                                                                        1,
+                                                                        1,
+                                                                        libxsmm_datatype::LIBXSMM_DATATYPE_F32,
+                                                                        i_xmm_dtype,
+                                                                        libxsmm_datatype::LIBXSMM_DATATYPE_F32 );
+  libxsmm_meltwfunction_unary l_convert = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_IDENTITY,
+                                                                        l_shape,
+                                                                        LIBXSMM_MELTW_FLAG_UNARY_NONE );
+  if( l_convert == nullptr ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  libxsmm_meltw_unary_param l_param;
+  l_param.in.primary  = &l_scalar_fp32;
+  l_param.out.primary = o_scalar;
+  l_convert( &l_param );
+
+  return err_t::SUCCESS;
+}
+
 
 void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i_out_aux,
                                                                   void       * io_out ){
@@ -28,6 +77,14 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_first_touch( void const * i
     l_param.out.primary =          io_out;
     m_xmm_kernel_first_touch_binary( &l_param );
   }
+
+  if( m_xmm_kernel_first_touch_scale != nullptr ) {
+    libxsmm_meltw_binary_param l_param;
+    l_param.in0.primary = io_out;
+    l_param.in1.primary = m_scalar_first_touch.data();
+    l_param.out.primary = io_out;
+    m_xmm_kernel_first_touch_scale( &l_param );
+  }
 }
 
 
@@ -46,19 +103,268 @@ void einsum_ir::basic::ContractionBackendTpp::kernel_last_touch( void const * i_
     l_param.out.primary =          io_out;
     m_xmm_kernel_last_touch_binary( &l_param );
   }
+  else {
+    // epilogue program: all steps work in-place on the output tile
+    int64_t l_num_bytes_out = ce_n_bytes( m_dtype_out );
+    for( std::size_t l_st = 0; l_st < m_epilogue_steps.size(); l_st++ ) {
+      epilogue_step_t const & l_step = m_epilogue_steps[l_st];
+      if( l_step.unary != nullptr ) {
+        libxsmm_meltw_unary_param l_param;
+        l_param.in.primary  = io_out;
+        l_param.out.primary = io_out;
+        l_step.unary( &l_param );
+      }
+      else {
+        libxsmm_meltw_binary_param l_param;
+        l_param.in0.primary = io_out;
+        if( l_step.use_aux ) {
+          l_param.in1.primary = (void *) i_out_aux;
+        }
+        else {
+          l_param.in1.primary = m_epilogue_scalars.data() + l_step.id_scalar * l_num_bytes_out;
+        }
+        l_param.out.primary = io_out;
+        l_step.binary( &l_param );
+      }
+    }
+  }
 }
 
 
 void einsum_ir::basic::ContractionBackendTpp::kernel_main( void const * i_left,
                                                            void const * i_right,
-                                                           void       * io_out ){
+                                                           void       * io_out,
+                                                           char       * io_scratch ){
   libxsmm_gemm_param l_param;
   l_param.a.primary = (void *) i_left;
   l_param.b.primary = (void *) i_right;
   l_param.c.primary =          io_out;
   l_param.op.tertiary = &m_br;
 
-  m_xmm_kernel_main( &l_param );
+  if( m_xmm_kernel_main_product == nullptr ) {
+    m_xmm_kernel_main( &l_param );
+  }
+  // the product is computed in the scratch memory, scaled by alpha and added to the output
+  else {
+    l_param.c.primary = io_scratch;
+    m_xmm_kernel_main_product( &l_param );
+
+    libxsmm_meltw_binary_param l_param_binary;
+    l_param_binary.in0.primary = io_scratch;
+    l_param_binary.in1.primary = m_scalar_alpha.data();
+    l_param_binary.out.primary = io_scratch;
+    m_xmm_kernel_product_scale( &l_param_binary );
+
+    l_param_binary.in0.primary = io_out;
+    l_param_binary.in1.primary = io_scratch;
+    l_param_binary.out.primary = io_out;
+    m_xmm_kernel_product_add( &l_param_binary );
+  }
+}
+
+
+void einsum_ir::basic::ContractionBackendTpp::kernel_main_first_touch( void const * i_left,
+                                                                       void const * i_right,
+                                                                       void const * i_out_aux,
+                                                                       void       * io_out,
+                                                                       char       * io_scratch ){
+  if( m_xmm_kernel_main_first_touch != nullptr ) {
+    libxsmm_gemm_param l_param;
+    l_param.a.primary = (void *) i_left;
+    l_param.b.primary = (void *) i_right;
+    l_param.c.primary =          io_out;
+    l_param.op.tertiary = &m_br;
+
+    m_xmm_kernel_main_first_touch( &l_param );
+  }
+  else {
+    ContractionBackend::kernel_main_first_touch( i_left,
+                                                 i_right,
+                                                 i_out_aux,
+                                                 io_out,
+                                                 io_scratch );
+  }
+}
+
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::add_epilogue_step_binary( libxsmm_meltw_binary_type          i_type,
+                                                                                           bool                               i_use_aux,
+                                                                                           double                             i_scalar,
+                                                                                           libxsmm_meltw_binary_shape const & i_shape_aux,
+                                                                                           libxsmm_meltw_binary_shape const & i_shape_scalar,
+                                                                                           libxsmm_bitfield                   i_flag_out_aux,
+                                                                                           libxsmm_datatype                   i_xmm_dtype_out ){
+  epilogue_step_t l_step;
+  l_step.use_aux = i_use_aux;
+
+  if( i_use_aux ) {
+    l_step.binary = libxsmm_dispatch_meltw_binary( i_type,
+                                                   i_shape_aux,
+                                                   i_flag_out_aux );
+  }
+  else {
+    // scalar operand is stored in the output datatype
+    int64_t l_num_bytes_out = ce_n_bytes( m_dtype_out );
+    l_step.id_scalar = m_epilogue_scalars.size() / l_num_bytes_out;
+    m_epilogue_scalars.resize( m_epilogue_scalars.size() + l_num_bytes_out );
+
+    err_t l_err = store_scalar( i_scalar,
+                                i_xmm_dtype_out,
+                                m_epilogue_scalars.data() + l_step.id_scalar * l_num_bytes_out );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    l_step.binary = libxsmm_dispatch_meltw_binary( i_type,
+                                                   i_shape_scalar,
+                                                   LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+  }
+  if( l_step.binary == nullptr ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  m_epilogue_steps.push_back( l_step );
+
+  return err_t::SUCCESS;
+}
+
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_epilogue( libxsmm_datatype i_xmm_dtype_out,
+                                                                                   libxsmm_datatype i_xmm_dtype_comp,
+                                                                                   libxsmm_bitfield i_flag_out_aux_binary ){
+  int64_t l_num_ops = m_epilogue.size();
+
+  m_epilogue_steps.clear();
+  m_epilogue_scalars.clear();
+
+  libxsmm_meltw_unary_shape l_shape_unary = libxsmm_create_meltw_unary_shape( m_m * m_r,
+                                                                              m_n,
+                                                                              m_ldc,
+                                                                              m_ldc,
+                                                                              i_xmm_dtype_out,
+                                                                              i_xmm_dtype_out,
+                                                                              i_xmm_dtype_comp );
+
+  libxsmm_meltw_binary_shape l_shape_binary_aux = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                     m_n,
+                                                                                     m_ldc,
+                                                                                     m_stride_n_out_aux,
+                                                                                     m_ldc,
+                                                                                     i_xmm_dtype_out,
+                                                                                     i_xmm_dtype_out,
+                                                                                     i_xmm_dtype_out,
+                                                                                     i_xmm_dtype_comp );
+
+  libxsmm_meltw_binary_shape l_shape_binary_scalar = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                        m_n,
+                                                                                        m_ldc,
+                                                                                        m_ldc,
+                                                                                        m_ldc,
+                                                                                        i_xmm_dtype_out,
+                                                                                        i_xmm_dtype_out,
+                                                                                        i_xmm_dtype_out,
+                                                                                        i_xmm_dtype_comp );
+
+  for( int64_t l_op = 0; l_op < l_num_ops; l_op++ ) {
+    kernel_t l_ktype   = m_epilogue[l_op].ktype;
+    bool     l_use_aux = m_epilogue[l_op].use_aux;
+    double   l_scalar  = m_epilogue[l_op].scalar;
+    err_t    l_err     = err_t::SUCCESS;
+
+    // unary ops
+    libxsmm_meltw_unary_type l_type_unary = LIBXSMM_MELTW_TYPE_UNARY_NONE;
+    if(      l_ktype == kernel_t::RELU    ) l_type_unary = LIBXSMM_MELTW_TYPE_UNARY_RELU;
+    else if( l_ktype == kernel_t::GELU    ) l_type_unary = LIBXSMM_MELTW_TYPE_UNARY_GELU;
+    else if( l_ktype == kernel_t::SIGMOID ) l_type_unary = LIBXSMM_MELTW_TYPE_UNARY_SIGMOID;
+    else if( l_ktype == kernel_t::TANH    ) l_type_unary = LIBXSMM_MELTW_TYPE_UNARY_TANH;
+
+    // binary ops
+    libxsmm_meltw_binary_type l_type_binary = LIBXSMM_MELTW_TYPE_BINARY_NONE;
+    if(      l_ktype == kernel_t::ADD ) l_type_binary = LIBXSMM_MELTW_TYPE_BINARY_ADD;
+    else if( l_ktype == kernel_t::MUL ) l_type_binary = LIBXSMM_MELTW_TYPE_BINARY_MUL;
+    else if( l_ktype == kernel_t::MIN ) l_type_binary = LIBXSMM_MELTW_TYPE_BINARY_MIN;
+    else if( l_ktype == kernel_t::MAX ) l_type_binary = LIBXSMM_MELTW_TYPE_BINARY_MAX;
+
+    if( l_type_unary != LIBXSMM_MELTW_TYPE_UNARY_NONE ) {
+      epilogue_step_t l_step;
+      l_step.unary = libxsmm_dispatch_meltw_unary( l_type_unary,
+                                                   l_shape_unary,
+                                                   LIBXSMM_MELTW_FLAG_UNARY_NONE );
+      if( l_step.unary == nullptr ) {
+        return err_t::COMPILATION_FAILED;
+      }
+      m_epilogue_steps.push_back( l_step );
+    }
+    else if( l_type_binary != LIBXSMM_MELTW_TYPE_BINARY_NONE ) {
+      l_err = add_epilogue_step_binary( l_type_binary,
+                                        l_use_aux,
+                                        l_scalar,
+                                        l_shape_binary_aux,
+                                        l_shape_binary_scalar,
+                                        i_flag_out_aux_binary,
+                                        i_xmm_dtype_out );
+    }
+    // in-place conversion of the INT32 accumulators, followed by the scaling
+    else if( l_ktype == kernel_t::DEQUANT ) {
+      libxsmm_meltw_unary_shape l_shape_convert = libxsmm_create_meltw_unary_shape( m_m * m_r,
+                                                                                    m_n,
+                                                                                    m_ldc,
+                                                                                    m_ldc,
+                                                                                    libxsmm_datatype::LIBXSMM_DATATYPE_I32,
+                                                                                    i_xmm_dtype_out,
+                                                                                    i_xmm_dtype_out );
+      epilogue_step_t l_step;
+      l_step.unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_IDENTITY,
+                                                   l_shape_convert,
+                                                   LIBXSMM_MELTW_FLAG_UNARY_NONE );
+      if( l_step.unary == nullptr ) {
+        return err_t::COMPILATION_FAILED;
+      }
+      m_epilogue_steps.push_back( l_step );
+
+      l_err = add_epilogue_step_binary( LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                        l_use_aux,
+                                        l_scalar,
+                                        l_shape_binary_aux,
+                                        l_shape_binary_scalar,
+                                        i_flag_out_aux_binary,
+                                        i_xmm_dtype_out );
+    }
+    // scaling, saturation to the INT8 range and rounding to the nearest integer
+    else if( l_ktype == kernel_t::QUANT ) {
+      // adding and subtracting 1.5*2^(#mantissa bits) rounds values of small magnitude to integers
+      double l_round = 0;
+      if(      i_xmm_dtype_out == libxsmm_datatype::LIBXSMM_DATATYPE_F32 ) l_round = 12582912.0;
+      else if( i_xmm_dtype_out == libxsmm_datatype::LIBXSMM_DATATYPE_F64 ) l_round = 6755399441055744.0;
+      else return err_t::COMPILATION_FAILED;
+
+      libxsmm_meltw_binary_type l_types[5] = { LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                               LIBXSMM_MELTW_TYPE_BINARY_MAX,
+                                               LIBXSMM_MELTW_TYPE_BINARY_MIN,
+                                               LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                               LIBXSMM_MELTW_TYPE_BINARY_ADD };
+      double l_scalars[5] = { l_scalar, -128.0, 127.0, l_round, -l_round };
+
+      for( int64_t l_st = 0; l_st < 5 && l_err == err_t::SUCCESS; l_st++ ) {
+        l_err = add_epilogue_step_binary( l_types[l_st],
+                                          l_st == 0 && l_use_aux,
+                                          l_scalars[l_st],
+                                          l_shape_binary_aux,
+                                          l_shape_binary_scalar,
+                                          i_flag_out_aux_binary,
+                                          i_xmm_dtype_out );
+      }
+    }
+    else {
+      return err_t::COMPILATION_FAILED;
+    }
+
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  return err_t::SUCCESS;
 }
 
 
@@ -77,6 +383,26 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
     return err_t::COMPILATION_FAILED;
   }
 
+  // BF16 and FP16 are storage types which require FP32 computations
+  if(    ( ce_n_bytes( m_dtype_left  ) == 2 || ce_n_bytes( m_dtype_right ) == 2 || ce_n_bytes( m_dtype_out ) == 2 )
+      && m_dtype_comp != data_t::FP32 ) {
+    return err_t::COMPILATION_FAILED;
+  }
+
+  // INT8 contractions accumulate in INT32, the elementwise TPPs operate on the output's datatype
+  libxsmm_datatype l_xmm_dtype_acc          = l_xmm_dtype_out;
+  libxsmm_datatype l_xmm_dtype_comp_eltwise = l_xmm_dtype_comp;
+  if( m_dtype_comp == data_t::INT32 ) {
+    l_xmm_dtype_acc          = libxsmm_datatype::LIBXSMM_DATATYPE_I32;
+    l_xmm_dtype_comp_eltwise = l_xmm_dtype_out;
+  }
+
+  // alpha and beta are applied in the first and last touches
+  err_t l_err = fold_alpha_beta();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
   // setup bcast 
   libxsmm_bitfield l_flag_out_aux_unary  = LIBXSMM_MELTW_FLAG_UNARY_NONE;
   libxsmm_bitfield l_flag_out_aux_binary = LIBXSMM_MELTW_FLAG_BINARY_NONE;
@@ -107,7 +433,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                      m_ldc,
                                                                                      l_xmm_dtype_out,
                                                                                      l_xmm_dtype_out,
-                                                                                     l_xmm_dtype_out );
+                                                                                     l_xmm_dtype_comp_eltwise );
   
   libxsmm_meltw_unary_shape l_shape_single_touch_aux_unary = libxsmm_create_meltw_unary_shape( m_m * m_r,
                                                                                                m_n,
@@ -115,7 +441,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                                m_ldc,
                                                                                                l_xmm_dtype_out,
                                                                                                l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out );
+                                                                                               l_xmm_dtype_comp_eltwise );
 
   libxsmm_meltw_binary_shape l_shape_single_touch_aux_binary = libxsmm_create_meltw_binary_shape( m_m * m_r,
                                                                                                   m_n,
@@ -125,7 +451,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                                                   l_xmm_dtype_out,
                                                                                                   l_xmm_dtype_out,
                                                                                                   l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out );
+                                                                                                  l_xmm_dtype_comp_eltwise );
 
   //first touch kernel
   if( m_ktype_first_touch == kernel_t::ZERO ) {
@@ -147,6 +473,79 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
     return err_t::COMPILATION_FAILED;
   }
 
+  // scaling of the output after the first touch
+  if(    m_scale_first_touch != 1.0
+      && m_ktype_first_touch != kernel_t::ZERO ) {
+    m_scalar_first_touch.resize( ce_n_bytes( m_dtype_out ) );
+    l_err = store_scalar( m_scale_first_touch,
+                          l_xmm_dtype_out,
+                          m_scalar_first_touch.data() );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    libxsmm_meltw_binary_shape l_shape_scale = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                  m_n,
+                                                                                  m_ldc,
+                                                                                  m_ldc,
+                                                                                  m_ldc,
+                                                                                  l_xmm_dtype_out,
+                                                                                  l_xmm_dtype_out,
+                                                                                  l_xmm_dtype_out,
+                                                                                  l_xmm_dtype_comp_eltwise );
+    m_xmm_kernel_first_touch_scale = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                                                    l_shape_scale,
+                                                                    LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+    if( m_xmm_kernel_first_touch_scale == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
+
+  // scaling of the product by alpha in the scratch memory and addition to the output
+  if(    m_alpha != 1.0
+      && !m_skip_main ) {
+    m_scalar_alpha.resize( ce_n_bytes( m_dtype_comp ) );
+    l_err = store_scalar( m_alpha,
+                          l_xmm_dtype_comp,
+                          m_scalar_alpha.data() );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    libxsmm_meltw_binary_shape l_shape_product_scale = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                          m_n,
+                                                                                          m_m * m_r,
+                                                                                          m_m * m_r,
+                                                                                          m_m * m_r,
+                                                                                          l_xmm_dtype_comp,
+                                                                                          l_xmm_dtype_comp,
+                                                                                          l_xmm_dtype_comp,
+                                                                                          l_xmm_dtype_comp );
+    m_xmm_kernel_product_scale = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_MUL,
+                                                                l_shape_product_scale,
+                                                                LIBXSMM_MELTW_FLAG_BINARY_BCAST_SCALAR_IN_1 );
+
+    libxsmm_meltw_binary_shape l_shape_product_add = libxsmm_create_meltw_binary_shape( m_m * m_r,
+                                                                                        m_n,
+                                                                                        m_ldc,
+                                                                                        m_m * m_r,
+                                                                                        m_ldc,
+                                                                                        l_xmm_dtype_out,
+                                                                                        l_xmm_dtype_comp,
+                                                                                        l_xmm_dtype_out,
+                                                                                        l_xmm_dtype_comp );
+    m_xmm_kernel_product_add = libxsmm_dispatch_meltw_binary( LIBXSMM_MELTW_TYPE_BINARY_ADD,
+                                                              l_shape_product_add,
+                                                              LIBXSMM_MELTW_FLAG_BINARY_NONE );
+
+    if(    m_xmm_kernel_product_scale == nullptr
+        || m_xmm_kernel_product_add   == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+
+    m_size_scratch = m_m * m_r * m_n * ce_n_bytes( m_dtype_comp );
+  }
+
   // last touch kernel
   if( m_ktype_last_touch == kernel_t::RELU ) {
     m_xmm_kernel_last_touch_unary = libxsmm_dispatch_meltw_unary( LIBXSMM_MELTW_TYPE_UNARY_RELU,
@@ -158,6 +557,14 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                                     l_shape_single_touch_aux_binary,
                                                                     l_flag_out_aux_binary );
   }
+  else if( m_ktype_last_touch == kernel_t::EPILOGUE ) {
+    l_err = compile_epilogue( l_xmm_dtype_out,
+                              l_xmm_dtype_comp_eltwise,
+                              l_flag_out_aux_binary );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
   else if( m_ktype_last_touch != kernel_t::UNDEFINED_KTYPE ) {
     return err_t::COMPILATION_FAILED;
   }
@@ -183,7 +590,7 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                               m_ldc,
                                               l_xmm_dtype_left,
                                               l_xmm_dtype_right,
-                                              l_xmm_dtype_out,
+                                              l_xmm_dtype_acc,
                                               l_xmm_dtype_comp );
 
   //set br type and scale br strides
@@ -209,6 +616,15 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
                                                  l_flags_brgemm,
                                                  l_prefetch_flags_brgemm,
                                                  l_brconfig );
+
+    //zero first touch is folded into a main kernel with beta=0
+    if(    m_fuse_first_touch
+        && m_ktype_first_touch == kernel_t::ZERO ) {
+      m_xmm_kernel_main_first_touch = libxsmm_dispatch_brgemm( l_shape_brgemm,
+                                                               l_flags_brgemm | LIBXSMM_GEMM_FLAG_BETA_0,
+                                                               l_prefetch_flags_brgemm,
+                                                               l_brconfig );
+    }
   }
   else if( m_ktype_main == kernel_t::PACKED_MADD ){
      m_xmm_kernel_main = libxsmm_create_packed_gemm( l_shape_brgemm,
@@ -220,6 +636,36 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionBackendTpp::compile_kernels
   if( m_xmm_kernel_main == nullptr ) {
     return err_t::COMPILATION_FAILED;
   }
+
+  //main kernel which writes the product to the compact scratch memory
+  if(    m_alpha != 1.0
+      && !m_skip_main ) {
+    libxsmm_gemm_shape l_shape_product = libxsmm_create_gemm_shape( m_m,
+                                                                    m_n,
+                                                                    m_k,
+                                                                    m_lda,
+                                                                    m_ldb,
+                                                                    m_m,
+                                                                    l_xmm_dtype_left,
+                                                                    l_xmm_dtype_right,
+                                                                    l_xmm_dtype_comp,
+                                                                    l_xmm_dtype_comp );
+    if( m_ktype_main == kernel_t::PACKED_MADD ) {
+      m_xmm_kernel_main_product = libxsmm_create_packed_gemm( l_shape_product,
+                                                              l_flags_brgemm | LIBXSMM_GEMM_FLAG_BETA_0,
+                                                              l_prefetch_flags_brgemm,
+                                                              m_r );
+    }
+    else {
+      m_xmm_kernel_main_product = libxsmm_dispatch_brgemm( l_shape_product,
+                                                           l_flags_brgemm | LIBXSMM_GEMM_FLAG_BETA_0,
+                                                           l_prefetch_flags_brgemm,
+                                                           l_brconfig );
+    }
+    if( m_xmm_kernel_main_product == nullptr ) {
+      return err_t::COMPILATION_FAILED;
+    }
+  }
   
   return err_t::SUCCESS;
 }
\ No newline at end of file
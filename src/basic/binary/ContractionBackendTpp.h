@@ -19,21 +19,100 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
     //! LIBXSMM-based binary first-touch TPP
     libxsmm_meltwfunction_binary m_xmm_kernel_first_touch_binary = nullptr;
 
+    //! LIBXSMM-based binary TPP which scales the output after the first touch
+    libxsmm_meltwfunction_binary m_xmm_kernel_first_touch_scale = nullptr;
+
+    //! scaling factor of the first touch in the output datatype
+    std::vector< char > m_scalar_first_touch;
+
     //! LIBXSMM-based main TPP
     libxsmm_gemmfunction m_xmm_kernel_main = nullptr;
 
+    //! LIBXSMM-based main TPP with beta=0 which replaces a zero first touch
+    libxsmm_gemmfunction m_xmm_kernel_main_first_touch = nullptr;
+
+    //! LIBXSMM-based main TPP with beta=0 which writes the product to the scratch memory if alpha scales the product
+    libxsmm_gemmfunction m_xmm_kernel_main_product = nullptr;
+
+    //! LIBXSMM-based binary TPP which scales the product in the scratch memory by alpha
+    libxsmm_meltwfunction_binary m_xmm_kernel_product_scale = nullptr;
+
+    //! LIBXSMM-based binary TPP which adds the scaled product to the output
+    libxsmm_meltwfunction_binary m_xmm_kernel_product_add = nullptr;
+
+    //! alpha in the datatype of the computations
+    std::vector< char > m_scalar_alpha;
+
     //! LIBXSMM-based unary last-touch TPP
     libxsmm_meltwfunction_unary m_xmm_kernel_last_touch_unary = nullptr;
 
     //! LIBXSMM-based binary last-touch TPP
     libxsmm_meltwfunction_binary m_xmm_kernel_last_touch_binary = nullptr;
 
+    //! step of the compiled epilogue program, ops like DEQUANT and QUANT consist of multiple steps
+    struct epilogue_step_t {
+      libxsmm_meltwfunction_unary  unary     = nullptr; // unary TPP, nullptr for binary steps
+      libxsmm_meltwfunction_binary binary    = nullptr; // binary TPP, nullptr for unary steps
+      bool                         use_aux   = false;   // true if the second operand is the auxiliary tensor
+      int64_t                      id_scalar = 0;       // id of the scalar operand otherwise
+    };
+
+    //! LIBXSMM-based TPPs of the epilogue program
+    std::vector< epilogue_step_t > m_epilogue_steps;
+
+    //! scalar operands of the epilogue program's binary steps in the output datatype
+    std::vector< char > m_epilogue_scalars;
+
     /**
      * converts internal datatypes to libxsmm datatypes
      *
      * @return libxsmm datatype.
      **/
     libxsmm_datatype dtype_to_libxsmm( data_t i_dtype );
+
+    /**
+     * Stores a scalar in the given datatype.
+     *
+     * @param i_scalar value of the scalar.
+     * @param i_xmm_dtype libxsmm datatype of the stored scalar.
+     * @param o_scalar will be set to the converted scalar.
+     * @return SUCCESS if the scalar was stored, otherwise an appropiate error code.
+     **/
+    static err_t store_scalar( double             i_scalar,
+                               libxsmm_datatype   i_xmm_dtype,
+                               void             * o_scalar );
+
+    /**
+     * Appends a binary step to the compiled epilogue program.
+     *
+     * @param i_type type of the binary TPP.
+     * @param i_use_aux true if the auxiliary tensor is the second operand, false if i_scalar is used.
+     * @param i_scalar scalar second operand.
+     * @param i_shape_aux shape of the TPP which uses the auxiliary tensor.
+     * @param i_shape_scalar shape of the TPP which uses the scalar.
+     * @param i_flag_out_aux broadcast flag of the TPP which uses the auxiliary tensor.
+     * @param i_xmm_dtype_out libxsmm datatype of the output tensor.
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t add_epilogue_step_binary( libxsmm_meltw_binary_type          i_type,
+                                    bool                               i_use_aux,
+                                    double                             i_scalar,
+                                    libxsmm_meltw_binary_shape const & i_shape_aux,
+                                    libxsmm_meltw_binary_shape const & i_shape_scalar,
+                                    libxsmm_bitfield                   i_flag_out_aux,
+                                    libxsmm_datatype                   i_xmm_dtype_out );
+
+    /**
+     * Compiles the TPPs of the epilogue program.
+     *
+     * @param i_xmm_dtype_out libxsmm datatype of the output tensor.
+     * @param i_xmm_dtype_comp libxsmm datatype of the computations.
+     * @param i_flag_out_aux_binary broadcast flag of binary ops which use the auxiliary output tensor.
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t compile_epilogue( libxsmm_datatype i_xmm_dtype_out,
+                            libxsmm_datatype i_xmm_dtype_comp,
+                            libxsmm_bitfield i_flag_out_aux_binary );
     
   public:
     /**
@@ -60,10 +139,27 @@ class einsum_ir::basic::ContractionBackendTpp: public ContractionBackend {
      * @param i_left pointer to a data section of the left tensor.
      * @param i_right pointer to a data section of the right tensor.
      * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
      **/
     void kernel_main( void const * i_left,
                       void const * i_right,
-                      void       * io_out );
+                      void       * io_out,
+                      char       * io_scratch );
+
+    /**
+     * Kernel called in the innermost loop on the first access of the output tensor.
+     *
+     * @param i_left pointer to a data section of the left tensor.
+     * @param i_right pointer to a data section of the right tensor.
+     * @param i_out_aux pointer to a data section of the auxiliary output tensor.
+     * @param io_out pointer to a data section of the output tensor.
+     * @param io_scratch scratch memory of the thread with m_size_scratch bytes.
+     **/
+    void kernel_main_first_touch( void const * i_left,
+                                  void const * i_right,
+                                  void const * i_out_aux,
+                                  void       * io_out,
+                                  char       * io_scratch );
 
     /**
      * Compiles all kernels
@@ -397,6 +397,189 @@ TEST_CASE( "Tensor contraction with omp parallelisation.", "[contraction_backend
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
 }
 
+TEST_CASE( "Tensor contraction with dynamic and guided schedules of the shared loops.", "[contraction_backend]" ) {
+  //example: [m1,k1,m1],[n2,n1,k1]->[n2,m1,n1,m1]
+  //sizes:   [17,13,20],[ 8,47,13]->[ 8,17,47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::N,
+                                             dim_t::M,
+                                             dim_t::M, 
+                                             dim_t::N, 
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::OMP,
+                                             exec_t::PRIM, 
+                                             exec_t::PRIM, 
+                                             exec_t::PRIM };
+
+  //                                                    n2, m2,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {     8, 17,20,47,13 };  
+  std::vector< int64_t > l_loop_strides_left     = {     0,260, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = {   611,  0, 0,13, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {     0,  0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 15980,940, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( {   17,13,20 } );
+  at::Tensor l_right   = at::randn( {    8,47,13 } );
+  at::Tensor l_out     = at::zeros( { 8,17,47,20 } );
+  at::Tensor l_out_ref = l_out.clone();
+
+  std::vector< schedule_t > l_schedules = { schedule_t::DYNAMIC,
+                                            schedule_t::GUIDED };
+
+  for( std::size_t l_sc = 0; l_sc < l_schedules.size(); l_sc++ ) {
+    l_out.zero_();
+    ContractionBackendTpp l_cont;
+
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 data_t::FP32,
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 12,
+                 5,
+                 1,
+                 nullptr,
+                 executor_t::OPENMP,
+                 l_schedules[l_sc] );
+                
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     nullptr,
+                     l_out.data_ptr() );
+
+
+    l_out_ref = at::einsum( "xcb,yac->yxab",
+                            { l_left, l_right } );
+
+    REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+  }
+}
+
+TEST_CASE( "Tensor contraction with a split K dimension and first and last touches.", "[contraction_backend]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     32
+  //    n    1     2x12
+  //    k    2     4x16
+
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::N,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::OMP,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  k0,  n0,  m, n1, k1
+  std::vector< int64_t > l_loop_sizes            = {   4,   2, 32, 12, 16 };
+  std::vector< int64_t > l_loop_strides_left     = { 512,   0,  1,  0, 32 };
+  std::vector< int64_t > l_loop_strides_right    = {  16, 768,  0, 64,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 384,  1, 32,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {   0, 384,  1, 32,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( { 64, 32 } );
+  at::Tensor l_right   = at::randn( { 24, 64 } );
+  at::Tensor l_out_aux = at::randn( { 24, 32 } );
+  at::Tensor l_out_init = at::randn( { 24, 32 } );
+
+  std::vector< kernel_t > l_first_touches = { kernel_t::UNDEFINED_KTYPE,
+                                              kernel_t::ZERO,
+                                              kernel_t::ADD };
+  std::vector< kernel_t > l_last_touches  = { kernel_t::UNDEFINED_KTYPE,
+                                              kernel_t::RELU,
+                                              kernel_t::ADD };
+  std::vector< schedule_t > l_schedules = { schedule_t::STATIC,
+                                            schedule_t::DYNAMIC };
+
+  for( std::size_t l_ft = 0; l_ft < l_first_touches.size(); l_ft++ ) {
+    for( std::size_t l_lt = 0; l_lt < l_last_touches.size(); l_lt++ ) {
+      for( std::size_t l_sc = 0; l_sc < l_schedules.size(); l_sc++ ) {
+        at::Tensor l_out = l_out_init.clone();
+
+        ContractionBackendTpp l_cont;
+        l_cont.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     l_first_touches[l_ft],
+                     kernel_t::MADD,
+                     l_last_touches[l_lt],
+                     4,
+                     1,
+                     1,
+                     nullptr,
+                     executor_t::OPENMP,
+                     l_schedules[l_sc] );
+
+        err_t l_err = l_cont.compile();
+        REQUIRE( l_err == err_t::SUCCESS );
+
+        l_cont.contract( l_left.data_ptr(),
+                         l_right.data_ptr(),
+                         l_out_aux.data_ptr(),
+                         l_out.data_ptr() );
+
+        // reference
+        at::Tensor l_out_ref = l_out_init.clone();
+        if( l_first_touches[l_ft] == kernel_t::ZERO ) {
+          l_out_ref.zero_();
+        }
+        else if( l_first_touches[l_ft] == kernel_t::ADD ) {
+          l_out_ref += l_out_aux;
+        }
+        l_out_ref += at::matmul( l_right, l_left );
+        if( l_last_touches[l_lt] == kernel_t::RELU ) {
+          l_out_ref = at::relu( l_out_ref );
+        }
+        else if( l_last_touches[l_lt] == kernel_t::ADD ) {
+          l_out_ref += l_out_aux;
+        }
+
+        REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+      }
+    }
+  }
+}
+
 TEST_CASE( "Blocked matmul with omp parallelisation.", "[contraction_backend]" ) {
   //example: [m2,k2,k1,m1],[n2,k2,n1,k1]->[n2,m2,n1,m1]
   //sizes:   [32, 8,64,64],[32, 8,64,64]->[32,32,64,64]
@@ -607,6 +790,77 @@ TEST_CASE( "Tensor contraction with SFC and omp parallelisation.", "[contraction
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
 }
 
+TEST_CASE( "Tensor contraction with SFC and shared parallelisation using the thread pool.", "[contraction_backend]" ) {
+  //example: [c1,m1,k1,m1],[c1,n2,n1,k1]->[c1,n2,m1,n1,m1]
+  //sizes:   [ 5,17,13,20],[ 5, 8,47,13]->[ 5, 8,17,47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::M, 
+                                             dim_t::N, 
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::SFC,
+                                             exec_t::SFC,
+                                             exec_t::PRIM, 
+                                             exec_t::PRIM, 
+                                             exec_t::PRIM };
+
+  //                                                     c1,  m2,   n2,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {      5, 17,    8,20,47,13 };  
+  std::vector< int64_t > l_loop_strides_left     = {   4420,260,    0, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = {   4888,  0,  611, 0,13, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {      0,  0,    0, 0, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 127840,940,15980, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left    = at::randn( {   5,17,13,20 } );
+  at::Tensor l_right   = at::randn( {   5, 8,47,13 } );
+  at::Tensor l_out     = at::zeros( { 5,8,17,47,20 } );
+  at::Tensor l_out_ref = l_out.clone();
+
+  ContractionBackendTpp l_cont;
+
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               kernel_t::ZERO,
+               kernel_t::MADD,
+               kernel_t::UNDEFINED_KTYPE,
+               10,
+               2,
+               3,
+               nullptr,
+               executor_t::THREAD_POOL );
+                
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   nullptr,
+                   l_out.data_ptr() );
+
+
+  l_out_ref = at::einsum( "zxcb,zyac->zyxab",
+                          { l_left, l_right } );
+
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+}
+
 TEST_CASE( "Tensor contraction with packing of left tensor and SFC parallelisation.", "[contraction_backend]" ) {
   //example: [c1,m1,k1,m1],[c1,n2,n1,k1]->[c1,n2,m1,n1,m1]
   //sizes:   [ 5,17,13,20],[ 5, 8,47,13]->[ 5, 8,17,47,20]
@@ -749,4 +1003,664 @@ TEST_CASE( "Tensor contraction with packing of both tensors and SFC parallelisat
                           { l_left, l_right } );
 
   REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Matmul with sequential batch dimension and epilogue programs.", "[contraction_backend]" ) {
+  //example: [c1,k1,m1],[c1,n1,k1]->[c1,n1,m1] with a bias [m1]
+  //sizes:   [17,13,20],[17,47,13]->[17,47,20]
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::C,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::SEQ,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  c1,m1,n1,k1
+  std::vector< int64_t > l_loop_sizes            = {  17,20,47,13 };
+  std::vector< int64_t > l_loop_strides_left     = { 260, 1, 0,20 };
+  std::vector< int64_t > l_loop_strides_right    = { 611, 0,13, 1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0, 1, 0, 0 };
+  std::vector< int64_t > l_loop_strides_out      = { 940, 1,20, 0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left  = at::randn( { 17,13,20 } );
+  at::Tensor l_right = at::randn( { 17,47,13 } );
+  at::Tensor l_bias  = at::randn( { 20 } );
+  at::Tensor l_out   = at::zeros( { 17,47,20 } );
+
+  at::Tensor l_out_ref = at::einsum( "xcb,xac->xab",
+                                     { l_left, l_right } );
+
+  // bias + GELU
+  std::vector< epilogue_op > l_epilogue( 2 );
+  l_epilogue[0].ktype = kernel_t::ADD;
+  l_epilogue[1].ktype = kernel_t::GELU;
+
+  ContractionBackendTpp l_cont_gelu;
+  l_cont_gelu.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    kernel_t::ZERO,
+                    kernel_t::MADD,
+                    kernel_t::EPILOGUE,
+                    1,
+                    1,
+                    1,
+                    nullptr,
+                    executor_t::OPENMP,
+                    schedule_t::STATIC,
+                    true,
+                    l_epilogue );
+
+  err_t l_err = l_cont_gelu.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_gelu.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        l_bias.data_ptr(),
+                        l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, at::gelu( l_out_ref + l_bias ), 1E-3, 1E-4 ) );
+
+  // scale + clamp
+  l_epilogue.resize( 3 );
+  l_epilogue[0].ktype   = kernel_t::MUL;
+  l_epilogue[0].use_aux = false;
+  l_epilogue[0].scalar  = 0.5;
+  l_epilogue[1].ktype   = kernel_t::MAX;
+  l_epilogue[1].use_aux = false;
+  l_epilogue[1].scalar  = -1.0;
+  l_epilogue[2].ktype   = kernel_t::MIN;
+  l_epilogue[2].use_aux = false;
+  l_epilogue[2].scalar  = 1.0;
+
+  ContractionBackendTpp l_cont_clamp;
+  l_cont_clamp.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::ZERO,
+                     kernel_t::MADD,
+                     kernel_t::EPILOGUE,
+                     1,
+                     1,
+                     1,
+                     nullptr,
+                     executor_t::OPENMP,
+                     schedule_t::STATIC,
+                     true,
+                     l_epilogue );
+
+  l_err = l_cont_clamp.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_clamp.contract( l_left.data_ptr(),
+                         l_right.data_ptr(),
+                         nullptr,
+                         l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, at::clamp( 0.5 * l_out_ref, -1.0, 1.0 ), 1E-4, 1E-5 ) );
+
+  // single sigmoid last touch
+  ContractionBackendTpp l_cont_sigmoid;
+  l_cont_sigmoid.init( l_loop_dim_type,
+                       l_loop_exec_type,
+                       l_loop_sizes,
+                       l_loop_strides_left,
+                       l_loop_strides_right,
+                       l_loop_strides_out_aux,
+                       l_loop_strides_out,
+                       l_packing_strides_left,
+                       l_packing_strides_right,
+                       data_t::FP32,
+                       data_t::FP32,
+                       data_t::FP32,
+                       data_t::FP32,
+                       kernel_t::ZERO,
+                       kernel_t::MADD,
+                       kernel_t::SIGMOID,
+                       1,
+                       1,
+                       1,
+                       nullptr );
+
+  l_err = l_cont_sigmoid.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_sigmoid.contract( l_left.data_ptr(),
+                           l_right.data_ptr(),
+                           nullptr,
+                           l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, at::sigmoid( l_out_ref ), 1E-3, 1E-4 ) );
+}
+
+TEST_CASE( "Matmul with alpha and beta.", "[contraction_backend]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     32
+  //    n    1     24
+  //    k    2     16
+
+  using namespace einsum_ir::basic;
+
+  at::Tensor l_left  = at::randn( { 16, 32 } );
+  at::Tensor l_right = at::randn( { 24, 16 } );
+  at::Tensor l_out   = at::randn( { 24, 32 } );
+
+  at::Tensor l_out_ref = 0.5 * l_out + 1.5 * at::matmul( l_right, l_left );
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                   m,  n,  k
+  std::vector< int64_t > l_loop_sizes            = {  32, 24, 16 };
+  std::vector< int64_t > l_loop_strides_left     = {   1,  0, 32 };
+  std::vector< int64_t > l_loop_strides_right    = {   0, 16,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0,  0,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {   1, 32,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  // out = 1.5 * left * right + 0.5 * out
+  ContractionBackendTpp l_cont;
+  l_cont.init( l_loop_dim_type,
+               l_loop_exec_type,
+               l_loop_sizes,
+               l_loop_strides_left,
+               l_loop_strides_right,
+               l_loop_strides_out_aux,
+               l_loop_strides_out,
+               l_packing_strides_left,
+               l_packing_strides_right,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               data_t::FP32,
+               kernel_t::UNDEFINED_KTYPE,
+               kernel_t::MADD,
+               kernel_t::UNDEFINED_KTYPE,
+               1,
+               1,
+               1,
+               nullptr,
+               executor_t::OPENMP,
+               schedule_t::STATIC,
+               true,
+               std::vector< epilogue_op >(),
+               1.5,
+               0.5 );
+
+  err_t l_err = l_cont.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont.contract( l_left.data_ptr(),
+                   l_right.data_ptr(),
+                   nullptr,
+                   l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+
+  // out = relu( -2.0 * left * right ), beta=0 ignores the previous values of out
+  ContractionBackendTpp l_cont_relu;
+  l_cont_relu.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    kernel_t::UNDEFINED_KTYPE,
+                    kernel_t::MADD,
+                    kernel_t::RELU,
+                    1,
+                    1,
+                    1,
+                    nullptr,
+                    executor_t::OPENMP,
+                    schedule_t::STATIC,
+                    true,
+                    std::vector< epilogue_op >(),
+                    -2.0,
+                    0.0 );
+
+  l_err = l_cont_relu.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_relu.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        nullptr,
+                        l_out.data_ptr() );
+
+  l_out_ref = at::relu( -2.0 * at::matmul( l_right, l_left ) );
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+
+  // out = 0.5 * out, alpha=0 skips the contraction
+  ContractionBackendTpp l_cont_scale;
+  l_cont_scale.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     data_t::FP32,
+                     kernel_t::UNDEFINED_KTYPE,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr,
+                     executor_t::OPENMP,
+                     schedule_t::STATIC,
+                     true,
+                     std::vector< epilogue_op >(),
+                     0.0,
+                     0.5 );
+
+  l_err = l_cont_scale.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_out_ref = 0.5 * l_out;
+  l_cont_scale.contract( l_left.data_ptr(),
+                         l_right.data_ptr(),
+                         nullptr,
+                         l_out.data_ptr() );
+
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+
+  // out = 1E-39 * left * right + 2.0 * out, beta is not divided by the tiny alpha
+  ContractionBackendTpp l_cont_tiny;
+  l_cont_tiny.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    data_t::FP32,
+                    kernel_t::UNDEFINED_KTYPE,
+                    kernel_t::MADD,
+                    kernel_t::UNDEFINED_KTYPE,
+                    1,
+                    1,
+                    1,
+                    nullptr,
+                    executor_t::OPENMP,
+                    schedule_t::STATIC,
+                    true,
+                    std::vector< epilogue_op >(),
+                    1E-39,
+                    2.0 );
+
+  l_err = l_cont_tiny.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_out_ref = 2.0 * l_out;
+  l_cont_tiny.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        nullptr,
+                        l_out.data_ptr() );
+
+  REQUIRE( at::isfinite( l_out ).all().item< bool >() );
+  REQUIRE( at::allclose( l_out, l_out_ref, 1E-4, 1E-5 ) );
+}
+
+TEST_CASE( "BF16 and FP16 matmuls with FP32 computations.", "[contraction_backend]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     32
+  //    n    1     24
+  //    k    2     64
+
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                   m,  n,  k
+  std::vector< int64_t > l_loop_sizes            = {  32, 24, 64 };
+  std::vector< int64_t > l_loop_strides_left     = {   1,  0, 32 };
+  std::vector< int64_t > l_loop_strides_right    = {   0, 64,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0,  0,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {   1, 32,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  data_t         l_dtypes[2]    = { data_t::BF16, data_t::FP16 };
+  at::ScalarType l_dtypes_at[2] = { at::ScalarType::BFloat16, at::ScalarType::Half };
+
+  for( int64_t l_ty = 0; l_ty < 2; l_ty++ ) {
+    at::Tensor l_left  = at::randn( { 64, 32 } ).to( l_dtypes_at[l_ty] );
+    at::Tensor l_right = at::randn( { 24, 64 } ).to( l_dtypes_at[l_ty] );
+    at::Tensor l_out   = at::zeros( { 24, 32 } ).to( l_dtypes_at[l_ty] );
+
+    ContractionBackendTpp l_cont;
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 l_dtypes[l_ty],
+                 l_dtypes[l_ty],
+                 data_t::FP32,
+                 l_dtypes[l_ty],
+                 kernel_t::ZERO,
+                 kernel_t::MADD,
+                 kernel_t::RELU,
+                 1,
+                 1,
+                 1,
+                 nullptr );
+
+    err_t l_err = l_cont.compile();
+    REQUIRE( l_err == err_t::SUCCESS );
+
+    l_cont.contract( l_left.data_ptr(),
+                     l_right.data_ptr(),
+                     nullptr,
+                     l_out.data_ptr() );
+
+    // reference computed in FP32
+    at::Tensor l_out_ref = at::relu( at::matmul( l_right.to( at::ScalarType::Float ),
+                                                 l_left.to( at::ScalarType::Float ) ) );
+
+    REQUIRE( at::allclose( l_out.to( at::ScalarType::Float ), l_out_ref, 1E-2, 1E-2 ) );
+  }
+
+  // 16-bit storage types require FP32 computations
+  ContractionBackendTpp l_cont_fp64;
+  l_cont_fp64.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::BF16,
+                    data_t::BF16,
+                    data_t::FP64,
+                    data_t::BF16,
+                    kernel_t::ZERO,
+                    kernel_t::MADD,
+                    kernel_t::UNDEFINED_KTYPE,
+                    1,
+                    1,
+                    1,
+                    nullptr );
+
+  REQUIRE( l_cont_fp64.compile() == err_t::COMPILATION_FAILED );
+}
+
+TEST_CASE( "BF16 and FP16 matmuls with a split K dimension are rejected.", "[contraction_backend]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     32
+  //    n    1     24
+  //    k    2     4x16
+
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::K,
+                                             dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::OMP,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                  k0,  m,  n, k1
+  std::vector< int64_t > l_loop_sizes            = {   4, 32, 24, 16 };
+  std::vector< int64_t > l_loop_strides_left     = { 512,  1,  0, 32 };
+  std::vector< int64_t > l_loop_strides_right    = {  16,  0, 64,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   0,  0,  0,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {   0,  1, 32,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  data_t l_dtypes[2] = { data_t::BF16, data_t::FP16 };
+
+  // the partial outputs would be rounded to the storage type
+  for( int64_t l_ty = 0; l_ty < 2; l_ty++ ) {
+    ContractionBackendTpp l_cont;
+    l_cont.init( l_loop_dim_type,
+                 l_loop_exec_type,
+                 l_loop_sizes,
+                 l_loop_strides_left,
+                 l_loop_strides_right,
+                 l_loop_strides_out_aux,
+                 l_loop_strides_out,
+                 l_packing_strides_left,
+                 l_packing_strides_right,
+                 l_dtypes[l_ty],
+                 l_dtypes[l_ty],
+                 data_t::FP32,
+                 l_dtypes[l_ty],
+                 kernel_t::UNDEFINED_KTYPE,
+                 kernel_t::MADD,
+                 kernel_t::UNDEFINED_KTYPE,
+                 4,
+                 1,
+                 1,
+                 nullptr );
+
+    REQUIRE( l_cont.compile() == err_t::COMPILATION_FAILED );
+  }
+}
+
+TEST_CASE( "INT8 matmuls with INT32 accumulation, dequantization and requantization.", "[contraction_backend]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     32
+  //    n    1     24
+  //    k    2     64
+
+  using namespace einsum_ir::basic;
+
+  std::vector< dim_t >  l_loop_dim_type  = { dim_t::M,
+                                             dim_t::N,
+                                             dim_t::K };
+  std::vector< exec_t > l_loop_exec_type = { exec_t::PRIM,
+                                             exec_t::PRIM,
+                                             exec_t::PRIM };
+
+  //                                                   m,  n,  k
+  std::vector< int64_t > l_loop_sizes            = {  32, 24, 64 };
+  std::vector< int64_t > l_loop_strides_left     = {   1,  0, 32 };
+  std::vector< int64_t > l_loop_strides_right    = {   0, 64,  1 };
+  std::vector< int64_t > l_loop_strides_out_aux  = {   1,  0,  0 };
+  std::vector< int64_t > l_loop_strides_out      = {   1, 32,  0 };
+  std::vector< int64_t > l_packing_strides_left  = {};
+  std::vector< int64_t > l_packing_strides_right = {};
+
+  at::Tensor l_left   = at::randint( -128, 128, { 64, 32 }, at::ScalarType::Char );
+  at::Tensor l_right  = at::randint( -128, 128, { 24, 64 }, at::ScalarType::Char );
+  at::Tensor l_scales = at::rand( { 32 } ) * 0.01;
+
+  // reference accumulators are exact in FP32
+  at::Tensor l_acc_ref = at::matmul( l_right.to( at::ScalarType::Float ),
+                                     l_left.to( at::ScalarType::Float ) );
+
+  // raw INT32 accumulators
+  at::Tensor l_out_int32 = at::zeros( { 24, 32 }, at::ScalarType::Int );
+
+  ContractionBackendTpp l_cont_int32;
+  l_cont_int32.init( l_loop_dim_type,
+                     l_loop_exec_type,
+                     l_loop_sizes,
+                     l_loop_strides_left,
+                     l_loop_strides_right,
+                     l_loop_strides_out_aux,
+                     l_loop_strides_out,
+                     l_packing_strides_left,
+                     l_packing_strides_right,
+                     data_t::INT8,
+                     data_t::INT8,
+                     data_t::INT32,
+                     data_t::INT32,
+                     kernel_t::ZERO,
+                     kernel_t::MADD,
+                     kernel_t::UNDEFINED_KTYPE,
+                     1,
+                     1,
+                     1,
+                     nullptr );
+
+  err_t l_err = l_cont_int32.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_int32.contract( l_left.data_ptr(),
+                         l_right.data_ptr(),
+                         nullptr,
+                         l_out_int32.data_ptr() );
+
+  REQUIRE( at::equal( l_out_int32, l_acc_ref.to( at::ScalarType::Int ) ) );
+
+  // per-channel dequantization followed by a requantization with a per-tensor scale
+  std::vector< epilogue_op > l_epilogue( 2 );
+  l_epilogue[0].ktype   = kernel_t::DEQUANT;
+  l_epilogue[1].ktype   = kernel_t::QUANT;
+  l_epilogue[1].use_aux = false;
+  l_epilogue[1].scalar  = 20.0;
+
+  at::Tensor l_out_fp32 = at::zeros( { 24, 32 } );
+
+  ContractionBackendTpp l_cont_fp32;
+  l_cont_fp32.init( l_loop_dim_type,
+                    l_loop_exec_type,
+                    l_loop_sizes,
+                    l_loop_strides_left,
+                    l_loop_strides_right,
+                    l_loop_strides_out_aux,
+                    l_loop_strides_out,
+                    l_packing_strides_left,
+                    l_packing_strides_right,
+                    data_t::INT8,
+                    data_t::INT8,
+                    data_t::INT32,
+                    data_t::FP32,
+                    kernel_t::ZERO,
+                    kernel_t::MADD,
+                    kernel_t::EPILOGUE,
+                    1,
+                    1,
+                    1,
+                    nullptr,
+                    executor_t::OPENMP,
+                    schedule_t::STATIC,
+                    true,
+                    l_epilogue );
+
+  l_err = l_cont_fp32.compile();
+  REQUIRE( l_err == err_t::SUCCESS );
+
+  l_cont_fp32.contract( l_left.data_ptr(),
+                        l_right.data_ptr(),
+                        l_scales.data_ptr(),
+                        l_out_fp32.data_ptr() );
+
+  at::Tensor l_out_ref = at::clamp( at::round( l_acc_ref * l_scales * 20.0 ), -128, 127 );
+
+  REQUIRE( at::allclose( l_out_fp32, l_out_ref ) );
+
+  // FP32 outputs require a dequantization of the accumulators
+  ContractionBackendTpp l_cont_no_dequant;
+  l_cont_no_dequant.init( l_loop_dim_type,
+                          l_loop_exec_type,
+                          l_loop_sizes,
+                          l_loop_strides_left,
+                          l_loop_strides_right,
+                          l_loop_strides_out_aux,
+                          l_loop_strides_out,
+                          l_packing_strides_left,
+                          l_packing_strides_right,
+                          data_t::INT8,
+                          data_t::INT8,
+                          data_t::INT32,
+                          data_t::FP32,
+                          kernel_t::ZERO,
+                          kernel_t::MADD,
+                          kernel_t::RELU,
+                          1,
+                          1,
+                          1,
+                          nullptr );
+
+  REQUIRE( l_cont_no_dequant.compile() == err_t::COMPILATION_FAILED );
+}
@@ -40,6 +40,8 @@ void einsum_ir::basic::ContractionMemoryManager::alloc_all_memory(){
 
 void einsum_ir::basic::ContractionMemoryManager::reserve_thread_memory( int64_t i_size, 
                                                                         int64_t i_num_threads ){
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+
   if( i_size > m_req_thread_mem ){
     m_req_thread_mem = i_size;
   }
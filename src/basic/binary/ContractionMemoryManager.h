@@ -1,6 +1,7 @@
 #ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_MEMORY_MANAGER
 #define EINSUM_IR_BASIC_BINARY_CONTRACTION_MEMORY_MANAGER
 
+#include <mutex>
 #include <vector>
 #include "../constants.h"
 
@@ -24,6 +25,9 @@ class einsum_ir::basic::ContractionMemoryManager{
     int64_t m_req_thread_mem = 0;
     //! number of threads
     int64_t m_num_threads = 1;
+
+    //! mutex protecting the reservations, contractions may be compiled concurrently
+    std::mutex m_mutex;
     
   public:
     /**
@@ -38,6 +42,7 @@ class einsum_ir::basic::ContractionMemoryManager{
 
     /**
      * Reserves thread specific memory for intermediate data in contractions. 
+     * The reservations are thread-safe and independent of their order.
      *
      * @param i_size size of reserved memory.
      **/
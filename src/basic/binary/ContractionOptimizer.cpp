@@ -15,7 +15,12 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
                                                    int64_t                        i_l2_cache_size,
                                                    int64_t                      * io_num_threads_shared,
                                                    int64_t                      * io_num_threads_sfc_m,
-                                                   int64_t                      * io_num_threads_sfc_n ){
+                                                   int64_t                      * io_num_threads_sfc_n,
+                                                   int64_t                        i_target_extra_packing,
+                                                   int64_t                        i_l3_cache_size,
+                                                   int64_t                        i_num_threads_l2,
+                                                   int64_t                        i_num_bytes_scalar_left,
+                                                   int64_t                        i_num_bytes_scalar_right ){
   m_iter_space = i_iter_space;
   m_ktype_main = i_ktype_main;
 
@@ -31,7 +36,11 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
   m_packed_gemm_support = i_packed_gemm_support;
 
   m_num_bytes_scalar_out = i_num_bytes_scalar_out;
+  m_num_bytes_scalar_left  = i_num_bytes_scalar_left  > 0 ? i_num_bytes_scalar_left  : i_num_bytes_scalar_out;
+  m_num_bytes_scalar_right = i_num_bytes_scalar_right > 0 ? i_num_bytes_scalar_right : i_num_bytes_scalar_out;
   m_l2_cache_size = i_l2_cache_size;
+  m_l3_cache_size = i_l3_cache_size;
+  m_num_threads_l2 = i_num_threads_l2;
 
   m_num_threads_sfc_m   = io_num_threads_sfc_m;
   m_num_threads_sfc_n   = io_num_threads_sfc_n;
@@ -39,9 +48,9 @@ void einsum_ir::basic::ContractionOptimizer::init( std::vector< iter_property >
 
   m_num_threads = *m_num_threads_sfc_m * *m_num_threads_sfc_n * *m_num_threads_shared;
 
-  //small power of 2 to avoid extra overhead and still utilise the stride one dimension to some extend
-  //heuristic right now, could choose this parameter architecture dependent
-  m_target_extra_packing = 8;
+  //default: small power of 2 to avoid extra overhead and still utilise the stride one dimension to some extend
+  //the autotuner may choose other values
+  m_target_extra_packing = i_target_extra_packing;
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
@@ -51,6 +60,9 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
   // sort iters and fuse them afterwards
   sort_and_fuse_iters();
 
+  // check if k dimensions may be parallelized
+  set_split_k( m_num_bytes_scalar_out );
+
   // find and add the Kernel
   err_t l_err = set_primitive_iters();
   if( l_err != err_t::SUCCESS ){
@@ -67,7 +79,8 @@ einsum_ir::basic::err_t einsum_ir::basic::ContractionOptimizer::optimize(){
                        m_size_sfc_n,
                        m_num_threads_shared,
                        m_num_threads_sfc_m,
-                       m_num_threads_sfc_n
+                       m_num_threads_sfc_n,
+                       m_num_threads_l2
                       );
 
   return err_t::SUCCESS;
@@ -110,6 +123,24 @@ void einsum_ir::basic::ContractionOptimizer::sort_and_fuse_iters(){
   }
 }
 
+void einsum_ir::basic::ContractionOptimizer::set_split_k( int64_t i_num_bytes_out ){
+  int64_t l_size_out = 1;
+  m_size_k_all = 1;
+  for( std::vector<iter_property>::iterator l_it = m_iter_space->begin(); l_it < m_iter_space->end(); l_it++ ){
+    if( l_it->dim_type == dim_t::K ){
+      m_size_k_all *= l_it->size;
+    }
+    else{
+      l_size_out *= l_it->size;
+    }
+  }
+
+  //every thread accumulates into its own copy of the output, the backend rejects 16-bit outputs
+  m_split_k =    m_num_threads > 1
+              && ( i_num_bytes_out == 4 || i_num_bytes_out == 8 )
+              && l_size_out * i_num_bytes_out <= m_l2_cache_size;
+}
+
 void einsum_ir::basic::ContractionOptimizer::remove_empty_iters(){
     std::vector<iter_property>::iterator l_it;
     l_it = std::remove_if( m_iter_space->begin(), 
@@ -210,6 +241,9 @@ void einsum_ir::basic::ContractionOptimizer::set_kernel_targets_heuristic( int64
   int64_t l_size_m, l_size_n;
   get_size_all_m_n( l_size_m, l_size_n );
   int64_t l_possible_parallelism = l_size_m * l_size_n;
+  if( m_split_k ){
+    l_possible_parallelism *= std::max( m_size_k_all / (io_kernel_targets[PRIM_K] * io_kernel_targets[PRIM_BR]), (int64_t)1 );
+  }
   while( l_possible_parallelism / (io_kernel_targets[PRIM_M] * io_kernel_targets[PRIM_N]) < m_num_threads &&
          io_kernel_targets[PRIM_M] * io_kernel_targets[PRIM_N] > 1 ){
     if(io_kernel_targets[PRIM_M] < io_kernel_targets[PRIM_N]){
@@ -627,9 +661,36 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
   }
   l_target_parallel_c = l_target_parallel / (l_target_parallel_m * l_target_parallel_n);
 
+  //use a 3d sfc if the blocks of the input tensors which contribute to an output tile don't fit into L2
+  int64_t l_target_sfc_k = 1;
+  if( m_generate_sfcs ){
+    int64_t l_kernel_size_m = 1;
+    int64_t l_kernel_size_n = 1;
+    for( l_it = l_kernel_iters.begin(); l_it < l_kernel_iters.end(); l_it++ ){
+      if( l_it->dim_type == dim_t::M ){
+        l_kernel_size_m *= l_it->size;
+      }
+      else if( l_it->dim_type == dim_t::N ){
+        l_kernel_size_n *= l_it->size;
+      }
+    }
+    int64_t l_size_blocks_in = (  l_kernel_size_m * m_num_bytes_scalar_left
+                                + l_kernel_size_n * m_num_bytes_scalar_right ) * m_size_k_all;
+    int64_t l_size_l2_half   = m_l2_cache_size / 2;
+    if( l_size_blocks_in > l_size_l2_half ){
+      l_target_sfc_k = (l_size_blocks_in + l_size_l2_half - 1) / l_size_l2_half;
+    }
+  }
+
   //add parallel dimension
   std::vector<iter_property> l_blocking_iters;
+  int64_t l_size_parallel = 1;
+  int64_t l_size_sfc_k = 1;
   if( m_generate_sfcs ) {
+    l_size_sfc_k = move_iters_until( &l_blocking_iters,
+                                     l_target_sfc_k,
+                                     dim_t::K,
+                                     exec_t::SFC );
     m_size_sfc_n = move_iters_until( &l_blocking_iters, 
                                     l_target_parallel_n,
                                     dim_t::N,
@@ -638,25 +699,72 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                                     l_target_parallel_m,
                                     dim_t::M,
                                     exec_t::SFC);
+    l_size_parallel = m_size_sfc_n * m_size_sfc_m;
   }
   else{
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_n,
-                      dim_t::N,
-                      exec_t::OMP);
-    move_iters_until( &l_blocking_iters, 
-                      l_target_parallel_m,
-                      dim_t::M,
-                      exec_t::OMP);
+    l_size_parallel *= move_iters_until( &l_blocking_iters, 
+                                         l_target_parallel_n,
+                                         dim_t::N,
+                                         exec_t::OMP);
+    l_size_parallel *= move_iters_until( &l_blocking_iters, 
+                                         l_target_parallel_m,
+                                         dim_t::M,
+                                         exec_t::OMP);
     m_size_sfc_n = 1;
     m_size_sfc_m = 1;
   }
 
-  //add sequential K dimension for L3 blocking
-  move_iters_until( &l_blocking_iters, 
-                    64,
-                    dim_t::K,
-                    exec_t::SEQ);
+  //split K dimensions if M, N and C dimensions can't keep all threads busy
+  std::vector<iter_property> l_split_k_iters;
+  if( m_split_k ){
+    int64_t l_size_c = 1;
+    for( l_it = m_iter_space->begin(); l_it < m_iter_space->end(); l_it++ ){
+      if( l_it->dim_type == dim_t::C ){
+        l_size_c *= l_it->size;
+      }
+    }
+    l_size_parallel *= std::min( l_size_c, l_target_parallel_c );
+
+    if( l_size_parallel < m_num_threads ){
+      move_iters_until( &l_split_k_iters,
+                        (m_num_threads + l_size_parallel - 1) / l_size_parallel,
+                        dim_t::K,
+                        exec_t::OMP );
+    }
+  }
+
+  //add sequential K dimension for L3 blocking, the sfc already blocks K if it is three-dimensional
+  if( l_size_sfc_k == 1 ){
+    //default if the L3 cache is unknown
+    int64_t l_target_seq_k = 64;
+
+    //use about half of the threads' L3 share for the blocks of the input tensors which are touched by the parallel tasks
+    if( m_l3_cache_size > 0 ){
+      int64_t l_kernel_size_k = 1;
+      int64_t l_kernel_size_m = 1;
+      int64_t l_kernel_size_n = 1;
+      for( l_it = l_kernel_iters.begin(); l_it < l_kernel_iters.end(); l_it++ ){
+        if( l_it->dim_type == dim_t::K ){
+          l_kernel_size_k *= l_it->size;
+        }
+        else if( l_it->dim_type == dim_t::M ){
+          l_kernel_size_m *= l_it->size;
+        }
+        else if( l_it->dim_type == dim_t::N ){
+          l_kernel_size_n *= l_it->size;
+        }
+      }
+      int64_t l_size_slice_in = (  m_size_sfc_m * l_kernel_size_m * m_num_bytes_scalar_left
+                                 + m_size_sfc_n * l_kernel_size_n * m_num_bytes_scalar_right ) * l_kernel_size_k;
+      int64_t l_size_l3_half = m_l3_cache_size * m_num_threads / 2;
+      l_target_seq_k = std::max( l_size_l3_half / std::max( l_size_slice_in, (int64_t)1 ), (int64_t)1 );
+    }
+
+    move_iters_until( &l_blocking_iters, 
+                      l_target_seq_k,
+                      dim_t::K,
+                      exec_t::SEQ);
+  }
   
   //add parallel C dimension
   move_iters_until( &l_blocking_iters, 
@@ -664,6 +772,9 @@ void einsum_ir::basic::ContractionOptimizer::reorder_and_parallelize_iters(){
                     dim_t::C,
                     exec_t::OMP);
 
+  //add parallel K dimension next to the parallel C dimension
+  l_blocking_iters.insert( l_blocking_iters.begin(), l_split_k_iters.begin(), l_split_k_iters.end() );
+
   //sort remaining dimensions by sum of strides
   std::sort( m_iter_space->begin(), m_iter_space->end(), 
              [&](iter_property l_a, iter_property l_b) -> bool {
@@ -682,7 +793,8 @@ void einsum_ir::basic::ContractionOptimizer::set_num_threads_sfc( int64_t   i_si
                                                                   int64_t   i_size_sfc_n,
                                                                   int64_t * io_num_threads_shared,
                                                                   int64_t * io_num_threads_sfc_m,
-                                                                  int64_t * io_num_threads_sfc_n
+                                                                  int64_t * io_num_threads_sfc_n,
+                                                                  int64_t   i_num_threads_l2
                                                                   ){
   
   int64_t l_num_threads = *io_num_threads_sfc_m * *io_num_threads_sfc_n * *io_num_threads_shared;
@@ -707,7 +819,13 @@ void einsum_ir::basic::ContractionOptimizer::set_num_threads_sfc( int64_t   i_si
     l_performance *= l_avg_task_n / l_tasks_n;
 
 
-    if(l_best_performance < l_performance){
+    //consecutive thread ids run in m direction: on ties, groups of threads sharing an L2 cache should work on the same n block
+    bool l_shared_l2 =    i_num_threads_l2 > 1
+                       && l_potential_threads_m % i_num_threads_l2 == 0;
+    bool l_tie = std::abs( l_performance - l_best_performance ) < 1.0E-12;
+
+    if(    ( l_best_performance < l_performance && !l_tie )
+        || ( l_tie && l_shared_l2 && l_best_threads_m % i_num_threads_l2 != 0 ) ){
       l_best_performance = l_performance;
       l_best_threads_m = l_potential_threads_m;
     }
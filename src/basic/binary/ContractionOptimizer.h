@@ -34,9 +34,21 @@ class einsum_ir::basic::ContractionOptimizer {
     //! number of bytes for scalar data types in output tensor
     int64_t m_num_bytes_scalar_out = 0;
 
+    //! number of bytes for scalar data types in left input tensor
+    int64_t m_num_bytes_scalar_left = 0;
+
+    //! number of bytes for scalar data types in right input tensor
+    int64_t m_num_bytes_scalar_right = 0;
+
     //! size of L2 cache in bytes
     int64_t m_l2_cache_size = 0;
 
+    //! size of L3 cache in bytes, 0 if unknown
+    int64_t m_l3_cache_size = 0;
+
+    //! number of threads sharing an L2 cache
+    int64_t m_num_threads_l2 = 1;
+
     //! target size for extra packing dimensions
     int64_t m_target_extra_packing = 0;
 
@@ -73,6 +85,21 @@ class einsum_ir::basic::ContractionOptimizer {
     //! size of the sfc in n dimension
     int64_t m_size_sfc_n = 1;
 
+    //! true if K dimensions may be parallelized through per-thread partial outputs (split-K)
+    bool m_split_k = false;
+
+    //! combined size of all K dimensions
+    int64_t m_size_k_all = 1;
+
+    /**
+     * Determines if split-K may be used.
+     * This is the case for multiple threads and 4- or 8-byte outputs which fit into the L2 cache.
+     * The backend rejects split-K for 16-bit storage types whose partial outputs would be rounded before the reduction.
+     *
+     * @param i_num_bytes_out number of bytes per scalar of the output tensor.
+     **/
+    void set_split_k( int64_t i_num_bytes_out );
+
     /**
       * Finds all iters with a specific stride in the iteration space.
       *
@@ -183,10 +210,15 @@ class einsum_ir::basic::ContractionOptimizer {
      * @param i_packing_support true if backend supports packing
      * @param i_packed_gemm_support indicates the support level for packed gemms
      * @param i_num_bytes_scalar_out number of bytes for scalar data types in output tensor
-     * @param i_l2_cache_size size of L2 cache in bytes
+     * @param i_l2_cache_size share of a thread of the L2 cache in bytes
      * @param io_num_threads_shared number of threads used for shared parallelization.
      * @param io_num_threads_sfc_m number of threads used for sfc m parallelization.
      * @param io_num_threads_sfc_n number of threads used for sfc n parallelization.
+     * @param i_target_extra_packing target size for extra packing dimensions (br or packed c).
+     * @param i_l3_cache_size share of a thread of the L3 cache in bytes, 0 if unknown.
+     * @param i_num_threads_l2 number of threads sharing an L2 cache.
+     * @param i_num_bytes_scalar_left number of bytes for scalar data types in left input tensor, 0 if equal to the output tensor.
+     * @param i_num_bytes_scalar_right number of bytes for scalar data types in right input tensor, 0 if equal to the output tensor.
      **/
     void init( std::vector< iter_property > * i_iter_space,
                kernel_t                     * i_ktype_main,
@@ -201,7 +233,12 @@ class einsum_ir::basic::ContractionOptimizer {
                int64_t                        i_l2_cache_size,
                int64_t                      * io_num_threads_shared,
                int64_t                      * io_num_threads_sfc_m,
-               int64_t                      * io_num_threads_sfc_n );    
+               int64_t                      * io_num_threads_sfc_n,
+               int64_t                        i_target_extra_packing = 8,
+               int64_t                        i_l3_cache_size = 0,
+               int64_t                        i_num_threads_l2 = 1,
+               int64_t                        i_num_bytes_scalar_left = 0,
+               int64_t                        i_num_bytes_scalar_right = 0 );
   
     /**
      * Optimizes the iters.
@@ -245,12 +282,14 @@ class einsum_ir::basic::ContractionOptimizer {
      * @param io_num_threads_shared number of threads used for shared parallelization.
      * @param io_num_threads_sfc_m number of threads used for sfc m parallelization.
      * @param io_num_threads_sfc_n number of threads used for sfc n parallelization.
+     * @param i_num_threads_l2 number of threads sharing an L2 cache.
      **/
     static void set_num_threads_sfc( int64_t   i_size_sfc_m,
                                      int64_t   i_size_sfc_n,
                                      int64_t * io_num_threads_shared,
                                      int64_t * io_num_threads_sfc_m,
-                                     int64_t * io_num_threads_sfc_n
+                                     int64_t * io_num_threads_sfc_n,
+                                     int64_t   i_num_threads_l2 = 1
                                      );
 };
 
@@ -246,4 +246,207 @@ TEST_CASE( "Test of Contraction Optimizer for transposed kernel", "[contraction_
   REQUIRE( l_size_before[1] == l_size_after[1] );
   REQUIRE( l_size_before[2] == l_size_after[2] );
   REQUIRE( l_size_before[3] == l_size_after[3] );
-}
\ No newline at end of file
+}
+TEST_CASE( "Parallel K dimension in Contraction Optimizer for small output tensors", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters = { {dim_t::K, exec_t::SEQ, 8192,    64,  1, 0,  0},
+                                           {dim_t::N, exec_t::SEQ,   64,     0, 8192, 0, 64},
+                                           {dim_t::M, exec_t::SEQ,   64,     1,  0, 0,  1}};
+
+  ContractionOptimizer l_opt;
+  kernel_t l_kernel_main = kernel_t::MADD;
+
+  int64_t l_num_threads_omp = 16;
+  int64_t l_num_threads_m = 1;
+  int64_t l_num_threads_n = 1;
+  l_opt.init( &l_iters,
+              &l_kernel_main,
+              64,
+              64,
+              64,
+              true,
+              true,
+              true,
+              packed_gemm_t::ALL_STRIDE_ONE,
+              4,
+              1024 * 1024,
+              &l_num_threads_omp,
+              &l_num_threads_m,
+              &l_num_threads_n );
+
+  REQUIRE( l_opt.optimize() == err_t::SUCCESS );
+
+  //check that a K dimension is parallelized and the sizes are unchanged
+  int64_t l_size_k_omp = 1;
+  int64_t l_size_after[] = {1,1,1};
+  for( std::size_t l_id = 0; l_id < l_iters.size(); l_id++ ){
+    if( l_iters[l_id].dim_type == dim_t::K ){
+      l_size_after[0] *= l_iters[l_id].size;
+      if( l_iters[l_id].exec_type == exec_t::OMP ){
+        l_size_k_omp *= l_iters[l_id].size;
+      }
+    }
+    if( l_iters[l_id].dim_type == dim_t::M ){
+      l_size_after[1] *= l_iters[l_id].size;
+    }
+    if( l_iters[l_id].dim_type == dim_t::N ){
+      l_size_after[2] *= l_iters[l_id].size;
+    }
+  }
+  REQUIRE( l_size_k_omp > 1 );
+  REQUIRE( l_iters[0].exec_type == exec_t::OMP );
+  REQUIRE( l_size_after[0] == 8192 );
+  REQUIRE( l_size_after[1] == 64 );
+  REQUIRE( l_size_after[2] == 64 );
+
+  //16-bit outputs are not split
+  std::vector< iter_property > l_iters_16 = { {dim_t::K, exec_t::SEQ, 8192,    64,  1, 0,  0},
+                                              {dim_t::N, exec_t::SEQ,   64,     0, 8192, 0, 64},
+                                              {dim_t::M, exec_t::SEQ,   64,     1,  0, 0,  1}};
+
+  ContractionOptimizer l_opt_16;
+  l_num_threads_omp = 16;
+  l_num_threads_m = 1;
+  l_num_threads_n = 1;
+  l_opt_16.init( &l_iters_16,
+                 &l_kernel_main,
+                 64,
+                 64,
+                 64,
+                 true,
+                 true,
+                 true,
+                 packed_gemm_t::ALL_STRIDE_ONE,
+                 2,
+                 1024 * 1024,
+                 &l_num_threads_omp,
+                 &l_num_threads_m,
+                 &l_num_threads_n );
+
+  REQUIRE( l_opt_16.optimize() == err_t::SUCCESS );
+
+  for( std::size_t l_id = 0; l_id < l_iters_16.size(); l_id++ ){
+    if( l_iters_16[l_id].dim_type == dim_t::K ){
+      REQUIRE( l_iters_16[l_id].exec_type != exec_t::OMP );
+    }
+  }
+}
+
+TEST_CASE( "3D SFC in Contraction Optimizer for large K dimensions", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters = { {dim_t::K, exec_t::SEQ, 8192,   512,    1, 0,   0},
+                                           {dim_t::N, exec_t::SEQ,  512,     0, 8192, 0, 512},
+                                           {dim_t::M, exec_t::SEQ,  512,     1,    0, 0,   1}};
+
+  ContractionOptimizer l_opt;
+  kernel_t l_kernel_main = kernel_t::MADD;
+
+  int64_t l_num_threads_omp = 4;
+  int64_t l_num_threads_m = 1;
+  int64_t l_num_threads_n = 1;
+  l_opt.init( &l_iters,
+              &l_kernel_main,
+              64,
+              64,
+              64,
+              true,
+              true,
+              true,
+              packed_gemm_t::ALL_STRIDE_ONE,
+              4,
+              1024 * 1024,
+              &l_num_threads_omp,
+              &l_num_threads_m,
+              &l_num_threads_n );
+
+  REQUIRE( l_opt.optimize() == err_t::SUCCESS );
+
+  //check that the sfc dimensions are consecutive and ordered by M, N and K
+  int64_t l_size_sfc[] = {1,1,1};
+  int64_t l_first_sfc = -1;
+  int64_t l_last_sfc  = -1;
+  int64_t l_size_after[] = {1,1,1};
+  for( std::size_t l_id = 0; l_id < l_iters.size(); l_id++ ){
+    int64_t l_type = 0;
+    if( l_iters[l_id].dim_type == dim_t::N ){
+      l_type = 1;
+    }
+    else if( l_iters[l_id].dim_type == dim_t::K ){
+      l_type = 2;
+    }
+    l_size_after[l_type] *= l_iters[l_id].size;
+
+    if( l_iters[l_id].exec_type == exec_t::SFC ){
+      if( l_first_sfc < 0 ){
+        l_first_sfc = l_id;
+      }
+      else{
+        REQUIRE( l_iters[l_last_sfc].dim_type <= l_iters[l_id].dim_type );
+      }
+      REQUIRE( (l_last_sfc < 0 || l_last_sfc + 1 == (int64_t) l_id) );
+      l_last_sfc = l_id;
+      l_size_sfc[l_type] *= l_iters[l_id].size;
+    }
+  }
+  REQUIRE( l_size_sfc[0] > 1 );
+  REQUIRE( l_size_sfc[1] > 1 );
+  REQUIRE( l_size_sfc[2] > 1 );
+  REQUIRE( l_size_after[0] == 512 );
+  REQUIRE( l_size_after[1] == 512 );
+  REQUIRE( l_size_after[2] == 8192 );
+}
+
+TEST_CASE( "3D SFC in Contraction Optimizer for 16-bit inputs", "[contraction_optimizer]" ) {
+  using namespace einsum_ir::basic;
+
+  //sizes of the sfc k dimensions for 4-byte and 2-byte inputs with a 4-byte output
+  int64_t l_size_sfc_k[2] = {1,1};
+  int64_t l_num_bytes_in[2] = {4,2};
+
+  for( int64_t l_ty = 0; l_ty < 2; l_ty++ ){
+    std::vector< iter_property > l_iters = { {dim_t::K, exec_t::SEQ, 8192,   512,    1, 0,   0},
+                                             {dim_t::N, exec_t::SEQ,  512,     0, 8192, 0, 512},
+                                             {dim_t::M, exec_t::SEQ,  512,     1,    0, 0,   1}};
+
+    ContractionOptimizer l_opt;
+    kernel_t l_kernel_main = kernel_t::MADD;
+
+    int64_t l_num_threads_omp = 4;
+    int64_t l_num_threads_m = 1;
+    int64_t l_num_threads_n = 1;
+    l_opt.init( &l_iters,
+                &l_kernel_main,
+                64,
+                64,
+                64,
+                true,
+                true,
+                true,
+                packed_gemm_t::ALL_STRIDE_ONE,
+                4,
+                1024 * 1024,
+                &l_num_threads_omp,
+                &l_num_threads_m,
+                &l_num_threads_n,
+                8,
+                0,
+                1,
+                l_num_bytes_in[l_ty],
+                l_num_bytes_in[l_ty] );
+
+    REQUIRE( l_opt.optimize() == err_t::SUCCESS );
+
+    for( std::size_t l_id = 0; l_id < l_iters.size(); l_id++ ){
+      if(    l_iters[l_id].exec_type == exec_t::SFC
+          && l_iters[l_id].dim_type  == dim_t::K ){
+        l_size_sfc_k[l_ty] *= l_iters[l_id].size;
+      }
+    }
+  }
+
+  //the input blocks of 16-bit inputs are half as large
+  REQUIRE( l_size_sfc_k[0] > 1 );
+  REQUIRE( l_size_sfc_k[1] < l_size_sfc_k[0] );
+}
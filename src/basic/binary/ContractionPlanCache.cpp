@@ -0,0 +1,408 @@
+#include "ContractionPlanCache.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+template< typename T >
+void einsum_ir::basic::ContractionPlanCache::write_vector( std::vector< T > const & i_values,
+                                                          std::ostream           & io_stream ) {
+  int64_t l_size = i_values.size();
+  io_stream.write( (char const *) &l_size,
+                   sizeof(int64_t) );
+  io_stream.write( (char const *) i_values.data(),
+                   l_size * sizeof(T) );
+}
+
+template< typename T >
+bool einsum_ir::basic::ContractionPlanCache::read_vector( std::istream     & io_stream,
+                                                         std::vector< T > & o_values ) {
+  int64_t l_size = 0;
+  io_stream.read( (char *) &l_size,
+                  sizeof(int64_t) );
+  if( !io_stream || l_size < 0 || l_size > (int64_t(1) << 32) ) {
+    return false;
+  }
+  o_values.resize( l_size );
+  io_stream.read( (char *) o_values.data(),
+                  l_size * sizeof(T) );
+
+  return (bool) io_stream;
+}
+
+einsum_ir::basic::ContractionPlanCache * einsum_ir::basic::ContractionPlanCache::get_instance() {
+  // never destroyed: plans stay valid until the process exits
+  static ContractionPlanCache * l_cache = [](){
+    ContractionPlanCache * l_new_cache = new ContractionPlanCache;
+
+    char const * l_enabled = std::getenv( "EINSUM_IR_PLAN_CACHE" );
+    if( l_enabled != nullptr && std::string( l_enabled ) == "0" ) {
+      l_new_cache->set_enabled( false );
+    }
+    return l_new_cache;
+  }();
+
+  return l_cache;
+}
+
+std::vector< int64_t > einsum_ir::basic::ContractionPlanCache::key( std::vector< iter_property > const & i_iter_space,
+                                                                    kernel_t                             i_ktype_first_touch,
+                                                                    kernel_t                             i_ktype_main,
+                                                                    kernel_t                             i_ktype_last_touch,
+                                                                    data_t                               i_dtype_left,
+                                                                    data_t                               i_dtype_right,
+                                                                    data_t                               i_dtype_comp,
+                                                                    data_t                               i_dtype_out,
+                                                                    int64_t                              i_num_threads,
+                                                                    int64_t                              i_l2_cache_size,
+                                                                    int64_t                              i_l3_cache_size,
+                                                                    int64_t                              i_num_threads_l2,
+                                                                    std::string                  const & i_backend,
+                                                                    tuning_config                const & i_config,
+                                                                    executor_t                           i_executor,
+                                                                    schedule_t                           i_schedule,
+                                                                    bool                                 i_fuse_first_touch,
+                                                                    std::vector< epilogue_op >   const & i_epilogue,
+                                                                    double                               i_alpha,
+                                                                    double                               i_beta,
+                                                                    bool                                 i_cpx_3m ) {
+  // scaling factors are compared by their bits
+  auto l_bits = []( double i_value ) {
+    int64_t l_value = 0;
+    std::memcpy( &l_value, &i_value, sizeof(double) );
+    return l_value;
+  };
+
+  // canonical iteration space: size-1 iterations are removed, the remaining ones are sorted
+  std::vector< std::array< int64_t, 6 > > l_iters;
+  for( std::size_t l_it = 0; l_it < i_iter_space.size(); l_it++ ) {
+    iter_property const & l_iter = i_iter_space[l_it];
+    if( l_iter.size == 1 ) {
+      continue;
+    }
+    l_iters.push_back( { (int64_t) l_iter.dim_type,
+                         l_iter.size,
+                         l_iter.stride_left,
+                         l_iter.stride_right,
+                         l_iter.stride_out_aux,
+                         l_iter.stride_out } );
+  }
+  std::sort( l_iters.begin(),
+             l_iters.end() );
+
+  std::vector< int64_t > l_key;
+  l_key.reserve( 6 * l_iters.size() + 3 * i_epilogue.size() + 32 + i_backend.size() );
+  l_key.push_back( l_iters.size() );
+  for( std::size_t l_it = 0; l_it < l_iters.size(); l_it++ ) {
+    l_key.insert( l_key.end(),
+                  l_iters[l_it].begin(),
+                  l_iters[l_it].end() );
+  }
+
+  l_key.push_back( i_ktype_first_touch );
+  l_key.push_back( i_ktype_main );
+  l_key.push_back( i_ktype_last_touch );
+  l_key.push_back( i_dtype_left );
+  l_key.push_back( i_dtype_right );
+  l_key.push_back( i_dtype_comp );
+  l_key.push_back( i_dtype_out );
+  l_key.push_back( i_num_threads );
+  l_key.push_back( i_l2_cache_size );
+  l_key.push_back( i_l3_cache_size );
+  l_key.push_back( i_num_threads_l2 );
+
+  l_key.push_back( i_config.target_m );
+  l_key.push_back( i_config.target_n );
+  l_key.push_back( i_config.target_k );
+  l_key.push_back( i_config.target_extra_packing );
+  l_key.push_back( i_config.generate_sfcs );
+  l_key.push_back( i_config.packing );
+  l_key.push_back( i_config.num_threads_shared );
+  l_key.push_back( i_config.num_threads_sfc_m );
+  l_key.push_back( i_config.num_threads_sfc_n );
+
+  l_key.push_back( i_executor );
+  l_key.push_back( i_schedule );
+  l_key.push_back( i_fuse_first_touch );
+  l_key.push_back( l_bits( i_alpha ) );
+  l_key.push_back( l_bits( i_beta ) );
+  l_key.push_back( i_cpx_3m );
+  l_key.push_back( i_epilogue.size() );
+  for( std::size_t l_op = 0; l_op < i_epilogue.size(); l_op++ ) {
+    l_key.push_back( i_epilogue[l_op].ktype );
+    l_key.push_back( i_epilogue[l_op].use_aux );
+    l_key.push_back( l_bits( i_epilogue[l_op].scalar ) );
+  }
+
+  l_key.insert( l_key.end(),
+                i_backend.begin(),
+                i_backend.end() );
+
+  return l_key;
+}
+
+std::shared_ptr< einsum_ir::basic::contraction_plan const > einsum_ir::basic::ContractionPlanCache::lookup( std::vector< int64_t > const & i_key ) {
+  if( !m_enabled.load() ) {
+    return nullptr;
+  }
+
+  std::shared_ptr< contraction_plan const > l_plan;
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    std::map< std::vector< int64_t >, std::shared_ptr< contraction_plan const > >::iterator l_it = m_plans.find( i_key );
+    if( l_it != m_plans.end() ) {
+      l_plan = l_it->second;
+    }
+  }
+
+  if( l_plan != nullptr ) {
+    m_num_hits++;
+  }
+  else {
+    m_num_misses++;
+  }
+
+  return l_plan;
+}
+
+void einsum_ir::basic::ContractionPlanCache::insert( std::vector< int64_t >             const & i_key,
+                                                     std::shared_ptr< contraction_plan const >   i_plan ) {
+  if( !m_enabled.load() ) {
+    return;
+  }
+
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_plans[i_key] = i_plan;
+}
+
+void einsum_ir::basic::ContractionPlanCache::clear() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  m_plans.clear();
+  m_num_hits   = 0;
+  m_num_misses = 0;
+}
+
+void einsum_ir::basic::ContractionPlanCache::set_enabled( bool i_enabled ) {
+  m_enabled = i_enabled;
+}
+
+int64_t einsum_ir::basic::ContractionPlanCache::get_num_hits() const {
+  return m_num_hits.load();
+}
+
+int64_t einsum_ir::basic::ContractionPlanCache::get_num_misses() const {
+  return m_num_misses.load();
+}
+
+int64_t einsum_ir::basic::ContractionPlanCache::get_num_plans() {
+  std::lock_guard< std::mutex > l_lock( m_mutex );
+  return m_plans.size();
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionPlanCache::write( std::string                                              const & i_path,
+                                                                     std::vector< std::vector< int64_t > >                    const & i_keys,
+                                                                     std::vector< std::shared_ptr< contraction_plan const > > const & i_plans ) {
+  if( i_keys.size() != i_plans.size() ) {
+    return err_t::UNDEFINED_ERROR;
+  }
+
+  // write to a temporary file which replaces the plan file
+  std::string l_path_tmp = i_path + ".tmp";
+  std::ofstream l_file( l_path_tmp,
+                        std::ios::binary );
+  if( !l_file.is_open() ) {
+    return err_t::IO_FAILED;
+  }
+
+  std::vector< int64_t > l_header = { m_file_magic,
+                                      m_file_version,
+                                      (int64_t) i_plans.size() };
+  l_file.write( (char const *) l_header.data(),
+                l_header.size() * sizeof(int64_t) );
+
+  for( std::size_t l_pl = 0; l_pl < i_plans.size(); l_pl++ ) {
+    contraction_plan const & l_plan = *i_plans[l_pl];
+    write_vector( i_keys[l_pl],
+                  l_file );
+
+    std::vector< int64_t > l_iters;
+    l_iters.reserve( 9 * l_plan.iters.size() );
+    for( std::size_t l_it = 0; l_it < l_plan.iters.size(); l_it++ ) {
+      iter_property const & l_iter = l_plan.iters[l_it];
+      l_iters.insert( l_iters.end(),
+                      { (int64_t) l_iter.dim_type,
+                        (int64_t) l_iter.exec_type,
+                        l_iter.size,
+                        l_iter.stride_left,
+                        l_iter.stride_right,
+                        l_iter.stride_out_aux,
+                        l_iter.stride_out,
+                        l_iter.packing_stride_left,
+                        l_iter.packing_stride_right } );
+    }
+    write_vector( l_iters,
+                  l_file );
+
+    std::vector< int64_t > l_scalars = { (int64_t) l_plan.ktype_main,
+                                         l_plan.num_threads_shared,
+                                         l_plan.num_threads_sfc_m,
+                                         l_plan.num_threads_sfc_n,
+                                         l_plan.caching_size,
+                                         (int64_t) l_plan.thread_infos.size() };
+    write_vector( l_scalars,
+                  l_file );
+
+    for( std::size_t l_th = 0; l_th < l_plan.thread_infos.size(); l_th++ ) {
+      thread_info const & l_info = l_plan.thread_infos[l_th];
+      std::vector< int64_t > l_info_scalars = { l_info.offset_left,
+                                                l_info.offset_right,
+                                                l_info.offset_out_aux,
+                                                l_info.offset_out,
+                                                l_info.id_shared_loop_start,
+                                                l_info.id_shared_loop_end,
+                                                l_info.id_shared_group,
+                                                l_info.sfc_size_m,
+                                                l_info.sfc_size_n,
+                                                l_info.sfc_size_k };
+      write_vector( l_info_scalars,
+                    l_file );
+      write_vector( l_info.k_count,
+                    l_file );
+      write_vector( l_info.movement_ids,
+                    l_file );
+    }
+  }
+  l_file.close();
+  if( l_file.fail() ) {
+    std::remove( l_path_tmp.c_str() );
+    return err_t::IO_FAILED;
+  }
+
+  if( std::rename( l_path_tmp.c_str(), i_path.c_str() ) != 0 ) {
+    return err_t::IO_FAILED;
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionPlanCache::read( std::string                                        const & i_path,
+                                                                    std::vector< std::vector< int64_t > >                    & o_keys,
+                                                                    std::vector< std::shared_ptr< contraction_plan const > > & o_plans ) {
+  o_keys.clear();
+  o_plans.clear();
+
+  std::ifstream l_file( i_path,
+                        std::ios::binary );
+  if( !l_file.is_open() ) {
+    return err_t::IO_FAILED;
+  }
+
+  int64_t l_header[3] = { 0, 0, 0 };
+  l_file.read( (char *) l_header,
+               sizeof(l_header) );
+  if(    !l_file
+      || l_header[0] != m_file_magic
+      || l_header[1] != m_file_version
+      || l_header[2] < 0 ) {
+    return err_t::IO_FAILED;
+  }
+
+  for( int64_t l_pl = 0; l_pl < l_header[2]; l_pl++ ) {
+    std::vector< int64_t > l_key;
+    std::vector< int64_t > l_iters;
+    std::vector< int64_t > l_scalars;
+    if(    !read_vector( l_file, l_key )
+        || !read_vector( l_file, l_iters )
+        || !read_vector( l_file, l_scalars )
+        || l_iters.size() % 9 != 0
+        || l_scalars.size() != 6
+        || l_scalars[5] < 0 ) {
+      return err_t::IO_FAILED;
+    }
+
+    std::shared_ptr< contraction_plan > l_plan = std::make_shared< contraction_plan >();
+    l_plan->iters.resize( l_iters.size() / 9 );
+    for( std::size_t l_it = 0; l_it < l_plan->iters.size(); l_it++ ) {
+      int64_t const * l_values = l_iters.data() + 9 * l_it;
+      iter_property & l_iter = l_plan->iters[l_it];
+      l_iter.dim_type             = (dim_t)  l_values[0];
+      l_iter.exec_type            = (exec_t) l_values[1];
+      l_iter.size                 = l_values[2];
+      l_iter.stride_left          = l_values[3];
+      l_iter.stride_right         = l_values[4];
+      l_iter.stride_out_aux       = l_values[5];
+      l_iter.stride_out           = l_values[6];
+      l_iter.packing_stride_left  = l_values[7];
+      l_iter.packing_stride_right = l_values[8];
+    }
+
+    l_plan->ktype_main         = (kernel_t) l_scalars[0];
+    l_plan->num_threads_shared = l_scalars[1];
+    l_plan->num_threads_sfc_m  = l_scalars[2];
+    l_plan->num_threads_sfc_n  = l_scalars[3];
+    l_plan->caching_size       = l_scalars[4];
+
+    l_plan->thread_infos.resize( l_scalars[5] );
+    for( std::size_t l_th = 0; l_th < l_plan->thread_infos.size(); l_th++ ) {
+      thread_info & l_info = l_plan->thread_infos[l_th];
+      std::vector< int64_t > l_info_scalars;
+      if(    !read_vector( l_file, l_info_scalars )
+          || l_info_scalars.size() != 10
+          || !read_vector( l_file, l_info.k_count )
+          || !read_vector( l_file, l_info.movement_ids ) ) {
+        return err_t::IO_FAILED;
+      }
+      l_info.offset_left          = l_info_scalars[0];
+      l_info.offset_right         = l_info_scalars[1];
+      l_info.offset_out_aux       = l_info_scalars[2];
+      l_info.offset_out           = l_info_scalars[3];
+      l_info.id_shared_loop_start = l_info_scalars[4];
+      l_info.id_shared_loop_end   = l_info_scalars[5];
+      l_info.id_shared_group      = l_info_scalars[6];
+      l_info.sfc_size_m           = l_info_scalars[7];
+      l_info.sfc_size_n           = l_info_scalars[8];
+      l_info.sfc_size_k           = l_info_scalars[9];
+    }
+
+    o_keys.push_back( l_key );
+    o_plans.push_back( l_plan );
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionPlanCache::store( std::string const & i_path ) {
+  std::vector< std::vector< int64_t > > l_keys;
+  std::vector< std::shared_ptr< contraction_plan const > > l_plans;
+  {
+    std::lock_guard< std::mutex > l_lock( m_mutex );
+    for( std::map< std::vector< int64_t >, std::shared_ptr< contraction_plan const > >::iterator l_it = m_plans.begin(); l_it != m_plans.end(); l_it++ ) {
+      l_keys.push_back( l_it->first );
+      l_plans.push_back( l_it->second );
+    }
+  }
+
+  return write( i_path,
+                l_keys,
+                l_plans );
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::ContractionPlanCache::load( std::string const & i_path ) {
+  std::vector< std::vector< int64_t > > l_keys;
+  std::vector< std::shared_ptr< contraction_plan const > > l_plans;
+  err_t l_err = read( i_path,
+                      l_keys,
+                      l_plans );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  for( std::size_t l_pl = 0; l_pl < l_plans.size(); l_pl++ ) {
+    insert( l_keys[l_pl],
+            l_plans[l_pl] );
+  }
+
+  return err_t::SUCCESS;
+}
@@ -0,0 +1,228 @@
+#ifndef EINSUM_IR_BASIC_BINARY_CONTRACTION_PLAN_CACHE
+#define EINSUM_IR_BASIC_BINARY_CONTRACTION_PLAN_CACHE
+
+#include <atomic>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace basic {
+    class ContractionPlanCache;
+  }
+}
+
+/**
+ * Process-wide cache of compiled contraction plans.
+ * A plan holds the optimized iterations, the thread distribution and the thread infos of the iteration space.
+ * Compilations of known contractions skip the contraction optimizer and the setup of the iteration space.
+ *
+ * Plans are keyed by the canonical form of the unoptimized contraction, i.e., the keys are compared exactly.
+ * The key holds all settings of the backend since a cached plan presets the backend's thread infos.
+ *
+ * Plans may be written to and read from a versioned binary file, e.g., to skip the optimization at startup.
+ * The file starts with the magic number and the version, followed by the number of plans and the plans.
+ * All values are stored as 64-bit integers in the byte order of the machine, sfc movement ids as bytes.
+ * Files with a different magic number or version are rejected.
+ **/
+class einsum_ir::basic::ContractionPlanCache {
+  private:
+    //! cached plans
+    std::map< std::vector< int64_t >, std::shared_ptr< contraction_plan const > > m_plans;
+
+    //! mutex protecting the plans
+    std::mutex m_mutex;
+
+    //! true if the cache is used
+    std::atomic< bool > m_enabled{ true };
+
+    //! number of lookups which found a plan
+    std::atomic< int64_t > m_num_hits{ 0 };
+
+    //! number of lookups which did not find a plan
+    std::atomic< int64_t > m_num_misses{ 0 };
+
+    //! magic number of plan files
+    static constexpr int64_t m_file_magic = 0x4e414c50534e4945; // EINSPLAN in little-endian byte order
+
+    //! version of plan files
+    static constexpr int64_t m_file_version = 3;
+
+    /**
+     * Writes a vector to a binary stream, the size of the vector is written first.
+     *
+     * @param i_values values which are written.
+     * @param io_stream binary stream.
+     **/
+    template< typename T >
+    static void write_vector( std::vector< T > const & i_values,
+                              std::ostream           & io_stream );
+
+    /**
+     * Reads a vector from a binary stream.
+     *
+     * @param io_stream binary stream.
+     * @param o_values will be set to the read values.
+     * @return true if the vector was read, false otherwise.
+     **/
+    template< typename T >
+    static bool read_vector( std::istream           & io_stream,
+                             std::vector< T >       & o_values );
+
+  public:
+    /**
+     * Gets the process-wide plan cache.
+     * The cache is disabled if the environment variable EINSUM_IR_PLAN_CACHE is set to 0.
+     *
+     * @return process-wide plan cache.
+     **/
+    static ContractionPlanCache * get_instance();
+
+    /**
+     * Derives the canonical key of a contraction.
+     * The key is independent of the order of the iterations and of size-1 iterations.
+     *
+     * @param i_iter_space unoptimized iteration space.
+     * @param i_ktype_first_touch type of the first touch kernel.
+     * @param i_ktype_main type of the main kernel.
+     * @param i_ktype_last_touch type of the last touch kernel.
+     * @param i_dtype_left datatype of left input tensor.
+     * @param i_dtype_right datatype of right input tensor.
+     * @param i_dtype_comp datatype of computation.
+     * @param i_dtype_out datatype of output tensor.
+     * @param i_num_threads number of threads.
+     * @param i_l2_cache_size share of a thread of the L2 cache in bytes.
+     * @param i_l3_cache_size share of a thread of the L3 cache in bytes, 0 if unknown.
+     * @param i_num_threads_l2 number of threads sharing an L2 cache.
+     * @param i_backend name of the backend.
+     * @param i_config configuration of the contraction optimizer.
+     * @param i_executor executor of the parallel regions.
+     * @param i_schedule schedule of the shared loops.
+     * @param i_fuse_first_touch true if first touches may be folded into the main kernel.
+     * @param i_epilogue epilogue program of the last touch.
+     * @param i_alpha scaling factor of the contraction's result.
+     * @param i_beta scaling factor of the output.
+     * @param i_cpx_3m true if complex contractions use three real multiplications.
+     * @return key of the contraction.
+     **/
+    static std::vector< int64_t > key( std::vector< iter_property > const & i_iter_space,
+                                       kernel_t                             i_ktype_first_touch,
+                                       kernel_t                             i_ktype_main,
+                                       kernel_t                             i_ktype_last_touch,
+                                       data_t                               i_dtype_left,
+                                       data_t                               i_dtype_right,
+                                       data_t                               i_dtype_comp,
+                                       data_t                               i_dtype_out,
+                                       int64_t                              i_num_threads,
+                                       int64_t                              i_l2_cache_size,
+                                       int64_t                              i_l3_cache_size,
+                                       int64_t                              i_num_threads_l2,
+                                       std::string                  const & i_backend,
+                                       tuning_config                const & i_config,
+                                       executor_t                           i_executor,
+                                       schedule_t                           i_schedule,
+                                       bool                                 i_fuse_first_touch,
+                                       std::vector< epilogue_op >   const & i_epilogue,
+                                       double                               i_alpha,
+                                       double                               i_beta,
+                                       bool                                 i_cpx_3m );
+
+    /**
+     * Looks up a plan and updates the hit and miss counters.
+     *
+     * @param i_key key of the contraction.
+     * @return plan of the contraction, nullptr if the cache has no plan for the key or is disabled.
+     **/
+    std::shared_ptr< contraction_plan const > lookup( std::vector< int64_t > const & i_key );
+
+    /**
+     * Inserts a plan.
+     * Nothing is inserted if the cache is disabled.
+     *
+     * @param i_key key of the contraction.
+     * @param i_plan plan of the contraction.
+     **/
+    void insert( std::vector< int64_t >             const & i_key,
+                 std::shared_ptr< contraction_plan const >   i_plan );
+
+    /**
+     * Writes plans to a binary file.
+     *
+     * @param i_path path of the file.
+     * @param i_keys keys of the plans.
+     * @param i_plans plans which are written.
+     * @return SUCCESS if the plans were written, otherwise an appropiate error code.
+     **/
+    static err_t write( std::string                                              const & i_path,
+                        std::vector< std::vector< int64_t > >                    const & i_keys,
+                        std::vector< std::shared_ptr< contraction_plan const > > const & i_plans );
+
+    /**
+     * Reads plans from a binary file.
+     *
+     * @param i_path path of the file.
+     * @param o_keys will be set to the keys of the plans.
+     * @param o_plans will be set to the read plans.
+     * @return SUCCESS if the plans were read, otherwise an appropiate error code.
+     **/
+    static err_t read( std::string                                        const & i_path,
+                       std::vector< std::vector< int64_t > >                    & o_keys,
+                       std::vector< std::shared_ptr< contraction_plan const > > & o_plans );
+
+    /**
+     * Writes all cached plans to a binary file.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were written, otherwise an appropiate error code.
+     **/
+    err_t store( std::string const & i_path );
+
+    /**
+     * Reads plans from a binary file and inserts them into the cache.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were read, otherwise an appropiate error code.
+     **/
+    err_t load( std::string const & i_path );
+
+    /**
+     * Removes all plans and resets the counters.
+     **/
+    void clear();
+
+    /**
+     * Enables or disables the cache.
+     *
+     * @param i_enabled true if the cache is used, false otherwise.
+     **/
+    void set_enabled( bool i_enabled );
+
+    /**
+     * Gets the number of lookups which found a plan.
+     *
+     * @return number of hits.
+     **/
+    int64_t get_num_hits() const;
+
+    /**
+     * Gets the number of lookups which did not find a plan.
+     *
+     * @return number of misses.
+     **/
+    int64_t get_num_misses() const;
+
+    /**
+     * Gets the number of cached plans.
+     *
+     * @return number of plans.
+     **/
+    int64_t get_num_plans();
+};
+
+#endif
@@ -0,0 +1,355 @@
+#include "catch.hpp"
+#include "ContractionPlanCache.h"
+#include "ContractionBackendScalar.h"
+#include "ContractionOptimizer.h"
+#include <cstdio>
+#include <fstream>
+
+TEST_CASE( "Canonical keys and counters of the contraction plan cache.", "[contraction_plan_cache]" ) {
+  using namespace einsum_ir::basic;
+
+  std::vector< iter_property > l_iters_0 = { {dim_t::M, exec_t::SEQ, 32,  1, 0, 0,  1},
+                                             {dim_t::N, exec_t::SEQ, 16,  0, 8, 0, 32},
+                                             {dim_t::K, exec_t::SEQ,  8, 32, 1, 0,  0} };
+
+  // reordered and additional size-1 iteration
+  std::vector< iter_property > l_iters_1 = { {dim_t::K, exec_t::SEQ,  8, 32, 1, 0,  0},
+                                             {dim_t::M, exec_t::SEQ, 32,  1, 0, 0,  1},
+                                             {dim_t::C, exec_t::SEQ,  1,  0, 0, 0,  0},
+                                             {dim_t::N, exec_t::SEQ, 16,  0, 8, 0, 32} };
+
+  tuning_config l_config;
+  l_config.target_m = 16;
+  l_config.target_n = 16;
+  l_config.target_k = 16;
+
+  std::vector< epilogue_op > l_epilogue;
+
+  std::vector< int64_t > l_key_0 = ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                              FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                              executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false );
+  std::vector< int64_t > l_key_1 = ContractionPlanCache::key( l_iters_1, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                              FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                              executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false );
+  std::vector< int64_t > l_key_2 = ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                              FP32, FP32, FP32, FP32, 4, 1048576, 0, 1, "scalar", l_config,
+                                                              executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false );
+
+  // settings of the backend
+  std::vector< std::vector< int64_t > > l_keys_settings;
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::THREAD_POOL, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::DYNAMIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, false, l_epilogue, 1.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 2.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 0.5, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, true ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 524288, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 4194304, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 2, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_epilogue.resize( 1 );
+  l_epilogue[0].ktype = kernel_t::TANH;
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_epilogue[0].ktype = kernel_t::GELU;
+  l_keys_settings.push_back( ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                        FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                        executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false ) );
+  l_epilogue.clear();
+
+  l_config.target_k = 8;
+  std::vector< int64_t > l_key_3 = ContractionPlanCache::key( l_iters_0, kernel_t::ZERO, kernel_t::MADD, kernel_t::UNDEFINED_KTYPE,
+                                                              FP32, FP32, FP32, FP32, 2, 1048576, 0, 1, "scalar", l_config,
+                                                              executor_t::OPENMP, schedule_t::STATIC, true, l_epilogue, 1.0, 1.0, false );
+
+  REQUIRE( l_key_0 == l_key_1 );
+  REQUIRE( l_key_0 != l_key_2 );
+  REQUIRE( l_key_0 != l_key_3 );
+  for( std::size_t l_ke = 0; l_ke < l_keys_settings.size(); l_ke++ ) {
+    REQUIRE( l_key_0 != l_keys_settings[l_ke] );
+    for( std::size_t l_ke_other = l_ke+1; l_ke_other < l_keys_settings.size(); l_ke_other++ ) {
+      REQUIRE( l_keys_settings[l_ke] != l_keys_settings[l_ke_other] );
+    }
+  }
+
+  ContractionPlanCache l_cache;
+  REQUIRE( l_cache.lookup( l_key_0 ) == nullptr );
+  REQUIRE( l_cache.get_num_misses() == 1 );
+
+  std::shared_ptr< contraction_plan > l_plan = std::make_shared< contraction_plan >();
+  l_plan->num_threads_shared = 3;
+  l_cache.insert( l_key_0, l_plan );
+  REQUIRE( l_cache.get_num_plans() == 1 );
+
+  std::shared_ptr< contraction_plan const > l_plan_hit = l_cache.lookup( l_key_1 );
+  REQUIRE( l_plan_hit != nullptr );
+  REQUIRE( l_plan_hit->num_threads_shared == 3 );
+  REQUIRE( l_cache.lookup( l_key_2 ) == nullptr );
+  REQUIRE( l_cache.get_num_hits()   == 1 );
+  REQUIRE( l_cache.get_num_misses() == 2 );
+
+  l_cache.set_enabled( false );
+  REQUIRE( l_cache.lookup( l_key_0 ) == nullptr );
+  l_cache.set_enabled( true );
+
+  l_cache.clear();
+  REQUIRE( l_cache.get_num_plans()  == 0 );
+  REQUIRE( l_cache.get_num_hits()   == 0 );
+  REQUIRE( l_cache.get_num_misses() == 0 );
+}
+
+TEST_CASE( "Compilation of a backend with the thread infos of a stored plan.", "[contraction_plan_cache]" ) {
+  using namespace einsum_ir::basic;
+
+  // C[n][m] = A[k][m] * B[n][k]
+  int64_t l_size_m = 24;
+  int64_t l_size_n = 20;
+  int64_t l_size_k = 16;
+  std::vector< iter_property > l_iters = { {dim_t::M, exec_t::SEQ, l_size_m,        1,        0, 0,        1},
+                                           {dim_t::N, exec_t::SEQ, l_size_n,        0, l_size_k, 0, l_size_m},
+                                           {dim_t::K, exec_t::SEQ, l_size_k, l_size_m,        1, 0,        0} };
+
+  contraction_plan l_plan;
+  l_plan.iters = l_iters;
+  l_plan.ktype_main = kernel_t::MADD;
+  l_plan.num_threads_shared = 3;
+  l_plan.num_threads_sfc_m  = 1;
+  l_plan.num_threads_sfc_n  = 1;
+
+  ContractionOptimizer l_opt;
+  l_opt.init( &l_plan.iters,
+              &l_plan.ktype_main,
+              1,
+              1,
+              1,
+              true,
+              false,
+              false,
+              packed_gemm_t::ALL_STRIDE_ONE,
+              4,
+              1024*1024,
+              &l_plan.num_threads_shared,
+              &l_plan.num_threads_sfc_m,
+              &l_plan.num_threads_sfc_n );
+  REQUIRE( l_opt.optimize() == err_t::SUCCESS );
+
+  ContractionBackendScalar l_backend_cold;
+  l_backend_cold.init( l_plan.iters,
+                       FP32,
+                       FP32,
+                       FP32,
+                       FP32,
+                       kernel_t::ZERO,
+                       l_plan.ktype_main,
+                       kernel_t::UNDEFINED_KTYPE,
+                       l_plan.num_threads_shared,
+                       l_plan.num_threads_sfc_m,
+                       l_plan.num_threads_sfc_n,
+                       nullptr );
+  REQUIRE( l_backend_cold.compile() == err_t::SUCCESS );
+  l_backend_cold.get_thread_infos( l_plan.thread_infos,
+                                   l_plan.caching_size );
+  REQUIRE( l_plan.thread_infos.size() > 0 );
+
+  // round trip through a plan file
+  std::string l_path = "einsum_ir_plans.test.bin";
+  std::vector< std::vector< int64_t > > l_keys = { { 1, 2, 3 } };
+  std::vector< std::shared_ptr< contraction_plan const > > l_plans = { std::make_shared< contraction_plan >( l_plan ) };
+  REQUIRE( ContractionPlanCache::write( l_path, l_keys, l_plans ) == err_t::SUCCESS );
+
+  std::vector< std::vector< int64_t > > l_keys_read;
+  std::vector< std::shared_ptr< contraction_plan const > > l_plans_read;
+  REQUIRE( ContractionPlanCache::read( l_path, l_keys_read, l_plans_read ) == err_t::SUCCESS );
+  REQUIRE( l_keys_read == l_keys );
+  REQUIRE( l_plans_read.size() == 1 );
+
+  contraction_plan const & l_plan_read = *l_plans_read[0];
+  REQUIRE( l_plan_read.iters.size() == l_plan.iters.size() );
+  for( std::size_t l_it = 0; l_it < l_plan.iters.size(); l_it++ ) {
+    REQUIRE( l_plan_read.iters[l_it].dim_type   == l_plan.iters[l_it].dim_type );
+    REQUIRE( l_plan_read.iters[l_it].exec_type  == l_plan.iters[l_it].exec_type );
+    REQUIRE( l_plan_read.iters[l_it].size       == l_plan.iters[l_it].size );
+    REQUIRE( l_plan_read.iters[l_it].stride_out == l_plan.iters[l_it].stride_out );
+  }
+  REQUIRE( l_plan_read.thread_infos.size() == l_plan.thread_infos.size() );
+  for( std::size_t l_th = 0; l_th < l_plan.thread_infos.size(); l_th++ ) {
+    REQUIRE( l_plan_read.thread_infos[l_th].offset_out   == l_plan.thread_infos[l_th].offset_out );
+    REQUIRE( l_plan_read.thread_infos[l_th].k_count      == l_plan.thread_infos[l_th].k_count );
+    REQUIRE( l_plan_read.thread_infos[l_th].movement_ids == l_plan.thread_infos[l_th].movement_ids );
+  }
+
+  ContractionPlanCache l_cache;
+  REQUIRE( l_cache.load( l_path ) == err_t::SUCCESS );
+  REQUIRE( l_cache.get_num_plans() == 1 );
+
+  ContractionBackendScalar l_backend_plan;
+  l_backend_plan.init( l_plan_read.iters,
+                       FP32,
+                       FP32,
+                       FP32,
+                       FP32,
+                       kernel_t::ZERO,
+                       l_plan_read.ktype_main,
+                       kernel_t::UNDEFINED_KTYPE,
+                       l_plan_read.num_threads_shared,
+                       l_plan_read.num_threads_sfc_m,
+                       l_plan_read.num_threads_sfc_n,
+                       nullptr );
+  l_backend_plan.set_thread_infos( l_plan_read.thread_infos,
+                                   l_plan_read.caching_size );
+  REQUIRE( l_backend_plan.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_left(  l_size_k * l_size_m );
+  std::vector< float > l_right( l_size_n * l_size_k );
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = (float) (l_en % 7) - 3;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = (float) (l_en % 5) - 2;
+  }
+
+  std::vector< float > l_out_ref(  l_size_n * l_size_m, 0 );
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+      for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+        l_out_ref[l_n * l_size_m + l_m] += l_left[l_k * l_size_m + l_m] * l_right[l_n * l_size_k + l_k];
+      }
+    }
+  }
+
+  std::vector< float > l_out_cold( l_size_n * l_size_m, 1 );
+  std::vector< float > l_out_plan( l_size_n * l_size_m, 1 );
+  l_backend_cold.contract( l_left.data(),
+                           l_right.data(),
+                           nullptr,
+                           l_out_cold.data() );
+  l_backend_plan.contract( l_left.data(),
+                           l_right.data(),
+                           nullptr,
+                           l_out_plan.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out_ref.size(); l_en++ ) {
+    REQUIRE( l_out_cold[l_en] == Approx( l_out_ref[l_en] ) );
+    REQUIRE( l_out_plan[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+
+  // files of other versions are rejected
+  std::fstream l_file( l_path, std::ios::binary | std::ios::in | std::ios::out );
+  int64_t l_version = 1000;
+  l_file.seekp( sizeof(int64_t) );
+  l_file.write( (char const *) &l_version, sizeof(int64_t) );
+  l_file.close();
+  REQUIRE( ContractionPlanCache::read( l_path, l_keys, l_plans ) == err_t::IO_FAILED );
+  std::remove( l_path.c_str() );
+}
+
+TEST_CASE( "Compilation of a backend with the thread infos of a plan with multiple SFC loops per dimension.", "[contraction_plan_cache]" ) {
+  using namespace einsum_ir::basic;
+
+  // C[n0][n1][m0][m1] = A[k][m0][m1] * B[n0][n1][k]
+  int64_t l_size_m0 = 3;
+  int64_t l_size_m1 = 8;
+  int64_t l_size_n0 = 2;
+  int64_t l_size_n1 = 5;
+  int64_t l_size_k  = 4;
+  int64_t l_size_m  = l_size_m0 * l_size_m1;
+  int64_t l_size_n  = l_size_n0 * l_size_n1;
+  std::vector< iter_property > l_iters = { {dim_t::M, exec_t::SFC, l_size_m0, l_size_m1,                   0, 0,             l_size_m1},
+                                           {dim_t::M, exec_t::SFC, l_size_m1,         1,                   0, 0,                     1},
+                                           {dim_t::N, exec_t::SFC, l_size_n0,         0, l_size_n1*l_size_k, 0, l_size_n1*l_size_m},
+                                           {dim_t::N, exec_t::SFC, l_size_n1,         0,            l_size_k, 0,              l_size_m},
+                                           {dim_t::K, exec_t::SEQ, l_size_k,   l_size_m,                   1, 0,                     0},
+                                           {dim_t::M, exec_t::PRIM,        1,         1,                   0, 0,                     1},
+                                           {dim_t::N, exec_t::PRIM,        1,         0,            l_size_k, 0,              l_size_m},
+                                           {dim_t::K, exec_t::PRIM,        1,  l_size_m,                   1, 0,                     0} };
+
+  ContractionBackendScalar l_backend_cold;
+  l_backend_cold.init( l_iters,
+                       FP32,
+                       FP32,
+                       FP32,
+                       FP32,
+                       kernel_t::ZERO,
+                       kernel_t::MADD,
+                       kernel_t::UNDEFINED_KTYPE,
+                       1,
+                       2,
+                       1,
+                       nullptr );
+  REQUIRE( l_backend_cold.compile() == err_t::SUCCESS );
+
+  std::vector< thread_info > l_thread_infos;
+  int64_t l_caching_size = 0;
+  l_backend_cold.get_thread_infos( l_thread_infos,
+                                   l_caching_size );
+
+  // the sfc strides of the preset backend have to be converted as in the cold compilation
+  ContractionBackendScalar l_backend_plan;
+  l_backend_plan.init( l_iters,
+                       FP32,
+                       FP32,
+                       FP32,
+                       FP32,
+                       kernel_t::ZERO,
+                       kernel_t::MADD,
+                       kernel_t::UNDEFINED_KTYPE,
+                       1,
+                       2,
+                       1,
+                       nullptr );
+  l_backend_plan.set_thread_infos( l_thread_infos,
+                                   l_caching_size );
+  REQUIRE( l_backend_plan.compile() == err_t::SUCCESS );
+
+  std::vector< float > l_left(  l_size_k * l_size_m );
+  std::vector< float > l_right( l_size_n * l_size_k );
+  for( std::size_t l_en = 0; l_en < l_left.size(); l_en++ ) {
+    l_left[l_en] = (float) (l_en % 7) - 3;
+  }
+  for( std::size_t l_en = 0; l_en < l_right.size(); l_en++ ) {
+    l_right[l_en] = (float) (l_en % 5) - 2;
+  }
+
+  std::vector< float > l_out_ref(  l_size_n * l_size_m, 0 );
+  for( int64_t l_n = 0; l_n < l_size_n; l_n++ ) {
+    for( int64_t l_m = 0; l_m < l_size_m; l_m++ ) {
+      for( int64_t l_k = 0; l_k < l_size_k; l_k++ ) {
+        l_out_ref[l_n * l_size_m + l_m] += l_left[l_k * l_size_m + l_m] * l_right[l_n * l_size_k + l_k];
+      }
+    }
+  }
+
+  std::vector< float > l_out_cold( l_size_n * l_size_m, 1 );
+  std::vector< float > l_out_plan( l_size_n * l_size_m, 1 );
+  l_backend_cold.contract( l_left.data(),
+                           l_right.data(),
+                           nullptr,
+                           l_out_cold.data() );
+  l_backend_plan.contract( l_left.data(),
+                           l_right.data(),
+                           nullptr,
+                           l_out_plan.data() );
+
+  for( std::size_t l_en = 0; l_en < l_out_ref.size(); l_en++ ) {
+    REQUIRE( l_out_cold[l_en] == Approx( l_out_ref[l_en] ) );
+    REQUIRE( l_out_plan[l_en] == Approx( l_out_ref[l_en] ) );
+  }
+}
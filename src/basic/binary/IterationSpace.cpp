@@ -1,4 +1,5 @@
 #include "IterationSpace.h"
+#include "SfcGilbert3d.h"
 #include "../third_party/gilbertSFC.cpp"
 #include <cmath>
 
@@ -20,12 +21,8 @@ void einsum_ir::basic::IterationSpace::init( std::vector< dim_t >   const * i_di
   m_num_threads_shared = i_num_threads_shared;
 }
 
-einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< int64_t >   & io_strides_left,
-                                                                 std::vector< int64_t >   & io_strides_right,
-                                                                 std::vector< int64_t >   & io_strides_out_aux,
-                                                                 std::vector< int64_t >   & io_strides_out, 
-                                                                 std::vector<thread_info> & io_thread_infos ) {
-                
+einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup_loops() {
+
   //calculate number of tasks and assigns parallel dimensions to three types shared, sfc_n, sfc_m
   m_sfc_tasks_m = 1;
   m_sfc_tasks_n = 1;
@@ -44,9 +41,6 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
       }
       m_shared_tasks *= m_sizes->at(l_id);
       m_shared_loops.end = l_id + 1;
-      if( m_dim_types->at(l_id) == dim_t::K ){
-        return err_t::COMPILATION_FAILED;
-      }
     }
     if( m_exec_types->at(l_id) == exec_t::SFC ){
       l_num_sfc_loops++;
@@ -92,6 +86,38 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
     return err_t::COMPILATION_FAILED;
   }
 
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup_strides( std::vector< int64_t > & io_strides_left,
+                                                                         std::vector< int64_t > & io_strides_right,
+                                                                         std::vector< int64_t > & io_strides_out_aux,
+                                                                         std::vector< int64_t > & io_strides_out ) {
+  err_t l_err = setup_loops();
+  if( l_err != err_t::SUCCESS ){
+    return l_err;
+  }
+
+  //convert strides to offsets
+  convert_strides_to_offsets( io_strides_left    );
+  convert_strides_to_offsets( io_strides_right   );
+  convert_strides_to_offsets( io_strides_out     );
+  convert_strides_to_offsets( io_strides_out_aux );
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< int64_t >   & io_strides_left,
+                                                                 std::vector< int64_t >   & io_strides_right,
+                                                                 std::vector< int64_t >   & io_strides_out_aux,
+                                                                 std::vector< int64_t >   & io_strides_out, 
+                                                                 std::vector<thread_info> & io_thread_infos ) {
+  //assign parallel loops to shared, sfc_m, sfc_n and sfc_k
+  err_t l_err = setup_loops();
+  if( l_err != err_t::SUCCESS ){
+    return l_err;
+  }
+
   //create thread infos
   int64_t l_num_threads = m_num_threads_m * m_num_threads_n * m_num_threads_shared;
   io_thread_infos.resize( l_num_threads );
@@ -131,6 +157,7 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
     l_end_shared   = l_end_shared   <= m_shared_tasks ? l_end_shared   : m_shared_tasks;
     io_thread_infos[l_thread_id].id_shared_loop_start = l_begin_shared;
     io_thread_infos[l_thread_id].id_shared_loop_end   = l_end_shared;
+    io_thread_infos[l_thread_id].id_shared_group      = l_thread_id_m + l_thread_id_n * m_num_threads_m;
     
     //set start ids
     int64_t l_id_sfc_m_old = l_begin_m;
@@ -157,13 +184,17 @@ einsum_ir::basic::err_t einsum_ir::basic::IterationSpace::setup( std::vector< in
 
     //calculate movements
     int64_t l_size = (l_end_m - l_begin_m) * (l_end_n - l_begin_n) * m_sfc_tasks_k;
-    io_thread_infos[l_thread_id].movement_ids.resize( l_size );
-    for( int64_t l_id = 0; l_id < l_size; l_id++ ){
+    io_thread_infos[l_thread_id].movement_ids.resize( l_size, 0 );
+    std::vector< int64_t > l_path;
+    sfc_path_3d( l_end_m - l_begin_m,
+                 l_end_n - l_begin_n,
+                 m_sfc_tasks_k,
+                 l_path );
+    for( int64_t l_id = 0; l_id < l_size - 1; l_id++ ){
       //determine new SFC position
-      int64_t l_id_sfc_m_new, l_id_sfc_n_new, l_id_sfc_k_new; 
-      sfc_oracle_3d( l_id+1, l_end_m - l_begin_m, l_end_n - l_begin_n, m_sfc_tasks_k, &l_id_sfc_m_new, &l_id_sfc_n_new, &l_id_sfc_k_new );
-      l_id_sfc_m_new += l_begin_m;
-      l_id_sfc_n_new += l_begin_n;
+      int64_t l_id_sfc_m_new = l_path[ 3*(l_id+1)     ] + l_begin_m;
+      int64_t l_id_sfc_n_new = l_path[ 3*(l_id+1) + 1 ] + l_begin_n;
+      int64_t l_id_sfc_k_new = l_path[ 3*(l_id+1) + 2 ];
 
       //determine movement
       if( l_id_sfc_m_new != l_id_sfc_m_old ){
@@ -313,3 +344,31 @@ void einsum_ir::basic::IterationSpace::sfc_oracle_3d( int64_t  i_idx,
   *o_m = l_idx_m;
   *o_n = l_idx_n;
 }
+
+void einsum_ir::basic::IterationSpace::sfc_path_3d( int64_t                  i_sfc_size_m,
+                                                    int64_t                  i_sfc_size_n,
+                                                    int64_t                  i_sfc_size_k,
+                                                    std::vector< int64_t > & o_path ) {
+  int64_t l_size = i_sfc_size_m * i_sfc_size_n * i_sfc_size_k;
+  o_path.resize( 3 * l_size );
+
+  //3d curve over m, n and k
+  if( i_sfc_size_k > 1 ){
+    SfcGilbert3d::path( i_sfc_size_m,
+                        i_sfc_size_n,
+                        i_sfc_size_k,
+                        o_path );
+  }
+  //2d curve over m and n
+  else {
+    for( int64_t l_id = 0; l_id < l_size; l_id++ ){
+      sfc_oracle_3d( l_id,
+                     i_sfc_size_m,
+                     i_sfc_size_n,
+                     i_sfc_size_k,
+                     &o_path[3*l_id],
+                     &o_path[3*l_id + 1],
+                     &o_path[3*l_id + 2] );
+    }
+  }
+}
@@ -56,6 +56,13 @@ class einsum_ir::basic::IterationSpace {
     //! number of tasks in n dimension 
     int64_t m_tasks_per_thread_n;
 
+    /**
+     * Determines the number of tasks and assigns the parallel loops to the shared, sfc m, sfc n and sfc k ranges.
+     *
+     * @return SUCCESS if the loops are valid, otherwise an appropiate error code.
+     **/
+    err_t setup_loops();
+
     /**
      * Converts strides into offsets for sfc dimensions.
      *
@@ -123,16 +130,32 @@ class einsum_ir::basic::IterationSpace {
                         int64_t *o_n,
                         int64_t *o_k );
 
+    /**
+     * Calculates all positions of a 3d SFC.
+     * The 3d generalized Hilbert curve of SfcGilbert3d is used if the sfc has more than one k task.
+     * Otherwise, the 2d SFC of sfc_oracle_3d is used.
+     * In both cases consecutive positions differ in a single dimension by one.
+     *
+     * @param i_sfc_size_m size of sfc in m direction.
+     * @param i_sfc_size_n size of sfc in n direction.
+     * @param i_sfc_size_k size of sfc in k direction.
+     * @param o_path will be set to the sfc m, n and k ids of all positions.
+     **/
+    void sfc_path_3d( int64_t                  i_sfc_size_m,
+                      int64_t                  i_sfc_size_n,
+                      int64_t                  i_sfc_size_k,
+                      std::vector< int64_t > & o_path );
+
   public:
     /**
      * Initializes the class.
      * restrictions:
      *    - all dimensions marked as SFC must be consecutive
-     *    - first  sfc dims of type n
-     *    - second sfc dims of type m
+     *    - first  sfc dims of type m
+     *    - second sfc dims of type n
      *    - third  sfc dims of type k
      * example: 
-     *    dim_t : ...   n1, n2, m1, m2, m3, k1, k2 ...
+     *    dim_t : ...   m1, m2, m3, n1, n2, k1, k2 ...
      *
      * @param i_loop_dim_type dimension type of the loops.
      * @param i_loop_exec_type execution type of the loops.
@@ -165,6 +188,21 @@ class einsum_ir::basic::IterationSpace {
                  std::vector< int64_t >   & io_strides_out,
                  std::vector<thread_info> & io_thread_infos );
 
+    /**
+     * Changes the sfc strides as setup does but keeps the thread infos, e.g., if they were preset.
+     *
+     * @param io_strides_left strides in the left input tensor.
+     * @param io_strides_right strides in the right input tensor.
+     * @param io_strides_out_aux strides in the auxiliary output tensor.
+     * @param io_strides_out strides in the output tensor.
+     *
+     * @return SUCCESS if the compilation was successful, otherwise an appropiate error code.
+     **/
+    err_t setup_strides( std::vector< int64_t > & io_strides_left,
+                         std::vector< int64_t > & io_strides_right,
+                         std::vector< int64_t > & io_strides_out_aux,
+                         std::vector< int64_t > & io_strides_out );
+
     /**
      * Simple function to determine if caching of values could be advantageous.
      *
@@ -0,0 +1,234 @@
+#include "SfcGilbert3d.h"
+
+einsum_ir::basic::SfcGilbert3d::vec_t einsum_ir::basic::SfcGilbert3d::add( vec_t i_a,
+                                                                           vec_t i_b ) {
+  return vec_t{ i_a.x + i_b.x, i_a.y + i_b.y, i_a.z + i_b.z };
+}
+
+einsum_ir::basic::SfcGilbert3d::vec_t einsum_ir::basic::SfcGilbert3d::sub( vec_t i_a,
+                                                                           vec_t i_b ) {
+  return vec_t{ i_a.x - i_b.x, i_a.y - i_b.y, i_a.z - i_b.z };
+}
+
+einsum_ir::basic::SfcGilbert3d::vec_t einsum_ir::basic::SfcGilbert3d::neg( vec_t i_a ) {
+  return vec_t{ -i_a.x, -i_a.y, -i_a.z };
+}
+
+int64_t einsum_ir::basic::SfcGilbert3d::length( vec_t i_a ) {
+  //directions are axis-aligned
+  int64_t l_sum = i_a.x + i_a.y + i_a.z;
+  return (l_sum < 0) ? -l_sum : l_sum;
+}
+
+einsum_ir::basic::SfcGilbert3d::vec_t einsum_ir::basic::SfcGilbert3d::unit( vec_t i_a ) {
+  return vec_t{ (0 < i_a.x) - (i_a.x < 0),
+                (0 < i_a.y) - (i_a.y < 0),
+                (0 < i_a.z) - (i_a.z < 0) };
+}
+
+einsum_ir::basic::SfcGilbert3d::vec_t einsum_ir::basic::SfcGilbert3d::scale( vec_t   i_a,
+                                                                             int64_t i_length ) {
+  vec_t l_unit = unit( i_a );
+  return vec_t{ l_unit.x * i_length, l_unit.y * i_length, l_unit.z * i_length };
+}
+
+bool einsum_ir::basic::SfcGilbert3d::feasible( int64_t i_size_a,
+                                               int64_t i_size_b,
+                                               int64_t i_size_c ) {
+  if( i_size_a < 1 || i_size_b < 1 || i_size_c < 1 ) {
+    return false;
+  }
+
+  //start and end coincide
+  if( i_size_a == 1 ) {
+    return i_size_b == 1 && i_size_c == 1;
+  }
+
+  //checkerboard coloring: start and end have the same color iff the number of positions is odd
+  return (i_size_a % 2 == 0) || (i_size_b % 2 == 1 && i_size_c % 2 == 1);
+}
+
+void einsum_ir::basic::SfcGilbert3d::curve( vec_t                    i_pos,
+                                            vec_t                    i_a,
+                                            vec_t                    i_b,
+                                            vec_t                    i_c,
+                                            std::vector< int64_t > & io_path ) {
+  int64_t l_w = length( i_a );
+  int64_t l_h = length( i_b );
+  int64_t l_d = length( i_c );
+
+  vec_t l_da = unit( i_a );
+  vec_t l_db = unit( i_b );
+  vec_t l_dc = unit( i_c );
+
+  //trivial row/column fills
+  if( (l_h == 1 && l_d == 1) || (l_w == 1 && l_d == 1) || (l_w == 1 && l_h == 1) ) {
+    int64_t l_size = l_w * l_h * l_d;
+    vec_t l_dir = (l_w > 1) ? l_da : (l_h > 1) ? l_db : l_dc;
+    for( int64_t l_id = 0; l_id < l_size; l_id++ ) {
+      io_path.push_back( i_pos.x );
+      io_path.push_back( i_pos.y );
+      io_path.push_back( i_pos.z );
+      i_pos = add( i_pos, l_dir );
+    }
+    return;
+  }
+
+  //default split of gilbert3d which prefers even steps
+  int64_t l_w2 = l_w / 2;
+  int64_t l_h2 = l_h / 2;
+  int64_t l_d2 = l_d / 2;
+  if( (l_w2 % 2) && (l_w > 2) ) l_w2++;
+  if( (l_h2 % 2) && (l_h > 2) ) l_h2++;
+  if( (l_d2 % 2) && (l_d > 2) ) l_d2++;
+
+  //0: split in w only, 1: no split in d, 2: no split in h, 3: split in w, h and d
+  int64_t l_case = 3;
+  if( (2*l_w > 3*l_h) && (2*l_w > 3*l_d) ) {
+    l_case = 0;
+  }
+  else if( 3*l_h > 4*l_d ) {
+    l_case = 1;
+  }
+  else if( 3*l_d > 4*l_h ) {
+    l_case = 2;
+  }
+
+  //search the closest split for which all sub-boxes are feasible, starting with the default case
+  int64_t const l_offsets[5] = { 0, 1, -1, 2, -2 };
+  int64_t l_cases[4] = { l_case, 0, 1, 2 };
+  for( int64_t l_ca = 1; l_ca < 4; l_ca++ ) {
+    if( l_cases[l_ca] >= l_case ) l_cases[l_ca]++;
+  }
+
+  bool l_found = false;
+  for( int64_t l_ca = 0; l_ca < 4 && !l_found; l_ca++ ) {
+    int64_t l_cs = l_cases[l_ca];
+    for( int64_t l_ow = 0; l_ow < 5 && !l_found; l_ow++ ) {
+      for( int64_t l_oh = 0; l_oh < 5 && !l_found; l_oh++ ) {
+        for( int64_t l_od = 0; l_od < 5 && !l_found; l_od++ ) {
+          int64_t l_sw = l_w2 + l_offsets[l_ow];
+          int64_t l_sh = l_h2 + l_offsets[l_oh];
+          int64_t l_sd = l_d2 + l_offsets[l_od];
+
+          bool l_feasible = false;
+          if( l_cs == 0 ) {
+            if( l_oh != 0 || l_od != 0 ) continue;
+            l_feasible =    feasible( l_sw,       l_h, l_d )
+                         && feasible( l_w - l_sw, l_h, l_d );
+          }
+          else if( l_cs == 1 ) {
+            if( l_od != 0 ) continue;
+            l_feasible =    feasible( l_sh, l_d,        l_sw       )
+                         && feasible( l_w,  l_h - l_sh, l_d        )
+                         && feasible( l_sh, l_d,        l_w - l_sw );
+          }
+          else if( l_cs == 2 ) {
+            if( l_oh != 0 ) continue;
+            l_feasible =    feasible( l_sd, l_sw,       l_h        )
+                         && feasible( l_w,  l_h,        l_d - l_sd )
+                         && feasible( l_sd, l_w - l_sw, l_h        );
+          }
+          else {
+            l_feasible =    feasible( l_sh, l_sd,       l_sw       )
+                         && feasible( l_d,  l_sw,       l_h - l_sh )
+                         && feasible( l_w,  l_sh,       l_d - l_sd )
+                         && feasible( l_d,  l_w - l_sw, l_h - l_sh )
+                         && feasible( l_sh, l_sd,       l_w - l_sw );
+          }
+
+          if( l_feasible ) {
+            l_found = true;
+            l_case = l_cs;
+            l_w2 = l_sw;
+            l_h2 = l_sh;
+            l_d2 = l_sd;
+          }
+        }
+      }
+    }
+  }
+
+  vec_t l_a2 = scale( i_a, l_w2 );
+  vec_t l_b2 = scale( i_b, l_h2 );
+  vec_t l_c2 = scale( i_c, l_d2 );
+
+  if( l_case == 0 ) {
+    curve( i_pos,                        l_a2,             i_b, i_c, io_path );
+    curve( add( i_pos, l_a2 ), sub( i_a, l_a2 ), i_b, i_c, io_path );
+  }
+  else if( l_case == 1 ) {
+    curve( i_pos,
+           l_b2, i_c, l_a2,
+           io_path );
+    curve( add( i_pos, l_b2 ),
+           i_a, sub( i_b, l_b2 ), i_c,
+           io_path );
+    curve( add( add( i_pos, sub( i_a, l_da ) ), sub( l_b2, l_db ) ),
+           neg( l_b2 ), i_c, neg( sub( i_a, l_a2 ) ),
+           io_path );
+  }
+  else if( l_case == 2 ) {
+    curve( i_pos,
+           l_c2, l_a2, i_b,
+           io_path );
+    curve( add( i_pos, l_c2 ),
+           i_a, i_b, sub( i_c, l_c2 ),
+           io_path );
+    curve( add( add( i_pos, sub( i_a, l_da ) ), sub( l_c2, l_dc ) ),
+           neg( l_c2 ), neg( sub( i_a, l_a2 ) ), i_b,
+           io_path );
+  }
+  else {
+    curve( i_pos,
+           l_b2, l_c2, l_a2,
+           io_path );
+    curve( add( i_pos, l_b2 ),
+           i_c, l_a2, sub( i_b, l_b2 ),
+           io_path );
+    curve( add( add( i_pos, sub( l_b2, l_db ) ), sub( i_c, l_dc ) ),
+           i_a, neg( l_b2 ), neg( sub( i_c, l_c2 ) ),
+           io_path );
+    curve( add( add( add( i_pos, sub( i_a, l_da ) ), l_b2 ), sub( i_c, l_dc ) ),
+           neg( i_c ), neg( sub( i_a, l_a2 ) ), sub( i_b, l_b2 ),
+           io_path );
+    curve( add( add( i_pos, sub( i_a, l_da ) ), sub( l_b2, l_db ) ),
+           neg( l_b2 ), l_c2, neg( sub( i_a, l_a2 ) ),
+           io_path );
+  }
+}
+
+void einsum_ir::basic::SfcGilbert3d::path( int64_t                  i_size_x,
+                                           int64_t                  i_size_y,
+                                           int64_t                  i_size_z,
+                                           std::vector< int64_t > & o_path ) {
+  o_path.clear();
+  o_path.reserve( 3 * i_size_x * i_size_y * i_size_z );
+
+  //the curve ends anywhere: use the largest direction as major direction for which the curve ends at its far end
+  int64_t l_sizes[3] = { i_size_x, i_size_y, i_size_z };
+  int64_t l_major = -1;
+  for( int64_t l_di = 0; l_di < 3; l_di++ ) {
+    bool l_feasible = feasible( l_sizes[l_di],
+                                l_sizes[(l_di+1)%3],
+                                l_sizes[(l_di+2)%3] );
+    if( l_feasible && (l_major == -1 || l_sizes[l_di] > l_sizes[l_major]) ) {
+      l_major = l_di;
+    }
+  }
+
+  vec_t l_x{ i_size_x, 0, 0 };
+  vec_t l_y{ 0, i_size_y, 0 };
+  vec_t l_z{ 0, 0, i_size_z };
+  vec_t l_origin{ 0, 0, 0 };
+
+  if( l_major == 1 ) {
+    curve( l_origin, l_y, l_x, l_z, o_path );
+  }
+  else if( l_major == 2 ) {
+    curve( l_origin, l_z, l_x, l_y, o_path );
+  }
+  else {
+    curve( l_origin, l_x, l_y, l_z, o_path );
+  }
+}
@@ -0,0 +1,86 @@
+#ifndef EINSUM_IR_BASIC_BINARY_SFC_GILBERT_3D
+#define EINSUM_IR_BASIC_BINARY_SFC_GILBERT_3D
+
+#include <cstdint>
+#include <vector>
+
+namespace einsum_ir {
+  namespace basic {
+    class SfcGilbert3d;
+  }
+}
+
+/**
+ * Generalized 3d Hilbert curve for arbitrary sizes.
+ * The recursion follows gilbert3d of https://github.com/jakubcerveny/gilbert.
+ * In contrast to gilbert3d, the splits are chosen such that all consecutive positions differ in a single dimension by one.
+ * This is also the case for odd sizes.
+ **/
+class einsum_ir::basic::SfcGilbert3d {
+  private:
+    //! vector in the 3d space
+    struct vec_t {
+      int64_t x = 0;
+      int64_t y = 0;
+      int64_t z = 0;
+    };
+
+    static vec_t add( vec_t i_a,
+                      vec_t i_b );
+
+    static vec_t sub( vec_t i_a,
+                      vec_t i_b );
+
+    static vec_t neg( vec_t i_a );
+
+    static int64_t length( vec_t i_a );
+
+    static vec_t unit( vec_t i_a );
+
+    static vec_t scale( vec_t   i_a,
+                        int64_t i_length );
+
+    /**
+     * Checks if a box can be traversed by a curve with unit steps
+     * which starts at the origin and ends at the far end of the major direction.
+     *
+     * @param i_size_a size of the box in the major direction.
+     * @param i_size_b size of the box in the first orthogonal direction.
+     * @param i_size_c size of the box in the second orthogonal direction.
+     * @return true if such a curve exists, false otherwise.
+     **/
+    static bool feasible( int64_t i_size_a,
+                          int64_t i_size_b,
+                          int64_t i_size_c );
+
+    /**
+     * Recursively appends the positions of the curve in a box.
+     *
+     * @param i_pos start position.
+     * @param i_a major direction.
+     * @param i_b first orthogonal direction.
+     * @param i_c second orthogonal direction.
+     * @param io_path positions to which the x, y and z ids are appended.
+     **/
+    static void curve( vec_t                    i_pos,
+                       vec_t                    i_a,
+                       vec_t                    i_b,
+                       vec_t                    i_c,
+                       std::vector< int64_t > & io_path );
+
+  public:
+    /**
+     * Calculates all positions of the curve.
+     *
+     * @param i_size_x size in x direction.
+     * @param i_size_y size in y direction.
+     * @param i_size_z size in z direction.
+     * @param o_path will be set to the x, y and z ids of all positions.
+     **/
+    static void path( int64_t                  i_size_x,
+                      int64_t                  i_size_y,
+                      int64_t                  i_size_z,
+                      std::vector< int64_t > & o_path );
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "catch.hpp"
+#include "SfcGilbert3d.h"
+#include <cstdlib>
+
+/**
+ * Checks that the path visits every position once and moves in a single dimension by one per step.
+ **/
+static bool check_sfc_gilbert_3d( int64_t i_size_x,
+                                  int64_t i_size_y,
+                                  int64_t i_size_z ) {
+  std::vector< int64_t > l_path;
+  einsum_ir::basic::SfcGilbert3d::path( i_size_x,
+                                        i_size_y,
+                                        i_size_z,
+                                        l_path );
+
+  int64_t l_size = i_size_x * i_size_y * i_size_z;
+  if( (int64_t) l_path.size() != 3 * l_size ) return false;
+
+  std::vector< bool > l_visited( l_size, false );
+  for( int64_t l_id = 0; l_id < l_size; l_id++ ) {
+    int64_t l_x = l_path[3*l_id    ];
+    int64_t l_y = l_path[3*l_id + 1];
+    int64_t l_z = l_path[3*l_id + 2];
+
+    if( l_x < 0 || l_x >= i_size_x ) return false;
+    if( l_y < 0 || l_y >= i_size_y ) return false;
+    if( l_z < 0 || l_z >= i_size_z ) return false;
+
+    int64_t l_pos = l_x + i_size_x * ( l_y + i_size_y * l_z );
+    if( l_visited[l_pos] ) return false;
+    l_visited[l_pos] = true;
+
+    if( l_id > 0 ) {
+      int64_t l_dist =   std::abs( l_x - l_path[3*l_id - 3] )
+                       + std::abs( l_y - l_path[3*l_id - 2] )
+                       + std::abs( l_z - l_path[3*l_id - 1] );
+      if( l_dist != 1 ) return false;
+    }
+  }
+
+  return true;
+}
+
+TEST_CASE( "Generalized 3D Hilbert curve with even sizes.", "[sfc_gilbert_3d]" ) {
+  using namespace einsum_ir::basic;
+
+  REQUIRE( check_sfc_gilbert_3d(  2,  2,  2 ) );
+  REQUIRE( check_sfc_gilbert_3d(  8,  8,  8 ) );
+  REQUIRE( check_sfc_gilbert_3d( 16,  4,  2 ) );
+  REQUIRE( check_sfc_gilbert_3d(  6, 10, 14 ) );
+
+  // corners of the cube
+  std::vector< int64_t > l_path;
+  SfcGilbert3d::path( 4, 4, 4, l_path );
+  REQUIRE( l_path[0] == 0 );
+  REQUIRE( l_path[1] == 0 );
+  REQUIRE( l_path[2] == 0 );
+  REQUIRE( l_path[3*63    ] == 3 );
+  REQUIRE( l_path[3*63 + 1] == 0 );
+  REQUIRE( l_path[3*63 + 2] == 0 );
+}
+
+TEST_CASE( "Generalized 3D Hilbert curve with odd sizes.", "[sfc_gilbert_3d]" ) {
+  REQUIRE( check_sfc_gilbert_3d(  3,  5,  7 ) );
+  REQUIRE( check_sfc_gilbert_3d(  7,  7,  2 ) );
+  REQUIRE( check_sfc_gilbert_3d(  2,  9,  9 ) );
+  REQUIRE( check_sfc_gilbert_3d(  1,  5,  3 ) );
+  REQUIRE( check_sfc_gilbert_3d( 13,  1, 11 ) );
+
+  for( int64_t l_x = 1; l_x <= 9; l_x++ ) {
+    for( int64_t l_y = 1; l_y <= 9; l_y++ ) {
+      for( int64_t l_z = 1; l_z <= 9; l_z++ ) {
+        REQUIRE( check_sfc_gilbert_3d( l_x, l_y, l_z ) );
+      }
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #ifndef EINSUM_IR_BASIC_CONSTANTS
 #define EINSUM_IR_BASIC_CONSTANTS
 
+#include <chrono>
 #include <cstdint>
 #include <vector>
 
@@ -19,6 +20,15 @@ namespace einsum_ir {
       BR_MADD         = 12,
       PACKED_MADD     = 13,
       CPX_PACKED_MADD = 14,
+      GELU            = 15,
+      SIGMOID         = 16,
+      TANH            = 17,
+      MUL             = 18,
+      MIN             = 19,
+      MAX             = 20,
+      EPILOGUE        = 21,
+      DEQUANT         = 22,
+      QUANT           = 23,
       UNDEFINED_KTYPE = 99
     } kernel_t;
 
@@ -37,12 +47,17 @@ namespace einsum_ir {
       SUCCESS                   =  0,
       COMPILATION_FAILED        =  1,
       INVALID_CPX_DIM           =  2,
+      IO_FAILED                 =  3,
       UNDEFINED_ERROR           = 99
     } err_t;
 
     typedef enum {
       FP32            = 0,
       FP64            = 1,
+      BF16            = 2, // storage only, computations use FP32
+      FP16            = 3, // storage only, computations use FP32
+      INT8            = 4, // quantized inputs, computations use INT32
+      INT32           = 5, // accumulators of INT8 computations
       UNDEFINED_DTYPE = 99
     } data_t;
 
@@ -60,6 +75,19 @@ namespace einsum_ir {
       OUT_STRIDE_ONE = 2  // output dimension has stride one
     } packed_gemm_t;
 
+    typedef enum {
+      OPENMP             = 0, // OpenMP parallel regions
+      THREAD_POOL        = 1, // persistent work-stealing thread pool
+      UNDEFINED_EXECUTOR = 99
+    } executor_t;
+
+    typedef enum {
+      STATIC             = 0, // one contiguous range of shared tasks per thread
+      DYNAMIC            = 1, // fixed-size chunks of shared tasks from a shared counter
+      GUIDED             = 2, // decreasing chunks of shared tasks from a shared counter
+      UNDEFINED_SCHEDULE = 99
+    } schedule_t;
+
     typedef uint8_t sfc_t;
 
     struct thread_info {
@@ -69,9 +97,11 @@ namespace einsum_ir {
       int64_t   offset_out     = 0;
       char    * memory_left    = nullptr;
       char    * memory_right   = nullptr;
+      char    * memory_scratch = nullptr;
 
       int64_t id_shared_loop_start = 0;
       int64_t id_shared_loop_end   = 0;
+      int64_t id_shared_group      = 0;
 
       int64_t sfc_size_m = 0;
       int64_t sfc_size_n = 0;
@@ -82,6 +112,12 @@ namespace einsum_ir {
       std::vector<const char *> cached_ptrs_right;
     };
 
+    struct epilogue_op {
+      kernel_t ktype   = kernel_t::UNDEFINED_KTYPE; // unary: RELU, GELU, SIGMOID, TANH; binary: ADD, MUL, MIN, MAX, DEQUANT, QUANT
+      bool     use_aux = true;                      // binary ops: true if the auxiliary tensor is the second operand
+      double   scalar  = 0;                         // binary ops: second operand if the auxiliary tensor is not used
+    };
+
     struct iter_property {
       dim_t   dim_type             = dim_t::UNDEFINED_DIM;
       exec_t  exec_type            = exec_t::SEQ;
@@ -94,11 +130,85 @@ namespace einsum_ir {
       int64_t packing_stride_right = 0;
     };
 
+    struct tuning_config {
+      int64_t target_m             = 0;    // targeted size of the kernel's m dimension
+      int64_t target_n             = 0;    // targeted size of the kernel's n dimension
+      int64_t target_k             = 0;    // targeted size of the kernel's k dimension
+      int64_t target_extra_packing = 8;    // targeted size of extra packing (br or c) dimensions
+      bool    generate_sfcs        = true; // true if sfc dimensions are generated
+      bool    packing              = true; // true if the inputs may be packed (backends with packing support only)
+      int64_t num_threads_shared   = 0;    // threads of the shared dimensions, 0: optimizer's choice
+      int64_t num_threads_sfc_m    = 0;    // threads of the sfc m dimensions, 0: optimizer's choice
+      int64_t num_threads_sfc_n    = 0;    // threads of the sfc n dimensions, 0: optimizer's choice
+      double  time                 = 0;    // measured time of the contraction in seconds, 0: not measured
+    };
+
+    struct contraction_plan {
+      std::vector< iter_property > iters;                                  // optimized iterations
+      kernel_t                     ktype_main = kernel_t::UNDEFINED_KTYPE; // main kernel type after optimization
+      int64_t                      num_threads_shared = 1;                 // threads of the shared dimensions
+      int64_t                      num_threads_sfc_m  = 1;                 // threads of the sfc m dimensions
+      int64_t                      num_threads_sfc_n  = 1;                 // threads of the sfc n dimensions
+      std::vector< thread_info >   thread_infos;                           // thread infos of the compiled iteration space
+      int64_t                      caching_size = 0;                       // number of cached packed blocks per input
+    };
+
+    struct phase_stats {
+      int64_t cycles = 0; // cycles spent in the phase
+      int64_t calls  = 0; // number of calls of the phase
+    };
+
+    // instrumentation counters of a thread, only updated if built with PP_EINSUM_IR_INSTRUMENT
+    struct alignas(64) thread_stats {
+      phase_stats total;                    // entire work of the thread in a contraction
+      phase_stats packing_left;             // packing of the left input
+      phase_stats packing_right;            // packing of the right input
+      phase_stats first_touch;              // first touch kernels, fused with the main kernel of the first k access
+      phase_stats main;                     // main kernels
+      phase_stats last_touch;               // last touch kernels
+      int64_t     packing_hits_left    = 0; // packed left blocks found in cached_ptrs_left
+      int64_t     packing_misses_left  = 0; // packed left blocks missing in cached_ptrs_left
+      int64_t     packing_hits_right   = 0; // packed right blocks found in cached_ptrs_right
+      int64_t     packing_misses_right = 0; // packed right blocks missing in cached_ptrs_right
+    };
+
+    /**
+     * Reads the cycle counter of the core, i.e., the time stamp counter on x86 and the virtual counter on aarch64.
+     * Other architectures fall back to nanoseconds.
+     *
+     * @return current value of the counter.
+     **/
+    inline int64_t read_cycles() {
+#if defined(__x86_64__)
+      uint32_t l_lo = 0;
+      uint32_t l_hi = 0;
+      __asm__ __volatile__( "rdtsc" : "=a"(l_lo), "=d"(l_hi) );
+      return ( (int64_t) l_hi << 32 ) | l_lo;
+#elif defined(__aarch64__)
+      int64_t l_cycles = 0;
+      __asm__ __volatile__( "mrs %0, cntvct_el0" : "=r"(l_cycles) );
+      return l_cycles;
+#else
+      return std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#endif
+    }
+
     constexpr int64_t ce_n_bytes( data_t i_dtype ) {
       if(      i_dtype == FP32 )  return 4;
       else if( i_dtype == FP64 )  return 8;
+      else if( i_dtype == BF16 )  return 2;
+      else if( i_dtype == FP16 )  return 2;
+      else if( i_dtype == INT8 )  return 1;
+      else if( i_dtype == INT32 ) return 4;
       else                        return -1;
     }
+
+    constexpr data_t ce_dtype_comp( data_t i_dtype ) {
+      if(      i_dtype == BF16 ) return FP32;
+      else if( i_dtype == FP16 ) return FP32;
+      else if( i_dtype == INT8 ) return INT32;
+      else                       return i_dtype;
+    }
   }
 }
 
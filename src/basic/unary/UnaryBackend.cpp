@@ -1,4 +1,6 @@
 #include "UnaryBackend.h"
+#include "../ThreadPool.h"
+#include <algorithm>
 
 void einsum_ir::basic::UnaryBackend::init( std::vector< exec_t >  const & i_exec_types,
                                            std::vector< int64_t > const & i_dim_sizes,
@@ -8,7 +10,8 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< exec_t >  const & i_exec
                                            data_t                         i_dtype_comp,
                                            data_t                         i_dtype_out,
                                            kernel_t                       i_ktype,
-                                           int64_t                        i_num_threads ){
+                                           int64_t                        i_num_threads,
+                                           executor_t                     i_executor ){
 
   //copy to local variables
   m_exec_types = i_exec_types;
@@ -24,6 +27,8 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< exec_t >  const & i_exec
   m_ktype = i_ktype;
 
   m_num_threads = i_num_threads;
+
+  m_executor = i_executor;
 }
 
 void einsum_ir::basic::UnaryBackend::init( std::vector< iter_property > const & i_iterations,
@@ -31,7 +36,8 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< iter_property > const &
                                            data_t                               i_dtype_comp,
                                            data_t                               i_dtype_out,
                                            kernel_t                             i_ktype,
-                                           int64_t                              i_num_threads ){
+                                           int64_t                              i_num_threads,
+                                           executor_t                           i_executor ){
 
   int64_t l_num_iters = i_iterations.size();
   m_exec_types.resize(l_num_iters);
@@ -53,6 +59,8 @@ void einsum_ir::basic::UnaryBackend::init( std::vector< iter_property > const &
   m_ktype = i_ktype;
 
   m_num_threads = i_num_threads;
+
+  m_executor = i_executor;
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::UnaryBackend::compile(){
@@ -64,6 +72,8 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackend::compile(){
     return l_err;
   }
 
+  reset_stats();
+
   // compile kernel
   l_err = compile_kernels();
   if( l_err != err_t::SUCCESS ) {
@@ -104,6 +114,10 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackend::compile(){
 
 void einsum_ir::basic::UnaryBackend::eval( void const * i_tensor_in,
                                            void       * io_tensor_out ) {
+#ifdef PP_EINSUM_IR_INSTRUMENT
+  int64_t l_cycles = read_cycles();
+#endif
+
   if(m_id_first_primitive_dim == 0){
     kernel_main( (char *) i_tensor_in,
                  (char *) io_tensor_out );
@@ -118,6 +132,23 @@ void einsum_ir::basic::UnaryBackend::eval( void const * i_tensor_in,
                (char *) i_tensor_in,
                (char *) io_tensor_out );
   }
+
+#ifdef PP_EINSUM_IR_INSTRUMENT
+  m_stats_cycles.fetch_add( read_cycles() - l_cycles,
+                            std::memory_order_relaxed );
+  m_stats_calls.fetch_add( 1,
+                           std::memory_order_relaxed );
+#endif
+}
+
+void einsum_ir::basic::UnaryBackend::get_stats( phase_stats & o_stats ) const {
+  o_stats.cycles = m_stats_cycles.load( std::memory_order_relaxed );
+  o_stats.calls  = m_stats_calls.load(  std::memory_order_relaxed );
+}
+
+void einsum_ir::basic::UnaryBackend::reset_stats() {
+  m_stats_cycles.store( 0, std::memory_order_relaxed );
+  m_stats_calls.store(  0, std::memory_order_relaxed );
 }
 
 
@@ -152,38 +183,63 @@ void einsum_ir::basic::UnaryBackend::eval_iter_parallel( int64_t         i_id_lo
   for( int64_t l_loop = 0; l_loop < m_num_parallel_loops; l_loop++ ) {
     l_all_size *= m_dim_sizes[l_loop];
   }
-  
 
   // issue loop iterations
+  if( m_executor == executor_t::THREAD_POOL ) {
+    // static distribution of the iterations to the tasks
+    int64_t l_num_tasks = std::min( m_num_threads, l_all_size );
+    ThreadPool::get_instance()->parallel_for( l_num_tasks,
+                                              [&]( int64_t l_task_id ) {
+                                                int64_t l_start = ( l_all_size *  l_task_id      ) / l_num_tasks;
+                                                int64_t l_end   = ( l_all_size * (l_task_id + 1) ) / l_num_tasks;
+                                                for( int64_t l_it = l_start; l_it < l_end; l_it++ ) {
+                                                  eval_iter_fused( i_id_loop,
+                                                                   l_it,
+                                                                   i_ptr_in,
+                                                                   i_ptr_out );
+                                                }
+                                              } );
+  }
+  else {
 #ifdef _OPENMP
 #pragma omp parallel for num_threads(m_num_threads)
 #endif
-  for( int64_t l_it = 0; l_it < l_all_size; l_it++ ) {
-
-    char const * l_ptr_in  = i_ptr_in;
-    char       * l_ptr_out = i_ptr_out;
-
-    int64_t l_it_all_loops   = l_it;
-    int64_t l_it_single_loop = 0;
-    for( int64_t l_loop = m_num_parallel_loops - 1; l_loop >= 0; l_loop-- ) {
-      l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
-      l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
-
-      //update pointer
-      l_ptr_in  = i_ptr_in  + l_it_single_loop * m_strides_in[  l_loop ];
-      l_ptr_out = i_ptr_out + l_it_single_loop * m_strides_out[ l_loop ];
+    for( int64_t l_it = 0; l_it < l_all_size; l_it++ ) {
+      eval_iter_fused( i_id_loop,
+                       l_it,
+                       i_ptr_in,
+                       i_ptr_out );
     }
+  }
+}
 
-    if( i_id_loop + 1 < m_id_first_primitive_dim ) {
-      eval_iter( i_id_loop+1,
-                 l_ptr_in,
+void einsum_ir::basic::UnaryBackend::eval_iter_fused( int64_t         i_id_loop,
+                                                      int64_t         i_it,
+                                                      char    const * i_ptr_in,
+                                                      char          * i_ptr_out ) {
+  char const * l_ptr_in  = i_ptr_in;
+  char       * l_ptr_out = i_ptr_out;
+
+  int64_t l_it_all_loops   = i_it;
+  int64_t l_it_single_loop = 0;
+  for( int64_t l_loop = m_num_parallel_loops - 1; l_loop >= 0; l_loop-- ) {
+    l_it_single_loop = l_it_all_loops % m_dim_sizes[l_loop];
+    l_it_all_loops   = l_it_all_loops / m_dim_sizes[l_loop];
+
+    //update pointer
+    l_ptr_in  += l_it_single_loop * m_strides_in[  l_loop ];
+    l_ptr_out += l_it_single_loop * m_strides_out[ l_loop ];
+  }
+
+  if( i_id_loop + m_num_parallel_loops < m_id_first_primitive_dim ) {
+    eval_iter( i_id_loop + m_num_parallel_loops,
+               l_ptr_in,
+               l_ptr_out );
+  }
+  else {
+    // execute main kernel
+    kernel_main( l_ptr_in,
                  l_ptr_out );
-    }
-    else {
-      // execute main kernel
-      kernel_main( l_ptr_in,
-                   l_ptr_out );
-    }
   }
 }
 
@@ -1,6 +1,7 @@
 #ifndef EINSUM_IR_BASIC_UNARY_BACKEND
 #define EINSUM_IR_BASIC_UNARY_BACKEND
 
+#include <atomic>
 #include <vector>
 #include "../constants.h"
 
@@ -26,6 +27,28 @@ class einsum_ir::basic::UnaryBackend {
     //! id of the first parallel loop
     int64_t m_id_first_parallel_loop = 0;
 
+    //! executor which runs the parallel iterations
+    executor_t m_executor = executor_t::OPENMP;
+
+    //! cycles spent in evaluations, only updated if built with PP_EINSUM_IR_INSTRUMENT
+    std::atomic< int64_t > m_stats_cycles{ 0 };
+
+    //! number of evaluations, only updated if built with PP_EINSUM_IR_INSTRUMENT
+    std::atomic< int64_t > m_stats_calls{ 0 };
+
+    /**
+     * Executes a single iteration of the fused parallel loops.
+     *
+     * @param i_id_loop dimension id of the first fused loop.
+     * @param i_it iteration id w.r.t. the fused loops.
+     * @param i_ptr_in pointer to the input tensor's data.
+     * @param i_ptr_out pointer to the output tensor's data.
+     **/
+    void eval_iter_fused( int64_t         i_id_loop,
+                          int64_t         i_it,
+                          char    const * i_ptr_in,
+                          char          * i_ptr_out );
+
   protected:
     //! datatype of the input
     data_t m_dtype_in = UNDEFINED_DTYPE;
@@ -79,6 +102,7 @@ class einsum_ir::basic::UnaryBackend {
      * @param i_dtype_out datatype of output tensor.
      * @param i_ktype type of the kernel.
      * @param i_num_threads number of threads for unary operation.
+     * @param i_executor executor which runs the parallel iterations.
      **/
     void init( std::vector< exec_t >  const & i_exec_types,
                std::vector< int64_t > const & i_dim_sizes,
@@ -88,7 +112,8 @@ class einsum_ir::basic::UnaryBackend {
                data_t                         i_dtype_comp,
                data_t                         i_dtype_out,
                kernel_t                       i_ktype,
-               int64_t                        i_num_threads );
+               int64_t                        i_num_threads,
+               executor_t                     i_executor = executor_t::OPENMP );
 
 
     /**
@@ -100,13 +125,15 @@ class einsum_ir::basic::UnaryBackend {
      * @param i_dtype_out datatype of output tensor.
      * @param i_ktype type of the kernel.
      * @param i_num_threads number of threads used for unary operation.
+     * @param i_executor executor which runs the parallel iterations.
      **/
     void init( std::vector< iter_property > const & i_iterations,
                data_t                               i_dtype_in,
                data_t                               i_dtype_comp,
                data_t                               i_dtype_out,
                kernel_t                             i_ktype,
-               int64_t                              i_num_threads );
+               int64_t                              i_num_threads,
+               executor_t                           i_executor = executor_t::OPENMP );
 
     /**
      * Compiles the unary backend.
@@ -124,6 +151,19 @@ class einsum_ir::basic::UnaryBackend {
      **/
     void eval( void const * i_tensor_in,
                void       * io_tensor_out );
+
+    /**
+     * Gets the instrumentation counters of all evaluations since the compilation or the last reset.
+     * Evaluations of packing backends are counted by all threads of the contraction.
+     *
+     * @param o_stats will be set to the cycles and number of the evaluations.
+     **/
+    void get_stats( phase_stats & o_stats ) const;
+
+    /**
+     * Resets the instrumentation counters.
+     **/
+    void reset_stats();
     
     /**
      * General purpose loop implementation featuring first and last touch operations.
@@ -139,7 +179,7 @@ class einsum_ir::basic::UnaryBackend {
 
     /**
      * General purpose loop implementation featuring first and last touch operations.
-     * Omp parallelization is applied by funsing all parallel loops.
+     * Parallelization is applied by fusing all parallel loops.
      *
      * @param i_id_loop dimension id of the loop which is executed.
      * @param i_ptr_in pointer to the input tensor's data.
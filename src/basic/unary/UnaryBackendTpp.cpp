@@ -7,6 +7,18 @@ libxsmm_datatype einsum_ir::basic::UnaryBackendTpp::dtype_to_libxsmm( data_t i_d
   else if( i_dtype == FP64 ) {
     return libxsmm_datatype::LIBXSMM_DATATYPE_F64;
   }
+  else if( i_dtype == BF16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_BF16;
+  }
+  else if( i_dtype == FP16 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_F16;
+  }
+  else if( i_dtype == INT8 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I8;
+  }
+  else if( i_dtype == INT32 ) {
+    return libxsmm_datatype::LIBXSMM_DATATYPE_I32;
+  }
 
   return libxsmm_datatype::LIBXSMM_DATATYPE_UNSUPPORTED;
 }
@@ -48,15 +60,15 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
                                                                                      m_ldb,
                                                                                      l_xmm_dtype_out,
                                                                                      l_xmm_dtype_out,
-                                                                                     l_xmm_dtype_out );
+                                                                                     l_xmm_dtype_comp );
   
   libxsmm_meltw_unary_shape l_shape_single_touch_aux_unary = libxsmm_create_meltw_unary_shape( m_m,
                                                                                                m_n,
                                                                                                m_lda,
                                                                                                m_ldb,
+                                                                                               l_xmm_dtype_in,
                                                                                                l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out,
-                                                                                               l_xmm_dtype_out );
+                                                                                               l_xmm_dtype_comp );
 
   libxsmm_meltw_binary_shape l_shape_single_touch_aux_binary = libxsmm_create_meltw_binary_shape( m_m,
                                                                                                   m_n,
@@ -64,9 +76,9 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryBackendTpp::compile_kernels(){
                                                                                                   m_lda,
                                                                                                   m_ldb,
                                                                                                   l_xmm_dtype_out,
+                                                                                                  l_xmm_dtype_in,
                                                                                                   l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out,
-                                                                                                  l_xmm_dtype_out );
+                                                                                                  l_xmm_dtype_comp );
 
   //first touch kernel
   if( m_ktype == kernel_t::ZERO ) {
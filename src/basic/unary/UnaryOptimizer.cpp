@@ -3,10 +3,14 @@
 
 void einsum_ir::basic::UnaryOptimizer::init( std::vector< iter_property > * i_iter_space,
                                              int64_t                        i_num_threads,
-                                             bool                           i_scalar_optim ){
+                                             bool                           i_scalar_optim,
+                                             int64_t                        i_num_bytes_scalar,
+                                             int64_t                        i_l1_cache_size ){
   m_iter_space = i_iter_space;
   m_num_threads = i_num_threads;
   m_sclar_optim = i_scalar_optim;
+  m_num_bytes_scalar = i_num_bytes_scalar;
+  m_l1_cache_size = i_l1_cache_size;
 }
 
 einsum_ir::basic::err_t einsum_ir::basic::UnaryOptimizer::optimize(){
@@ -62,6 +66,74 @@ einsum_ir::basic::err_t einsum_ir::basic::UnaryOptimizer::optimize(){
       l_new_iter.stride_out =  l_iter->size * l_found_stride_one_out + !l_found_stride_one_out;
       m_iter_space->insert(m_iter_space->end() - l_found_stride_one_in, l_new_iter);
     }
+
+    block_transposition();
   }
   return err_t::SUCCESS;
 }
+
+void einsum_ir::basic::UnaryOptimizer::block_transposition(){
+  if(    m_num_bytes_scalar <= 0
+      || m_l1_cache_size    <= 0
+      || m_iter_space->size() < 2 ){
+    return;
+  }
+
+  std::size_t l_size = m_iter_space->size();
+  iter_property & l_prim_n = m_iter_space->at(l_size - 2);
+  iter_property & l_prim_m = m_iter_space->at(l_size - 1);
+
+  //only transpositions jump through memory, other primitives stream through the tensors
+  if(    l_prim_n.exec_type   != exec_t::PRIM
+      || l_prim_m.exec_type   != exec_t::PRIM
+      || l_prim_m.stride_left != 1
+      || l_prim_n.stride_out  != 1 ){
+    return;
+  }
+
+  //splits with small blocks would increase the number of kernel calls without benefit
+  int64_t const l_min_block = 16;
+
+  int64_t l_block[2] = { l_prim_n.size, l_prim_m.size };
+  bool l_splittable[2] = { true, true };
+  while(    2 * l_block[0] * l_block[1] * m_num_bytes_scalar > m_l1_cache_size
+         && ( l_splittable[0] || l_splittable[1] ) ){
+    //halve the larger block if possible
+    int64_t l_id = ( l_splittable[0] && ( l_block[0] >= l_block[1] || !l_splittable[1] ) ) ? 0 : 1;
+
+    //largest divisor which at most halves the block
+    int64_t l_divisor = 1;
+    for( int64_t l_di = l_block[l_id] / 2; l_di > 1; l_di-- ){
+      if( l_block[l_id] % l_di == 0 ){
+        l_divisor = l_di;
+        break;
+      }
+    }
+
+    if( l_divisor < l_min_block ){
+      l_splittable[l_id] = false;
+    }
+    else{
+      l_block[l_id] = l_divisor;
+    }
+  }
+
+  //outer iterations of the blocks
+  std::vector< iter_property > l_outer_iters;
+  iter_property * l_prims[2] = { &l_prim_n, &l_prim_m };
+  for( int64_t l_id = 0; l_id < 2; l_id++ ){
+    if( l_block[l_id] < l_prims[l_id]->size ){
+      iter_property l_outer = *l_prims[l_id];
+      l_outer.exec_type   = exec_t::SEQ;
+      l_outer.size        = l_prims[l_id]->size / l_block[l_id];
+      l_outer.stride_left = l_prims[l_id]->stride_left * l_block[l_id];
+      l_outer.stride_out  = l_prims[l_id]->stride_out  * l_block[l_id];
+      l_prims[l_id]->size = l_block[l_id];
+      l_outer_iters.push_back( l_outer );
+    }
+  }
+
+  m_iter_space->insert( m_iter_space->end() - 2,
+                        l_outer_iters.begin(),
+                        l_outer_iters.end() );
+}
@@ -21,6 +21,17 @@ class einsum_ir::basic::UnaryOptimizer {
   //! true if scalar execution should be generated, false otherwise
    bool m_sclar_optim = false;
 
+   //! number of bytes of the larger scalar data type of input and output
+   int64_t m_num_bytes_scalar = 0;
+
+   //! share of a thread of the L1 data cache in bytes, 0 if unknown
+   int64_t m_l1_cache_size = 0;
+
+   /**
+     * Blocks the primitive iterations of transpositions such that a block of the input and output tensor fits into the L1 cache.
+     **/
+   void block_transposition();
+
 
   public:
    /**
@@ -29,10 +40,14 @@ class einsum_ir::basic::UnaryOptimizer {
      * @param i_iter_space vector of iters corresponding to an unoptimized unary operation.
      * @param i_num_threads number of participating threads for unary operation.
      * @param i_scalar_optim true if scalar execution should be generated, false otherwise.
+     * @param i_num_bytes_scalar number of bytes of the larger scalar data type of input and output.
+     * @param i_l1_cache_size share of a thread of the L1 data cache in bytes, 0 disables blocking.
      **/
     void init( std::vector< iter_property > * i_iter_space,
                int64_t                        i_num_threads, 
-               bool                           i_scalar_optim );    
+               bool                           i_scalar_optim,
+               int64_t                        i_num_bytes_scalar = 0,
+               int64_t                        i_l1_cache_size = 0 );    
   
    /**
      * Optimizes the iteration space.
@@ -165,10 +165,245 @@ void bench_binary( std::map< int64_t, int64_t > & i_dim_sizes_map,
   }
   else{
     std::cout << "  results are close" << std::endl;
-  } 
+  }
+
+  /*
+   * einsum_ir with other executors and schedules of the shared loops
+   */
+  double l_time_omp_static = l_time;
+
+  std::vector< einsum_ir::executor_t > l_executors = { einsum_ir::THREAD_POOL,
+                                                       einsum_ir::OPENMP,
+                                                       einsum_ir::OPENMP };
+  std::vector< einsum_ir::schedule_t > l_schedules = { einsum_ir::STATIC,
+                                                       einsum_ir::DYNAMIC,
+                                                       einsum_ir::GUIDED };
+  std::vector< std::string > l_config_names = { "thread pool",
+                                                "omp, dynamic schedule",
+                                                "omp, guided schedule" };
+
+  for( std::size_t l_co = 0; l_co < l_executors.size(); l_co++ ) {
+    std::cout << "einsum_ir (" << l_config_names[l_co] << "):" << std::endl;
+
+    einsum_ir::backend::MemoryManager l_memory_config;
+    einsum_ir::backend::BinaryContractionTpp l_bin_cont_config;
+    l_bin_cont_config.m_executor = l_executors[l_co];
+    l_bin_cont_config.m_schedule = l_schedules[l_co];
+    l_bin_cont_config.init( i_dim_ids_in_left.size(),
+                            i_dim_ids_in_right.size(),
+                            i_dim_ids_out.size(),
+                            &i_dim_sizes_map,
+                            &i_dim_sizes_map,
+                            &i_dim_sizes_map,
+                            nullptr,
+                            &i_dim_sizes_map,
+                            i_loop_order,
+                            i_dim_ids_in_left.data(),
+                            i_dim_ids_in_right.data(),
+                            i_dim_ids_out.data(),
+                            l_dim_ids_permute_left.data(),
+                            l_dim_ids_permute_right.data(),
+                            &l_memory_config,
+                            i_dtype_einsum_ir,
+                            i_dtype_einsum_ir,
+                            i_dtype_einsum_ir,
+                            i_dtype_einsum_ir,
+                            einsum_ir::ZERO,
+                            einsum_ir::MADD,
+                            einsum_ir::UNDEFINED_KTYPE,
+                            l_num_threads );
+
+    l_tp0 = std::chrono::steady_clock::now();
+    l_bin_cont_config.compile();
+    l_memory_config.alloc_all_memory();
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    l_time_compile = l_dur.count();
+
+    // warm up, also starts the workers of the pool
+    l_tp0 = std::chrono::steady_clock::now();
+    for( int64_t l_rep = 0; l_rep < l_repetitions_warm_up; l_rep++ ){
+      l_bin_cont_config.contract( l_ten_left.data_ptr(),
+                                  l_ten_right.data_ptr(),
+                                  l_ten_out.data_ptr() );
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    l_repetitions = l_repetitions_warm_up / l_dur.count() + 1;
+
+    l_tp0 = std::chrono::steady_clock::now();
+    for( int64_t l_rep = 0; l_rep < l_repetitions; l_rep++ ){
+      l_bin_cont_config.contract( l_ten_left.data_ptr(),
+                                  l_ten_right.data_ptr(),
+                                  l_ten_out.data_ptr() );
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    l_time = l_dur.count() / l_repetitions;
+    l_gflops = 1.0E-9 * l_n_flops / l_time;
+
+    std::cout << "  time (compile): " << l_time_compile << std::endl;
+    std::cout << "  time (contract): " << l_time << std::endl;
+    std::cout << "  gflops: " << l_gflops << std::endl;
+    std::cout << "  speedup over omp with static schedule: " << l_time_omp_static / l_time << std::endl;
+
+    if( !at::allclose( l_ten_out_torch, l_ten_out, 1e-03 ) ) {
+      std::cerr << "error: einsum_ir solution (" << l_config_names[l_co] << ") is not close to aten!" << std::endl;
+    }
+    else{
+      std::cout << "  results are close" << std::endl;
+    }
+  }
+
+  /*
+   * einsum_ir with a separate zero first touch
+   */
+  std::cout << "einsum_ir (separate first touch):" << std::endl;
+
+  einsum_ir::backend::MemoryManager l_memory_sep;
+  einsum_ir::backend::BinaryContractionTpp l_bin_cont_sep;
+  l_bin_cont_sep.m_fuse_first_touch = false;
+  l_bin_cont_sep.init( i_dim_ids_in_left.size(),
+                       i_dim_ids_in_right.size(),
+                       i_dim_ids_out.size(),
+                       &i_dim_sizes_map,
+                       &i_dim_sizes_map,
+                       &i_dim_sizes_map,
+                       nullptr,
+                       &i_dim_sizes_map,
+                       i_loop_order,
+                       i_dim_ids_in_left.data(),
+                       i_dim_ids_in_right.data(),
+                       i_dim_ids_out.data(),
+                       l_dim_ids_permute_left.data(),
+                       l_dim_ids_permute_right.data(),
+                       &l_memory_sep,
+                       i_dtype_einsum_ir,
+                       i_dtype_einsum_ir,
+                       i_dtype_einsum_ir,
+                       i_dtype_einsum_ir,
+                       einsum_ir::ZERO,
+                       einsum_ir::MADD,
+                       einsum_ir::UNDEFINED_KTYPE,
+                       l_num_threads );
+  l_bin_cont_sep.compile();
+  l_memory_sep.alloc_all_memory();
+
+  // warm up
+  l_tp0 = std::chrono::steady_clock::now();
+  for( int64_t l_rep = 0; l_rep < l_repetitions_warm_up; l_rep++ ){
+    l_bin_cont_sep.contract( l_ten_left.data_ptr(),
+                             l_ten_right.data_ptr(),
+                             l_ten_out.data_ptr() );
+  }
+  l_tp1 = std::chrono::steady_clock::now();
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  l_repetitions = l_repetitions_warm_up / l_dur.count() + 1;
+
+  l_tp0 = std::chrono::steady_clock::now();
+  for( int64_t l_rep = 0; l_rep < l_repetitions; l_rep++ ){
+    l_bin_cont_sep.contract( l_ten_left.data_ptr(),
+                             l_ten_right.data_ptr(),
+                             l_ten_out.data_ptr() );
+  }
+  l_tp1 = std::chrono::steady_clock::now();
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  l_time = l_dur.count() / l_repetitions;
+  l_gflops = 1.0E-9 * l_n_flops / l_time;
+
+  // the separate zero pass reads (write-allocate) and writes the output tensor once
+  double l_gib_first_touch = 2.0 * l_ten_out.numel() * l_ten_out.element_size() / (1024.0 * 1024.0 * 1024.0);
+
+  std::cout << "  time (contract): " << l_time << std::endl;
+  std::cout << "  gflops: " << l_gflops << std::endl;
+  std::cout << "  speedup of the fused first touch: " << l_time / l_time_omp_static << std::endl;
+  std::cout << "  memory traffic saved by the fused first touch (GiB): " << l_gib_first_touch << std::endl;
+  std::cout << "  bandwidth saved by the fused first touch (GiB/s): " << l_gib_first_touch / l_time_omp_static << std::endl;
+
+  if( !at::allclose( l_ten_out_torch, l_ten_out, 1e-03 ) ) {
+    std::cerr << "error: einsum_ir solution (separate first touch) is not close to aten!" << std::endl;
+  }
+  else{
+    std::cout << "  results are close" << std::endl;
+  }
+
+  /*
+   * einsum_ir with BF16 inputs and an FP32 output, the optimizer blocks K for the smaller input blocks
+   */
+  if( i_dtype_einsum_ir == einsum_ir::FP32 ) {
+    std::cout << "einsum_ir (BF16 inputs):" << std::endl;
+
+    at::Tensor l_ten_left_bf16  = l_ten_left.to( at::ScalarType::BFloat16 );
+    at::Tensor l_ten_right_bf16 = l_ten_right.to( at::ScalarType::BFloat16 );
+
+    einsum_ir::backend::MemoryManager l_memory_bf16;
+    einsum_ir::backend::BinaryContractionTpp l_bin_cont_bf16;
+    l_bin_cont_bf16.init( i_dim_ids_in_left.size(),
+                          i_dim_ids_in_right.size(),
+                          i_dim_ids_out.size(),
+                          &i_dim_sizes_map,
+                          &i_dim_sizes_map,
+                          &i_dim_sizes_map,
+                          nullptr,
+                          &i_dim_sizes_map,
+                          i_loop_order,
+                          i_dim_ids_in_left.data(),
+                          i_dim_ids_in_right.data(),
+                          i_dim_ids_out.data(),
+                          l_dim_ids_permute_left.data(),
+                          l_dim_ids_permute_right.data(),
+                          &l_memory_bf16,
+                          einsum_ir::BF16,
+                          einsum_ir::BF16,
+                          einsum_ir::FP32,
+                          einsum_ir::FP32,
+                          einsum_ir::ZERO,
+                          einsum_ir::MADD,
+                          einsum_ir::UNDEFINED_KTYPE,
+                          l_num_threads );
+    l_bin_cont_bf16.compile();
+    l_memory_bf16.alloc_all_memory();
+
+    // warm up
+    l_tp0 = std::chrono::steady_clock::now();
+    for( int64_t l_rep = 0; l_rep < l_repetitions_warm_up; l_rep++ ){
+      l_bin_cont_bf16.contract( l_ten_left_bf16.data_ptr(),
+                                l_ten_right_bf16.data_ptr(),
+                                l_ten_out.data_ptr() );
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    l_repetitions = l_repetitions_warm_up / l_dur.count() + 1;
+
+    l_tp0 = std::chrono::steady_clock::now();
+    for( int64_t l_rep = 0; l_rep < l_repetitions; l_rep++ ){
+      l_bin_cont_bf16.contract( l_ten_left_bf16.data_ptr(),
+                                l_ten_right_bf16.data_ptr(),
+                                l_ten_out.data_ptr() );
+    }
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    l_time = l_dur.count() / l_repetitions;
+    l_gflops = 1.0E-9 * l_n_flops / l_time;
+
+    std::cout << "  time (contract): " << l_time << std::endl;
+    std::cout << "  gflops: " << l_gflops << std::endl;
+    std::cout << "  speedup over FP32 inputs: " << l_time_omp_static / l_time << std::endl;
+
+    at::Tensor l_ten_out_bf16_ref = at::einsum( i_einsum_string,
+                                                {l_ten_left_bf16.to( at::ScalarType::Float ),
+                                                 l_ten_right_bf16.to( at::ScalarType::Float )},
+                                                { {0,1} } );
+    if( !at::allclose( l_ten_out_bf16_ref, l_ten_out, 1e-03 ) ) {
+      std::cerr << "error: einsum_ir solution (BF16 inputs) is not close to aten!" << std::endl;
+    }
+    else{
+      std::cout << "  results are close" << std::endl;
+    }
+  }
 
   /**
-   * Matmul 
+   * Matmul
    **/
   int64_t l_size_c = 1;
   int64_t l_size_m = 1;
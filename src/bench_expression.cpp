@@ -4,21 +4,30 @@
 #include <ATen/ATen.h>
 #include "frontend/EinsumExpression.h"
 #include "frontend/EinsumExpressionAscii.h"
+#include "frontend/PathOptimizer.h"
+#include "basic/binary/ContractionPlanCache.h"
+#include "backend/Tracer.h"
 
 int main( int     i_argc,
           char  * i_argv[] ) {
   if( i_argc < 4 ) {
     std::cerr << "Usage:" << std::endl;
-    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree" << std::endl;
+    std::cerr << "  ./bench_expression einsum_string dimension_sizes contraction_path dtype store_lock print_tree cpx_3m autotune plan_file trace_file memory_budget compile_parallel" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Arguments:" << std::endl;
     std::cerr << "  * einsum_string:    Einsum expression string. Either in single-character or standard format." << std::endl;
     std::cerr << "  * dimension_sizes:  Dimension sizes have to be in ascending order of the dimension names." << std::endl;
     std::cerr << "                      ASCII numbers (see Example #3) are sorted by their numeric value." << std::endl;
-    std::cerr << "  * contraction_path: Contraction path." << std::endl;
-    std::cerr << "  * dtype:            FP32, FP64, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
+    std::cerr << "  * contraction_path: Contraction path or search method of the path optimizer (greedy, optimal, random_greedy, auto)." << std::endl;
+    std::cerr << "  * dtype:            FP32, FP64, BF16, FP16, CPX_FP32 or CPX_FP64, default: FP32." << std::endl;
     std::cerr << "  * store_lock:       If 1 all einsum_ir input tensors are stored and locked before evaluation, default: 0." << std::endl;
     std::cerr << "  * print_tree:       If not 0 the einsum tree is printed (1: dimension ids, 2: characters), default: 0." << std::endl;
+    std::cerr << "  * cpx_3m:           If 1 complex contractions use three instead of four real multiplications, default: 0." << std::endl;
+    std::cerr << "  * autotune:         If 1 contractions without an entry in the tuning database (EINSUM_IR_TUNING_DB) are autotuned, default: 0." << std::endl;
+    std::cerr << "  * plan_file:        If set, the compiled plans are written to the file and compiling from the file is benchmarked." << std::endl;
+    std::cerr << "  * trace_file:       If set, an additional evaluation is traced and written to the file in the Chrome Trace Event format." << std::endl;
+    std::cerr << "  * memory_budget:    If not 0, dimensions are sliced such that the estimated memory in bytes fits into the budget, default: 0." << std::endl;
+    std::cerr << "  * compile_parallel: If 1 independent subtrees are compiled concurrently, default: 0." << std::endl;
     std::cerr << std::endl;
     std::cerr << "Example #1 (single character format):" << std::endl;
     std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
@@ -26,6 +35,8 @@ int main( int     i_argc,
     std::cerr << "  ./bench_expression \"[i,a,e],[b,f],[d,c,b,a],[c,g],[d,h]->[h,g,f,e,i]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
     std::cerr << "Example #3 (standard format using integers):" << std::endl;
     std::cerr << "  ./bench_expression \"[8,0,4],[1,5],[3,2,1,0],[2,6],[3,7]->[7,6,5,4,8]\" \"32,8,4,2,16,64,8,8,8\" \"(1,2),(2,3),(0,1),(0,1)\"" << std::endl;
+    std::cerr << "Example #4 (path optimizer):" << std::endl;
+    std::cerr << "  ./bench_expression \"iae,bf,dcba,cg,dh->hgfei\" \"32,8,4,2,16,64,8,8,8\" \"auto\"" << std::endl;
     return EXIT_FAILURE;
   }
 
@@ -73,14 +84,29 @@ int main( int     i_argc,
    */
   std::string l_path_string( i_argv[3] );
   std::vector< int64_t > l_path;
-  einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
-                                                          l_path );
+  einsum_ir::path_t l_path_method = einsum_ir::UNDEFINED_PATH;
+  if( l_path_string == "greedy" ) {
+    l_path_method = einsum_ir::GREEDY_PATH;
+  }
+  else if( l_path_string == "optimal" ) {
+    l_path_method = einsum_ir::OPTIMAL_PATH;
+  }
+  else if( l_path_string == "random_greedy" ) {
+    l_path_method = einsum_ir::RANDOM_GREEDY_PATH;
+  }
+  else if( l_path_string == "auto" || l_path_string == "" ) {
+    l_path_method = einsum_ir::AUTO_PATH;
+  }
+  else {
+    einsum_ir::frontend::EinsumExpressionAscii::parse_path( l_path_string,
+                                                            l_path );
 
-  std::cout << "parsed contraction path: ";
-  for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
-    std::cout << l_path[l_co] << " ";
+    std::cout << "parsed contraction path: ";
+    for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
+      std::cout << l_path[l_co] << " ";
+    }
+    std::cout << std::endl;
   }
-  std::cout << std::endl;
 
   /*
    * create mapping from dimension name to id
@@ -129,6 +155,12 @@ int main( int     i_argc,
     else if( l_arg_dtype == "FP64" ) {
       l_dtype_at = at::ScalarType::Double;
     }
+    else if( l_arg_dtype == "BF16" ) {
+      l_dtype_at = at::ScalarType::BFloat16;
+    }
+    else if( l_arg_dtype == "FP16" ) {
+      l_dtype_at = at::ScalarType::Half;
+    }
     else if( l_arg_dtype == "CPX_FP32" ) {
       l_dtype_at = at::ScalarType::ComplexFloat;
     }
@@ -154,6 +186,12 @@ int main( int     i_argc,
   else if( l_dtype_einsum_ir == einsum_ir::FP64 ) {
     std::cout << "dtype: FP64" << std::endl;
   }
+  else if( l_dtype_einsum_ir == einsum_ir::BF16 ) {
+    std::cout << "dtype: BF16" << std::endl;
+  }
+  else if( l_dtype_einsum_ir == einsum_ir::FP16 ) {
+    std::cout << "dtype: FP16" << std::endl;
+  }
   else {
     std::cerr << "failed to determine dtype" << std::endl;
     return EXIT_FAILURE;
@@ -188,6 +226,69 @@ int main( int     i_argc,
   }
   std::cout << "print_tree: " << l_print_tree << std::endl;
 
+  /*
+   * parse cpx_3m
+   */
+  bool l_cpx_3m = false;
+  if( i_argc > 7 ) {
+    int l_arg_3m = std::stoi( i_argv[7] );
+    if( l_arg_3m == 1 ) {
+      l_cpx_3m = true;
+    }
+  }
+  std::cout << "cpx_3m: " << l_cpx_3m << std::endl;
+
+  /*
+   * parse autotune
+   */
+  bool l_autotune = false;
+  if( i_argc > 8 ) {
+    int l_arg_autotune = std::stoi( i_argv[8] );
+    if( l_arg_autotune == 1 ) {
+      l_autotune = true;
+    }
+  }
+  std::cout << "autotune: " << l_autotune << std::endl;
+
+  /*
+   * parse plan_file
+   */
+  std::string l_plan_file = "";
+  if( i_argc > 9 ) {
+    l_plan_file = std::string( i_argv[9] );
+  }
+  std::cout << "plan_file: " << l_plan_file << std::endl;
+
+  /*
+   * parse trace_file
+   */
+  std::string l_trace_file = "";
+  if( i_argc > 10 ) {
+    l_trace_file = std::string( i_argv[10] );
+  }
+  std::cout << "trace_file: " << l_trace_file << std::endl;
+
+  /*
+   * parse memory_budget
+   */
+  int64_t l_memory_budget = 0;
+  if( i_argc > 11 ) {
+    l_memory_budget = std::stoll( i_argv[11] );
+  }
+  std::cout << "memory_budget: " << l_memory_budget << std::endl;
+
+  /*
+   * parse compile_parallel
+   */
+  bool l_compile_parallel = false;
+  if( i_argc > 12 ) {
+    int l_arg_compile_parallel = std::stoi( i_argv[12] );
+    if( l_arg_compile_parallel == 1 ) {
+      l_compile_parallel = true;
+    }
+  }
+  std::cout << "compile_parallel: " << l_compile_parallel << std::endl;
+
   /*
    * assemble einsum_ir data structures
    */
@@ -235,6 +336,36 @@ int main( int     i_argc,
   }
   std::cout << std::endl;
 
+  /*
+   * search contraction path
+   */
+  if( l_path_method != einsum_ir::UNDEFINED_PATH ) {
+    einsum_ir::frontend::PathOptimizer l_path_opt;
+    l_path_opt.init( l_dim_sizes.size(),
+                     l_dim_sizes.data(),
+                     l_num_tensors - 1,
+                     l_string_num_dims.data(),
+                     l_string_dim_ids.data(),
+                     l_dtype_einsum_ir );
+
+    std::chrono::steady_clock::time_point l_tp_path = std::chrono::steady_clock::now();
+    einsum_ir::err_t l_err_path = l_path_opt.optimize( l_path_method,
+                                                       l_path );
+    std::chrono::duration< double > l_dur_path = std::chrono::steady_clock::now() - l_tp_path;
+    if( l_err_path != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to search contraction path" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "searched contraction path: ";
+    for( std::size_t l_co = 0; l_co < l_path.size(); l_co++ ) {
+      std::cout << l_path[l_co] << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "  cost: " << l_path_opt.cost( l_path ) << std::endl;
+    std::cout << "  time (path search): " << l_dur_path.count() << std::endl;
+  }
+
   /*
    * create the tensors' data
    */
@@ -289,6 +420,10 @@ int main( int     i_argc,
                      l_ctype_einsum_ir,
                      l_dtype_einsum_ir,
                      l_data_ptrs.data() );
+  l_einsum_exp.m_cpx_3m = l_cpx_3m;
+  l_einsum_exp.m_autotune = l_autotune;
+  l_einsum_exp.m_memory_budget = l_memory_budget;
+  l_einsum_exp.m_compile_parallel = l_compile_parallel;
 
   l_tp0 = std::chrono::steady_clock::now();
   einsum_ir::err_t l_err = l_einsum_exp.compile();
@@ -301,6 +436,64 @@ int main( int     i_argc,
     return EXIT_FAILURE;
   }
 
+  // compile a second expression from the plan file
+  if( l_plan_file != "" ) {
+    l_err = l_einsum_exp.store_plans( l_plan_file );
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to store plans in " << l_plan_file << std::endl;
+      return EXIT_FAILURE;
+    }
+    einsum_ir::basic::ContractionPlanCache::get_instance()->clear();
+
+    einsum_ir::frontend::EinsumExpression l_einsum_exp_plan;
+    l_einsum_exp_plan.init( l_dim_sizes.size(),
+                            l_dim_sizes.data(),
+                            l_path.size()/2,
+                            l_string_num_dims.data(),
+                            l_string_dim_ids.data(),
+                            l_path.data(),
+                            l_ctype_einsum_ir,
+                            l_dtype_einsum_ir,
+                            l_data_ptrs.data() );
+    l_einsum_exp_plan.m_cpx_3m = l_cpx_3m;
+    l_einsum_exp_plan.m_autotune = l_autotune;
+    l_einsum_exp_plan.m_memory_budget = l_memory_budget;
+    l_einsum_exp_plan.m_compile_parallel = l_compile_parallel;
+
+    l_tp0 = std::chrono::steady_clock::now();
+    l_err = l_einsum_exp_plan.load_plans( l_plan_file );
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    double l_time_load = l_dur.count();
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to load plans from " << l_plan_file << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    l_tp0 = std::chrono::steady_clock::now();
+    l_err = l_einsum_exp_plan.compile();
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    double l_time_compile_plan = l_dur.count();
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to compile einsum_ir expression from plans" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "  time (cold compile):    " << l_time_compile << std::endl;
+    std::cout << "  time (load plans):      " << l_time_load << std::endl;
+    std::cout << "  time (compile w/ plan): " << l_time_compile_plan << std::endl;
+    std::cout << "  plan cache hits:        " << einsum_ir::basic::ContractionPlanCache::get_instance()->get_num_hits() << std::endl;
+    std::cout << "CSV_PLAN_DATA: "
+              << "\"" << l_expression_string_arg << "\","
+              << "\"" << l_dim_sizes_string << "\","
+              << "\"" << l_path_string << "\","
+              << l_time_compile << ","
+              << l_time_load << ","
+              << l_time_compile_plan
+              << std::endl;
+  }
+
   // print einsum tree
   std::string l_tree = "";
   if(    l_print_tree == 1
@@ -363,6 +556,18 @@ int main( int     i_argc,
   std::cout << "  time (eval):    " << l_time_eval << std::endl;
   std::cout << "  gflops (eval):  " << l_gflops_eval << std::endl;
   std::cout << "  gflops (total): " << l_gflops_total << std::endl;
+  std::cout << "  memory (peak):  " << l_einsum_exp.m_memory.get_peak_memory() << std::endl;
+  std::cout << "  memory (bound): " << l_einsum_exp.m_memory.get_lower_bound() << std::endl;
+  if( l_einsum_exp.m_num_slices > 1 ) {
+    std::cout << "  #slices:        " << l_einsum_exp.m_num_slices << std::endl;
+    std::cout << "  sliced dims:    ";
+    for( std::size_t l_sd = 0; l_sd < l_einsum_exp.m_slice_dim_ids.size(); l_sd++ ) {
+      int64_t l_dim_id = l_einsum_exp.m_slice_dim_ids[l_sd];
+      std::cout << l_dim_id << ":" << l_einsum_exp.m_slice_dim_sizes[l_dim_id] << " ";
+    }
+    std::cout << std::endl;
+    std::cout << "  memory (slice): " << l_einsum_exp.estimate_memory( l_einsum_exp.m_slice_dim_sizes ) << std::endl;
+  }
   std::cout << "CSV_DATA: "
             << "einsum_ir,"
             << "\"" << l_expression_string_arg << "\","
@@ -375,6 +580,66 @@ int main( int     i_argc,
             << l_gflops_total
             << std::endl;
 
+  // traced run
+  if( l_trace_file != "" ) {
+    einsum_ir::backend::Tracer l_tracer;
+    l_einsum_exp.set_tracer( &l_tracer );
+    l_tracer.clear();
+    l_einsum_exp.eval();
+    l_einsum_exp.set_tracer( nullptr );
+
+    l_err = l_tracer.store( l_trace_file );
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to write trace to " << l_trace_file << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "  trace:          " << l_trace_file << std::endl;
+  }
+
+  /*
+   * run einsum_ir with inter-op parallel evaluation of independent subtrees
+   */
+  if( !l_einsum_exp.m_inter_op ) {
+    std::cout <<  "\n*** benchmarking einsum_ir (inter-op) ***" << std::endl;
+    double l_time_eval_serial = l_time_eval;
+
+    einsum_ir::frontend::EinsumExpression l_einsum_exp_inter_op;
+    l_einsum_exp_inter_op.init( l_dim_sizes.size(),
+                                l_dim_sizes.data(),
+                                l_path.size()/2,
+                                l_string_num_dims.data(),
+                                l_string_dim_ids.data(),
+                                l_path.data(),
+                                l_ctype_einsum_ir,
+                                l_dtype_einsum_ir,
+                                l_data_ptrs.data() );
+    l_einsum_exp_inter_op.m_cpx_3m = l_cpx_3m;
+    l_einsum_exp_inter_op.m_memory_budget = l_memory_budget;
+    l_einsum_exp_inter_op.m_inter_op = true;
+
+    l_err = l_einsum_exp_inter_op.compile();
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to compile einsum_ir expression with inter-op evaluation" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // warmup run
+    l_einsum_exp_inter_op.eval();
+
+    l_tp0 = std::chrono::steady_clock::now();
+    l_einsum_exp_inter_op.eval();
+    l_tp1 = std::chrono::steady_clock::now();
+    l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+    double l_time_eval_inter_op = l_dur.count();
+
+    std::cout << "  time (eval):    " << l_time_eval_inter_op << std::endl;
+    std::cout << "  gflops (eval):  " << 1.0E-9 * l_num_flops / l_time_eval_inter_op << std::endl;
+    std::cout << "  speedup over serial evaluation: " << l_time_eval_serial / l_time_eval_inter_op << std::endl;
+    if( l_time_eval_inter_op >= l_time_eval_serial ) {
+      std::cerr << "warning: inter-op evaluation is not faster than serial evaluation" << std::endl;
+    }
+  }
+
   /*
    * run at::einsum
    */
@@ -533,7 +798,15 @@ int main( int     i_argc,
     std::cout << "  frobenius norm of difference:                 " << l_frob_diff << std::endl;
     std::cout << "  relative error:                               " << l_err << std::endl;
 
-    double l_tol = (l_dtype_einsum_ir == einsum_ir::FP32) ? 1.0E-5 : 1.0E-12;
+    double l_tol = 1.0E-12;
+    if( l_dtype_einsum_ir == einsum_ir::FP32 ) {
+      l_tol = 1.0E-5;
+    }
+    // intermediate tensors are rounded to 16 bits
+    else if(    l_dtype_einsum_ir == einsum_ir::BF16
+             || l_dtype_einsum_ir == einsum_ir::FP16 ) {
+      l_tol = 5.0E-2;
+    }
 
     if( l_err > l_tol ) {
       std::cerr << "warning: relative error is large!" << std::endl;
@@ -350,6 +350,305 @@ int main( int     i_argc,
             << l_gflops_total
             << std::endl;
 
+  /*
+   * einsum ir with GELU activations
+   */
+  std::cout << "running einsum_ir model with GELU activations (fused bias + GELU epilogue)" << std::endl;
+
+  // bias and GELU are applied to the output tiles while they are in cache
+  std::vector< einsum_ir::epilogue_op > l_epilogue_gelu( 2 );
+  l_epilogue_gelu[0].ktype = einsum_ir::kernel_t::ADD;
+  l_epilogue_gelu[1].ktype = einsum_ir::kernel_t::GELU;
+
+  at::Tensor l_out_gelu = at::rand( { 1152, 10 } );
+
+  int64_t * l_dim_ids_gelu[6] = { l_dim_ids_input,
+                                  l_dim_ids_hidden_0,
+                                  l_dim_ids_hidden_1,
+                                  l_dim_ids_hidden_2,
+                                  l_dim_ids_hidden_3,
+                                  l_dim_ids_out };
+  int64_t * l_dim_ids_weight_gelu[5] = { l_dim_ids_weight_0,
+                                         l_dim_ids_weight_1,
+                                         l_dim_ids_weight_2,
+                                         l_dim_ids_weight_3,
+                                         l_dim_ids_weight_4 };
+
+  einsum_ir::backend::EinsumNode l_nodes_gelu[6];
+  einsum_ir::backend::EinsumNode l_nodes_weight_gelu[5];
+  einsum_ir::backend::MemoryManager l_memory_gelu;
+
+  l_nodes_gelu[0].init( 4,
+                        l_dim_ids_gelu[0],
+                        &l_dim_sizes,
+                        nullptr,
+                        einsum_ir::FP32,
+                        l_data.data_ptr(),
+                        &l_memory_gelu );
+
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_nodes_weight_gelu[l_la].init( l_la < 4 ? 4 : 3,
+                                    l_dim_ids_weight_gelu[l_la],
+                                    &l_dim_sizes,
+                                    nullptr,
+                                    einsum_ir::FP32,
+                                    l_fc_weights[l_la].data_ptr(),
+                                    &l_memory_gelu );
+
+    bool l_hidden = l_la < 4;
+    l_nodes_gelu[l_la+1].init( l_hidden ? 4 : 3,
+                               l_dim_ids_gelu[l_la+1],
+                               &l_dim_sizes,
+                               &l_dim_sizes_aux,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               einsum_ir::FP32,
+                               l_fc_biases[l_la].data_ptr(),
+                               l_hidden ? nullptr : l_out_gelu.data_ptr(),
+                               l_hidden ? einsum_ir::kernel_t::ZERO     : einsum_ir::kernel_t::COPY,
+                               einsum_ir::kernel_t::MADD,
+                               l_hidden ? einsum_ir::kernel_t::EPILOGUE : einsum_ir::kernel_t::UNDEFINED_KTYPE,
+                               &l_nodes_gelu[l_la],
+                               &l_nodes_weight_gelu[l_la],
+                               &l_memory_gelu,
+                               l_num_threads );
+    if( l_hidden ) {
+      l_nodes_gelu[l_la+1].m_epilogue = l_epilogue_gelu;
+    }
+  }
+
+  l_tp0 = std::chrono::steady_clock::now();
+
+  l_err = l_nodes_gelu[5].compile();
+  if( l_err != einsum_ir::SUCCESS ) {
+    std::cerr << "error: failed to compile MLP with GELU activations" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_nodes_weight_gelu[l_la].store_and_lock_data();
+  }
+  if( l_store_and_lock ) {
+    l_nodes_gelu[0].store_and_lock_data();
+  }
+
+  l_tp1 = std::chrono::steady_clock::now();
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  l_time_compile = l_dur.count();
+
+  // warm up
+  l_nodes_gelu[5].eval();
+
+  l_tp0 = std::chrono::steady_clock::now();
+  l_nodes_gelu[5].eval();
+  l_tp1 = std::chrono::steady_clock::now();
+
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  double l_time_eval_gelu_fused = l_dur.count();
+
+  std::cout << "  time (compile): " << l_time_compile << std::endl;
+  std::cout << "  time (eval):    " << l_time_eval_gelu_fused << std::endl;
+  std::cout << "  gflops (eval):  " << 1.0E-9 * l_num_flops / l_time_eval_gelu_fused << std::endl;
+
+  // reference: separate passes over the hidden activations for bias and GELU
+  std::cout << "running ATen model with GELU activations (separate bias + GELU passes)" << std::endl;
+
+  auto l_mlp_gelu_ref = [&]() {
+    at::Tensor l_act = l_data;
+    for( int64_t l_la = 0; l_la < 4; l_la++ ) {
+      l_act = at::matmul( l_act, l_fc_weights[l_la].t() );
+      l_act.add_( l_fc_biases[l_la] );
+      l_act = at::gelu( l_act );
+    }
+    return at::linear( l_act, l_fc_weights[4], l_fc_biases[4] );
+  };
+
+  // warm up
+  at::Tensor l_out_gelu_ref = l_mlp_gelu_ref();
+
+  l_tp0 = std::chrono::steady_clock::now();
+  l_mlp_gelu_ref();
+  l_tp1 = std::chrono::steady_clock::now();
+
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  double l_time_eval_gelu_ref = l_dur.count();
+
+  std::cout << "  time (eval):    " << l_time_eval_gelu_ref << std::endl;
+  std::cout << "  gflops (eval):  " << 1.0E-9 * l_num_flops / l_time_eval_gelu_ref << std::endl;
+  std::cout << "  speedup of the fused epilogue: " << l_time_eval_gelu_ref / l_time_eval_gelu_fused << std::endl;
+  std::cout << "CSV_DATA: "
+            << "einsum_ir_gelu_epilogue,"
+            << "\"" << l_model_path << "\","
+            << l_num_flops << ","
+            << l_time_compile << ","
+            << l_time_eval_gelu_fused << ","
+            << l_time_eval_gelu_ref
+            << std::endl;
+
+  if( !at::allclose( l_out_gelu_ref, l_out_gelu, 1E-3, 1E-4 ) ) {
+    std::cerr << "error: einsum_ir solution with GELU activations is not close to ATen!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  /*
+   * einsum ir with INT8 weights and activations
+   */
+  std::cout << "running einsum_ir model with INT8 weights and activations (INT32 accumulation)" << std::endl;
+
+  // FP32 reference activations calibrate the per-tensor scales of the activations
+  std::vector< at::Tensor > l_acts_ref;
+  l_acts_ref.push_back( l_data );
+  for( int64_t l_la = 0; l_la < 4; l_la++ ) {
+    l_acts_ref.push_back( at::relu( at::linear( l_acts_ref.back(),
+                                                l_fc_weights[l_la],
+                                                l_fc_biases[l_la] ) ) );
+  }
+  at::Tensor l_out_int8_ref = at::linear( l_acts_ref.back(),
+                                          l_fc_weights[4],
+                                          l_fc_biases[4] );
+
+  double l_scales_act[5] = { 0 };
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_scales_act[l_la] = l_acts_ref[l_la].abs().max().item< double >() / 127.0;
+  }
+
+  // symmetric per-tensor quantization
+  auto l_quantize = []( at::Tensor const & i_tensor,
+                        double             i_scale ) {
+    return at::clamp( at::round( i_tensor / i_scale ), -127, 127 ).to( at::ScalarType::Char ).contiguous();
+  };
+
+  at::Tensor l_data_int8 = l_quantize( l_data,
+                                       l_scales_act[0] );
+  std::vector< at::Tensor > l_fc_weights_int8;
+  double l_scales_weight[5] = { 0 };
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_scales_weight[l_la] = l_fc_weights[l_la].abs().max().item< double >() / 127.0;
+    l_fc_weights_int8.push_back( l_quantize( l_fc_weights[l_la],
+                                             l_scales_weight[l_la] ) );
+  }
+
+  at::Tensor l_out_int8 = at::rand( { 1152, 10 } );
+
+  // hidden layers: dequantization, bias, ReLU and requantization in the last touch;
+  // single-child nodes convert the requantized activations to INT8
+  einsum_ir::backend::EinsumNode l_nodes_int8[6];
+  einsum_ir::backend::EinsumNode l_nodes_conv_int8[4];
+  einsum_ir::backend::EinsumNode l_nodes_weight_int8[5];
+  einsum_ir::backend::MemoryManager l_memory_int8;
+  std::vector< einsum_ir::epilogue_op > l_epilogues_int8[5];
+
+  l_nodes_int8[0].init( 4,
+                        l_dim_ids_gelu[0],
+                        &l_dim_sizes,
+                        nullptr,
+                        einsum_ir::INT8,
+                        l_data_int8.data_ptr(),
+                        &l_memory_int8 );
+
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_nodes_weight_int8[l_la].init( l_la < 4 ? 4 : 3,
+                                    l_dim_ids_weight_gelu[l_la],
+                                    &l_dim_sizes,
+                                    nullptr,
+                                    einsum_ir::INT8,
+                                    l_fc_weights_int8[l_la].data_ptr(),
+                                    &l_memory_int8 );
+
+    bool l_hidden = l_la < 4;
+    einsum_ir::backend::EinsumNode * l_input = l_la == 0 ? &l_nodes_int8[0] : &l_nodes_conv_int8[l_la-1];
+
+    l_nodes_int8[l_la+1].init( l_hidden ? 4 : 3,
+                               l_dim_ids_gelu[l_la+1],
+                               &l_dim_sizes,
+                               &l_dim_sizes_aux,
+                               nullptr,
+                               nullptr,
+                               nullptr,
+                               einsum_ir::FP32,
+                               l_fc_biases[l_la].data_ptr(),
+                               l_hidden ? nullptr : l_out_int8.data_ptr(),
+                               einsum_ir::kernel_t::ZERO,
+                               einsum_ir::kernel_t::MADD,
+                               einsum_ir::kernel_t::EPILOGUE,
+                               l_input,
+                               &l_nodes_weight_int8[l_la],
+                               &l_memory_int8,
+                               l_num_threads );
+
+    l_epilogues_int8[l_la].resize( l_hidden ? 4 : 2 );
+    l_epilogues_int8[l_la][0].ktype   = einsum_ir::kernel_t::DEQUANT;
+    l_epilogues_int8[l_la][0].use_aux = false;
+    l_epilogues_int8[l_la][0].scalar  = l_scales_act[l_la] * l_scales_weight[l_la];
+    l_epilogues_int8[l_la][1].ktype   = einsum_ir::kernel_t::ADD;
+    if( l_hidden ) {
+      l_epilogues_int8[l_la][2].ktype   = einsum_ir::kernel_t::RELU;
+      l_epilogues_int8[l_la][3].ktype   = einsum_ir::kernel_t::QUANT;
+      l_epilogues_int8[l_la][3].use_aux = false;
+      l_epilogues_int8[l_la][3].scalar  = 1.0 / l_scales_act[l_la+1];
+
+      l_nodes_conv_int8[l_la].init( 4,
+                                    l_dim_ids_gelu[l_la+1],
+                                    &l_dim_sizes,
+                                    nullptr,
+                                    einsum_ir::INT8,
+                                    nullptr,
+                                    &l_nodes_int8[l_la+1],
+                                    &l_memory_int8,
+                                    l_num_threads );
+    }
+    l_nodes_int8[l_la+1].m_epilogue = l_epilogues_int8[l_la];
+  }
+
+  l_tp0 = std::chrono::steady_clock::now();
+
+  l_err = l_nodes_int8[5].compile();
+  if( l_err != einsum_ir::SUCCESS ) {
+    std::cerr << "error: failed to compile MLP with INT8 weights and activations" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for( int64_t l_la = 0; l_la < 5; l_la++ ) {
+    l_nodes_weight_int8[l_la].store_and_lock_data();
+  }
+  if( l_store_and_lock ) {
+    l_nodes_int8[0].store_and_lock_data();
+  }
+
+  l_tp1 = std::chrono::steady_clock::now();
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  l_time_compile = l_dur.count();
+
+  // warm up
+  l_nodes_int8[5].eval();
+
+  l_tp0 = std::chrono::steady_clock::now();
+  l_nodes_int8[5].eval();
+  l_tp1 = std::chrono::steady_clock::now();
+
+  l_dur = std::chrono::duration_cast< std::chrono::duration< double> >( l_tp1 - l_tp0 );
+  double l_time_eval_int8 = l_dur.count();
+
+  double l_error_int8 = ( l_out_int8 - l_out_int8_ref ).norm().item< double >() / l_out_int8_ref.norm().item< double >();
+
+  std::cout << "  time (compile): " << l_time_compile << std::endl;
+  std::cout << "  time (eval):    " << l_time_eval_int8 << std::endl;
+  std::cout << "  gops (eval):    " << 1.0E-9 * l_num_flops / l_time_eval_int8 << std::endl;
+  std::cout << "  rel. error:     " << l_error_int8 << std::endl;
+  std::cout << "CSV_DATA: "
+            << "einsum_ir_int8,"
+            << "\"" << l_model_path << "\","
+            << l_num_flops << ","
+            << l_time_compile << ","
+            << l_time_eval_int8 << ","
+            << l_error_int8
+            << std::endl;
+
+  // quantization error of 8-bit weights and activations
+  if( l_error_int8 > 5E-2 ) {
+    std::cerr << "error: einsum_ir solution with INT8 weights and activations is not close to ATen!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   /*
    * torchscript model
    */
@@ -4,17 +4,19 @@
 #include <ATen/ATen.h>
 #include "frontend/EinsumTree.h"
 #include "frontend/EinsumTreeAscii.h"
+#include "backend/Tracer.h"
 
 int main( int     i_argc,
           char  * i_argv[] ) {
   if( i_argc < 3 ) {
     std::cerr << "Usage:" << std::endl;
-    std::cerr << "  ./bench_tree einsum_tree dimension_sizes dtype" << std::endl;
+    std::cerr << "  ./bench_tree einsum_tree dimension_sizes dtype trace_file" << std::endl;
     std::cerr << std::endl;
     std::cerr << "Arguments:" << std::endl;
     std::cerr << "  * einsum_tree:      A compiled einsum tree." << std::endl;
     std::cerr << "  * dimension_sizes:  Dimension sizes have to be in ascending order of the dimension ids." << std::endl;
-    std::cerr << "  * dtype:            FP32, FP64, default: FP32." << std::endl;
+    std::cerr << "  * dtype:            FP32, FP64, BF16 or FP16, default: FP32." << std::endl;
+    std::cerr << "  * trace_file:       If set, an additional evaluation is traced and written to the file in the Chrome Trace Event format." << std::endl;
     std::cerr << std::endl;
     std::cerr << "Example:" << std::endl;
     std::cerr << "  ./bench_tree \"[[3,0]->[0,3]],[[3,2,4],[1,4,2]->[1,2,3]]->[0,1,2]\" \"2,3,4,5,6\" FP32" << std::endl;
@@ -75,6 +77,22 @@ int main( int     i_argc,
       l_dtype_at = at::ScalarType::Double;
       l_dtype_einsum_ir = einsum_ir::FP64;
     }
+    else if( l_dtype_arg == "BF16" ){
+      l_dtype_at = at::ScalarType::BFloat16;
+      l_dtype_einsum_ir = einsum_ir::BF16;
+    }
+    else if( l_dtype_arg == "FP16" ){
+      l_dtype_at = at::ScalarType::Half;
+      l_dtype_einsum_ir = einsum_ir::FP16;
+    }
+  }
+
+  /*
+   * parse trace_file
+   */
+  std::string l_trace_file = "";
+  if( i_argc > 4 ) {
+    l_trace_file = std::string( i_argv[4] );
   }
 
   /*
@@ -158,6 +176,8 @@ int main( int     i_argc,
   std::cout << "  time (eval):    " << l_time_eval << std::endl;
   std::cout << "  gflops (eval):  " << l_gflops_eval << std::endl;
   std::cout << "  gflops (total): " << l_gflops_total << std::endl;
+  std::cout << "  memory (peak):  " << l_einsum_tree.m_memory.get_peak_memory() << std::endl;
+  std::cout << "  memory (bound): " << l_einsum_tree.m_memory.get_lower_bound() << std::endl;
   std::cout << "CSV_DATA: "
             << "einsum_ir,"
             << "\"" << l_expression_string_arg << "\","
@@ -168,6 +188,21 @@ int main( int     i_argc,
             << l_gflops_eval << ","
             << l_gflops_total
             << std::endl;
-  
+
+  // traced run
+  if( l_trace_file != "" ) {
+    einsum_ir::backend::Tracer l_tracer;
+    l_einsum_tree.set_tracer( &l_tracer );
+    l_tracer.clear();
+    l_einsum_tree.eval();
+    l_einsum_tree.set_tracer( nullptr );
+
+    l_err = l_tracer.store( l_trace_file );
+    if( l_err != einsum_ir::SUCCESS ) {
+      std::cerr << "error: failed to write trace to " << l_trace_file << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::cout << "  trace:          " << l_trace_file << std::endl;
+  }
 }
 
@@ -2,6 +2,7 @@
 #define EINSUM_IR_CONSTANTS
 
 #include <cstdint>
+#include <vector>
 #include "basic/constants.h"
 
 namespace einsum_ir {
@@ -42,12 +43,20 @@ namespace einsum_ir {
     INVALID_CPX_DIM           =  8,
     INVALID_DTYPE             =  9,
     INVALID_KTYPE             = 10,
+    IO_FAILED                 = 11,
+    INVALID_PATH              = 12,
+    MEMORY_BUDGET_EXCEEDED    = 13,
+    UNEXPECTED_DATA_PTR       = 14,
     UNDEFINED_ERROR           = 99
   } err_t;
 
   typedef enum {
     FP32            = 0,
     FP64            = 1,
+    BF16            = 2, // storage only, computations use FP32
+    FP16            = 3, // storage only, computations use FP32
+    INT8            = 4, // quantized inputs, computations use INT32
+    INT32           = 5, // accumulators of INT8 computations
     UNDEFINED_DTYPE = 99
   } data_t;
 
@@ -74,6 +83,15 @@ namespace einsum_ir {
     BR_MADD         = 12,
     PACKED_MADD     = 13,
     CPX_PACKED_MADD = 14,
+    GELU            = 15,
+    SIGMOID         = 16,
+    TANH            = 17,
+    MUL             = 18,
+    MIN             = 19,
+    MAX             = 20,
+    EPILOGUE        = 21,
+    DEQUANT         = 22,
+    QUANT           = 23,
     UNDEFINED_KTYPE = 99
   } kernel_t;
 
@@ -86,6 +104,50 @@ namespace einsum_ir {
     UNDEFINED_BACKEND = 99
   } backend_t;
 
+  typedef enum {
+    OPENMP             = 0,
+    THREAD_POOL        = 1,
+    UNDEFINED_EXECUTOR = 99
+  } executor_t;
+
+  typedef enum {
+    STATIC             = 0,
+    DYNAMIC            = 1,
+    GUIDED             = 2,
+    UNDEFINED_SCHEDULE = 99
+  } schedule_t;
+
+  typedef enum {
+    GREEDY_PATH        = 0, // contracts the pair with the largest reduction in size first
+    OPTIMAL_PATH       = 1, // dynamic programming over the subsets of the inputs
+    RANDOM_GREEDY_PATH = 2, // best of multiple randomized greedy searches
+    AUTO_PATH          = 3, // optimal for few inputs, randomized greedy otherwise
+    UNDEFINED_PATH     = 99
+  } path_t;
+
+  typedef enum {
+    TRACE_NODE       = 0, // work of a node without its children
+    TRACE_PERMUTE    = 1, // permutation of the node's external data
+    TRACE_CONTRACT   = 2, // binary contraction
+    TRACE_COPY       = 3, // copy or conversion of a single child's data
+    UNDEFINED_TRACE  = 99
+  } trace_t;
+
+  struct epilogue_op {
+    kernel_t ktype   = kernel_t::UNDEFINED_KTYPE; // unary: RELU, GELU, SIGMOID, TANH; binary: ADD, MUL, MIN, MAX, DEQUANT, QUANT
+    bool     use_aux = true;                      // binary ops: true if the auxiliary tensor is the second operand
+    double   scalar  = 0;                         // binary ops: second operand if the auxiliary tensor is not used
+  };
+
+  struct trace_event {
+    int64_t node_id    = -1;                      // id of the node in the rendered einsum tree
+    trace_t phase      = trace_t::UNDEFINED_TRACE;
+    int64_t thread_id  = 0;                       // dense id of the recording thread
+    int64_t time_start = 0;                       // nanoseconds since the start of the trace
+    int64_t time_end   = 0;                       // nanoseconds since the start of the trace
+    int64_t num_ops    = 0;                       // number of operations of the phase
+  };
+
   constexpr basic::dim_t ce_dimt_to_basic( dim_t i_dim ) {
     if(      i_dim == dim_t::C   ) return basic::dim_t::C;
     else if( i_dim == dim_t::M   ) return basic::dim_t::M;
@@ -98,9 +160,13 @@ namespace einsum_ir {
   }
 
   constexpr basic::data_t ce_dtype_to_basic( data_t i_dtype ) {
-    if(      i_dtype == FP32 ) return basic::data_t::FP32;
-    else if( i_dtype == FP64 ) return basic::data_t::FP64;
-    else                       return basic::data_t::UNDEFINED_DTYPE;
+    if(      i_dtype == FP32  ) return basic::data_t::FP32;
+    else if( i_dtype == FP64  ) return basic::data_t::FP64;
+    else if( i_dtype == BF16  ) return basic::data_t::BF16;
+    else if( i_dtype == FP16  ) return basic::data_t::FP16;
+    else if( i_dtype == INT8  ) return basic::data_t::INT8;
+    else if( i_dtype == INT32 ) return basic::data_t::INT32;
+    else                        return basic::data_t::UNDEFINED_DTYPE;
   }
 
   constexpr basic::kernel_t ce_kernelt_to_basic( kernel_t i_ktype ) {
@@ -116,22 +182,66 @@ namespace einsum_ir {
     else if( i_ktype == BR_MADD         ) return basic::kernel_t::BR_MADD;
     else if( i_ktype == PACKED_MADD     ) return basic::kernel_t::PACKED_MADD;
     else if( i_ktype == CPX_PACKED_MADD ) return basic::kernel_t::CPX_PACKED_MADD;
+    else if( i_ktype == GELU            ) return basic::kernel_t::GELU;
+    else if( i_ktype == SIGMOID         ) return basic::kernel_t::SIGMOID;
+    else if( i_ktype == TANH            ) return basic::kernel_t::TANH;
+    else if( i_ktype == MUL             ) return basic::kernel_t::MUL;
+    else if( i_ktype == MIN             ) return basic::kernel_t::MIN;
+    else if( i_ktype == MAX             ) return basic::kernel_t::MAX;
+    else if( i_ktype == EPILOGUE        ) return basic::kernel_t::EPILOGUE;
+    else if( i_ktype == DEQUANT         ) return basic::kernel_t::DEQUANT;
+    else if( i_ktype == QUANT           ) return basic::kernel_t::QUANT;
     else                                  return basic::kernel_t::UNDEFINED_KTYPE;
   }
 
+  inline std::vector< basic::epilogue_op > epilogue_to_basic( std::vector< epilogue_op > const & i_epilogue ) {
+    std::vector< basic::epilogue_op > l_epilogue( i_epilogue.size() );
+    for( std::size_t l_op = 0; l_op < i_epilogue.size(); l_op++ ) {
+      l_epilogue[l_op].ktype   = ce_kernelt_to_basic( i_epilogue[l_op].ktype );
+      l_epilogue[l_op].use_aux = i_epilogue[l_op].use_aux;
+      l_epilogue[l_op].scalar  = i_epilogue[l_op].scalar;
+    }
+    return l_epilogue;
+  }
+
+  constexpr basic::executor_t ce_executor_to_basic( executor_t i_executor ) {
+    if(      i_executor == OPENMP      ) return basic::executor_t::OPENMP;
+    else if( i_executor == THREAD_POOL ) return basic::executor_t::THREAD_POOL;
+    else                                 return basic::executor_t::UNDEFINED_EXECUTOR;
+  }
+
+  constexpr basic::schedule_t ce_schedule_to_basic( schedule_t i_schedule ) {
+    if(      i_schedule == STATIC  ) return basic::schedule_t::STATIC;
+    else if( i_schedule == DYNAMIC ) return basic::schedule_t::DYNAMIC;
+    else if( i_schedule == GUIDED  ) return basic::schedule_t::GUIDED;
+    else                             return basic::schedule_t::UNDEFINED_SCHEDULE;
+  }
+
   constexpr err_t ce_basic_err_to_err( basic::err_t i_err ) {
     if(      i_err == basic::err_t::SUCCESS                   ) return err_t::SUCCESS;
     else if( i_err == basic::err_t::COMPILATION_FAILED        ) return err_t::COMPILATION_FAILED;
     else if( i_err == basic::err_t::INVALID_CPX_DIM           ) return err_t::INVALID_CPX_DIM;
+    else if( i_err == basic::err_t::IO_FAILED                 ) return err_t::IO_FAILED;
     else                                                        return err_t::UNDEFINED_ERROR;
   }
 
   constexpr int64_t ce_n_bytes( data_t i_dtype ) {
     if(      i_dtype == FP32 )  return 4;
     else if( i_dtype == FP64 )  return 8;
+    else if( i_dtype == BF16 )  return 2;
+    else if( i_dtype == FP16 )  return 2;
+    else if( i_dtype == INT8 )  return 1;
+    else if( i_dtype == INT32 ) return 4;
     else                        return -1;
   }
 
+  constexpr data_t ce_dtype_comp( data_t i_dtype ) {
+    if(      i_dtype == BF16 ) return FP32;
+    else if( i_dtype == FP16 ) return FP32;
+    else if( i_dtype == INT8 ) return INT32;
+    else                       return i_dtype;
+  }
+
   constexpr bool ce_cpx_op( kernel_t i_ktype ) {
     if(    i_ktype > kernel_t::CPX_INT_LOW
         && i_ktype < kernel_t::CPX_INT_HIGH ) {
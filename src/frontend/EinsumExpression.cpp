@@ -1,4 +1,8 @@
 #include "EinsumExpression.h"
+#include "PathOptimizer.h"
+#include "../basic/ThreadPool.h"
+#include <algorithm>
+#include <cstring>
 #include <deque>
 #include <set>
 #include <cmath>
@@ -140,7 +144,25 @@ void einsum_ir::frontend::EinsumExpression::init( int64_t                 i_num_
         i_data_ptrs );
 }
 
-einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile_strings() {
+  // derive a contraction path if none was given
+  if( m_path_ext == nullptr ) {
+    PathOptimizer l_path_opt;
+    l_path_opt.init( m_num_dims,
+                     m_dim_sizes,
+                     m_num_conts + 1,
+                     m_string_num_dims_ext,
+                     m_string_dim_ids_ext,
+                     m_dtype );
+
+    err_t l_err = l_path_opt.optimize( m_path_method,
+                                       m_path_opt );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+    m_path_ext = m_path_opt.data();
+  }
+
   // derive contraction path using unqiue tensor ids
   m_path_int.resize( m_num_conts*2 );
   unique_tensor_ids( m_num_conts,
@@ -230,7 +252,52 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
   m_string_dim_ids_int.insert( m_string_dim_ids_int.end(),
                                l_dim_ids_ext_root,
                                l_dim_ids_ext_root + m_string_num_dims_int.back() );
-  l_string_offsets.push_back( m_string_dim_ids_int.size() );
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
+  err_t l_err = compile_strings();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  // number of input tensors
+  int64_t l_num_tensors_in = m_num_conts + 1;
+  // total number of tensors
+  int64_t l_num_tensors    = l_num_tensors_in + 1;
+
+  // derive offsets of the tensors in the internal string
+  std::vector< int64_t > l_string_offsets( m_string_num_dims_int.size() + 1 );
+  l_string_offsets[0] = 0;
+  for( std::size_t l_te = 0; l_te < m_string_num_dims_int.size(); l_te++ ) {
+    l_string_offsets[l_te+1] = l_string_offsets[l_te] + m_string_num_dims_int[l_te];
+  }
+
+#ifdef _OPENMP
+  int64_t l_num_threads = (m_num_threads > 0) ? m_num_threads : omp_get_max_threads();
+#else
+  int64_t l_num_threads = (m_num_threads > 0) ? m_num_threads : 1;
+#endif
+
+  // slice the expression if the memory budget is exceeded
+  m_num_slices = 1;
+  if( m_memory_budget > 0 ) {
+    l_err = plan_slices();
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+
+    if( m_num_slices > 1 ) {
+      l_err = compile_slices( l_num_threads );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+      m_compiled = true;
+
+      return err_t::SUCCESS;
+    }
+  }
 
   /*
    * add nodes
@@ -259,12 +326,6 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
   kernel_t l_ktype_first_touch = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::ZERO : einsum_ir::CPX_ZERO;
   kernel_t l_ktype_main        = (m_ctype_ext == complex_t::REAL_ONLY) ? einsum_ir::MADD : einsum_ir::CPX_MADD;
 
-#ifdef _OPENMP
-  int64_t l_num_threads = omp_get_max_threads();
-#else
-  int64_t l_num_threads = 1;
-#endif
-
   // add internal nodes
   for( int64_t l_co = 0; l_co < m_num_conts-1; l_co++ ) {
     int64_t l_id_left  = m_path_int[l_co*2 + 0];
@@ -291,6 +352,8 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                                          &m_nodes[l_id_right],
                                          &m_memory,
                                          l_num_threads );
+    m_nodes[l_num_tensors_in+l_co].m_cpx_3m = m_cpx_3m;
+    m_nodes[l_num_tensors_in+l_co].m_autotune = m_autotune;
   }
 
   // add root contraction
@@ -317,6 +380,8 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                                                     &m_nodes[l_root_id_right],
                                                     &m_memory,
                                                     l_num_threads );
+  m_nodes[l_num_tensors_in + m_num_conts - 1].m_cpx_3m = m_cpx_3m;
+  m_nodes[l_num_tensors_in + m_num_conts - 1].m_autotune = m_autotune;
 
   // add batch-outer to batch-inner conversion
   if( m_ctype_ext == complex_t::BATCH_INNER ) {
@@ -335,13 +400,543 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile() {
                          l_num_threads );
   }
 
-  err_t l_err = m_nodes.back().compile();
+  m_nodes.back().set_executor( m_executor );
+  if( m_inter_op ) {
+    m_nodes.back().m_inter_op = true;
+  }
+  if( m_compile_parallel ) {
+    m_nodes.back().m_compile_parallel = true;
+  }
+  m_memory.set_resident_budget( m_cache_budget );
+
+  l_err = m_nodes.back().compile();
 
   m_compiled = true;
 
   return l_err;
 }
 
+void einsum_ir::frontend::EinsumExpression::copy_block( int64_t         i_num_dims,
+                                                        int64_t const * i_sizes,
+                                                        int64_t const * i_strides_in,
+                                                        int64_t const * i_strides_out,
+                                                        data_t          i_dtype,
+                                                        bool            i_add,
+                                                        void    const * i_data_in,
+                                                        void          * io_data_out ) {
+  int64_t l_num_bytes = ce_n_bytes( i_dtype );
+  char const * l_data_in  = (char const *) i_data_in;
+  char       * l_data_out = (char       *) io_data_out;
+
+  // innermost dimension or scalar
+  if( i_num_dims <= 1 ) {
+    int64_t l_size       = (i_num_dims == 1) ? i_sizes[0]       : 1;
+    int64_t l_stride_in  = (i_num_dims == 1) ? i_strides_in[0]  : 1;
+    int64_t l_stride_out = (i_num_dims == 1) ? i_strides_out[0] : 1;
+
+    if( i_add == false ) {
+      if( l_stride_in == 1 && l_stride_out == 1 ) {
+        std::memcpy( l_data_out,
+                     l_data_in,
+                     l_size * l_num_bytes );
+      }
+      else {
+        for( int64_t l_en = 0; l_en < l_size; l_en++ ) {
+          std::memcpy( l_data_out + l_en * l_stride_out * l_num_bytes,
+                       l_data_in  + l_en * l_stride_in  * l_num_bytes,
+                       l_num_bytes );
+        }
+      }
+    }
+    else if( i_dtype == data_t::FP32 ) {
+      float const * l_in  = (float const *) l_data_in;
+      float       * l_out = (float       *) l_data_out;
+      for( int64_t l_en = 0; l_en < l_size; l_en++ ) {
+        l_out[l_en * l_stride_out] += l_in[l_en * l_stride_in];
+      }
+    }
+    else if( i_dtype == data_t::FP64 ) {
+      double const * l_in  = (double const *) l_data_in;
+      double       * l_out = (double       *) l_data_out;
+      for( int64_t l_en = 0; l_en < l_size; l_en++ ) {
+        l_out[l_en * l_stride_out] += l_in[l_en * l_stride_in];
+      }
+    }
+    return;
+  }
+
+  for( int64_t l_it = 0; l_it < i_sizes[0]; l_it++ ) {
+    copy_block( i_num_dims - 1,
+                i_sizes + 1,
+                i_strides_in + 1,
+                i_strides_out + 1,
+                i_dtype,
+                i_add,
+                l_data_in  + l_it * i_strides_in[0]  * l_num_bytes,
+                l_data_out + l_it * i_strides_out[0] * l_num_bytes );
+  }
+}
+
+int64_t einsum_ir::frontend::EinsumExpression::estimate_memory( std::vector< int64_t > const & i_dim_sizes ) const {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+  int64_t l_num_bytes = ce_n_bytes( m_dtype );
+
+  // offsets of the tensors in the internal einsum string
+  std::vector< int64_t > l_string_offsets( l_num_tensors_in + m_num_conts + 1, 0 );
+  for( std::size_t l_te = 1; l_te < l_string_offsets.size(); l_te++ ) {
+    l_string_offsets[l_te] = l_string_offsets[l_te-1] + m_string_num_dims_int[l_te-1];
+  }
+
+  // size of a tensor in the internal einsum string
+  auto l_size = [&]( int64_t i_id ) {
+    int64_t l_size_tensor = l_num_bytes;
+    for( int64_t l_di = 0; l_di < m_string_num_dims_int[i_id]; l_di++ ) {
+      l_size_tensor *= i_dim_sizes[ m_string_dim_ids_int[ l_string_offsets[i_id] + l_di ] ];
+    }
+    return l_size_tensor;
+  };
+
+  // sorted dimension ids of a tensor in the internal einsum string
+  auto l_dim_ids_sorted = [&]( int64_t i_id ) {
+    std::vector< int64_t > l_dim_ids( m_string_dim_ids_int.begin() + l_string_offsets[i_id],
+                                      m_string_dim_ids_int.begin() + l_string_offsets[i_id] + m_string_num_dims_int[i_id] );
+    std::sort( l_dim_ids.begin(),
+               l_dim_ids.end() );
+    return l_dim_ids;
+  };
+
+  // intermediate and permuted input tensors in the order of the contraction path
+  backend::MemoryManager l_memory;
+  std::vector< int64_t > l_mem_ids( l_num_tensors_in + m_num_conts, 0 );
+  for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+    int64_t l_id_out = l_num_tensors_in + l_co;
+    std::vector< int64_t > l_dim_ids_out = l_dim_ids_sorted( l_id_out );
+
+    for( int64_t l_ch = 0; l_ch < 2; l_ch++ ) {
+      int64_t l_id_child = m_path_int[l_co*2 + l_ch];
+      int64_t l_id_other = m_path_int[l_co*2 + 1 - l_ch];
+
+      if(    l_id_child < l_num_tensors_in
+          && PathOptimizer::requires_permutation( m_string_num_dims_int[l_id_child],
+                                                  m_string_dim_ids_int.data() + l_string_offsets[l_id_child],
+                                                  l_dim_ids_sorted( l_id_other ),
+                                                  l_dim_ids_out ) ) {
+        l_mem_ids[l_id_child] = l_memory.reserve_memory( l_size( l_id_child ) );
+      }
+    }
+
+    if(    l_co < m_num_conts-1
+        || m_ctype_ext == complex_t::BATCH_INNER ) {
+      l_mem_ids[l_id_out] = l_memory.reserve_memory( l_size( l_id_out ) );
+    }
+
+    for( int64_t l_ch = 0; l_ch < 2; l_ch++ ) {
+      int64_t l_id_child = m_path_int[l_co*2 + l_ch];
+      if( l_mem_ids[l_id_child] ) {
+        l_memory.remove_reservation( l_mem_ids[l_id_child] );
+      }
+    }
+  }
+  l_memory.plan_memory();
+  int64_t l_mem = l_memory.get_peak_memory();
+
+  // buffers of the sliced tensors, the output tensor is always buffered
+  bool l_sliced = false;
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    if( i_dim_sizes[l_di] < m_dim_sizes[l_di] ) {
+      l_sliced = true;
+    }
+  }
+
+  if( l_sliced ) {
+    int64_t l_offset = 0;
+    for( int64_t l_te = 0; l_te < l_num_tensors_in + 1; l_te++ ) {
+      bool l_buffer = (l_te == l_num_tensors_in);
+      int64_t l_size = l_num_bytes;
+      for( int64_t l_di = 0; l_di < m_string_num_dims_ext[l_te]; l_di++ ) {
+        int64_t l_id = m_string_dim_ids_ext[l_offset + l_di];
+        l_size *= i_dim_sizes[l_id];
+        if( i_dim_sizes[l_id] < m_dim_sizes[l_id] ) {
+          l_buffer = true;
+        }
+      }
+      if( l_buffer ) {
+        l_mem += l_size;
+      }
+      l_offset += m_string_num_dims_ext[l_te];
+    }
+  }
+
+  return l_mem;
+}
+
+double einsum_ir::frontend::EinsumExpression::estimate_ops( std::vector< int64_t > const & i_dim_sizes ) const {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  std::vector< int64_t > l_string_offsets( l_num_tensors_in + m_num_conts, 0 );
+  for( std::size_t l_te = 1; l_te < l_string_offsets.size(); l_te++ ) {
+    l_string_offsets[l_te] = l_string_offsets[l_te-1] + m_string_num_dims_int[l_te-1];
+  }
+
+  // operations of a single slice
+  double l_ops = 0;
+  for( int64_t l_co = 0; l_co < m_num_conts; l_co++ ) {
+    std::set< int64_t > l_dim_ids;
+    for( int64_t l_ch = 0; l_ch < 2; l_ch++ ) {
+      int64_t l_id = m_path_int[l_co*2 + l_ch];
+      l_dim_ids.insert( m_string_dim_ids_int.begin() + l_string_offsets[l_id],
+                        m_string_dim_ids_int.begin() + l_string_offsets[l_id] + m_string_num_dims_int[l_id] );
+    }
+
+    double l_ops_cont = 2;
+    for( std::set< int64_t >::iterator l_it = l_dim_ids.begin(); l_it != l_dim_ids.end(); l_it++ ) {
+      l_ops_cont *= i_dim_sizes[*l_it];
+    }
+    l_ops += l_ops_cont;
+  }
+
+  // number of slices
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    l_ops *= m_dim_sizes[l_di] / i_dim_sizes[l_di];
+  }
+
+  return l_ops;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::plan_slices() {
+  int64_t l_num_tensors_in = m_num_conts + 1;
+
+  // dimensions of the output tensor
+  int64_t l_offset_out = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    l_offset_out += m_string_num_dims_ext[l_te];
+  }
+  int64_t l_num_dims_out = m_string_num_dims_ext[l_num_tensors_in];
+  int64_t const * l_dim_ids_out = m_string_dim_ids_ext + l_offset_out;
+
+  std::vector< bool > l_dim_out( m_num_dims, false );
+  for( int64_t l_di = 0; l_di < l_num_dims_out; l_di++ ) {
+    l_dim_out[ l_dim_ids_out[l_di] ] = true;
+  }
+
+  // dimensions which may be sliced
+  bool l_acc = (m_dtype == data_t::FP32) || (m_dtype == data_t::FP64);
+  std::vector< bool > l_sliceable( m_num_dims, true );
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    if( l_dim_out[l_di] == false && l_acc == false ) {
+      l_sliceable[l_di] = false;
+    }
+  }
+  if( l_num_dims_out > 0 ) {
+    if( m_ctype_ext == complex_t::BATCH_INNER ) {
+      l_sliceable[ l_dim_ids_out[l_num_dims_out-1] ] = false;
+    }
+    else if( m_ctype_ext == complex_t::BATCH_OUTER ) {
+      l_sliceable[ l_dim_ids_out[0] ] = false;
+    }
+  }
+
+  // divisors of the dimension sizes in descending order
+  std::vector< std::vector< int64_t > > l_divisors( m_num_dims );
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    for( int64_t l_si = m_dim_sizes[l_di]-1; l_si > 0 && l_sliceable[l_di]; l_si-- ) {
+      if( m_dim_sizes[l_di] % l_si == 0 ) {
+        l_divisors[l_di].push_back( l_si );
+      }
+    }
+  }
+
+  std::vector< int64_t > l_sizes( m_dim_sizes,
+                                  m_dim_sizes + m_num_dims );
+  int64_t l_mem = estimate_memory( l_sizes );
+  double  l_ops = estimate_ops( l_sizes );
+
+  while( l_mem > m_memory_budget ) {
+    int64_t l_best_dim = -1;
+    int64_t l_best_size = 0;
+    int64_t l_best_mem = 0;
+    double  l_best_ops = 0;
+    double  l_best_ratio = 0;
+
+    for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+      // largest slice size which reduces the memory
+      for( std::size_t l_dv = 0; l_dv < l_divisors[l_di].size(); l_dv++ ) {
+        if( l_divisors[l_di][l_dv] >= l_sizes[l_di] ) {
+          continue;
+        }
+
+        std::vector< int64_t > l_sizes_cand = l_sizes;
+        l_sizes_cand[l_di] = l_divisors[l_di][l_dv];
+
+        int64_t l_mem_cand = estimate_memory( l_sizes_cand );
+        if( l_mem_cand < l_mem ) {
+          double l_ops_cand = estimate_ops( l_sizes_cand );
+          double l_ratio = (l_ops_cand - l_ops) / (l_mem - l_mem_cand);
+
+          if(    l_best_dim < 0
+              || l_ratio < l_best_ratio
+              || (l_ratio == l_best_ratio && l_mem_cand < l_best_mem) ) {
+            l_best_dim = l_di;
+            l_best_size = l_sizes_cand[l_di];
+            l_best_mem = l_mem_cand;
+            l_best_ops = l_ops_cand;
+            l_best_ratio = l_ratio;
+          }
+          break;
+        }
+      }
+    }
+
+    if( l_best_dim < 0 ) {
+      return err_t::MEMORY_BUDGET_EXCEEDED;
+    }
+
+    l_sizes[l_best_dim] = l_best_size;
+    l_mem = l_best_mem;
+    l_ops = l_best_ops;
+  }
+
+  // store slicing
+  m_slice_dim_sizes = l_sizes;
+  m_slice_dim_ids.clear();
+  m_slice_accumulate = false;
+  m_num_slices = 1;
+  for( int64_t l_di = 0; l_di < m_num_dims; l_di++ ) {
+    if( l_sizes[l_di] < m_dim_sizes[l_di] ) {
+      m_slice_dim_ids.push_back( l_di );
+      m_num_slices *= m_dim_sizes[l_di] / l_sizes[l_di];
+      if( l_dim_out[l_di] == false ) {
+        m_slice_accumulate = true;
+      }
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::compile_slices( int64_t i_num_threads ) {
+  int64_t l_num_tensors = m_num_conts + 2;
+  int64_t l_num_bytes = ce_n_bytes( m_dtype );
+
+  // number of concurrent slices
+  int64_t l_mem_slice = std::max( estimate_memory( m_slice_dim_sizes ), (int64_t) 1 );
+  int64_t l_num_replicas = std::min( m_num_slices, i_num_threads );
+  l_num_replicas = std::min( l_num_replicas, m_memory_budget / l_mem_slice );
+  l_num_replicas = std::max( l_num_replicas, (int64_t) 1 );
+  int64_t l_num_threads_replica = std::max( i_num_threads / l_num_replicas, (int64_t) 1 );
+
+  m_slices.resize( l_num_replicas );
+  m_slice_data_ptrs.assign( l_num_replicas, std::vector< void * >( l_num_tensors, nullptr ) );
+  m_slice_buffers.assign( l_num_replicas, std::vector< std::vector< char > >( l_num_tensors ) );
+
+  for( int64_t l_re = 0; l_re < l_num_replicas; l_re++ ) {
+    // use buffers for the output tensor and input tensors with sliced dimensions
+    int64_t l_offset = 0;
+    for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+      bool l_buffer = (l_te == l_num_tensors-1);
+      int64_t l_size = l_num_bytes;
+      for( int64_t l_di = 0; l_di < m_string_num_dims_ext[l_te]; l_di++ ) {
+        int64_t l_id = m_string_dim_ids_ext[l_offset + l_di];
+        l_size *= m_slice_dim_sizes[l_id];
+        if( m_slice_dim_sizes[l_id] < m_dim_sizes[l_id] ) {
+          l_buffer = true;
+        }
+      }
+
+      if( l_buffer ) {
+        m_slice_buffers[l_re][l_te].resize( l_size );
+        m_slice_data_ptrs[l_re][l_te] = m_slice_buffers[l_re][l_te].data();
+      }
+      else {
+        m_slice_data_ptrs[l_re][l_te] = m_data_ptrs[l_te];
+      }
+      l_offset += m_string_num_dims_ext[l_te];
+    }
+
+    m_slices[l_re].reset( new EinsumExpression );
+    m_slices[l_re]->init( m_num_dims,
+                          m_slice_dim_sizes.data(),
+                          m_num_conts,
+                          m_string_num_dims_ext,
+                          m_string_dim_ids_ext,
+                          m_path_ext,
+                          m_ctype_ext,
+                          m_dtype,
+                          m_slice_data_ptrs[l_re].data() );
+    m_slices[l_re]->m_cpx_3m = m_cpx_3m;
+    m_slices[l_re]->m_autotune = m_autotune;
+    m_slices[l_re]->m_inter_op = m_inter_op;
+    m_slices[l_re]->m_compile_parallel = m_compile_parallel;
+    m_slices[l_re]->m_num_threads = l_num_threads_replica;
+    // an OpenMP team started by a pinned worker would inherit the worker's core
+    m_slices[l_re]->m_executor = (l_num_replicas > 1) ? executor_t::THREAD_POOL : m_executor;
+
+    err_t l_err = m_slices[l_re]->compile();
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::frontend::EinsumExpression::eval_slices() {
+  int64_t l_num_tensors = m_num_conts + 2;
+  int64_t l_num_slice_dims = m_slice_dim_ids.size();
+  int64_t l_num_replicas = m_slices.size();
+
+  // sizes and strides of the tensors' blocks, strides of the full tensors
+  std::vector< std::vector< int64_t > > l_sizes( l_num_tensors );
+  std::vector< std::vector< int64_t > > l_strides_full( l_num_tensors );
+  std::vector< std::vector< int64_t > > l_strides_slice( l_num_tensors );
+  std::vector< int64_t > l_string_offsets( l_num_tensors, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    if( l_te > 0 ) {
+      l_string_offsets[l_te] = l_string_offsets[l_te-1] + m_string_num_dims_ext[l_te-1];
+    }
+    int64_t l_num_dims = m_string_num_dims_ext[l_te];
+    int64_t const * l_dim_ids = m_string_dim_ids_ext + l_string_offsets[l_te];
+
+    l_sizes[l_te].resize( l_num_dims );
+    l_strides_full[l_te].resize( l_num_dims );
+    l_strides_slice[l_te].resize( l_num_dims );
+
+    int64_t l_stride_full = 1;
+    int64_t l_stride_slice = 1;
+    for( int64_t l_di = l_num_dims-1; l_di >= 0; l_di-- ) {
+      l_sizes[l_te][l_di] = m_slice_dim_sizes[ l_dim_ids[l_di] ];
+      l_strides_full[l_te][l_di] = l_stride_full;
+      l_strides_slice[l_te][l_di] = l_stride_slice;
+      l_stride_full *= m_dim_sizes[ l_dim_ids[l_di] ];
+      l_stride_slice *= l_sizes[l_te][l_di];
+    }
+  }
+
+  // offset of a slice's block in a full tensor
+  auto l_offset = [&]( int64_t i_tensor,
+                       int64_t i_slice ) {
+    // start of the slice in every dimension
+    std::vector< int64_t > l_start( m_num_dims, 0 );
+    for( int64_t l_sd = l_num_slice_dims-1; l_sd >= 0; l_sd-- ) {
+      int64_t l_id = m_slice_dim_ids[l_sd];
+      int64_t l_num_parts = m_dim_sizes[l_id] / m_slice_dim_sizes[l_id];
+      l_start[l_id] = (i_slice % l_num_parts) * m_slice_dim_sizes[l_id];
+      i_slice /= l_num_parts;
+    }
+
+    int64_t l_off = 0;
+    for( int64_t l_di = 0; l_di < m_string_num_dims_ext[i_tensor]; l_di++ ) {
+      int64_t l_id = m_string_dim_ids_ext[ l_string_offsets[i_tensor] + l_di ];
+      l_off += l_start[l_id] * l_strides_full[i_tensor][l_di];
+    }
+
+    return l_off * ce_n_bytes( m_dtype );
+  };
+
+  int64_t l_te_out = l_num_tensors-1;
+
+  // zero the output tensor if slices are accumulated
+  if( m_slice_accumulate ) {
+    int64_t l_size_out = ce_n_bytes( m_dtype );
+    for( int64_t l_di = 0; l_di < m_string_num_dims_ext[l_te_out]; l_di++ ) {
+      l_size_out *= m_dim_sizes[ m_string_dim_ids_ext[ l_string_offsets[l_te_out] + l_di ] ];
+    }
+    std::memset( m_data_ptrs[l_te_out],
+                 0,
+                 l_size_out );
+  }
+
+  for( int64_t l_first = 0; l_first < m_num_slices; l_first += l_num_replicas ) {
+    int64_t l_num_tasks = std::min( l_num_replicas, m_num_slices - l_first );
+
+    basic::ThreadPool::get_instance()->parallel_for( l_num_tasks,
+                                                    [&]( int64_t i_re ) {
+      int64_t l_slice = l_first + i_re;
+
+      // gather the sliced input tensors
+      for( int64_t l_te = 0; l_te < l_num_tensors-1; l_te++ ) {
+        if( m_slice_buffers[i_re][l_te].size() > 0 ) {
+          copy_block( m_string_num_dims_ext[l_te],
+                      l_sizes[l_te].data(),
+                      l_strides_full[l_te].data(),
+                      l_strides_slice[l_te].data(),
+                      m_dtype,
+                      false,
+                      (char const *) m_data_ptrs[l_te] + l_offset( l_te, l_slice ),
+                      m_slice_data_ptrs[i_re][l_te] );
+        }
+      }
+
+      m_slices[i_re]->eval();
+
+      // blocks of the output tensor are disjoint if the slices are not accumulated
+      if( m_slice_accumulate == false ) {
+        copy_block( m_string_num_dims_ext[l_te_out],
+                    l_sizes[l_te_out].data(),
+                    l_strides_slice[l_te_out].data(),
+                    l_strides_full[l_te_out].data(),
+                    m_dtype,
+                    false,
+                    m_slice_data_ptrs[i_re][l_te_out],
+                    (char *) m_data_ptrs[l_te_out] + l_offset( l_te_out, l_slice ) );
+      }
+    } );
+
+    if( m_slice_accumulate ) {
+      for( int64_t l_re = 0; l_re < l_num_tasks; l_re++ ) {
+        copy_block( m_string_num_dims_ext[l_te_out],
+                    l_sizes[l_te_out].data(),
+                    l_strides_slice[l_te_out].data(),
+                    l_strides_full[l_te_out].data(),
+                    m_dtype,
+                    true,
+                    m_slice_data_ptrs[l_re][l_te_out],
+                    (char *) m_data_ptrs[l_te_out] + l_offset( l_te_out, l_first + l_re ) );
+      }
+    }
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_plans( std::string const & i_path ) const {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  if( m_num_slices > 1 ) {
+    return m_slices[0]->store_plans( i_path );
+  }
+
+  std::vector< std::vector< int64_t > > l_keys;
+  std::vector< std::shared_ptr< basic::contraction_plan const > > l_plans;
+  m_nodes.back().get_plans( l_keys,
+                            l_plans );
+
+  return ce_basic_err_to_err( basic::ContractionPlanCache::write( i_path,
+                                                                  l_keys,
+                                                                  l_plans ) );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::load_plans( std::string const & i_path ) {
+  return ce_basic_err_to_err( basic::ContractionPlanCache::get_instance()->load( i_path ) );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::set_tracer( backend::Tracer * i_tracer ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  if( m_num_slices > 1 ) {
+    for( std::size_t l_re = 0; l_re < m_slices.size(); l_re++ ) {
+      m_slices[l_re]->set_tracer( i_tracer );
+    }
+    return err_t::SUCCESS;
+  }
+
+  m_nodes.back().set_tracer( i_tracer );
+
+  return err_t::SUCCESS;
+}
+
 einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_and_lock_data( int64_t i_tensor_id ) {
   if( m_compiled == false ) {
     return err_t::CALLED_BEFORE_COMPILATION;
@@ -350,6 +945,20 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::store_and_lock_data( int
     return err_t::INVALID_ID;
   }
 
+  if( m_num_slices > 1 ) {
+    // tensors with sliced dimensions are gathered from the provided data
+    if( m_slice_data_ptrs[0][i_tensor_id] != m_data_ptrs[i_tensor_id] ) {
+      return err_t::INVALID_ID;
+    }
+    for( std::size_t l_re = 0; l_re < m_slices.size(); l_re++ ) {
+      err_t l_err = m_slices[l_re]->store_and_lock_data( i_tensor_id );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+    return err_t::SUCCESS;
+  }
+
   err_t l_err = m_nodes[i_tensor_id].store_and_lock_data();
 
   return l_err;
@@ -363,17 +972,122 @@ einsum_ir::err_t einsum_ir::frontend::EinsumExpression::unlock_data( int64_t i_t
     return err_t::INVALID_ID;
   }
 
+  if( m_num_slices > 1 ) {
+    // tensors with sliced dimensions are gathered from the provided data
+    if( m_slice_data_ptrs[0][i_tensor_id] != m_data_ptrs[i_tensor_id] ) {
+      return err_t::INVALID_ID;
+    }
+    for( std::size_t l_re = 0; l_re < m_slices.size(); l_re++ ) {
+      err_t l_err = m_slices[l_re]->unlock_data( i_tensor_id );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+    return err_t::SUCCESS;
+  }
+
   err_t l_err = m_nodes[i_tensor_id].unlock_data();
 
   return l_err;
 }
 
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::mark_dirty( int64_t i_tensor_id ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+  else if( !(i_tensor_id < m_num_conts+2) ) {
+    return err_t::INVALID_ID;
+  }
+
+  if( m_num_slices > 1 ) {
+    return err_t::SUCCESS;
+  }
+
+  if( i_tensor_id < m_num_conts+1 ) {
+    m_nodes[i_tensor_id].mark_dirty();
+  }
+  else {
+    m_nodes.back().mark_dirty();
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::set_data_ptrs( void * const * i_data_ptrs ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  int64_t l_num_tensors = m_num_conts + 2;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    if( i_data_ptrs[l_te] == nullptr ) {
+      return err_t::NO_DATA_PTR_PROVIDED;
+    }
+  }
+
+  if( m_num_slices > 1 ) {
+    // tensors with sliced dimensions keep their buffers
+    for( std::size_t l_re = 0; l_re < m_slices.size(); l_re++ ) {
+      for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+        if( m_slice_buffers[l_re][l_te].size() == 0 ) {
+          m_slice_data_ptrs[l_re][l_te] = i_data_ptrs[l_te];
+        }
+      }
+      err_t l_err = m_slices[l_re]->set_data_ptrs( m_slice_data_ptrs[l_re].data() );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+  }
+  else {
+    for( int64_t l_te = 0; l_te < l_num_tensors-1; l_te++ ) {
+      err_t l_err = m_nodes[l_te].set_data_ptr( i_data_ptrs[l_te] );
+      if( l_err != err_t::SUCCESS ) {
+        return l_err;
+      }
+    }
+
+    // root or batch-outer to batch-inner conversion
+    err_t l_err = m_nodes.back().set_data_ptr( i_data_ptrs[l_num_tensors-1] );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  if( i_data_ptrs != m_data_ptrs_bound.data() ) {
+    m_data_ptrs_bound.assign( i_data_ptrs,
+                              i_data_ptrs + l_num_tensors );
+    m_data_ptrs = m_data_ptrs_bound.data();
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumExpression::eval( void * const * i_data_ptrs ) {
+  err_t l_err = set_data_ptrs( i_data_ptrs );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  eval();
+
+  return err_t::SUCCESS;
+}
+
 void einsum_ir::frontend::EinsumExpression::eval() {
-  m_nodes.back().eval();
+  if( m_num_slices > 1 ) {
+    eval_slices();
+  }
+  else {
+    m_nodes.back().eval();
+  }
 }
 
 int64_t einsum_ir::frontend::EinsumExpression::num_ops() {
-  if( m_nodes.size() > 0 ) {
+  if( m_num_slices > 1 ) {
+    return m_slices[0]->num_ops() * m_num_slices;
+  }
+  else if( m_nodes.size() > 0 ) {
     return m_nodes.back().num_ops( true );
   }
   else {
@@ -385,6 +1099,9 @@ std::string einsum_ir::frontend::EinsumExpression::to_string_render() const {
   if( m_compiled == false ) {
     return "Error: Expression not compiled.";
   }
+  if( m_num_slices > 1 ) {
+    return m_slices[0]->to_string_render();
+  }
 
   std::vector< backend::EinsumNode const * > l_nodes;
   std::vector< int64_t > l_pos;
@@ -511,6 +1228,9 @@ std::string einsum_ir::frontend::EinsumExpression::to_string_exchange_format( ba
   if( m_compiled == false ) {
     return "Error: Expression not compiled.";
   }
+  if( m_num_slices > 1 && i_node == nullptr ) {
+    return m_slices[0]->to_string_exchange_format();
+  }
 
   std::string l_str = "";
 
@@ -2,6 +2,7 @@
 #define EINSUM_IR_FRONTEND_EINSUM_EXPRESSION
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include "../backend/EinsumNode.h"
 
@@ -45,13 +46,56 @@ class einsum_ir::frontend::EinsumExpression {
     //! complex type of the external tensors
     complex_t m_ctype_ext = complex_t::UNDEFINED_CTYPE;
 
+    //! true if complex contractions use three real multiplications (3M) instead of four, has to be set before compilation
+    //! 3M saves a quarter of the multiplications but computes the imaginary parts by cancellation,
+    //! i.e., small imaginary parts lose relative accuracy
+    bool m_cpx_3m = false;
+
+    //! true if contractions without an entry in the tuning database are autotuned, has to be set before compilation
+    //! the tuned configurations are stored in the database given by the environment variable EINSUM_IR_TUNING_DB
+    bool m_autotune = false;
+
+    //! true if independent subtrees are evaluated concurrently, has to be set before compilation
+    //! the threads are split between concurrent subtrees by their number of operations
+    //! inter-op parallelism may also be enabled through the environment variable EINSUM_IR_INTER_OP
+    bool m_inter_op = false;
+
+    //! true if independent subtrees are compiled concurrently, has to be set before compilation
+    //! parallel compilation may also be enabled through the environment variable EINSUM_IR_COMPILE_PARALLEL
+    //! subtrees with autotuned contractions are compiled sequentially
+    bool m_compile_parallel = false;
+
+    //! number of threads, 0 uses all available threads, has to be set before compilation
+    int64_t m_num_threads = 0;
+
+    //! executor of the contractions and unary operations, has to be set before compilation
+    //! concurrently evaluated slices use the thread pool since its workers are pinned to cores
+    executor_t m_executor = executor_t::OPENMP;
+
+    //! memory budget in bytes, 0 disables the budget, has to be set before compilation
+    //! if the estimated memory exceeds the budget, dimensions are sliced and the expression is evaluated once per slice
+    int64_t m_memory_budget = 0;
+
+    //! memory budget in bytes of intermediate tensors which are kept between evaluations, has to be set before compilation
+    //! if not 0, evaluations are incremental: only the nodes depending on dirty tensors (see mark_dirty) are recomputed
+    int64_t m_cache_budget = 0;
+
     //! data points of the tensors 
     void * const * m_data_ptrs = nullptr;
 
+    //! data pointers of the tensors which were set after compilation
+    std::vector< void * > m_data_ptrs_bound;
+
     //! external contraction path
     //! tensors are assumed to be removed after every contraction
     int64_t const * m_path_ext = nullptr;
 
+    //! search method of the contraction path if no external path is given, has to be set before compilation
+    path_t m_path_method = path_t::AUTO_PATH;
+
+    //! contraction path derived by the path optimizer if no external path is given
+    std::vector< int64_t > m_path_opt;
+
     //! internal contraction path
     //! tensors are not removed after the contraction, i.e., they have unique ids
     std::vector< int64_t > m_path_int;
@@ -76,6 +120,93 @@ class einsum_ir::frontend::EinsumExpression {
     //! true if the expression was compiled
     bool m_compiled = false;
 
+    //! number of slices, the expression is not sliced if 1
+    int64_t m_num_slices = 1;
+
+    //! true if the slices are accumulated, i.e., a dimension which is not part of the output tensor is sliced
+    bool m_slice_accumulate = false;
+
+    //! ids of the sliced dimensions
+    std::vector< int64_t > m_slice_dim_ids;
+
+    //! sizes of the dimensions within a slice
+    std::vector< int64_t > m_slice_dim_sizes;
+
+    //! expressions evaluating the slices concurrently
+    std::vector< std::unique_ptr< EinsumExpression > > m_slices;
+
+    //! data pointers of the sliced expressions
+    std::vector< std::vector< void * > > m_slice_data_ptrs;
+
+    //! buffers of the sliced tensors, empty for tensors without sliced dimensions
+    std::vector< std::vector< std::vector< char > > > m_slice_buffers;
+
+    /**
+     * Copies or adds a strided block of a tensor.
+     *
+     * @param i_num_dims number of dimensions of the block.
+     * @param i_sizes sizes of the block's dimensions.
+     * @param i_strides_in strides of the input in elements.
+     * @param i_strides_out strides of the output in elements.
+     * @param i_dtype datatype of the tensors, addition supports FP32 and FP64.
+     * @param i_add true if the block is added to the output, false if it is copied.
+     * @param i_data_in input data.
+     * @param io_data_out output data.
+     **/
+    static void copy_block( int64_t         i_num_dims,
+                            int64_t const * i_sizes,
+                            int64_t const * i_strides_in,
+                            int64_t const * i_strides_out,
+                            data_t          i_dtype,
+                            bool            i_add,
+                            void    const * i_data_in,
+                            void          * io_data_out );
+
+    /**
+     * Estimates the memory of an evaluation of the expression for the given dimension sizes.
+     * This includes the intermediate tensors and input tensors which are expected to require a permutation,
+     * planned by their live intervals, and the buffers of sliced tensors.
+     * Requires the internal contraction path and einsum string.
+     *
+     * @param i_dim_sizes sizes of the dimensions.
+     * @return estimated memory in bytes.
+     **/
+    int64_t estimate_memory( std::vector< int64_t > const & i_dim_sizes ) const;
+
+    /**
+     * Estimates the number of operations of all slices for the given dimension sizes.
+     * Requires the internal contraction path and einsum string.
+     *
+     * @param i_dim_sizes sizes of the dimensions within a slice.
+     * @return estimated number of operations.
+     **/
+    double estimate_ops( std::vector< int64_t > const & i_dim_sizes ) const;
+
+    /**
+     * Chooses the sliced dimensions such that the estimated memory fits into the memory budget.
+     * Dimensions are sliced by divisors of their sizes, every step picks the slicing with the fewest
+     * additional operations per saved byte.
+     * Dimensions which are not part of the output tensor are only sliced for FP32 and FP64 tensors,
+     * since the slices have to be accumulated.
+     *
+     * @return SUCCESS if the budget is met, otherwise an appropiate error code.
+     **/
+    err_t plan_slices();
+
+    /**
+     * Compiles the expressions evaluating the slices.
+     * Multiple slices are evaluated concurrently if threads and the memory budget allow it.
+     *
+     * @param i_num_threads number of threads which are shared by the concurrent slices.
+     * @return SUCCESS if successful, error code otherwise.
+     **/
+    err_t compile_slices( int64_t i_num_threads );
+
+    /**
+     * Evaluates the expression slice by slice and assembles the output tensor.
+     **/
+    void eval_slices();
+
     /**
      * Derives a histogram showing how often the dimensions appear in the einsum string.
      *
@@ -140,7 +271,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path, a path is derived by the path optimizer if nullptr.
      * @param i_ctype complex type of all tensors.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
@@ -163,7 +294,7 @@ class einsum_ir::frontend::EinsumExpression {
      * @param i_num_conts number of binary contractions.
      * @param i_string_num_ids sizes of the substrings describing the input tensors and output tensor.
      * @param i_string_dim_ids einsum string containing the dimension ids.
-     * @param i_path contraction path.
+     * @param i_path contraction path, a path is derived by the path optimizer if nullptr.
      * @param i_dtype datatype of all tensors.
      * @param i_data_ptr pointers to the tensor's data.
      **/
@@ -176,14 +307,51 @@ class einsum_ir::frontend::EinsumExpression {
                data_t                  i_dtype,
                void          * const * i_data_ptrs );
 
+    /**
+     * Derives the contraction path, if none was given, and the internal einsum string.
+     * Called by compile, may be called before to inspect the contraction tree.
+     *
+     * @return SUCCESS if successful, otherwise an appropiate error code.
+     **/
+    err_t compile_strings();
+
     /**
      * Compiles the einsum expression. 
      **/
     err_t compile();
 
+    /**
+     * Writes the compiled contraction plans of the expression to a binary file.
+     * Has to be called after compilation.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were written, otherwise an appropiate error code.
+     **/
+    err_t store_plans( std::string const & i_path ) const;
+
+    /**
+     * Reads contraction plans from a binary file into the process-wide plan cache.
+     * Has to be called before compilation, contractions with a plan skip the contraction optimizer.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were read, otherwise an appropiate error code.
+     **/
+    err_t load_plans( std::string const & i_path );
+
+    /**
+     * Sets the tracer which records the evaluation of the expression.
+     * The ids of the traced nodes match the breadth-first order of the rendered einsum tree.
+     * Has to be called after compilation.
+     *
+     * @param i_tracer tracer, nullptr disables tracing.
+     * @return SUCCESS if the tracer was set, otherwise an appropiate error code.
+     **/
+    err_t set_tracer( backend::Tracer * i_tracer );
+
     /**
      * Stores the data of the given tensor internally and locks it.
      * In following execution the stored data is used.
+     * If the expression is sliced, only tensors without sliced dimensions may be locked.
      *
      * @param i_tensor_id id of the the tensor in the einsum string.
      **/
@@ -195,11 +363,39 @@ class einsum_ir::frontend::EinsumExpression {
      **/
     err_t unlock_data( int64_t i_tensor_id );
 
+    /**
+     * Marks a tensor as changed.
+     * In incremental evaluations, only the tensors depending on changed tensors are recomputed.
+     * Setting data pointers and storing or unlocking data marks the affected tensors automatically.
+     * Sliced expressions are always evaluated completely.
+     *
+     * @param i_tensor_id id of the tensor in the einsum string.
+     * @return SUCCESS if the tensor was marked, otherwise an appropiate error code.
+     **/
+    err_t mark_dirty( int64_t i_tensor_id );
+
+    /**
+     * Sets the data pointers of the tensors after compilation.
+     * The compiled kernels and the memory plan are reused, locked tensors keep their stored data.
+     *
+     * @param i_data_ptrs pointers to the tensors' data, ordered as the tensors in the einsum string.
+     * @return SUCCESS if the pointers were set, otherwise an appropiate error code.
+     **/
+    err_t set_data_ptrs( void * const * i_data_ptrs );
+
     /**
      * Evaluates the einsum expression.
      */
     void eval();
 
+    /**
+     * Evaluates the einsum expression on the given data.
+     *
+     * @param i_data_ptrs pointers to the tensors' data, ordered as the tensors in the einsum string.
+     * @return SUCCESS if the expression was evaluated, otherwise an appropiate error code.
+     **/
+    err_t eval( void * const * i_data_ptrs );
+
     /**
      * Gets the number of scalar operations required to evaluate the expression.
      *
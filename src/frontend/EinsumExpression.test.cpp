@@ -59,4 +59,54 @@ TEST_CASE( "Unique contraction path generation.", "[einsum_exp]" ) {
 
   REQUIRE( l_path_unique[4] == 3 );
   REQUIRE( l_path_unique[5] == 5 );
-}
\ No newline at end of file
+}
+
+TEST_CASE( "Copy and addition of strided blocks.", "[einsum_exp]" ) {
+  // 3x4 block at offset (1,2) of a 5x8 tensor
+  double l_tensor[5*8];
+  for( int64_t l_en = 0; l_en < 5*8; l_en++ ) {
+    l_tensor[l_en] = l_en;
+  }
+  double l_block[3*4] = { 0 };
+
+  int64_t l_sizes[2] = { 3, 4 };
+  int64_t l_strides_tensor[2] = { 8, 1 };
+  int64_t l_strides_block[2] = { 4, 1 };
+
+  einsum_ir::frontend::EinsumExpression::copy_block( 2,
+                                                     l_sizes,
+                                                     l_strides_tensor,
+                                                     l_strides_block,
+                                                     einsum_ir::FP64,
+                                                     false,
+                                                     l_tensor + 1*8 + 2,
+                                                     l_block );
+
+  for( int64_t l_m = 0; l_m < 3; l_m++ ) {
+    for( int64_t l_n = 0; l_n < 4; l_n++ ) {
+      REQUIRE( l_block[l_m*4 + l_n] == (l_m+1)*8 + l_n + 2 );
+    }
+  }
+
+  // add the tensor's block to the transposed block
+  double l_block_ref[3*4];
+  for( int64_t l_en = 0; l_en < 3*4; l_en++ ) {
+    l_block_ref[l_en] = l_block[l_en];
+  }
+
+  int64_t l_strides_block_t[2] = { 1, 3 };
+  einsum_ir::frontend::EinsumExpression::copy_block( 2,
+                                                     l_sizes,
+                                                     l_strides_tensor,
+                                                     l_strides_block_t,
+                                                     einsum_ir::FP64,
+                                                     true,
+                                                     l_tensor + 1*8 + 2,
+                                                     l_block );
+
+  for( int64_t l_m = 0; l_m < 3; l_m++ ) {
+    for( int64_t l_n = 0; l_n < 4; l_n++ ) {
+      REQUIRE( l_block[l_n*3 + l_m] == l_block_ref[l_n*3 + l_m] + (l_m+1)*8 + l_n + 2 );
+    }
+  }
+}
@@ -188,6 +188,74 @@ TEST_CASE( "Single batch-inner complex matmul example using an einsum expression
   REQUIRE( l_einsum_exp.num_ops() == 4 * 2*3*4*2 - 2 * 2*3 );
 }
 
+TEST_CASE( "Batch-inner complex tensor contractions with 3M multiplications using an einsum expression through the native interface.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //         ___fdc___
+  //        /         \
+  //     __edc__      fec
+  //    /       \
+  //  eac       adc
+  //
+  // char   id   size
+  //    a    0      5
+  //    c    1      2
+  //    d    2      7
+  //    e    3      8
+  //    f    4      3
+
+  // data
+  at::Tensor l_data_ea = at::randn( {8, 5},
+                                    at::ScalarType::ComplexDouble );
+  at::Tensor l_data_ad = at::randn( {5, 7},
+                                    at::ScalarType::ComplexDouble );
+  at::Tensor l_data_fe = at::randn( {3, 8},
+                                    at::ScalarType::ComplexDouble );
+  at::Tensor l_data_fd = at::randn( {3, 7},
+                                    at::ScalarType::ComplexDouble );
+
+  int64_t l_dim_sizes[5] = { 5, 2, 7, 8, 3 };
+
+  int64_t l_string_dim_ids[12] = { 3, 0, 1,   // eac
+                                   0, 2, 1,   // adc
+                                   4, 3, 1,   // fec
+                                   4, 2, 1 }; // fdc
+
+  int64_t l_string_num_dims[4] = { 3, 3, 3, 3 };
+
+  void * l_data_ptrs[4] = { l_data_ea.data_ptr(),
+                            l_data_ad.data_ptr(),
+                            l_data_fe.data_ptr(),
+                            l_data_fd.data_ptr() };
+
+  int64_t l_path[4] = { 0, 1, 0, 1 };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 5,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::complex_t::BATCH_INNER,
+                     einsum_ir::data_t::FP64,
+                     l_data_ptrs );
+  l_einsum_exp.m_cpx_3m = true;
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  // reference
+  at::Tensor l_data_fd_ref = at::einsum( "ea,ad,fe->fd",
+                                         {l_data_ea, l_data_ad, l_data_fe} );
+
+  // check results
+  REQUIRE( at::allclose( l_data_fd, l_data_fd_ref )  );
+}
+
 TEST_CASE( "Binary contraction representing a sum of small GEMMs.", "[einsum_exp]" ) {
   // test case:
   //
@@ -995,4 +1063,568 @@ TEST_CASE( "Multi-level batch-inner complex einsum expression with additional C
                                                 l_data_dhy } );
 
   REQUIRE( at::allclose( l_data_xhgfeiy_ref, l_data_xhgfeiy ) );
-}
\ No newline at end of file
+}
+TEST_CASE( "Einsum expression with BF16 tensors.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //        ______ad______
+  //       /              \
+  //     ac___            cd
+  //    /     \
+  //   ab     bc
+  //
+  // char   id   size
+  //    a    0     40
+  //    b    1     32
+  //    c    2     48
+  //    d    3     24
+
+  // data
+  at::Tensor l_in_0 = at::randn( {40, 32} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_in_1 = at::randn( {32, 48} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_in_2 = at::randn( {48, 24} ).to( at::ScalarType::BFloat16 );
+  at::Tensor l_out  = at::zeros( {40, 24} ).to( at::ScalarType::BFloat16 );
+
+  int64_t l_dim_sizes[4] = { 40, 32, 48, 24 };
+
+  int64_t l_string_dim_ids[8] = { 0, 1,   // ab
+                                  1, 2,   // bc
+                                  2, 3,   // cd
+                                  0, 3 }; // ad
+
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+
+  void * l_data_ptrs[4] = { l_in_0.data_ptr(),
+                            l_in_1.data_ptr(),
+                            l_in_2.data_ptr(),
+                            l_out.data_ptr() };
+
+  int64_t l_path[4] = { 0, 1,
+                        0, 1 };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 4,
+                     l_dim_sizes,
+                     2,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::BF16,
+                     l_data_ptrs );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+
+  // reference computed in FP32
+  at::Tensor l_out_ref = at::einsum( "ab,bc,cd->ad",
+                                     { l_in_0.to( at::ScalarType::Float ),
+                                       l_in_1.to( at::ScalarType::Float ),
+                                       l_in_2.to( at::ScalarType::Float ) } );
+
+  // check results, the intermediate tensor is stored in BF16
+  double l_err_rel = at::norm( l_out.to( at::ScalarType::Float ) - l_out_ref ).item().toDouble()
+                   / at::norm( l_out_ref ).item().toDouble();
+  REQUIRE( l_err_rel < 1E-2 );
+}
+
+TEST_CASE( "Inter-op parallel evaluation of independent subtrees.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //          ____ae____
+  //         /          \
+  //    ___ac___      ___ce___
+  //   /        \    /        \
+  // ab          bc cd         de
+  //
+  // char   id   size
+  //    a    0     16
+  //    b    1     24
+  //    c    2     32
+  //    d    3     20
+  //    e    4     12
+
+  // data
+  at::Tensor l_data_ab = at::randn( {16, 24} );
+  at::Tensor l_data_bc = at::randn( {24, 32} );
+  at::Tensor l_data_cd = at::randn( {32, 20} );
+  at::Tensor l_data_de = at::randn( {20, 12} );
+  at::Tensor l_data_ae = at::zeros( {16, 12} );
+
+  int64_t l_dim_sizes[5] = { 16, 24, 32, 20, 12 };
+
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[10] = { 0, 1,   // ab
+                                   1, 2,   // bc
+                                   2, 3,   // cd
+                                   3, 4,   // de
+                                   0, 4 }; // ae
+
+  int64_t l_path[6] = { 0, 1,   // ac
+                        0, 1,   // ce
+                        0, 1 }; // ae
+
+  void * l_data_ptrs[5] = { l_data_ab.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_cd.data_ptr(),
+                            l_data_de.data_ptr(),
+                            l_data_ae.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 5,
+                     l_dim_sizes,
+                     3,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+  l_einsum_exp.m_inter_op = true;
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  // the subtrees split the threads and do not share memory
+  einsum_ir::backend::EinsumNode const & l_root = l_einsum_exp.m_nodes.back();
+  if( l_root.m_num_threads > 1 ) {
+    REQUIRE( l_root.m_eval_parallel );
+    REQUIRE( l_root.m_children[0]->m_num_threads + l_root.m_children[1]->m_num_threads == l_root.m_num_threads );
+    REQUIRE( l_root.m_children[0]->m_memory != l_root.m_children[1]->m_memory );
+
+    // the subtrees run on the pinned workers of the thread pool
+    for( int64_t l_ch = 0; l_ch < 2; l_ch++ ) {
+      REQUIRE( l_root.m_children[l_ch]->m_executor == einsum_ir::THREAD_POOL );
+      REQUIRE( l_root.m_children[l_ch]->m_cont->m_executor == einsum_ir::THREAD_POOL );
+    }
+  }
+
+  l_einsum_exp.eval();
+  l_einsum_exp.eval();
+
+  // reference
+  at::Tensor l_data_ae_ref = at::einsum( "ab,bc,cd,de->ae",
+                                         {l_data_ab, l_data_bc, l_data_cd, l_data_de} );
+
+  // check results
+  REQUIRE( at::allclose( l_data_ae, l_data_ae_ref, 1E-4, 1E-4 ) );
+}
+
+TEST_CASE( "Memory-bounded evaluation of an einsum expression through slicing.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //          ____ae____
+  //         /          \
+  //    ___ac___      ___ce___
+  //   /        \    /        \
+  // ab          bc cd         de
+  //
+  // char   id   size
+  //    a    0     16
+  //    b    1     24
+  //    c    2     32
+  //    d    3     20
+  //    e    4     12
+
+  // data
+  at::Tensor l_data_ab = at::randn( {16, 24} );
+  at::Tensor l_data_bc = at::randn( {24, 32} );
+  at::Tensor l_data_cd = at::randn( {32, 20} );
+  at::Tensor l_data_de = at::randn( {20, 12} );
+  at::Tensor l_data_ae = at::randn( {16, 12} );
+
+  int64_t l_dim_sizes[5] = { 16, 24, 32, 20, 12 };
+
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[10] = { 0, 1,   // ab
+                                   1, 2,   // bc
+                                   2, 3,   // cd
+                                   3, 4,   // de
+                                   0, 4 }; // ae
+
+  int64_t l_path[6] = { 0, 1,   // ac
+                        0, 1,   // ce
+                        0, 1 }; // ae
+
+  void * l_data_ptrs[5] = { l_data_ab.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_cd.data_ptr(),
+                            l_data_de.data_ptr(),
+                            l_data_ae.data_ptr() };
+
+  at::Tensor l_data_ae_ref = at::einsum( "ab,bc,cd,de->ae",
+                                         {l_data_ab, l_data_bc, l_data_cd, l_data_de} );
+
+  // budgets which slice kept and contracted dimensions
+  int64_t l_budgets[2] = { 2048, 1024 };
+  for( int64_t l_bu = 0; l_bu < 2; l_bu++ ) {
+    einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+    l_einsum_exp.init( 5,
+                       l_dim_sizes,
+                       3,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       l_path,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    l_einsum_exp.m_memory_budget = l_budgets[l_bu];
+
+    einsum_ir::err_t l_err = l_einsum_exp.compile();
+    REQUIRE( l_err == einsum_ir::SUCCESS );
+    REQUIRE( l_einsum_exp.m_num_slices > 1 );
+    REQUIRE( l_einsum_exp.estimate_memory( l_einsum_exp.m_slice_dim_sizes ) <= l_budgets[l_bu] );
+
+    // concurrent replicas split the threads and run on the thread pool
+    if( l_einsum_exp.m_slices.size() > 1 ) {
+      for( std::size_t l_re = 0; l_re < l_einsum_exp.m_slices.size(); l_re++ ) {
+        REQUIRE( l_einsum_exp.m_slices[l_re]->m_executor == einsum_ir::THREAD_POOL );
+        REQUIRE( l_einsum_exp.m_slices[l_re]->m_nodes.back().m_cont->m_executor == einsum_ir::THREAD_POOL );
+      }
+    }
+
+    l_einsum_exp.eval();
+    l_einsum_exp.eval();
+
+    REQUIRE( at::allclose( l_data_ae, l_data_ae_ref, 1E-4, 1E-4 ) );
+  }
+
+  // budget which may not be met
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+  l_einsum_exp.init( 5,
+                     l_dim_sizes,
+                     3,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+  l_einsum_exp.m_memory_budget = 1;
+
+  REQUIRE( l_einsum_exp.compile() == einsum_ir::MEMORY_BUDGET_EXCEEDED );
+}
+
+TEST_CASE( "Rebinding the data pointers of a compiled einsum expression.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //    ____nm___
+  //   /         \
+  // km           nk
+  //
+  // char   id   size
+  //    m    0     16
+  //    n    1     24
+  //    k    2     32
+
+  at::Tensor l_left_0  = at::randn( {32, 16} );
+  at::Tensor l_right_0 = at::randn( {24, 32} );
+  at::Tensor l_out_0   = at::randn( {24, 16} );
+
+  at::Tensor l_left_1  = at::randn( {32, 16} );
+  at::Tensor l_right_1 = at::randn( {24, 32} );
+  at::Tensor l_out_1   = at::randn( {24, 16} );
+
+  int64_t l_dim_sizes[3] = { 16, 24, 32 };
+
+  int64_t l_string_dim_ids[6] = { 2, 0,   // km
+                                  1, 2,   // nk
+                                  1, 0 }; // nm
+
+  int64_t l_string_num_dims[3] = { 2, 2, 2 };
+
+  void * l_data_ptrs_0[3] = { l_left_0.data_ptr(),
+                              l_right_0.data_ptr(),
+                              l_out_0.data_ptr() };
+
+  void * l_data_ptrs_1[3] = { l_left_1.data_ptr(),
+                              l_right_1.data_ptr(),
+                              l_out_1.data_ptr() };
+
+  int64_t l_path[2] = { 0, 1 };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 3,
+                     l_dim_sizes,
+                     1,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs_0 );
+
+  REQUIRE( l_einsum_exp.set_data_ptrs( l_data_ptrs_1 ) == einsum_ir::CALLED_BEFORE_COMPILATION );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  // the right tensor keeps its stored data
+  REQUIRE( l_einsum_exp.store_and_lock_data( 1 ) == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_out_0, at::einsum( "km,nk->nm", {l_left_0, l_right_0} ), 1E-4, 1E-4 ) );
+
+  REQUIRE( l_einsum_exp.eval( l_data_ptrs_1 ) == einsum_ir::SUCCESS );
+  REQUIRE( at::allclose( l_out_1, at::einsum( "km,nk->nm", {l_left_1, l_right_0} ), 1E-4, 1E-4 ) );
+
+  REQUIRE( l_einsum_exp.unlock_data( 1 ) == einsum_ir::SUCCESS );
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_out_1, at::einsum( "km,nk->nm", {l_left_1, l_right_1} ), 1E-4, 1E-4 ) );
+
+  // all tensors require data
+  l_data_ptrs_1[0] = nullptr;
+  REQUIRE( l_einsum_exp.set_data_ptrs( l_data_ptrs_1 ) == einsum_ir::NO_DATA_PTR_PROVIDED );
+}
+
+TEST_CASE( "Incremental evaluation of an einsum expression.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //          ____ae____
+  //         /          \
+  //     ___ad___        de
+  //    /        \
+  //   ac        cd
+  //  /  \
+  // ab   bc
+  //
+  // char   id   size
+  //    a    0      8
+  //    b    1     12
+  //    c    2     16
+  //    d    3     20
+  //    e    4     24
+
+  at::Tensor l_ab = at::randn( {  8, 12 } );
+  at::Tensor l_bc = at::randn( { 12, 16 } );
+  at::Tensor l_cd = at::randn( { 16, 20 } );
+  at::Tensor l_de = at::randn( { 20, 24 } );
+  at::Tensor l_ae = at::randn( {  8, 24 } );
+
+  int64_t l_dim_sizes[5] = { 8, 12, 16, 20, 24 };
+
+  int64_t l_string_dim_ids[10] = { 0, 1,   // ab
+                                   1, 2,   // bc
+                                   2, 3,   // cd
+                                   3, 4,   // de
+                                   0, 4 }; // ae
+
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+
+  void * l_data_ptrs[5] = { l_ab.data_ptr(),
+                            l_bc.data_ptr(),
+                            l_cd.data_ptr(),
+                            l_de.data_ptr(),
+                            l_ae.data_ptr() };
+
+  int64_t l_path[6] = { 0, 1, 0, 2, 0, 1 };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+  l_einsum_exp.init( 5,
+                     l_dim_sizes,
+                     3,
+                     l_string_num_dims,
+                     l_string_dim_ids,
+                     l_path,
+                     einsum_ir::FP32,
+                     l_data_ptrs );
+
+  // keep all intermediate tensors resident
+  l_einsum_exp.m_cache_budget = 1024*1024;
+
+  REQUIRE( l_einsum_exp.mark_dirty( 0 ) == einsum_ir::CALLED_BEFORE_COMPILATION );
+
+  einsum_ir::err_t l_err = l_einsum_exp.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_ae, at::einsum( "ab,bc,cd,de->ae", {l_ab, l_bc, l_cd, l_de} ), 1E-3, 1E-4 ) );
+
+  // only the root depends on the last input
+  l_de.copy_( at::randn( { 20, 24 } ) );
+  REQUIRE( l_einsum_exp.mark_dirty( 3 ) == einsum_ir::SUCCESS );
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_ae, at::einsum( "ab,bc,cd,de->ae", {l_ab, l_bc, l_cd, l_de} ), 1E-3, 1E-4 ) );
+
+  // the entire path to the root is recomputed
+  l_ab.copy_( at::randn( { 8, 12 } ) );
+  REQUIRE( l_einsum_exp.mark_dirty( 0 ) == einsum_ir::SUCCESS );
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_ae, at::einsum( "ab,bc,cd,de->ae", {l_ab, l_bc, l_cd, l_de} ), 1E-3, 1E-4 ) );
+
+  // rebinding unchanged pointers does not mark the tensors dirty
+  at::Tensor l_ae_ref = l_ae.clone();
+  at::Tensor l_ab_old = l_ab.clone();
+  l_ab.copy_( at::randn( { 8, 12 } ) );
+  REQUIRE( l_einsum_exp.set_data_ptrs( l_data_ptrs ) == einsum_ir::SUCCESS );
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_ae, l_ae_ref ) );
+  REQUIRE( at::allclose( l_ae, at::einsum( "ab,bc,cd,de->ae", {l_ab_old, l_bc, l_cd, l_de} ), 1E-3, 1E-4 ) );
+
+  // a new pointer marks the tensor dirty
+  at::Tensor l_ab_new = at::randn( { 8, 12 } );
+  l_data_ptrs[0] = l_ab_new.data_ptr();
+  REQUIRE( l_einsum_exp.set_data_ptrs( l_data_ptrs ) == einsum_ir::SUCCESS );
+  l_einsum_exp.eval();
+  REQUIRE( at::allclose( l_ae, at::einsum( "ab,bc,cd,de->ae", {l_ab_new, l_bc, l_cd, l_de} ), 1E-3, 1E-4 ) );
+
+  REQUIRE( l_einsum_exp.mark_dirty( 9 ) == einsum_ir::INVALID_ID );
+}
+
+TEST_CASE( "Parallel compilation of independent subtrees.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //          ____ae____
+  //         /          \
+  //    ___ac___      ___ce___
+  //   /        \    /        \
+  // ab          bc cd         de
+  //
+  // char   id   size
+  //    a    0     16
+  //    b    1     24
+  //    c    2     32
+  //    d    3     20
+  //    e    4     12
+
+  // data
+  at::Tensor l_data_ab = at::randn( {16, 24} );
+  at::Tensor l_data_bc = at::randn( {24, 32} );
+  at::Tensor l_data_cd = at::randn( {32, 20} );
+  at::Tensor l_data_de = at::randn( {20, 12} );
+  at::Tensor l_data_ae = at::zeros( {16, 12} );
+
+  int64_t l_dim_sizes[5] = { 16, 24, 32, 20, 12 };
+
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[10] = { 0, 1,   // ab
+                                   1, 2,   // bc
+                                   2, 3,   // cd
+                                   3, 4,   // de
+                                   0, 4 }; // ae
+
+  int64_t l_path[6] = { 0, 1,   // ac
+                        0, 1,   // ce
+                        0, 1 }; // ae
+
+  void * l_data_ptrs[5] = { l_data_ab.data_ptr(),
+                            l_data_bc.data_ptr(),
+                            l_data_cd.data_ptr(),
+                            l_data_de.data_ptr(),
+                            l_data_ae.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_serial;
+  einsum_ir::frontend::EinsumExpression l_einsum_exp_parallel;
+
+  l_einsum_exp_serial.init( 5,
+                            l_dim_sizes,
+                            3,
+                            l_string_num_dims,
+                            l_string_dim_ids,
+                            l_path,
+                            einsum_ir::FP32,
+                            l_data_ptrs );
+
+  l_einsum_exp_parallel.init( 5,
+                              l_dim_sizes,
+                              3,
+                              l_string_num_dims,
+                              l_string_dim_ids,
+                              l_path,
+                              einsum_ir::FP32,
+                              l_data_ptrs );
+  l_einsum_exp_parallel.m_compile_parallel = true;
+
+  REQUIRE( l_einsum_exp_serial.compile() == einsum_ir::SUCCESS );
+  REQUIRE( l_einsum_exp_parallel.compile() == einsum_ir::SUCCESS );
+
+  // the memory plan does not depend on the order of the compilation
+  REQUIRE( l_einsum_exp_parallel.m_memory.get_peak_memory() == l_einsum_exp_serial.m_memory.get_peak_memory() );
+  for( std::size_t l_no = 0; l_no < l_einsum_exp_parallel.m_nodes.size(); l_no++ ) {
+    REQUIRE( l_einsum_exp_parallel.m_nodes[l_no].m_compile_parallel );
+    REQUIRE( l_einsum_exp_parallel.m_nodes[l_no].m_mem_id == l_einsum_exp_serial.m_nodes[l_no].m_mem_id );
+    REQUIRE( l_einsum_exp_parallel.m_nodes[l_no].m_exec_order == l_einsum_exp_serial.m_nodes[l_no].m_exec_order );
+  }
+
+  l_einsum_exp_parallel.eval();
+
+  // reference
+  at::Tensor l_data_ae_ref = at::einsum( "ab,bc,cd,de->ae",
+                                         {l_data_ab, l_data_bc, l_data_cd, l_data_de} );
+
+  // check results
+  REQUIRE( at::allclose( l_data_ae, l_data_ae_ref, 1E-4, 1E-4 ) );
+}
+
+TEST_CASE( "Einsum expression without a given contraction path.", "[einsum_exp]" ) {
+  // test case:
+  //
+  //   ab,bc,cd,de->ae
+  //
+  // char   id   size
+  //    a    0     24
+  //    b    1      4
+  //    c    2     32
+  //    d    3      6
+  //    e    4     20
+
+  // data
+  at::Tensor l_data_ab = at::randn( {24,  4} );
+  at::Tensor l_data_bc = at::randn( { 4, 32} );
+  at::Tensor l_data_cd = at::randn( {32,  6} );
+  at::Tensor l_data_de = at::randn( { 6, 20} );
+
+  int64_t l_dim_sizes[5] = { 24, 4, 32, 6, 20 };
+
+  int64_t l_string_num_dims[5] = { 2, 2, 2, 2, 2 };
+
+  int64_t l_string_dim_ids[10] = { 0, 1,   // ab
+                                   1, 2,   // bc
+                                   2, 3,   // cd
+                                   3, 4,   // de
+                                   0, 4 }; // ae
+
+  // reference
+  at::Tensor l_data_ae_ref = at::einsum( "ab,bc,cd,de->ae",
+                                         {l_data_ab, l_data_bc, l_data_cd, l_data_de} );
+
+  einsum_ir::path_t l_path_methods[4] = { einsum_ir::path_t::GREEDY_PATH,
+                                          einsum_ir::path_t::OPTIMAL_PATH,
+                                          einsum_ir::path_t::RANDOM_GREEDY_PATH,
+                                          einsum_ir::path_t::AUTO_PATH };
+
+  for( int64_t l_me = 0; l_me < 4; l_me++ ) {
+    at::Tensor l_data_ae = at::zeros( {24, 20} );
+
+    void * l_data_ptrs[5] = { l_data_ab.data_ptr(),
+                              l_data_bc.data_ptr(),
+                              l_data_cd.data_ptr(),
+                              l_data_de.data_ptr(),
+                              l_data_ae.data_ptr() };
+
+    einsum_ir::frontend::EinsumExpression l_einsum_exp;
+
+    l_einsum_exp.init( 5,
+                       l_dim_sizes,
+                       3,
+                       l_string_num_dims,
+                       l_string_dim_ids,
+                       nullptr,
+                       einsum_ir::FP32,
+                       l_data_ptrs );
+    l_einsum_exp.m_path_method = l_path_methods[l_me];
+
+    REQUIRE( l_einsum_exp.compile() == einsum_ir::SUCCESS );
+    REQUIRE( l_einsum_exp.m_path_opt.size() == 6 );
+
+    l_einsum_exp.eval();
+
+    // check results
+    REQUIRE( at::allclose( l_data_ae, l_data_ae_ref, 1E-4, 1E-4 ) );
+  }
+}
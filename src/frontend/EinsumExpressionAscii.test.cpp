@@ -92,4 +92,30 @@ TEST_CASE( "Parse dimension ids from an einsum expression with integers as dimen
   REQUIRE( l_map_dim_name_to_id["11"] == 6 );
   REQUIRE( l_map_dim_name_to_id["12"] == 7 );
   REQUIRE( l_map_dim_name_to_id["13"] == 8 );
-}
\ No newline at end of file
+}
+TEST_CASE( "Parse data and complex types from strings.", "[einsum_exp_ascii]" ) {
+  einsum_ir::data_t l_dtype = einsum_ir::UNDEFINED_DTYPE;
+  einsum_ir::complex_t l_ctype = einsum_ir::UNDEFINED_CTYPE;
+
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( "BF16",
+                                                           l_dtype );
+  einsum_ir::frontend::EinsumExpressionAscii::parse_ctype( "BF16",
+                                                           l_ctype );
+  REQUIRE( l_dtype == einsum_ir::BF16 );
+  REQUIRE( l_ctype == einsum_ir::REAL_ONLY );
+
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( "FP16",
+                                                           l_dtype );
+  REQUIRE( l_dtype == einsum_ir::FP16 );
+
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( "CPX_FP64",
+                                                           l_dtype );
+  einsum_ir::frontend::EinsumExpressionAscii::parse_ctype( "CPX_FP64",
+                                                           l_ctype );
+  REQUIRE( l_dtype == einsum_ir::FP64 );
+  REQUIRE( l_ctype == einsum_ir::BATCH_INNER );
+
+  einsum_ir::frontend::EinsumExpressionAscii::parse_dtype( "INT3",
+                                                           l_dtype );
+  REQUIRE( l_dtype == einsum_ir::UNDEFINED_DTYPE );
+}
@@ -0,0 +1,513 @@
+#include "EinsumGraph.h"
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+
+void einsum_ir::frontend::EinsumGraph::canonicalize( EinsumExpression                const & i_expr,
+                                                      std::vector< std::string >            & o_keys,
+                                                      std::vector< std::vector< int64_t > > & o_dim_ids ) {
+  int64_t l_num_tensors_in = i_expr.m_num_conts + 1;
+  int64_t l_num_tensors    = l_num_tensors_in + i_expr.m_num_conts - 1;
+
+  // derive offsets of the tensors in the internal string
+  std::vector< int64_t > l_string_offsets( l_num_tensors + 1 );
+  l_string_offsets[0] = 0;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_string_offsets[l_te+1] = l_string_offsets[l_te] + i_expr.m_string_num_dims_int[l_te];
+  }
+
+  o_keys.resize( l_num_tensors );
+  o_dim_ids.resize( l_num_tensors );
+
+  // inputs are identified by their data, datatype and sizes
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    int64_t const * l_dim_ids = i_expr.m_string_dim_ids_int.data() + l_string_offsets[l_te];
+
+    std::ostringstream l_key;
+    l_key << "T" << reinterpret_cast< std::uintptr_t >( i_expr.m_data_ptrs[l_te] )
+          << ":" << (int64_t) i_expr.m_dtype << "[";
+    for( int64_t l_di = 0; l_di < i_expr.m_string_num_dims_int[l_te]; l_di++ ) {
+      l_key << i_expr.m_dim_sizes[ l_dim_ids[l_di] ] << ",";
+    }
+    l_key << "]";
+
+    o_keys[l_te] = l_key.str();
+    o_dim_ids[l_te].assign( l_dim_ids,
+                            l_dim_ids + i_expr.m_string_num_dims_int[l_te] );
+  }
+
+  // intermediates are identified by their children and the roles of the children's dimensions
+  for( int64_t l_co = 0; l_co < i_expr.m_num_conts-1; l_co++ ) {
+    int64_t l_te = l_num_tensors_in + l_co;
+    int64_t l_id_x = i_expr.m_path_int[l_co*2 + 0];
+    int64_t l_id_y = i_expr.m_path_int[l_co*2 + 1];
+    if( o_keys[l_id_y] < o_keys[l_id_x] ) {
+      std::swap( l_id_x, l_id_y );
+    }
+    std::vector< int64_t > const & l_dim_ids_x = o_dim_ids[l_id_x];
+    std::vector< int64_t > const & l_dim_ids_y = o_dim_ids[l_id_y];
+
+    std::set< int64_t > l_dim_ids_out( i_expr.m_string_dim_ids_int.data() + l_string_offsets[l_te],
+                                       i_expr.m_string_dim_ids_int.data() + l_string_offsets[l_te+1] );
+
+    std::ostringstream l_key;
+    l_key << "(" << o_keys[l_id_x] << "," << o_keys[l_id_y] << ":";
+    o_dim_ids[l_te].clear();
+
+    // dimensions of the first child: position in the second child and if they are kept
+    for( std::size_t l_di = 0; l_di < l_dim_ids_x.size(); l_di++ ) {
+      int64_t l_pos_y = std::find( l_dim_ids_y.begin(),
+                                   l_dim_ids_y.end(),
+                                   l_dim_ids_x[l_di] ) - l_dim_ids_y.begin();
+      if( l_pos_y == (int64_t) l_dim_ids_y.size() ) {
+        l_pos_y = -1;
+      }
+      bool l_kept = l_dim_ids_out.count( l_dim_ids_x[l_di] ) > 0;
+
+      l_key << l_pos_y << (l_kept ? "+" : "-");
+      if( l_kept ) {
+        o_dim_ids[l_te].push_back( l_dim_ids_x[l_di] );
+      }
+    }
+    l_key << ";";
+
+    // remaining dimensions of the second child
+    for( std::size_t l_di = 0; l_di < l_dim_ids_y.size(); l_di++ ) {
+      if( std::find( l_dim_ids_x.begin(),
+                     l_dim_ids_x.end(),
+                     l_dim_ids_y[l_di] ) == l_dim_ids_x.end() ) {
+        bool l_kept = l_dim_ids_out.count( l_dim_ids_y[l_di] ) > 0;
+
+        l_key << (l_kept ? "+" : "-");
+        if( l_kept ) {
+          o_dim_ids[l_te].push_back( l_dim_ids_y[l_di] );
+        }
+      }
+    }
+    l_key << ")";
+
+    o_keys[l_te] = l_key.str();
+  }
+}
+
+void einsum_ir::frontend::EinsumGraph::init( int64_t                    i_num_exprs,
+                                             EinsumExpression * const * i_exprs ) {
+  m_exprs.assign( i_exprs,
+                  i_exprs + i_num_exprs );
+  m_compiled = false;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumGraph::share_subexpressions() {
+  int64_t l_num_exprs = m_exprs.size();
+
+  m_shared_keys.clear();
+  m_shared_sizes.clear();
+  m_stage_num_dims.clear();
+  m_stage_dim_ids.clear();
+  m_stage_paths.clear();
+  m_stage_data_ptrs.clear();
+  m_stage_shared_in.clear();
+  m_stage_shared_out.clear();
+  m_stage_exprs.clear();
+
+  // derive canonical keys of the expressions' tensors
+  std::vector< bool > l_shareable( l_num_exprs );
+  std::vector< std::vector< std::string > > l_keys( l_num_exprs );
+  std::vector< std::vector< std::vector< int64_t > > > l_dim_ids( l_num_exprs );
+
+  for( int64_t l_ex = 0; l_ex < l_num_exprs; l_ex++ ) {
+    EinsumExpression * l_expr = m_exprs[l_ex];
+
+    // complex expressions and expressions without intermediates are evaluated unchanged
+    l_shareable[l_ex] =    l_expr->m_ctype_ext == complex_t::REAL_ONLY
+                        && l_expr->m_num_conts > 1;
+    if( !l_shareable[l_ex] ) {
+      continue;
+    }
+
+    err_t l_err = l_expr->compile_strings();
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+    canonicalize( *l_expr,
+                  l_keys[l_ex],
+                  l_dim_ids[l_ex] );
+  }
+
+  // collect the consumers of the intermediates, i.e., the distinct parents and the operand they are used as
+  std::map< std::string, std::set< std::pair< std::string, int64_t > > > l_consumers;
+  for( int64_t l_ex = 0; l_ex < l_num_exprs; l_ex++ ) {
+    if( !l_shareable[l_ex] ) {
+      continue;
+    }
+    EinsumExpression * l_expr = m_exprs[l_ex];
+    int64_t l_num_tensors_in = l_expr->m_num_conts + 1;
+
+    for( int64_t l_co = 0; l_co < l_expr->m_num_conts; l_co++ ) {
+      std::string l_parent = "root" + std::to_string( l_ex );
+      if( l_co < l_expr->m_num_conts-1 ) {
+        l_parent = l_keys[l_ex][l_num_tensors_in + l_co];
+      }
+
+      int64_t l_ids[2] = { l_expr->m_path_int[l_co*2 + 0],
+                           l_expr->m_path_int[l_co*2 + 1] };
+      if( l_keys[l_ex][ l_ids[1] ] < l_keys[l_ex][ l_ids[0] ] ) {
+        std::swap( l_ids[0], l_ids[1] );
+      }
+
+      for( int64_t l_op = 0; l_op < 2; l_op++ ) {
+        if( l_ids[l_op] >= l_num_tensors_in ) {
+          l_consumers[ l_keys[l_ex][ l_ids[l_op] ] ].insert( {l_parent, l_op} );
+        }
+      }
+    }
+  }
+
+  // intermediates with several consumers are shared, dependencies are discovered first
+  std::map< std::string, int64_t > l_shared_ids;
+  std::vector< std::pair< int64_t, int64_t > > l_shared_reps;
+  for( int64_t l_ex = 0; l_ex < l_num_exprs; l_ex++ ) {
+    if( !l_shareable[l_ex] ) {
+      continue;
+    }
+    EinsumExpression * l_expr = m_exprs[l_ex];
+    int64_t l_num_tensors_in = l_expr->m_num_conts + 1;
+
+    for( int64_t l_co = 0; l_co < l_expr->m_num_conts-1; l_co++ ) {
+      int64_t l_te = l_num_tensors_in + l_co;
+      std::string const & l_key = l_keys[l_ex][l_te];
+
+      if(    l_consumers[l_key].size() > 1
+          && l_shared_ids.count( l_key ) == 0 ) {
+        l_shared_ids.insert( {l_key, (int64_t) m_shared_keys.size()} );
+        l_shared_reps.push_back( {l_ex, l_te} );
+        m_shared_keys.push_back( l_key );
+
+        int64_t l_size = ce_n_bytes( l_expr->m_dtype );
+        for( std::size_t l_di = 0; l_di < l_dim_ids[l_ex][l_te].size(); l_di++ ) {
+          l_size *= l_expr->m_dim_sizes[ l_dim_ids[l_ex][l_te][l_di] ];
+        }
+        m_shared_sizes.push_back( l_size );
+      }
+    }
+  }
+
+  /*
+   * assembles a stage evaluating the subtree of the given tensor,
+   * shared tensors below the subtree's root and the expression's inputs become the stage's inputs
+   */
+  auto l_add_stage = [&]( int64_t                        i_ex,
+                          int64_t                        i_te,
+                          std::vector< int64_t > const & i_dim_ids_out,
+                          void                         * i_data_ptr_out,
+                          int64_t                        i_shared_out ) {
+    EinsumExpression * l_expr = m_exprs[i_ex];
+    int64_t l_num_tensors_in = l_expr->m_num_conts + 1;
+
+    std::vector< int64_t > l_string_offsets( l_num_tensors_in + 1 );
+    l_string_offsets[0] = 0;
+    for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+      l_string_offsets[l_te+1] = l_string_offsets[l_te] + l_expr->m_string_num_dims_int[l_te];
+    }
+
+    std::vector< int64_t > l_stage_num_dims;
+    std::vector< int64_t > l_stage_dim_ids;
+    std::vector< void * > l_data_ptrs;
+    std::vector< int64_t > l_shared_in;
+    // inputs have ids >= 0, the j-th contraction has id -(j+1)
+    std::vector< int64_t > l_conts;
+
+    std::function< int64_t( int64_t, bool ) > l_add_tensor = [&]( int64_t i_te_sub,
+                                                                 bool    i_root ) -> int64_t {
+      if( i_te_sub < l_num_tensors_in ) {
+        int64_t const * l_dim_ids_in = l_expr->m_string_dim_ids_int.data() + l_string_offsets[i_te_sub];
+        l_stage_num_dims.push_back( l_expr->m_string_num_dims_int[i_te_sub] );
+        l_stage_dim_ids.insert( l_stage_dim_ids.end(),
+                                l_dim_ids_in,
+                                l_dim_ids_in + l_stage_num_dims.back() );
+        l_data_ptrs.push_back( l_expr->m_data_ptrs[i_te_sub] );
+        l_shared_in.push_back( -1 );
+
+        return l_stage_num_dims.size() - 1;
+      }
+
+      std::string const & l_key = l_keys[i_ex][i_te_sub];
+      if( !i_root && l_shared_ids.count( l_key ) > 0 ) {
+        l_stage_num_dims.push_back( l_dim_ids[i_ex][i_te_sub].size() );
+        l_stage_dim_ids.insert( l_stage_dim_ids.end(),
+                                l_dim_ids[i_ex][i_te_sub].begin(),
+                                l_dim_ids[i_ex][i_te_sub].end() );
+        l_data_ptrs.push_back( nullptr );
+        l_shared_in.push_back( l_shared_ids.at( l_key ) );
+
+        return l_stage_num_dims.size() - 1;
+      }
+
+      int64_t l_co = i_te_sub - l_num_tensors_in;
+      int64_t l_id_left  = l_add_tensor( l_expr->m_path_int[l_co*2 + 0], false );
+      int64_t l_id_right = l_add_tensor( l_expr->m_path_int[l_co*2 + 1], false );
+      l_conts.push_back( l_id_left );
+      l_conts.push_back( l_id_right );
+
+      return -( (int64_t) l_conts.size() / 2 );
+    };
+    l_add_tensor( i_te, true );
+
+    // translate the contractions to a path which removes the used tensors
+    int64_t l_num_tensors_stage = l_stage_num_dims.size();
+    std::deque< int64_t > l_tensor_ids;
+    for( int64_t l_te = 0; l_te < l_num_tensors_stage; l_te++ ) {
+      l_tensor_ids.push_back( l_te );
+    }
+
+    std::vector< int64_t > l_path;
+    for( std::size_t l_co = 0; l_co < l_conts.size() / 2; l_co++ ) {
+      int64_t l_pos[2] = { 0, 0 };
+      for( int64_t l_op = 0; l_op < 2; l_op++ ) {
+        int64_t l_id = l_conts[l_co*2 + l_op];
+        if( l_id < 0 ) {
+          l_id = l_num_tensors_stage - l_id - 1;
+        }
+        l_pos[l_op] = std::find( l_tensor_ids.begin(),
+                                 l_tensor_ids.end(),
+                                 l_id ) - l_tensor_ids.begin();
+      }
+      l_path.push_back( l_pos[0] );
+      l_path.push_back( l_pos[1] );
+
+      l_tensor_ids.erase( l_tensor_ids.begin() + std::max( l_pos[0], l_pos[1] ) );
+      l_tensor_ids.erase( l_tensor_ids.begin() + std::min( l_pos[0], l_pos[1] ) );
+      l_tensor_ids.push_back( l_num_tensors_stage + l_co );
+    }
+
+    // add output
+    l_stage_num_dims.push_back( i_dim_ids_out.size() );
+    l_stage_dim_ids.insert( l_stage_dim_ids.end(),
+                            i_dim_ids_out.begin(),
+                            i_dim_ids_out.end() );
+    l_data_ptrs.push_back( i_data_ptr_out );
+
+    m_stage_num_dims.push_back( l_stage_num_dims );
+    m_stage_dim_ids.push_back( l_stage_dim_ids );
+    m_stage_paths.push_back( l_path );
+    m_stage_data_ptrs.push_back( l_data_ptrs );
+    m_stage_shared_in.push_back( l_shared_in );
+    m_stage_shared_out.push_back( i_shared_out );
+    m_stage_exprs.push_back( i_ex );
+  };
+
+  // stages of the shared tensors
+  for( std::size_t l_sh = 0; l_sh < l_shared_reps.size(); l_sh++ ) {
+    int64_t l_ex = l_shared_reps[l_sh].first;
+    int64_t l_te = l_shared_reps[l_sh].second;
+
+    l_add_stage( l_ex,
+                 l_te,
+                 l_dim_ids[l_ex][l_te],
+                 nullptr,
+                 l_sh );
+  }
+
+  // stages of the expressions
+  for( int64_t l_ex = 0; l_ex < l_num_exprs; l_ex++ ) {
+    EinsumExpression * l_expr = m_exprs[l_ex];
+    int64_t l_num_tensors = l_expr->m_num_conts + 2;
+
+    if( l_shareable[l_ex] ) {
+      std::vector< int64_t > l_dim_ids_root( l_expr->m_string_dim_ids_int.end() - l_expr->m_string_num_dims_int.back(),
+                                             l_expr->m_string_dim_ids_int.end() );
+
+      l_add_stage( l_ex,
+                   2*l_expr->m_num_conts,
+                   l_dim_ids_root,
+                   l_expr->m_data_ptrs[l_num_tensors-1],
+                   -1 );
+    }
+    else {
+      int64_t l_string_size = 0;
+      for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+        l_string_size += l_expr->m_string_num_dims_ext[l_te];
+      }
+
+      m_stage_num_dims.push_back( std::vector< int64_t >( l_expr->m_string_num_dims_ext,
+                                                          l_expr->m_string_num_dims_ext + l_num_tensors ) );
+      m_stage_dim_ids.push_back( std::vector< int64_t >( l_expr->m_string_dim_ids_ext,
+                                                         l_expr->m_string_dim_ids_ext + l_string_size ) );
+      m_stage_paths.push_back( std::vector< int64_t >() );
+      if( l_expr->m_path_ext != nullptr ) {
+        m_stage_paths.back().assign( l_expr->m_path_ext,
+                                     l_expr->m_path_ext + 2*l_expr->m_num_conts );
+      }
+      m_stage_data_ptrs.push_back( std::vector< void * >( l_expr->m_data_ptrs,
+                                                          l_expr->m_data_ptrs + l_num_tensors ) );
+      m_stage_shared_in.push_back( std::vector< int64_t >( l_num_tensors-1, -1 ) );
+      m_stage_shared_out.push_back( -1 );
+      m_stage_exprs.push_back( l_ex );
+    }
+  }
+
+  // plan the memory of the shared tensors, which are live until their last consumer was evaluated
+  int64_t l_num_shared = m_shared_keys.size();
+  int64_t l_num_stages = m_stage_exprs.size();
+
+  // cached stages may skip their evaluation, i.e., the shared tensors have to keep their data
+  bool l_keep_shared = false;
+  for( int64_t l_ex = 0; l_ex < l_num_exprs; l_ex++ ) {
+    if( m_exprs[l_ex]->m_cache_budget > 0 ) {
+      l_keep_shared = true;
+    }
+  }
+
+  m_count_mem_users.assign( l_num_shared, 0 );
+  for( int64_t l_st = 0; l_st < l_num_stages; l_st++ ) {
+    for( std::size_t l_te = 0; l_te < m_stage_shared_in[l_st].size(); l_te++ ) {
+      if( m_stage_shared_in[l_st][l_te] >= 0 ) {
+        m_count_mem_users[ m_stage_shared_in[l_st][l_te] ]++;
+      }
+    }
+  }
+
+  std::vector< int64_t > l_active_mem_users = m_count_mem_users;
+  m_shared_mem_ids.assign( l_num_shared, 0 );
+  for( int64_t l_st = 0; l_st < l_num_stages; l_st++ ) {
+    int64_t l_sh_out = m_stage_shared_out[l_st];
+    if( l_sh_out >= 0 ) {
+      m_shared_mem_ids[l_sh_out] = m_memory.reserve_memory( m_shared_sizes[l_sh_out] );
+    }
+
+    for( std::size_t l_te = 0; l_te < m_stage_shared_in[l_st].size(); l_te++ ) {
+      int64_t l_sh_in = m_stage_shared_in[l_st][l_te];
+      if( l_sh_in >= 0 ) {
+        l_active_mem_users[l_sh_in]--;
+        if(    l_active_mem_users[l_sh_in] == 0
+            && !l_keep_shared ) {
+          m_memory.remove_reservation( m_shared_mem_ids[l_sh_in] );
+        }
+      }
+    }
+  }
+  m_memory.alloc_all_memory();
+
+  // assign the shared tensors' data
+  for( int64_t l_st = 0; l_st < l_num_stages; l_st++ ) {
+    for( std::size_t l_te = 0; l_te < m_stage_shared_in[l_st].size(); l_te++ ) {
+      int64_t l_sh_in = m_stage_shared_in[l_st][l_te];
+      if( l_sh_in >= 0 ) {
+        m_stage_data_ptrs[l_st][l_te] = m_memory.get_mem_ptr( m_shared_mem_ids[l_sh_in] );
+      }
+    }
+    if( m_stage_shared_out[l_st] >= 0 ) {
+      m_stage_data_ptrs[l_st].back() = m_memory.get_mem_ptr( m_shared_mem_ids[ m_stage_shared_out[l_st] ] );
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumGraph::compile() {
+  err_t l_err = share_subexpressions();
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  int64_t l_num_stages = m_stage_exprs.size();
+  m_stages.resize( l_num_stages );
+
+  for( int64_t l_st = 0; l_st < l_num_stages; l_st++ ) {
+    EinsumExpression const * l_expr = m_exprs[ m_stage_exprs[l_st] ];
+
+    m_stages[l_st].reset( new EinsumExpression );
+    m_stages[l_st]->init( l_expr->m_num_dims,
+                          l_expr->m_dim_sizes,
+                          m_stage_num_dims[l_st].size() - 2,
+                          m_stage_num_dims[l_st].data(),
+                          m_stage_dim_ids[l_st].data(),
+                          m_stage_paths[l_st].size() > 0 ? m_stage_paths[l_st].data() : nullptr,
+                          l_expr->m_ctype_ext,
+                          l_expr->m_dtype,
+                          m_stage_data_ptrs[l_st].data() );
+    m_stages[l_st]->m_cpx_3m           = l_expr->m_cpx_3m;
+    m_stages[l_st]->m_autotune         = l_expr->m_autotune;
+    m_stages[l_st]->m_inter_op         = l_expr->m_inter_op;
+    m_stages[l_st]->m_compile_parallel = l_expr->m_compile_parallel;
+    m_stages[l_st]->m_num_threads      = l_expr->m_num_threads;
+    m_stages[l_st]->m_executor         = l_expr->m_executor;
+    m_stages[l_st]->m_memory_budget    = l_expr->m_memory_budget;
+    m_stages[l_st]->m_cache_budget     = l_expr->m_cache_budget;
+    m_stages[l_st]->m_path_method      = l_expr->m_path_method;
+
+    l_err = m_stages[l_st]->compile();
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  // the first evaluation is complete
+  m_stage_dirty.assign( l_num_stages, true );
+
+  m_compiled = true;
+
+  return err_t::SUCCESS;
+}
+
+void einsum_ir::frontend::EinsumGraph::eval() {
+  for( std::size_t l_st = 0; l_st < m_stages.size(); l_st++ ) {
+    m_stages[l_st]->eval();
+
+    // the consumers of a recomputed shared tensor read changed data
+    int64_t l_sh_out = m_stage_shared_out[l_st];
+    if( m_stage_dirty[l_st] && l_sh_out >= 0 ) {
+      for( std::size_t l_co = l_st+1; l_co < m_stages.size(); l_co++ ) {
+        for( std::size_t l_te = 0; l_te < m_stage_shared_in[l_co].size(); l_te++ ) {
+          if( m_stage_shared_in[l_co][l_te] == l_sh_out ) {
+            m_stages[l_co]->mark_dirty( l_te );
+            m_stage_dirty[l_co] = true;
+          }
+        }
+      }
+    }
+    m_stage_dirty[l_st] = false;
+  }
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumGraph::mark_dirty( int64_t i_expr_id,
+                                                               int64_t i_tensor_id ) {
+  if( m_compiled == false ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+  else if(    !(i_expr_id < (int64_t) m_exprs.size())
+           || !(i_tensor_id < m_exprs[i_expr_id]->m_num_conts+2) ) {
+    return err_t::INVALID_ID;
+  }
+
+  // stages identify the expressions' tensors by their data
+  void * l_data_ptr = m_exprs[i_expr_id]->m_data_ptrs[i_tensor_id];
+  for( std::size_t l_st = 0; l_st < m_stages.size(); l_st++ ) {
+    for( std::size_t l_te = 0; l_te < m_stage_data_ptrs[l_st].size(); l_te++ ) {
+      bool l_external =    l_te + 1 == m_stage_data_ptrs[l_st].size()
+                        || m_stage_shared_in[l_st][l_te] < 0;
+      if(    l_external
+          && m_stage_data_ptrs[l_st][l_te] == l_data_ptr ) {
+        err_t l_err = m_stages[l_st]->mark_dirty( l_te );
+        if( l_err != err_t::SUCCESS ) {
+          return l_err;
+        }
+        m_stage_dirty[l_st] = true;
+      }
+    }
+  }
+
+  return err_t::SUCCESS;
+}
+
+int64_t einsum_ir::frontend::EinsumGraph::num_ops() {
+  int64_t l_num_ops = 0;
+  for( std::size_t l_st = 0; l_st < m_stages.size(); l_st++ ) {
+    l_num_ops += m_stages[l_st]->num_ops();
+  }
+
+  return l_num_ops;
+}
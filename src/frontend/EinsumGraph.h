@@ -0,0 +1,138 @@
+#ifndef EINSUM_IR_FRONTEND_EINSUM_GRAPH
+#define EINSUM_IR_FRONTEND_EINSUM_GRAPH
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "EinsumExpression.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class EinsumGraph;
+  }
+}
+
+/**
+ * Multi-root graph of einsum expressions which share intermediate tensors.
+ * Two intermediates are identical if they contract the same input tensors through the same contractions,
+ * where the dimension ids may be renamed.
+ * Every intermediate which has several consumers is evaluated once by its own stage and written to a shared tensor.
+ * The expressions are rewritten such that they read the shared tensors as inputs.
+ * The shared tensors are planned by the memory manager, i.e., a shared tensor is live until its last consumer was evaluated.
+ * If an expression keeps intermediates between evaluations (cache budget), the shared tensors are live for all evaluations
+ * and changed tensors (see mark_dirty) are propagated from the stages to the consumers of their shared tensors.
+ **/
+class einsum_ir::frontend::EinsumGraph {
+  public:
+    //! expressions of the graph, initialized but not compiled
+    std::vector< EinsumExpression * > m_exprs;
+
+    //! canonical keys of the shared tensors
+    std::vector< std::string > m_shared_keys;
+
+    //! sizes of the shared tensors in bytes
+    std::vector< int64_t > m_shared_sizes;
+
+    //! number of stage inputs which read a shared tensor
+    std::vector< int64_t > m_count_mem_users;
+
+    //! ids of the shared tensors' memory reservations
+    std::vector< int64_t > m_shared_mem_ids;
+
+    //! sizes of the tensors in the stages' einsum strings
+    std::vector< std::vector< int64_t > > m_stage_num_dims;
+
+    //! dimension ids of the stages' einsum strings
+    std::vector< std::vector< int64_t > > m_stage_dim_ids;
+
+    //! contraction paths of the stages
+    std::vector< std::vector< int64_t > > m_stage_paths;
+
+    //! data pointers of the stages' tensors
+    std::vector< std::vector< void * > > m_stage_data_ptrs;
+
+    //! ids of the shared tensors which are read by the stages' input tensors, -1 for external inputs
+    std::vector< std::vector< int64_t > > m_stage_shared_in;
+
+    //! id of the shared tensor written by a stage, -1 if the stage evaluates one of the graph's expressions
+    std::vector< int64_t > m_stage_shared_out;
+
+    //! id of the graph's expression whose settings are used by a stage
+    std::vector< int64_t > m_stage_exprs;
+
+    //! stages in evaluation order: the shared tensors are followed by the rewritten expressions
+    std::vector< std::unique_ptr< EinsumExpression > > m_stages;
+
+    //! true if an input of a stage changed since the stage's last evaluation
+    std::vector< bool > m_stage_dirty;
+
+    //! memory manager of the shared tensors
+    backend::MemoryManager m_memory;
+
+    //! true if the graph was compiled
+    bool m_compiled = false;
+
+    /**
+     * Derives the canonical keys of the input and intermediate tensors of an expression.
+     * Equal keys identify identical tensors, the canonical dimension ids give the renaming of the dimensions.
+     * The expression's internal einsum string has to be derived.
+     *
+     * @param i_expr einsum expression.
+     * @param o_keys will be set to the keys of the tensors, ordered by the unique tensor ids without the root.
+     * @param o_dim_ids will be set to the dimension ids of the tensors in canonical order.
+     **/
+    static void canonicalize( EinsumExpression                const & i_expr,
+                              std::vector< std::string >            & o_keys,
+                              std::vector< std::vector< int64_t > > & o_dim_ids );
+
+    /**
+     * Initializes the graph.
+     *
+     * @param i_num_exprs number of expressions.
+     * @param i_exprs initialized expressions, the graph uses their settings but does not compile them.
+     **/
+    void init( int64_t                    i_num_exprs,
+               EinsumExpression * const * i_exprs );
+
+    /**
+     * Finds the shared intermediate tensors and assembles the stages.
+     * Plans the memory of the shared tensors but does not compile the stages.
+     *
+     * @return SUCCESS if successful, otherwise an appropiate error code.
+     **/
+    err_t share_subexpressions();
+
+    /**
+     * Compiles the graph.
+     *
+     * @return SUCCESS if successful, otherwise an appropiate error code.
+     **/
+    err_t compile();
+
+    /**
+     * Evaluates all expressions of the graph.
+     **/
+    void eval();
+
+    /**
+     * Marks a tensor of one of the graph's expressions as changed.
+     * All stages which read the tensor's data are marked.
+     *
+     * @param i_expr_id id of the expression.
+     * @param i_tensor_id id of the tensor in the expression's einsum string.
+     * @return SUCCESS if the tensor was marked, otherwise an appropiate error code.
+     **/
+    err_t mark_dirty( int64_t i_expr_id,
+                      int64_t i_tensor_id );
+
+    /**
+     * Gets the number of scalar operations required to evaluate the graph.
+     * Shared tensors are counted once.
+     *
+     * @return number of scalar operations.
+     **/
+    int64_t num_ops();
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "EinsumGraph.h"
+
+TEST_CASE( "Canonical keys of renamed tensors.", "[einsum_graph]" ) {
+  using namespace einsum_ir;
+  using namespace einsum_ir::frontend;
+
+  double l_data[3] = { 0 };
+  int64_t l_dim_sizes[4] = { 3, 4, 5, 6 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_path[4] = { 0, 1, 0, 1 };
+
+  // ab,bc,cd->ad
+  int64_t l_string_dim_ids_0[8] = { 0, 1, 1, 2, 2, 3, 0, 3 };
+  void * l_data_ptrs_0[4] = { l_data, l_data+1, l_data+2, nullptr };
+
+  // same contractions with renamed dimensions: dc,cb,ba->da
+  int64_t l_dim_sizes_1[4] = { 6, 5, 4, 3 };
+  int64_t l_string_dim_ids_1[8] = { 3, 2, 2, 1, 1, 0, 3, 0 };
+
+  // different data of the second input
+  void * l_data_ptrs_2[4] = { l_data, l_data+2, l_data+2, nullptr };
+
+  EinsumExpression l_exprs[3];
+  l_exprs[0].init( 4, l_dim_sizes,   2, l_string_num_dims, l_string_dim_ids_0, l_path, FP64, l_data_ptrs_0 );
+  l_exprs[1].init( 4, l_dim_sizes_1, 2, l_string_num_dims, l_string_dim_ids_1, l_path, FP64, l_data_ptrs_0 );
+  l_exprs[2].init( 4, l_dim_sizes,   2, l_string_num_dims, l_string_dim_ids_0, l_path, FP64, l_data_ptrs_2 );
+
+  std::vector< std::string > l_keys[3];
+  std::vector< std::vector< int64_t > > l_dim_ids[3];
+  for( int64_t l_ex = 0; l_ex < 3; l_ex++ ) {
+    REQUIRE( l_exprs[l_ex].compile_strings() == SUCCESS );
+    EinsumGraph::canonicalize( l_exprs[l_ex],
+                               l_keys[l_ex],
+                               l_dim_ids[l_ex] );
+    REQUIRE( l_keys[l_ex].size() == 4 );
+  }
+
+  // ab,bc->ac matches dc,cb->db
+  REQUIRE( l_keys[0][3] == l_keys[1][3] );
+  REQUIRE( l_dim_ids[0][3] == std::vector< int64_t >( { 0, 2 } ) );
+  REQUIRE( l_dim_ids[1][3] == std::vector< int64_t >( { 3, 1 } ) );
+
+  REQUIRE( l_keys[0][3] != l_keys[2][3] );
+  REQUIRE( l_keys[0][2] == l_keys[2][2] );
+}
+
+TEST_CASE( "Sharing of common subexpressions.", "[einsum_graph]" ) {
+  using namespace einsum_ir;
+  using namespace einsum_ir::frontend;
+
+  double l_data[7] = { 0 };
+  int64_t l_dim_sizes[5] = { 2, 3, 4, 5, 6 };
+
+  // ab,bc,cd,de->ae with path ((ab,bc),cd),de
+  int64_t l_string_num_dims_0[5] = { 2, 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_0[10] = { 0, 1, 1, 2, 2, 3, 3, 4, 0, 4 };
+  int64_t l_path_0[6] = { 0, 1, 0, 2, 0, 1 };
+  void * l_data_ptrs_0[5] = { l_data, l_data+1, l_data+2, l_data+3, l_data+4 };
+
+  // ab,bc,cd->ad with path (ab,bc),cd and a different last input
+  int64_t l_string_num_dims_1[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_1[8] = { 0, 1, 1, 2, 2, 3, 0, 3 };
+  int64_t l_path_1[4] = { 0, 1, 0, 1 };
+  void * l_data_ptrs_1[4] = { l_data, l_data+1, l_data+5, l_data+6 };
+
+  EinsumExpression l_exprs[2];
+  l_exprs[0].init( 5, l_dim_sizes, 3, l_string_num_dims_0, l_string_dim_ids_0, l_path_0, FP64, l_data_ptrs_0 );
+  l_exprs[1].init( 4, l_dim_sizes, 2, l_string_num_dims_1, l_string_dim_ids_1, l_path_1, FP64, l_data_ptrs_1 );
+  EinsumExpression * l_expr_ptrs[2] = { l_exprs, l_exprs+1 };
+
+  EinsumGraph l_graph;
+  l_graph.init( 2, l_expr_ptrs );
+  REQUIRE( l_graph.share_subexpressions() == SUCCESS );
+
+  // ab,bc->ac is shared
+  REQUIRE( l_graph.m_shared_keys.size() == 1 );
+  REQUIRE( l_graph.m_shared_sizes[0] == 2*4*8 );
+  REQUIRE( l_graph.m_count_mem_users[0] == 2 );
+
+  REQUIRE( l_graph.m_stage_exprs == std::vector< int64_t >( { 0, 0, 1 } ) );
+  REQUIRE( l_graph.m_stage_shared_out == std::vector< int64_t >( { 0, -1, -1 } ) );
+
+  // shared stage: ab,bc->ac
+  REQUIRE( l_graph.m_stage_num_dims[0] == std::vector< int64_t >( { 2, 2, 2 } ) );
+  REQUIRE( l_graph.m_stage_dim_ids[0] == std::vector< int64_t >( { 0, 1, 1, 2, 0, 2 } ) );
+
+  // first expression: de,cd,ac->ae, the inputs follow the path
+  REQUIRE( l_graph.m_stage_num_dims[1] == std::vector< int64_t >( { 2, 2, 2, 2 } ) );
+  REQUIRE( l_graph.m_stage_dim_ids[1] == std::vector< int64_t >( { 3, 4, 2, 3, 0, 2, 0, 4 } ) );
+  REQUIRE( l_graph.m_stage_paths[1] == std::vector< int64_t >( { 1, 2, 0, 1 } ) );
+  REQUIRE( l_graph.m_stage_shared_in[1] == std::vector< int64_t >( { -1, -1, 0 } ) );
+  REQUIRE( l_graph.m_stage_data_ptrs[1][0] == l_data+3 );
+  REQUIRE( l_graph.m_stage_data_ptrs[1][1] == l_data+2 );
+  REQUIRE( l_graph.m_stage_data_ptrs[1][3] == l_data+4 );
+
+  // second expression: cd,ac->ad
+  REQUIRE( l_graph.m_stage_shared_in[2] == std::vector< int64_t >( { -1, 0 } ) );
+  REQUIRE( l_graph.m_stage_data_ptrs[2][0] == l_data+5 );
+  REQUIRE( l_graph.m_stage_data_ptrs[2][1] == l_graph.m_stage_data_ptrs[0][2] );
+}
@@ -0,0 +1,142 @@
+#include <ATen/ATen.h>
+#include "catch.hpp"
+#include "EinsumGraph.h"
+
+TEST_CASE( "Evaluation of einsum expressions with common subexpressions.", "[einsum_graph]" ) {
+  // test case:
+  //
+  //   expression 0: ab,bc,cd,de->ae with path ((ab,bc),cd),de
+  //   expression 1: wv,xy,yz,zw->xv with path ((xy,yz),zw),wv, i.e., renamed dimensions
+  //   expression 2: ab,bc,cf->af with path (ab,bc),cf
+  //
+  //   shared: ab,bc->ac is consumed by expressions 0/1 and expression 2,
+  //           ac,cd->ad is consumed by expressions 0 and 1
+  at::Tensor l_a = at::randn( { 8, 12 } );
+  at::Tensor l_b = at::randn( { 12, 16 } );
+  at::Tensor l_c = at::randn( { 16, 20 } );
+  at::Tensor l_d = at::randn( { 20, 24 } );
+  at::Tensor l_e = at::randn( { 20, 28 } );
+  at::Tensor l_f = at::randn( { 16, 32 } );
+
+  at::Tensor l_out_0 = at::randn( { 8, 24 } );
+  at::Tensor l_out_1 = at::randn( { 8, 28 } );
+  at::Tensor l_out_2 = at::randn( { 8, 32 } );
+
+  int64_t l_dim_sizes_0[5] = { 8, 12, 16, 20, 24 };
+  int64_t l_string_num_dims_0[5] = { 2, 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_0[10] = { 0, 1, 1, 2, 2, 3, 3, 4, 0, 4 };
+  int64_t l_path_0[6] = { 0, 1, 0, 2, 0, 1 };
+  void * l_data_ptrs_0[5] = { l_a.data_ptr(), l_b.data_ptr(), l_c.data_ptr(), l_d.data_ptr(), l_out_0.data_ptr() };
+
+  // v: 0, w: 1, z: 2, y: 3, x: 4
+  int64_t l_dim_sizes_1[5] = { 28, 20, 16, 12, 8 };
+  int64_t l_string_num_dims_1[5] = { 2, 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_1[10] = { 1, 0, 4, 3, 3, 2, 2, 1, 4, 0 };
+  int64_t l_path_1[6] = { 1, 2, 1, 2, 0, 1 };
+  void * l_data_ptrs_1[5] = { l_e.data_ptr(), l_a.data_ptr(), l_b.data_ptr(), l_c.data_ptr(), l_out_1.data_ptr() };
+
+  int64_t l_dim_sizes_2[4] = { 8, 12, 16, 32 };
+  int64_t l_string_num_dims_2[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_2[8] = { 0, 1, 1, 2, 2, 3, 0, 3 };
+  int64_t l_path_2[4] = { 0, 1, 0, 1 };
+  void * l_data_ptrs_2[4] = { l_a.data_ptr(), l_b.data_ptr(), l_f.data_ptr(), l_out_2.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_exprs[3];
+  l_exprs[0].init( 5, l_dim_sizes_0, 3, l_string_num_dims_0, l_string_dim_ids_0, l_path_0, einsum_ir::FP32, l_data_ptrs_0 );
+  l_exprs[1].init( 5, l_dim_sizes_1, 3, l_string_num_dims_1, l_string_dim_ids_1, l_path_1, einsum_ir::FP32, l_data_ptrs_1 );
+  l_exprs[2].init( 4, l_dim_sizes_2, 2, l_string_num_dims_2, l_string_dim_ids_2, l_path_2, einsum_ir::FP32, l_data_ptrs_2 );
+  einsum_ir::frontend::EinsumExpression * l_expr_ptrs[3] = { l_exprs, l_exprs+1, l_exprs+2 };
+
+  einsum_ir::frontend::EinsumGraph l_graph;
+  l_graph.init( 3,
+                l_expr_ptrs );
+
+  einsum_ir::err_t l_err = l_graph.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+
+  REQUIRE( l_graph.m_shared_keys.size() == 2 );
+  REQUIRE( l_graph.m_stages.size() == 5 );
+  REQUIRE( l_graph.m_count_mem_users[0] == 2 );
+  REQUIRE( l_graph.m_count_mem_users[1] == 2 );
+
+  // every contraction is evaluated once
+  int64_t l_num_ops =   2*8*12*16 - 8*16
+                      + 2*8*16*20 - 8*20
+                      + 2*8*20*24 - 8*24
+                      + 2*8*20*28 - 8*28
+                      + 2*8*16*32 - 8*32;
+  REQUIRE( l_graph.num_ops() == l_num_ops );
+
+  l_graph.eval();
+
+  at::Tensor l_ref_0 = at::einsum( "ab,bc,cd,de->ae", { l_a, l_b, l_c, l_d } );
+  at::Tensor l_ref_1 = at::einsum( "ab,bc,cd,de->ae", { l_a, l_b, l_c, l_e } );
+  at::Tensor l_ref_2 = at::einsum( "ab,bc,cf->af",    { l_a, l_b, l_f } );
+
+  REQUIRE( at::allclose( l_out_0, l_ref_0, 1E-3, 1E-4 ) );
+  REQUIRE( at::allclose( l_out_1, l_ref_1, 1E-3, 1E-4 ) );
+  REQUIRE( at::allclose( l_out_2, l_ref_2, 1E-3, 1E-4 ) );
+}
+
+TEST_CASE( "Incremental evaluation of einsum expressions with common subexpressions.", "[einsum_graph]" ) {
+  // test case:
+  //
+  //   expression 0: ab,bc,cd,de->ae with path ((ab,bc),cd),de
+  //   expression 1: ab,bc,cf->af with path (ab,bc),cf
+  //
+  //   shared: ab,bc->ac
+  at::Tensor l_a = at::randn( { 8, 12 } );
+  at::Tensor l_b = at::randn( { 12, 16 } );
+  at::Tensor l_c = at::randn( { 16, 20 } );
+  at::Tensor l_d = at::randn( { 20, 24 } );
+  at::Tensor l_f = at::randn( { 16, 32 } );
+
+  at::Tensor l_out_0 = at::randn( { 8, 24 } );
+  at::Tensor l_out_1 = at::randn( { 8, 32 } );
+
+  int64_t l_dim_sizes_0[5] = { 8, 12, 16, 20, 24 };
+  int64_t l_string_num_dims_0[5] = { 2, 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_0[10] = { 0, 1, 1, 2, 2, 3, 3, 4, 0, 4 };
+  int64_t l_path_0[6] = { 0, 1, 0, 2, 0, 1 };
+  void * l_data_ptrs_0[5] = { l_a.data_ptr(), l_b.data_ptr(), l_c.data_ptr(), l_d.data_ptr(), l_out_0.data_ptr() };
+
+  int64_t l_dim_sizes_1[4] = { 8, 12, 16, 32 };
+  int64_t l_string_num_dims_1[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids_1[8] = { 0, 1, 1, 2, 2, 3, 0, 3 };
+  int64_t l_path_1[4] = { 0, 1, 0, 1 };
+  void * l_data_ptrs_1[4] = { l_a.data_ptr(), l_b.data_ptr(), l_f.data_ptr(), l_out_1.data_ptr() };
+
+  einsum_ir::frontend::EinsumExpression l_exprs[2];
+  l_exprs[0].init( 5, l_dim_sizes_0, 3, l_string_num_dims_0, l_string_dim_ids_0, l_path_0, einsum_ir::FP32, l_data_ptrs_0 );
+  l_exprs[1].init( 4, l_dim_sizes_1, 2, l_string_num_dims_1, l_string_dim_ids_1, l_path_1, einsum_ir::FP32, l_data_ptrs_1 );
+  l_exprs[0].m_cache_budget = 1024 * 1024;
+  l_exprs[1].m_cache_budget = 1024 * 1024;
+  einsum_ir::frontend::EinsumExpression * l_expr_ptrs[2] = { l_exprs, l_exprs+1 };
+
+  einsum_ir::frontend::EinsumGraph l_graph;
+  l_graph.init( 2,
+                l_expr_ptrs );
+
+  einsum_ir::err_t l_err = l_graph.compile();
+  REQUIRE( l_err == einsum_ir::SUCCESS );
+  REQUIRE( l_graph.m_shared_keys.size() == 1 );
+
+  l_graph.eval();
+
+  // changes of an expression's input are propagated through the shared tensor
+  l_c.copy_( at::randn( { 16, 20 } ) );
+  l_f.copy_( at::randn( { 16, 32 } ) );
+  REQUIRE( l_graph.mark_dirty( 0, 2 ) == einsum_ir::SUCCESS );
+  REQUIRE( l_graph.mark_dirty( 1, 2 ) == einsum_ir::SUCCESS );
+  l_graph.eval();
+
+  REQUIRE( at::allclose( l_out_0, at::einsum( "ab,bc,cd,de->ae", { l_a, l_b, l_c, l_d } ), 1E-3, 1E-4 ) );
+  REQUIRE( at::allclose( l_out_1, at::einsum( "ab,bc,cf->af",    { l_a, l_b, l_f } ),      1E-3, 1E-4 ) );
+
+  l_a.copy_( at::randn( { 8, 12 } ) );
+  REQUIRE( l_graph.mark_dirty( 1, 0 ) == einsum_ir::SUCCESS );
+  l_graph.eval();
+
+  REQUIRE( at::allclose( l_out_0, at::einsum( "ab,bc,cd,de->ae", { l_a, l_b, l_c, l_d } ), 1E-3, 1E-4 ) );
+  REQUIRE( at::allclose( l_out_1, at::einsum( "ab,bc,cf->af",    { l_a, l_b, l_f } ),      1E-3, 1E-4 ) );
+}
@@ -86,6 +86,14 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
     }
   }
   
+  if( m_inter_op ) {
+    m_nodes.back().m_inter_op = true;
+  }
+  if( m_compile_parallel ) {
+    m_nodes.back().m_compile_parallel = true;
+  }
+  m_memory.set_resident_budget( m_cache_budget );
+
   //compile all nodes
   l_err = m_nodes.back().compile();
   if( l_err != einsum_ir::SUCCESS ) {
@@ -95,10 +103,84 @@ einsum_ir::err_t einsum_ir::frontend::EinsumTree::compile() {
   return einsum_ir::SUCCESS;
 }
 
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::store_plans( std::string const & i_path ) const {
+  if( m_nodes.size() == 0 ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  std::vector< std::vector< int64_t > > l_keys;
+  std::vector< std::shared_ptr< basic::contraction_plan const > > l_plans;
+  m_nodes.back().get_plans( l_keys,
+                            l_plans );
+
+  return ce_basic_err_to_err( basic::ContractionPlanCache::write( i_path,
+                                                                  l_keys,
+                                                                  l_plans ) );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::load_plans( std::string const & i_path ) {
+  return ce_basic_err_to_err( basic::ContractionPlanCache::get_instance()->load( i_path ) );
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::set_tracer( backend::Tracer * i_tracer ) {
+  if( m_nodes.size() == 0 ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  m_nodes.back().set_tracer( i_tracer );
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::mark_dirty( int64_t i_tensor_id ) {
+  if( m_nodes.size() == 0 ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+  else if( i_tensor_id < 0 || i_tensor_id >= (int64_t) m_nodes.size() ) {
+    return err_t::INVALID_ID;
+  }
+
+  m_nodes[i_tensor_id].mark_dirty();
+
+  return err_t::SUCCESS;
+}
+
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::set_data_ptrs( void * const * i_data_ptrs ) {
+  if( m_nodes.size() == 0 ) {
+    return err_t::CALLED_BEFORE_COMPILATION;
+  }
+
+  for( std::size_t l_no = 0; l_no < m_nodes.size(); l_no++ ) {
+    err_t l_err = m_nodes[l_no].set_data_ptr( i_data_ptrs[l_no] );
+    if( l_err != err_t::SUCCESS ) {
+      return l_err;
+    }
+  }
+
+  if( i_data_ptrs != m_data_ptrs_bound.data() ) {
+    m_data_ptrs_bound.assign( i_data_ptrs,
+                              i_data_ptrs + m_nodes.size() );
+    m_data_ptrs = m_data_ptrs_bound.data();
+  }
+
+  return err_t::SUCCESS;
+}
+
 void einsum_ir::frontend::EinsumTree::eval() {
   m_nodes.back().eval();
 }
 
+einsum_ir::err_t einsum_ir::frontend::EinsumTree::eval( void * const * i_data_ptrs ) {
+  err_t l_err = set_data_ptrs( i_data_ptrs );
+  if( l_err != err_t::SUCCESS ) {
+    return l_err;
+  }
+
+  eval();
+
+  return err_t::SUCCESS;
+}
+
 int64_t einsum_ir::frontend::EinsumTree::num_ops() {
   if( m_nodes.size() > 0 ) {
     return m_nodes.back().num_ops( true );
@@ -26,12 +26,26 @@ class einsum_ir::frontend::EinsumTree {
     //! data points of the tensors 
     void * const * m_data_ptrs = nullptr;
 
+    //! data pointers of the tensors which were set after compilation
+    std::vector< void * > m_data_ptrs_bound;
+
     //! Memory Manager
     einsum_ir::backend::MemoryManager m_memory;
 
     //! datatype of all tensors
     data_t m_dtype = data_t::UNDEFINED_DTYPE;
 
+    //! true if independent subtrees are evaluated concurrently, has to be set before compilation
+    bool m_inter_op = false;
+
+    //! true if independent subtrees are compiled concurrently, has to be set before compilation
+    //! subtrees with autotuned contractions are compiled sequentially
+    bool m_compile_parallel = false;
+
+    //! memory budget in bytes of intermediate tensors which are kept between evaluations, has to be set before compilation
+    //! if not 0, evaluations are incremental: only the nodes depending on dirty tensors (see mark_dirty) are recomputed
+    int64_t m_cache_budget = 0;
+
     //! mapping from dim ids to sizes
     std::map< int64_t, int64_t > * m_map_dim_sizes;
 
@@ -54,11 +68,66 @@ class einsum_ir::frontend::EinsumTree {
      **/
     err_t compile();
 
+    /**
+     * Writes the compiled contraction plans of the tree to a binary file.
+     * Has to be called after compilation.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were written, otherwise an appropiate error code.
+     **/
+    err_t store_plans( std::string const & i_path ) const;
+
+    /**
+     * Reads contraction plans from a binary file into the process-wide plan cache.
+     * Has to be called before compilation, contractions with a plan skip the contraction optimizer.
+     *
+     * @param i_path path of the file.
+     * @return SUCCESS if the plans were read, otherwise an appropiate error code.
+     **/
+    err_t load_plans( std::string const & i_path );
+
+    /**
+     * Sets the tracer which records the evaluation of the tree.
+     * The ids of the traced nodes follow the breadth-first order starting at the root.
+     * Has to be called after compilation.
+     *
+     * @param i_tracer tracer, nullptr disables tracing.
+     * @return SUCCESS if the tracer was set, otherwise an appropiate error code.
+     **/
+    err_t set_tracer( backend::Tracer * i_tracer );
+
+    /**
+     * Marks a tensor as changed.
+     * In incremental evaluations, only the tensors depending on changed tensors are recomputed.
+     *
+     * @param i_tensor_id id of the tensor, i.e., of its node in the tree.
+     * @return SUCCESS if the tensor was marked, otherwise an appropiate error code.
+     **/
+    err_t mark_dirty( int64_t i_tensor_id );
+
+    /**
+     * Sets the data pointers of the tensors after compilation.
+     * The compiled kernels and the memory plan are reused.
+     * Tensors which were compiled without external data require nullptr.
+     *
+     * @param i_data_ptrs pointers to the tensors' data, ordered as the nodes of the tree.
+     * @return SUCCESS if the pointers were set, otherwise an appropiate error code.
+     **/
+    err_t set_data_ptrs( void * const * i_data_ptrs );
+
     /**
      * Evaluates the einsum tree.
      */
     void eval();
 
+    /**
+     * Evaluates the einsum tree on the given data.
+     *
+     * @param i_data_ptrs pointers to the tensors' data, ordered as the nodes of the tree.
+     * @return SUCCESS if the tree was evaluated, otherwise an appropiate error code.
+     **/
+    err_t eval( void * const * i_data_ptrs );
+
     /**
      * Gets the number of scalar operations required to evaluate the expression.
      *
@@ -160,5 +160,19 @@ TEST_CASE( "creation of a complex einsum tree", "[einsum_tree]" ) {
 
   // check results
   REQUIRE( at::allclose( l_out, l_out_ref )  );
+
+  // intermediate tensors were compiled without external data
+  at::Tensor l_in1_new = at::rand( {5, 2}, at::ScalarType::Double);
+  void * l_data_ptrs_new[] = { l_in1_new.data_ptr(),
+                               l_out.data_ptr(),
+                               l_in2.data_ptr(),
+                               l_in3.data_ptr(),
+                               nullptr,
+                               l_out.data_ptr() };
+  REQUIRE( einsum_tree.set_data_ptrs( l_data_ptrs_new ) == einsum_ir::UNEXPECTED_DATA_PTR );
+
+  l_data_ptrs_new[1] = nullptr;
+  REQUIRE( einsum_tree.eval( l_data_ptrs_new ) == einsum_ir::SUCCESS );
+  REQUIRE( at::allclose( l_out, at::einsum( "da,dce,bec->abc", {l_in1_new, l_in2, l_in3} ) ) );
 }
 
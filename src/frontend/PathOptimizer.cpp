@@ -0,0 +1,539 @@
+#include "PathOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+
+void einsum_ir::frontend::PathOptimizer::dim_ids_contraction( std::vector< int64_t > const & i_dim_ids_left,
+                                                              std::vector< int64_t > const & i_dim_ids_right,
+                                                              std::vector< int64_t > const & i_dim_counts,
+                                                              std::vector< int64_t >       & o_dim_ids_all,
+                                                              std::vector< int64_t >       & o_dim_ids_out ) {
+  o_dim_ids_all.clear();
+  std::set_union( i_dim_ids_left.begin(),
+                  i_dim_ids_left.end(),
+                  i_dim_ids_right.begin(),
+                  i_dim_ids_right.end(),
+                  std::back_inserter( o_dim_ids_all ) );
+
+  o_dim_ids_out.clear();
+  for( std::size_t l_di = 0; l_di < o_dim_ids_all.size(); l_di++ ) {
+    int64_t l_id = o_dim_ids_all[l_di];
+    int64_t l_count = i_dim_counts[l_id];
+    if( std::binary_search( i_dim_ids_left.begin(),  i_dim_ids_left.end(),  l_id ) ) l_count--;
+    if( std::binary_search( i_dim_ids_right.begin(), i_dim_ids_right.end(), l_id ) ) l_count--;
+
+    if( l_count > 0 ) {
+      o_dim_ids_out.push_back( l_id );
+    }
+  }
+}
+
+double einsum_ir::frontend::PathOptimizer::size( std::vector< int64_t > const & i_dim_ids ) const {
+  double l_size = 1;
+  for( std::size_t l_di = 0; l_di < i_dim_ids.size(); l_di++ ) {
+    l_size *= m_dim_sizes[ i_dim_ids[l_di] ];
+  }
+  return l_size;
+}
+
+bool einsum_ir::frontend::PathOptimizer::requires_permutation( int64_t                        i_num_dims,
+                                                               int64_t                const * i_dim_ids,
+                                                               std::vector< int64_t > const & i_dim_ids_other,
+                                                               std::vector< int64_t > const & i_dim_ids_out ) {
+  std::vector< dim_t > l_dim_types_runs;
+
+  for( int64_t l_di = i_num_dims-1; l_di >= 0; l_di-- ) {
+    bool l_other = std::binary_search( i_dim_ids_other.begin(), i_dim_ids_other.end(), i_dim_ids[l_di] );
+    bool l_out   = std::binary_search( i_dim_ids_out.begin(),   i_dim_ids_out.end(),   i_dim_ids[l_di] );
+
+    dim_t l_dim_type = I;
+    if(      l_other &&  l_out ) l_dim_type = C;
+    else if( l_other && !l_out ) l_dim_type = K;
+    else if(             l_out ) l_dim_type = M;
+
+    // outer dimensions are arbitrary
+    if( l_dim_type == I ) {
+      break;
+    }
+
+    if( l_dim_types_runs.size() == 0 || l_dim_types_runs.back() != l_dim_type ) {
+      // types of the trailing runs have to be distinct
+      if( std::find( l_dim_types_runs.begin(),
+                     l_dim_types_runs.end(),
+                     l_dim_type ) != l_dim_types_runs.end() ) {
+        return true;
+      }
+      l_dim_types_runs.push_back( l_dim_type );
+    }
+  }
+
+  return false;
+}
+
+double einsum_ir::frontend::PathOptimizer::cost_contraction( int64_t                        i_id_left,
+                                                             int64_t                        i_id_right,
+                                                             std::vector< int64_t > const & i_dim_ids_left,
+                                                             std::vector< int64_t > const & i_dim_ids_right,
+                                                             std::vector< int64_t > const & i_dim_ids_all,
+                                                             std::vector< int64_t > const & i_dim_ids_out ) const {
+  int64_t l_num_tensors_in = m_dim_ids_in.size();
+
+  double l_num_ops = 2.0 * size( i_dim_ids_all );
+  double l_num_bytes = size( i_dim_ids_out );
+
+  // intermediate tensors are written in the required layout
+  int64_t l_ids[2] = { i_id_left, i_id_right };
+  std::vector< int64_t > const * l_dim_ids_other[2] = { &i_dim_ids_right, &i_dim_ids_left };
+  for( int64_t l_te = 0; l_te < 2; l_te++ ) {
+    if( l_ids[l_te] < l_num_tensors_in ) {
+      std::vector< int64_t > const & l_dim_ids = m_dim_ids_in[ l_ids[l_te] ];
+
+      if( requires_permutation( l_dim_ids.size(),
+                                l_dim_ids.data(),
+                                *l_dim_ids_other[l_te],
+                                i_dim_ids_out ) ) {
+        l_num_bytes += 2.0 * size( l_dim_ids );
+      }
+    }
+  }
+
+  return l_num_ops + m_cost_per_byte * l_num_bytes * m_num_bytes;
+}
+
+void einsum_ir::frontend::PathOptimizer::init( int64_t         i_num_dims,
+                                               int64_t const * i_dim_sizes,
+                                               int64_t         i_num_tensors_in,
+                                               int64_t const * i_string_num_dims,
+                                               int64_t const * i_string_dim_ids,
+                                               data_t          i_dtype ) {
+  m_dim_sizes = std::vector< int64_t >( i_dim_sizes,
+                                        i_dim_sizes + i_num_dims );
+
+  m_dim_ids_in.resize( i_num_tensors_in );
+  int64_t l_off = 0;
+  for( int64_t l_te = 0; l_te < i_num_tensors_in; l_te++ ) {
+    m_dim_ids_in[l_te] = std::vector< int64_t >( i_string_dim_ids + l_off,
+                                                 i_string_dim_ids + l_off + i_string_num_dims[l_te] );
+    l_off += i_string_num_dims[l_te];
+  }
+  m_dim_ids_out = std::vector< int64_t >( i_string_dim_ids + l_off,
+                                          i_string_dim_ids + l_off + i_string_num_dims[i_num_tensors_in] );
+
+  m_num_bytes = ce_n_bytes( i_dtype );
+}
+
+double einsum_ir::frontend::PathOptimizer::search_greedy( int64_t                  i_num_candidates,
+                                                          double                   i_temperature,
+                                                          uint64_t                 i_seed,
+                                                          std::vector< int64_t > & o_path ) const {
+  int64_t l_num_tensors_in = m_dim_ids_in.size();
+  int64_t l_num_dims = m_dim_sizes.size();
+
+  // sorted dimension ids of all tensors, results get the ids following the inputs
+  std::vector< std::vector< int64_t > > l_dim_ids( 2*l_num_tensors_in - 1 );
+  std::vector< int64_t > l_dim_counts( l_num_dims, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    std::set< int64_t > l_set( m_dim_ids_in[l_te].begin(),
+                               m_dim_ids_in[l_te].end() );
+    l_dim_ids[l_te] = std::vector< int64_t >( l_set.begin(),
+                                              l_set.end() );
+    for( std::size_t l_di = 0; l_di < l_dim_ids[l_te].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids[l_te][l_di] ]++;
+    }
+  }
+  std::set< int64_t > l_set_out( m_dim_ids_out.begin(),
+                                 m_dim_ids_out.end() );
+  for( std::set< int64_t >::iterator l_di = l_set_out.begin(); l_di != l_set_out.end(); l_di++ ) {
+    l_dim_counts[ *l_di ]++;
+  }
+
+  std::vector< int64_t > l_alive( l_num_tensors_in );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    l_alive[l_te] = l_te;
+  }
+
+  std::mt19937_64 l_gen( i_seed );
+  std::uniform_real_distribution< double > l_dist( 0.0, 1.0 );
+
+  std::vector< int64_t > l_path_unique;
+  std::vector< int64_t > l_dim_ids_all;
+  std::vector< int64_t > l_dim_ids_out;
+  double l_cost = 0;
+
+  for( int64_t l_id_new = l_num_tensors_in; l_id_new < 2*l_num_tensors_in - 1; l_id_new++ ) {
+    // candidate pairs: tensors with common dimensions, all pairs otherwise
+    std::set< std::pair< int64_t, int64_t > > l_pairs;
+    for( std::size_t l_a = 0; l_a < l_alive.size(); l_a++ ) {
+      for( std::size_t l_b = l_a+1; l_b < l_alive.size(); l_b++ ) {
+        std::vector< int64_t > const & l_ids_a = l_dim_ids[ l_alive[l_a] ];
+        std::vector< int64_t > const & l_ids_b = l_dim_ids[ l_alive[l_b] ];
+        std::vector< int64_t > l_common;
+        std::set_intersection( l_ids_a.begin(), l_ids_a.end(),
+                               l_ids_b.begin(), l_ids_b.end(),
+                               std::back_inserter( l_common ) );
+        if( l_common.size() > 0 ) {
+          l_pairs.insert( { l_alive[l_a], l_alive[l_b] } );
+        }
+      }
+    }
+    if( l_pairs.size() == 0 ) {
+      for( std::size_t l_a = 0; l_a < l_alive.size(); l_a++ ) {
+        for( std::size_t l_b = l_a+1; l_b < l_alive.size(); l_b++ ) {
+          l_pairs.insert( { l_alive[l_a], l_alive[l_b] } );
+        }
+      }
+    }
+
+    // rate the pairs by the reduction in size
+    std::vector< std::pair< double, std::pair< int64_t, int64_t > > > l_rated;
+    for( std::set< std::pair< int64_t, int64_t > >::iterator l_pa = l_pairs.begin(); l_pa != l_pairs.end(); l_pa++ ) {
+      dim_ids_contraction( l_dim_ids[l_pa->first],
+                           l_dim_ids[l_pa->second],
+                           l_dim_counts,
+                           l_dim_ids_all,
+                           l_dim_ids_out );
+      double l_gain =   size( l_dim_ids_out )
+                      - size( l_dim_ids[l_pa->first] )
+                      - size( l_dim_ids[l_pa->second] );
+      l_rated.push_back( { l_gain, *l_pa } );
+    }
+    std::stable_sort( l_rated.begin(),
+                      l_rated.end(),
+                      []( std::pair< double, std::pair< int64_t, int64_t > > const & i_a,
+                          std::pair< double, std::pair< int64_t, int64_t > > const & i_b ) { return i_a.first < i_b.first; } );
+
+    // draw from the best candidates through a Boltzmann distribution
+    int64_t l_num_candidates = std::min( (int64_t) l_rated.size(), std::max( i_num_candidates, (int64_t) 1 ) );
+    int64_t l_choice = 0;
+    if( l_num_candidates > 1 ) {
+      double l_scale = i_temperature * std::max( std::abs( l_rated[0].first ), 1.0 );
+      std::vector< double > l_weights( l_num_candidates );
+      double l_sum = 0;
+      for( int64_t l_ca = 0; l_ca < l_num_candidates; l_ca++ ) {
+        l_weights[l_ca] = std::exp( -( l_rated[l_ca].first - l_rated[0].first ) / l_scale );
+        l_sum += l_weights[l_ca];
+      }
+      double l_draw = l_dist( l_gen ) * l_sum;
+      while( l_choice < l_num_candidates-1 && l_draw > l_weights[l_choice] ) {
+        l_draw -= l_weights[l_choice];
+        l_choice++;
+      }
+    }
+    int64_t l_id_left  = l_rated[l_choice].second.first;
+    int64_t l_id_right = l_rated[l_choice].second.second;
+
+    // contract the pair
+    dim_ids_contraction( l_dim_ids[l_id_left],
+                         l_dim_ids[l_id_right],
+                         l_dim_counts,
+                         l_dim_ids_all,
+                         l_dim_ids_out );
+    l_cost += cost_contraction( l_id_left,
+                                l_id_right,
+                                l_dim_ids[l_id_left],
+                                l_dim_ids[l_id_right],
+                                l_dim_ids_all,
+                                l_dim_ids_out );
+
+    for( std::size_t l_di = 0; l_di < l_dim_ids[l_id_left].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids[l_id_left][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_dim_ids[l_id_right].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids[l_id_right][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_dim_ids_out.size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids_out[l_di] ]++;
+    }
+    l_dim_ids[l_id_new] = l_dim_ids_out;
+
+    l_alive.erase( std::find( l_alive.begin(), l_alive.end(), l_id_left ) );
+    l_alive.erase( std::find( l_alive.begin(), l_alive.end(), l_id_right ) );
+    l_alive.push_back( l_id_new );
+
+    l_path_unique.push_back( l_id_left );
+    l_path_unique.push_back( l_id_right );
+  }
+
+  standard_path( l_path_unique,
+                 o_path );
+
+  return l_cost;
+}
+
+double einsum_ir::frontend::PathOptimizer::search_optimal( std::vector< int64_t > & o_path ) const {
+  int64_t l_num_tensors_in = m_dim_ids_in.size();
+  int64_t l_num_dims = m_dim_sizes.size();
+  int64_t l_num_sets = int64_t(1) << l_num_tensors_in;
+
+  // sorted dimension ids of the inputs
+  std::vector< std::vector< int64_t > > l_dim_ids_in( l_num_tensors_in );
+  std::vector< int64_t > l_dim_counts( l_num_dims, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    std::set< int64_t > l_set( m_dim_ids_in[l_te].begin(),
+                               m_dim_ids_in[l_te].end() );
+    l_dim_ids_in[l_te] = std::vector< int64_t >( l_set.begin(),
+                                                 l_set.end() );
+    for( std::size_t l_di = 0; l_di < l_dim_ids_in[l_te].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids_in[l_te][l_di] ]++;
+    }
+  }
+  std::set< int64_t > l_set_out( m_dim_ids_out.begin(),
+                                 m_dim_ids_out.end() );
+  for( std::set< int64_t >::iterator l_di = l_set_out.begin(); l_di != l_set_out.end(); l_di++ ) {
+    l_dim_counts[ *l_di ]++;
+  }
+
+  // dimensions of the result of every subset: used by an input outside of the subset or by the output
+  std::vector< std::vector< int64_t > > l_dim_ids_sets( l_num_sets );
+  std::vector< int64_t > l_dim_counts_set( l_num_dims, 0 );
+  for( int64_t l_se = 1; l_se < l_num_sets; l_se++ ) {
+    std::set< int64_t > l_dim_ids_union;
+    for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+      if( l_se & (int64_t(1) << l_te) ) {
+        for( std::size_t l_di = 0; l_di < l_dim_ids_in[l_te].size(); l_di++ ) {
+          l_dim_counts_set[ l_dim_ids_in[l_te][l_di] ]++;
+          l_dim_ids_union.insert( l_dim_ids_in[l_te][l_di] );
+        }
+      }
+    }
+    for( std::set< int64_t >::iterator l_di = l_dim_ids_union.begin(); l_di != l_dim_ids_union.end(); l_di++ ) {
+      if( l_dim_counts[*l_di] - l_dim_counts_set[*l_di] > 0 ) {
+        l_dim_ids_sets[l_se].push_back( *l_di );
+      }
+      l_dim_counts_set[*l_di] = 0;
+    }
+  }
+
+  // cheapest evaluation of every subset and the corresponding split
+  std::vector< double > l_costs( l_num_sets, std::numeric_limits< double >::max() );
+  std::vector< int64_t > l_splits( l_num_sets, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    l_costs[ int64_t(1) << l_te ] = 0;
+    l_dim_ids_sets[ int64_t(1) << l_te ] = l_dim_ids_in[l_te];
+  }
+
+  std::vector< int64_t > l_dim_ids_all;
+  for( int64_t l_se = 1; l_se < l_num_sets; l_se++ ) {
+    if( ( l_se & (l_se - 1) ) == 0 ) continue;
+
+    int64_t l_low = l_se & (-l_se);
+    for( int64_t l_left = (l_se - 1) & l_se; l_left > 0; l_left = (l_left - 1) & l_se ) {
+      // every split is considered once
+      if( ( l_left & l_low ) == 0 ) continue;
+      int64_t l_right = l_se ^ l_left;
+
+      double l_cost_children = l_costs[l_left] + l_costs[l_right];
+      if( l_cost_children >= l_costs[l_se] ) continue;
+
+      l_dim_ids_all.clear();
+      std::set_union( l_dim_ids_sets[l_left].begin(),
+                      l_dim_ids_sets[l_left].end(),
+                      l_dim_ids_sets[l_right].begin(),
+                      l_dim_ids_sets[l_right].end(),
+                      std::back_inserter( l_dim_ids_all ) );
+
+      // inputs are identified by their id, results by an id beyond the inputs
+      int64_t l_id_left  = ( l_left  & (l_left  - 1) ) == 0 ? (int64_t) std::log2( l_left )  : l_num_tensors_in;
+      int64_t l_id_right = ( l_right & (l_right - 1) ) == 0 ? (int64_t) std::log2( l_right ) : l_num_tensors_in;
+
+      double l_cost = l_cost_children + cost_contraction( l_id_left,
+                                                          l_id_right,
+                                                          l_dim_ids_sets[l_left],
+                                                          l_dim_ids_sets[l_right],
+                                                          l_dim_ids_all,
+                                                          l_dim_ids_sets[l_se] );
+      if( l_cost < l_costs[l_se] ) {
+        l_costs[l_se] = l_cost;
+        l_splits[l_se] = l_left;
+      }
+    }
+  }
+
+  // assemble the path by a post-order traversal of the splits
+  std::vector< int64_t > l_path_unique;
+  int64_t l_id_next = l_num_tensors_in;
+  std::vector< std::pair< int64_t, bool > > l_stack = { { l_num_sets - 1, false } };
+  std::vector< int64_t > l_ids;
+  while( l_stack.size() > 0 ) {
+    int64_t l_se = l_stack.back().first;
+    bool l_visited = l_stack.back().second;
+    l_stack.pop_back();
+
+    if( ( l_se & (l_se - 1) ) == 0 ) {
+      l_ids.push_back( (int64_t) std::log2( l_se ) );
+    }
+    else if( l_visited ) {
+      int64_t l_id_right = l_ids.back();
+      l_ids.pop_back();
+      int64_t l_id_left = l_ids.back();
+      l_ids.pop_back();
+
+      l_path_unique.push_back( l_id_left );
+      l_path_unique.push_back( l_id_right );
+      l_ids.push_back( l_id_next );
+      l_id_next++;
+    }
+    else {
+      l_stack.push_back( { l_se, true } );
+      l_stack.push_back( { l_se ^ l_splits[l_se], false } );
+      l_stack.push_back( { l_splits[l_se], false } );
+    }
+  }
+
+  standard_path( l_path_unique,
+                 o_path );
+
+  return l_costs[l_num_sets - 1];
+}
+
+void einsum_ir::frontend::PathOptimizer::standard_path( std::vector< int64_t > const & i_path_unique,
+                                                        std::vector< int64_t >       & o_path ) const {
+  int64_t l_num_tensors = m_dim_ids_in.size();
+
+  std::vector< int64_t > l_tensor_ids( l_num_tensors );
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_tensor_ids[l_te] = l_te;
+  }
+
+  o_path.clear();
+  for( std::size_t l_co = 0; l_co < i_path_unique.size() / 2; l_co++ ) {
+    int64_t l_pos_0 = std::find( l_tensor_ids.begin(), l_tensor_ids.end(), i_path_unique[l_co*2 + 0] ) - l_tensor_ids.begin();
+    int64_t l_pos_1 = std::find( l_tensor_ids.begin(), l_tensor_ids.end(), i_path_unique[l_co*2 + 1] ) - l_tensor_ids.begin();
+
+    o_path.push_back( std::min( l_pos_0, l_pos_1 ) );
+    o_path.push_back( std::max( l_pos_0, l_pos_1 ) );
+
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::max( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::min( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.push_back( l_num_tensors );
+    l_num_tensors++;
+  }
+}
+
+double einsum_ir::frontend::PathOptimizer::cost( std::vector< int64_t > const & i_path ) const {
+  int64_t l_num_tensors_in = m_dim_ids_in.size();
+  int64_t l_num_dims = m_dim_sizes.size();
+
+  std::vector< std::vector< int64_t > > l_dim_ids;
+  std::vector< int64_t > l_dim_counts( l_num_dims, 0 );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    std::set< int64_t > l_set( m_dim_ids_in[l_te].begin(),
+                               m_dim_ids_in[l_te].end() );
+    l_dim_ids.push_back( std::vector< int64_t >( l_set.begin(),
+                                                 l_set.end() ) );
+    for( std::set< int64_t >::iterator l_di = l_set.begin(); l_di != l_set.end(); l_di++ ) {
+      l_dim_counts[ *l_di ]++;
+    }
+  }
+  std::set< int64_t > l_set_out( m_dim_ids_out.begin(),
+                                 m_dim_ids_out.end() );
+  for( std::set< int64_t >::iterator l_di = l_set_out.begin(); l_di != l_set_out.end(); l_di++ ) {
+    l_dim_counts[ *l_di ]++;
+  }
+
+  std::vector< int64_t > l_tensor_ids( l_num_tensors_in );
+  for( int64_t l_te = 0; l_te < l_num_tensors_in; l_te++ ) {
+    l_tensor_ids[l_te] = l_te;
+  }
+
+  double l_cost = 0;
+  std::vector< int64_t > l_dim_ids_all;
+  std::vector< int64_t > l_dim_ids_out;
+  for( std::size_t l_co = 0; l_co < i_path.size() / 2; l_co++ ) {
+    int64_t l_pos_0 = i_path[l_co*2 + 0];
+    int64_t l_pos_1 = i_path[l_co*2 + 1];
+    int64_t l_id_0 = l_tensor_ids[l_pos_0];
+    int64_t l_id_1 = l_tensor_ids[l_pos_1];
+
+    dim_ids_contraction( l_dim_ids[l_id_0],
+                         l_dim_ids[l_id_1],
+                         l_dim_counts,
+                         l_dim_ids_all,
+                         l_dim_ids_out );
+    l_cost += cost_contraction( l_id_0,
+                                l_id_1,
+                                l_dim_ids[l_id_0],
+                                l_dim_ids[l_id_1],
+                                l_dim_ids_all,
+                                l_dim_ids_out );
+
+    for( std::size_t l_di = 0; l_di < l_dim_ids[l_id_0].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids[l_id_0][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_dim_ids[l_id_1].size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids[l_id_1][l_di] ]--;
+    }
+    for( std::size_t l_di = 0; l_di < l_dim_ids_out.size(); l_di++ ) {
+      l_dim_counts[ l_dim_ids_out[l_di] ]++;
+    }
+
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::max( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.erase( l_tensor_ids.begin() + std::min( l_pos_0, l_pos_1 ) );
+    l_tensor_ids.push_back( l_dim_ids.size() );
+    l_dim_ids.push_back( l_dim_ids_out );
+  }
+
+  return l_cost;
+}
+
+einsum_ir::err_t einsum_ir::frontend::PathOptimizer::optimize( path_t                   i_method,
+                                                               std::vector< int64_t > & o_path ) const {
+  int64_t l_num_tensors_in = m_dim_ids_in.size();
+  o_path.clear();
+
+  if( l_num_tensors_in < 1 ) {
+    return err_t::INVALID_PATH;
+  }
+  else if( l_num_tensors_in == 1 ) {
+    return err_t::SUCCESS;
+  }
+
+  path_t l_method = i_method;
+  if( l_method == path_t::AUTO_PATH ) {
+    if( l_num_tensors_in <= m_max_inputs_optimal ) {
+      l_method = path_t::OPTIMAL_PATH;
+    }
+    else {
+      l_method = path_t::RANDOM_GREEDY_PATH;
+    }
+  }
+
+  if( l_method == path_t::GREEDY_PATH ) {
+    search_greedy( 1,
+                   0,
+                   m_seed,
+                   o_path );
+  }
+  else if( l_method == path_t::OPTIMAL_PATH ) {
+    if( l_num_tensors_in > m_max_inputs_optimal_limit ) {
+      return err_t::INVALID_PATH;
+    }
+    search_optimal( o_path );
+  }
+  else if( l_method == path_t::RANDOM_GREEDY_PATH ) {
+    // the first search is deterministic
+    double l_cost_best = search_greedy( 1,
+                                        0,
+                                        m_seed,
+                                        o_path );
+    std::vector< int64_t > l_path;
+    for( int64_t l_tr = 1; l_tr < m_num_trials; l_tr++ ) {
+      double l_cost = search_greedy( m_num_candidates,
+                                     m_temperature,
+                                     m_seed + l_tr,
+                                     l_path );
+      if( l_cost < l_cost_best ) {
+        l_cost_best = l_cost;
+        o_path = l_path;
+      }
+    }
+  }
+  else {
+    return err_t::INVALID_PATH;
+  }
+
+  return err_t::SUCCESS;
+}
@@ -0,0 +1,186 @@
+#ifndef EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+#define EINSUM_IR_FRONTEND_PATH_OPTIMIZER
+
+#include <cstdint>
+#include <vector>
+#include "../constants.h"
+
+namespace einsum_ir {
+  namespace frontend {
+    class PathOptimizer;
+  }
+}
+
+/**
+ * Searches contraction paths of einsum expressions.
+ * The paths are given in the standard formulation, i.e., contracted tensors are removed and the result is appended.
+ *
+ * The cost of a binary contraction consists of its floating point operations and the moved bytes, weighted by m_cost_per_byte.
+ * The moved bytes are the written intermediate tensor and the permutations of input tensors.
+ * Intermediate tensors are written in the layout required by their consumer and are never permuted.
+ * An input tensor is expected to require a permutation if its trailing dimensions may not be blocked by the primitives.
+ **/
+class einsum_ir::frontend::PathOptimizer {
+  private:
+    //! sizes of the dimensions
+    std::vector< int64_t > m_dim_sizes;
+
+    //! dimension ids of the input tensors
+    std::vector< std::vector< int64_t > > m_dim_ids_in;
+
+    //! dimension ids of the output tensor
+    std::vector< int64_t > m_dim_ids_out;
+
+    //! number of bytes per tensor entry
+    int64_t m_num_bytes = 4;
+
+    /**
+     * Derives the dimensions of the result of a contraction of two tensors.
+     * A dimension is kept if it is used by one of the other tensors or by the output tensor.
+     *
+     * @param i_dim_ids_left sorted dimension ids of the left tensor.
+     * @param i_dim_ids_right sorted dimension ids of the right tensor.
+     * @param i_dim_counts number of remaining tensors which use a dimension, the output tensor included.
+     * @param o_dim_ids_all will be set to the sorted dimension ids of both tensors.
+     * @param o_dim_ids_out will be set to the sorted dimension ids of the result.
+     **/
+    static void dim_ids_contraction( std::vector< int64_t > const & i_dim_ids_left,
+                                     std::vector< int64_t > const & i_dim_ids_right,
+                                     std::vector< int64_t > const & i_dim_counts,
+                                     std::vector< int64_t >       & o_dim_ids_all,
+                                     std::vector< int64_t >       & o_dim_ids_out );
+
+    /**
+     * Gets the number of entries of a tensor.
+     *
+     * @param i_dim_ids dimension ids of the tensor.
+     * @return number of entries.
+     **/
+    double size( std::vector< int64_t > const & i_dim_ids ) const;
+
+    /**
+     * Derives the cost of a binary contraction.
+     *
+     * @param i_id_left id of the left tensor, ids of input tensors are smaller than the number of inputs.
+     * @param i_id_right id of the right tensor.
+     * @param i_dim_ids_left sorted dimension ids of the left tensor.
+     * @param i_dim_ids_right sorted dimension ids of the right tensor.
+     * @param i_dim_ids_all sorted dimension ids of both tensors.
+     * @param i_dim_ids_out sorted dimension ids of the result.
+     * @return cost of the contraction.
+     **/
+    double cost_contraction( int64_t                        i_id_left,
+                             int64_t                        i_id_right,
+                             std::vector< int64_t > const & i_dim_ids_left,
+                             std::vector< int64_t > const & i_dim_ids_right,
+                             std::vector< int64_t > const & i_dim_ids_all,
+                             std::vector< int64_t > const & i_dim_ids_out ) const;
+
+    /**
+     * Searches a path by greedily contracting the pair with the largest reduction in size.
+     * Pairs without common dimensions are only considered if no other pairs exist.
+     *
+     * @param i_num_candidates number of best pairs from which the contracted one is drawn, 1 is deterministic.
+     * @param i_temperature temperature of the Boltzmann distribution over the candidates.
+     * @param i_seed seed of the random number generator.
+     * @param o_path will be set to the contraction path.
+     * @return cost of the path.
+     **/
+    double search_greedy( int64_t                  i_num_candidates,
+                          double                   i_temperature,
+                          uint64_t                 i_seed,
+                          std::vector< int64_t > & o_path ) const;
+
+    /**
+     * Searches the path with the lowest cost through dynamic programming over the subsets of the inputs.
+     *
+     * @param o_path will be set to the contraction path.
+     * @return cost of the path.
+     **/
+    double search_optimal( std::vector< int64_t > & o_path ) const;
+
+    /**
+     * Converts a path in which every tensor has a unique id to the standard formulation.
+     *
+     * @param i_path_unique contraction path with unique tensor ids, results get the ids following the inputs.
+     * @param o_path will be set to the contraction path in the standard formulation.
+     **/
+    void standard_path( std::vector< int64_t > const & i_path_unique,
+                        std::vector< int64_t >       & o_path ) const;
+
+  public:
+    //! weight of a moved byte relative to a floating point operation
+    double m_cost_per_byte = 8.0;
+
+    //! maximum number of inputs for which AUTO_PATH uses the optimal search
+    int64_t m_max_inputs_optimal = 10;
+
+    //! maximum number of inputs of the optimal search
+    int64_t m_max_inputs_optimal_limit = 16;
+
+    //! number of searches of the randomized greedy search
+    int64_t m_num_trials = 32;
+
+    //! number of best pairs from which the randomized greedy search draws
+    int64_t m_num_candidates = 4;
+
+    //! temperature of the randomized greedy search
+    double m_temperature = 0.3;
+
+    //! seed of the randomized greedy search
+    uint64_t m_seed = 0;
+
+    /**
+     * Determines if an input tensor is expected to require a permutation.
+     * The trailing dimensions have to be runs of distinct types which may be blocked by the primitives,
+     * i.e., dimensions kept in the output, contracted dimensions or dimensions shared by all tensors.
+     * Outer dimensions are arbitrary.
+     *
+     * @param i_num_dims number of dimensions of the tensor.
+     * @param i_dim_ids dimension ids of the tensor in external order.
+     * @param i_dim_ids_other sorted dimension ids of the other tensor.
+     * @param i_dim_ids_out sorted dimension ids of the result.
+     * @return true if a permutation is expected, false otherwise.
+     **/
+    static bool requires_permutation( int64_t                        i_num_dims,
+                                      int64_t                const * i_dim_ids,
+                                      std::vector< int64_t > const & i_dim_ids_other,
+                                      std::vector< int64_t > const & i_dim_ids_out );
+
+    /**
+     * Initializes the path optimizer.
+     *
+     * @param i_num_dims number of dimensions.
+     * @param i_dim_sizes sizes of the dimensions.
+     * @param i_num_tensors_in number of input tensors.
+     * @param i_string_num_dims sizes of the substrings describing the input tensors and output tensor.
+     * @param i_string_dim_ids einsum string containing the dimension ids.
+     * @param i_dtype datatype of the tensors.
+     **/
+    void init( int64_t         i_num_dims,
+               int64_t const * i_dim_sizes,
+               int64_t         i_num_tensors_in,
+               int64_t const * i_string_num_dims,
+               int64_t const * i_string_dim_ids,
+               data_t          i_dtype );
+
+    /**
+     * Derives the cost of a contraction path.
+     *
+     * @param i_path contraction path in the standard formulation.
+     * @return cost of the path.
+     **/
+    double cost( std::vector< int64_t > const & i_path ) const;
+
+    /**
+     * Searches a contraction path.
+     *
+     * @param i_method search method.
+     * @param o_path will be set to the contraction path in the standard formulation.
+     * @return SUCCESS if a path was found, otherwise an appropiate error code.
+     **/
+    err_t optimize( path_t                   i_method,
+                    std::vector< int64_t > & o_path ) const;
+};
+
+#endif
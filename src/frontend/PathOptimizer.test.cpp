@@ -0,0 +1,133 @@
+#include "catch.hpp"
+#include "PathOptimizer.h"
+
+TEST_CASE( "Expected permutations of input tensors.", "[path_optimizer]" ) {
+  using namespace einsum_ir::frontend;
+
+  // ab,bc->ac
+  int64_t l_dim_ids_0[2] = { 0, 1 };
+  std::vector< int64_t > l_dim_ids_other = { 1, 2 };
+  std::vector< int64_t > l_dim_ids_out   = { 0, 2 };
+  REQUIRE( PathOptimizer::requires_permutation( 2, l_dim_ids_0, l_dim_ids_other, l_dim_ids_out ) == false );
+
+  // kmk: contracted dimensions are split by a kept one
+  int64_t l_dim_ids_1[3] = { 1, 0, 3 };
+  l_dim_ids_other = { 1, 2, 3 };
+  REQUIRE( PathOptimizer::requires_permutation( 3, l_dim_ids_1, l_dim_ids_other, l_dim_ids_out ) == true );
+
+  // outer dimensions which are neither contracted nor kept are arbitrary
+  int64_t l_dim_ids_2[4] = { 0, 5, 1, 3 };
+  l_dim_ids_other = { 1, 2 };
+  l_dim_ids_out   = { 0, 2, 3 };
+  REQUIRE( PathOptimizer::requires_permutation( 4, l_dim_ids_2, l_dim_ids_other, l_dim_ids_out ) == false );
+}
+
+TEST_CASE( "Contraction paths of a matrix chain.", "[path_optimizer]" ) {
+  using namespace einsum_ir;
+  using namespace einsum_ir::frontend;
+
+  // ab,bc,cd->ad
+  int64_t l_dim_sizes[4] = { 10, 1000, 10, 1000 };
+  int64_t l_string_num_dims[4] = { 2, 2, 2, 2 };
+  int64_t l_string_dim_ids[8] = { 0, 1,  1, 2,  2, 3,  0, 3 };
+
+  PathOptimizer l_opt;
+  l_opt.init( 4,
+              l_dim_sizes,
+              3,
+              l_string_num_dims,
+              l_string_dim_ids,
+              data_t::FP32 );
+
+  std::vector< path_t > l_methods = { path_t::GREEDY_PATH,
+                                      path_t::OPTIMAL_PATH,
+                                      path_t::RANDOM_GREEDY_PATH,
+                                      path_t::AUTO_PATH };
+  for( std::size_t l_me = 0; l_me < l_methods.size(); l_me++ ) {
+    std::vector< int64_t > l_path;
+    REQUIRE( l_opt.optimize( l_methods[l_me], l_path ) == err_t::SUCCESS );
+
+    REQUIRE( l_path.size() == 4 );
+    REQUIRE( l_path[0] == 0 );
+    REQUIRE( l_path[1] == 1 );
+    REQUIRE( l_path[2] == 0 );
+    REQUIRE( l_path[3] == 1 );
+  }
+
+  std::vector< int64_t > l_path_ab_c = { 0, 1, 0, 1 };
+  std::vector< int64_t > l_path_a_bc = { 1, 2, 0, 1 };
+  REQUIRE( l_opt.cost( l_path_ab_c ) < l_opt.cost( l_path_a_bc ) );
+}
+
+TEST_CASE( "Contraction paths of a tensor network.", "[path_optimizer]" ) {
+  using namespace einsum_ir;
+  using namespace einsum_ir::frontend;
+
+  // iae,bf,dcba,cg,dh->hgfei
+  int64_t l_dim_sizes[9] = { 32, 8, 4, 2, 16, 64, 8, 8, 8 };
+  int64_t l_string_num_dims[6] = { 3, 2, 4, 2, 2, 5 };
+  int64_t l_string_dim_ids[18] = { 8, 0, 4,  1, 5,  3, 2, 1, 0,  2, 6,  3, 7,  7, 6, 5, 4, 8 };
+
+  PathOptimizer l_opt;
+  l_opt.init( 9,
+              l_dim_sizes,
+              5,
+              l_string_num_dims,
+              l_string_dim_ids,
+              data_t::FP32 );
+
+  std::vector< int64_t > l_path_greedy;
+  std::vector< int64_t > l_path_optimal;
+  std::vector< int64_t > l_path_random;
+  REQUIRE( l_opt.optimize( path_t::GREEDY_PATH,        l_path_greedy  ) == err_t::SUCCESS );
+  REQUIRE( l_opt.optimize( path_t::OPTIMAL_PATH,       l_path_optimal ) == err_t::SUCCESS );
+  REQUIRE( l_opt.optimize( path_t::RANDOM_GREEDY_PATH, l_path_random  ) == err_t::SUCCESS );
+
+  // valid paths in the standard formulation
+  std::vector< std::vector< int64_t > > l_paths = { l_path_greedy, l_path_optimal, l_path_random };
+  for( std::size_t l_pa = 0; l_pa < l_paths.size(); l_pa++ ) {
+    REQUIRE( l_paths[l_pa].size() == 8 );
+    for( int64_t l_co = 0; l_co < 4; l_co++ ) {
+      REQUIRE( l_paths[l_pa][l_co*2 + 0] <  l_paths[l_pa][l_co*2 + 1] );
+      REQUIRE( l_paths[l_pa][l_co*2 + 1] <  5 - l_co );
+    }
+  }
+
+  std::vector< int64_t > l_path_ext = { 1, 2, 2, 3, 0, 1, 0, 1 };
+  REQUIRE( l_opt.cost( l_path_optimal ) <= l_opt.cost( l_path_greedy ) );
+  REQUIRE( l_opt.cost( l_path_optimal ) <= l_opt.cost( l_path_random ) );
+  REQUIRE( l_opt.cost( l_path_optimal ) <= l_opt.cost( l_path_ext ) );
+  REQUIRE( l_opt.cost( l_path_random )  <= l_opt.cost( l_path_greedy ) );
+}
+
+TEST_CASE( "Limit of the optimal contraction path search.", "[path_optimizer]" ) {
+  using namespace einsum_ir;
+  using namespace einsum_ir::frontend;
+
+  // chain of 20 matrices
+  int64_t l_num_tensors = 20;
+  std::vector< int64_t > l_dim_sizes( l_num_tensors + 1 );
+  std::vector< int64_t > l_string_num_dims( l_num_tensors + 1, 2 );
+  std::vector< int64_t > l_string_dim_ids;
+  for( int64_t l_te = 0; l_te < l_num_tensors; l_te++ ) {
+    l_dim_sizes[l_te] = 4 + (l_te * 7) % 13;
+    l_string_dim_ids.push_back( l_te );
+    l_string_dim_ids.push_back( l_te + 1 );
+  }
+  l_dim_sizes[l_num_tensors] = 5;
+  l_string_dim_ids.push_back( 0 );
+  l_string_dim_ids.push_back( l_num_tensors );
+
+  PathOptimizer l_opt;
+  l_opt.init( l_num_tensors + 1,
+              l_dim_sizes.data(),
+              l_num_tensors,
+              l_string_num_dims.data(),
+              l_string_dim_ids.data(),
+              data_t::FP64 );
+
+  std::vector< int64_t > l_path;
+  REQUIRE( l_opt.optimize( path_t::OPTIMAL_PATH, l_path ) == err_t::INVALID_PATH );
+  REQUIRE( l_opt.optimize( path_t::AUTO_PATH,    l_path ) == err_t::SUCCESS );
+  REQUIRE( (int64_t) l_path.size() == 2 * (l_num_tensors - 1) );
+}